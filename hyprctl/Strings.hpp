@@ -51,8 +51,12 @@ commands:
     setprop ...         → Sets a window property
     getprop ...         → Gets a window property
     splash              → Get the current splash
+    state [generation]  → Lists monitors, workspaces and windows that changed
+                          since a generation, or all of them without one
     switchxkblayout ... → Sets the xkb layout index for a keyboard
     systeminfo          → Get system info
+    trace ...           → Records a frame timeline and dumps it as a Chrome
+                          trace
     version             → Prints the hyprland version, meaning flags, commit
                           and branch of build.
     workspacerules      → Lists all workspace rules
@@ -63,6 +67,8 @@ flags:
     -r                  → Refresh state after issuing command (e.g. for
                           updating variables)
     --batch             → Execute a batch of commands, separated by ';'
+    --binary            → Send a --batch as pipelined binary requests over
+                          one connection
     --instance (-i)     → use a specific instance. Can be either signature or
                           index in hyprctl instances (0, 1, etc)
     --quiet (-q)        → Disable the output of hyprctl
@@ -184,3 +190,15 @@ cmd:
 
 flags:
     See 'hyprctl --help')#";
+
+const std::string_view TRACE_HELP = R"#(usage: hyprctl [flags] trace <request>
+
+requests:
+    start           → Starts recording the frame timeline
+    stop            → Stops recording
+    dump <path>     → Writes what was recorded since the last start as
+                      Chrome trace JSON, for chrome://tracing or
+                      ui.perfetto.dev
+
+flags:
+    See 'hyprctl --help')#";
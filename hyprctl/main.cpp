@@ -31,6 +31,7 @@ using namespace Hyprutils::String;
 using namespace Hyprutils::Memory;
 
 #include "Strings.hpp"
+#include "../src/debug/HyprCtlProtocol.hpp"
 
 std::string instanceSignature;
 bool        quiet = false;
@@ -254,6 +255,129 @@ int request(std::string_view arg, int minArgs = 0, bool needRoll = false) {
     return 0;
 }
 
+// splits a batch on ';', except inside [], like Hyprland does
+static std::vector<std::string> splitBatch(std::string_view commands) {
+    std::vector<std::string> result;
+    int                      bracket = 0;
+    size_t                   idx     = 0;
+
+    for (size_t i = 0; i <= commands.size(); ++i) {
+        const char ch = i < commands.size() ? commands[i] : ';';
+        if (ch == '[')
+            ++bracket;
+        else if (ch == ']')
+            --bracket;
+        else if (ch == ';' && bracket == 0) {
+            const auto CMD = trim(std::string{commands.substr(idx, i - idx)});
+            if (!CMD.empty())
+                result.emplace_back(CMD);
+            idx = i + 1;
+        }
+    }
+
+    return result;
+}
+
+// sends all requests at once over one connection in binary framing, prints the replies in request order
+int binaryRequest(const std::vector<std::string>& requests) {
+    const auto SERVERSOCKET = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (SERVERSOCKET < 0) {
+        log("Couldn't open a socket (1)");
+        return 1;
+    }
+
+    auto t = timeval{.tv_sec = 5, .tv_usec = 0};
+    if (setsockopt(SERVERSOCKET, SOL_SOCKET, SO_RCVTIMEO, &t, sizeof(struct timeval)) < 0) {
+        log("Couldn't set socket timeout (2)");
+        return 2;
+    }
+
+    if (instanceSignature.empty()) {
+        log("HYPRLAND_INSTANCE_SIGNATURE was not set! (Is Hyprland running?) (3)");
+        return 3;
+    }
+
+    sockaddr_un serverAddress = {0};
+    serverAddress.sun_family  = AF_UNIX;
+
+    std::string socketPath = getRuntimeDir() + "/" + instanceSignature + "/.socket.sock";
+
+    strncpy(serverAddress.sun_path, socketPath.c_str(), sizeof(serverAddress.sun_path) - 1);
+
+    if (connect(SERVERSOCKET, rc<sockaddr*>(&serverAddress), SUN_LEN(&serverAddress)) < 0) {
+        log("Couldn't connect to " + socketPath + ". (4)");
+        return 4;
+    }
+
+    std::string out(HyprCtlProtocol::BINARY_MAGIC.data(), HyprCtlProtocol::BINARY_MAGIC.size());
+    for (uint32_t i = 0; i < requests.size(); ++i) {
+        const HyprCtlProtocol::SFrameHeader HEADER = {.id = i, .length = sc<uint32_t>(requests[i].size())};
+        out.append(rc<const char*>(&HEADER), sizeof(HEADER));
+        out.append(requests[i]);
+    }
+
+    for (std::string_view left = out; !left.empty();) {
+        const auto WRITTEN = write(SERVERSOCKET, left.data(), left.size());
+        if (WRITTEN < 0) {
+            log("Couldn't write (5)");
+            close(SERVERSOCKET);
+            return 5;
+        }
+
+        left.remove_prefix(WRITTEN);
+    }
+
+    std::vector<std::optional<std::string>> replies(requests.size());
+    size_t                                  pending = requests.size();
+    std::string                             in;
+    std::array<char, 8192>                  buffer;
+
+    while (pending > 0) {
+        const auto LEN = read(SERVERSOCKET, buffer.data(), buffer.size());
+        if (LEN <= 0) {
+            if (LEN < 0 && errno == EWOULDBLOCK)
+                log("Hyprland IPC didn't respond in time\n");
+            log("Couldn't read (6)");
+            close(SERVERSOCKET);
+            return 6;
+        }
+
+        in.append(buffer.data(), LEN);
+
+        size_t offset = 0;
+        while (in.size() - offset >= sizeof(HyprCtlProtocol::SFrameHeader)) {
+            HyprCtlProtocol::SFrameHeader header;
+            std::memcpy(&header, in.data() + offset, sizeof(header));
+
+            if (in.size() - offset - sizeof(header) < header.length)
+                break;
+
+            if (header.id < replies.size() && !replies[header.id]) {
+                replies[header.id] = in.substr(offset + sizeof(header), header.length);
+                pending--;
+            }
+
+            offset += sizeof(header) + header.length;
+        }
+
+        in.erase(0, offset);
+    }
+
+    close(SERVERSOCKET);
+
+    std::string result;
+    for (const auto& r : replies) {
+        if (!result.empty())
+            result += "\n\n\n";
+        result += *r;
+    }
+
+    log(result);
+
+    return 0;
+}
+
 int requestIPC(std::string_view filename, std::string_view arg) {
     const auto SERVERSOCKET = socket(AF_UNIX, SOCK_STREAM, 0);
 
@@ -313,7 +437,7 @@ int requestHyprsunset(std::string_view arg) {
     return requestIPC(".hyprsunset.sock", arg);
 }
 
-void batchRequest(std::string_view arg, bool json) {
+int batchRequest(std::string_view arg, bool json, bool binary) {
     std::string commands(arg.substr(arg.find_first_of(' ') + 1));
 
     if (json) {
@@ -321,8 +445,11 @@ void batchRequest(std::string_view arg, bool json) {
         commands.insert(0, "j/");
     }
 
+    if (binary)
+        return binaryRequest(splitBatch(commands));
+
     std::string rq = "[[BATCH]]" + commands;
-    request(rq);
+    return request(rq);
 }
 
 void instancesRequest(bool json) {
@@ -377,6 +504,7 @@ int main(int argc, char** argv) {
     const auto  ARGS             = splitArgs(argc, argv);
     bool        json             = false;
     bool        needRoll         = false;
+    bool        binary           = false;
     std::string overrideInstance = "";
 
     for (std::size_t i = 0; i < ARGS.size(); ++i) {
@@ -401,6 +529,8 @@ int main(int argc, char** argv) {
                 needRoll = true;
             } else if (ARGS[i] == "--batch") {
                 fullRequest = "--batch ";
+            } else if (ARGS[i] == "--binary") {
+                binary = true;
             } else if (ARGS[i] == "--instance" || ARGS[i] == "-i") {
                 ++i;
 
@@ -431,6 +561,8 @@ int main(int argc, char** argv) {
                     std::println("{}", GETPROP_HELP);
                 } else if (cmd == "switchxkblayout") {
                     std::println("{}", SWITCHXKBLAYOUT_HELP);
+                } else if (cmd == "trace") {
+                    std::println("{}", TRACE_HELP);
                 } else {
                     std::println("{}", USAGE);
                 }
@@ -444,6 +576,12 @@ int main(int argc, char** argv) {
             continue;
         }
 
+        // hyprland doesn't share our cwd
+        if (i >= 2 && ARGS[i - 2] == "trace" && ARGS[i - 1] == "dump") {
+            fullRequest += std::filesystem::absolute(ARGS[i]).string() + " ";
+            continue;
+        }
+
         fullRequest += ARGS[i] + " ";
     }
 
@@ -499,7 +637,7 @@ int main(int argc, char** argv) {
     int exitStatus = 0;
 
     if (fullRequest.contains("/--batch"))
-        batchRequest(fullRequest, json);
+        exitStatus = batchRequest(fullRequest, json, binary);
     else if (fullRequest.contains("/hyprpaper"))
         exitStatus = requestHyprpaper(fullRequest);
     else if (fullRequest.contains("/hyprsunset"))
@@ -512,6 +650,8 @@ int main(int argc, char** argv) {
         exitStatus = request(fullRequest, 3);
     else if (fullRequest.contains("/plugin"))
         exitStatus = request(fullRequest, 1);
+    else if (fullRequest.contains("/trace"))
+        exitStatus = request(fullRequest, 1);
     else if (fullRequest.contains("/dismissnotify"))
         exitStatus = request(fullRequest, 0);
     else if (fullRequest.contains("/notify"))
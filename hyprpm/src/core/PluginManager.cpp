@@ -14,7 +14,10 @@
 #include <print>
 #include <fstream>
 #include <algorithm>
+#include <atomic>
 #include <format>
+#include <ranges>
+#include <thread>
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -54,6 +57,26 @@ static std::string getTempRoot() {
     return STR;
 }
 
+// user-writable, unlike the state store. Empty if there's nowhere to cache to.
+static std::string getCacheRoot() {
+    if (const auto XDG = getenv("XDG_CACHE_HOME"); XDG && XDG[0] == '/')
+        return XDG + std::string{"/hyprpm/"};
+
+    if (const auto HOME = getenv("HOME"); HOME && HOME[0] == '/')
+        return HOME + std::string{"/.cache/hyprpm/"};
+
+    return "";
+}
+
+static std::string gitCommand(const std::string& url) {
+    // since git 2.38 submodules of a local remote aren't cloned unless allowed explicitly.
+    // The user asked for this remote, so let it bring its submodules along.
+    if (url.starts_with("file://") || url.starts_with("/"))
+        return "git -c protocol.file.allow=always";
+
+    return "git";
+}
+
 CPluginManager::CPluginManager() {
     if (NSys::isSuperuser())
         Debug::die("Don't run hyprpm as a superuser.");
@@ -205,7 +228,7 @@ bool CPluginManager::addNewPluginRepo(const std::string& url, const std::string&
 
     progress.printMessageAbove(infoString("Cloning {}", url));
 
-    std::string ret = execAndGet(std::format("cd {} && git clone --recursive {} {}", getTempRoot(), url, USERNAME));
+    std::string ret = execAndGet(std::format("cd {} && {} clone --recursive {} {}", getTempRoot(), gitCommand(url), url, USERNAME));
 
     if (!std::filesystem::exists(m_szWorkingPluginDirectory + "/.git")) {
         std::println(stderr, "\n{}", failureString("Could not clone the plugin repository. shell returned:\n{}", ret));
@@ -213,14 +236,14 @@ bool CPluginManager::addNewPluginRepo(const std::string& url, const std::string&
     }
 
     if (!rev.empty()) {
-        std::string ret = execAndGet("git -C " + m_szWorkingPluginDirectory + " reset --hard --recurse-submodules " + rev);
+        std::string ret = execAndGet(gitCommand(url) + " -C " + m_szWorkingPluginDirectory + " reset --hard --recurse-submodules " + rev);
         if (ret.compare(0, 6, "fatal:") == 0) {
             std::println(stderr, "\n{}", failureString("Could not check out revision {}. shell returned:\n{}", rev, ret));
             return false;
         }
-        ret = execAndGet("git -C " + m_szWorkingPluginDirectory + " submodule update --init");
+        ret = execAndGet(gitCommand(url) + " -C " + m_szWorkingPluginDirectory + " submodule update --init");
         if (m_bVerbose)
-            std::println("{}", verboseString("git submodule update --init returned: {}", ret));
+            progress.printMessageAbove(verboseString("git submodule update --init returned: {}", ret));
     }
 
     progress.m_iSteps = 1;
@@ -274,11 +297,11 @@ bool CPluginManager::addNewPluginRepo(const std::string& url, const std::string&
 
             progress.printMessageAbove(successString("commit pin {} matched hl, resetting", plugin));
 
-            execAndGet("cd " + m_szWorkingPluginDirectory + " && git reset --hard --recurse-submodules " + plugin);
+            execAndGet("cd " + m_szWorkingPluginDirectory + " && " + gitCommand(url) + " reset --hard --recurse-submodules " + plugin);
 
-            ret = execAndGet("git -C " + m_szWorkingPluginDirectory + " submodule update --init");
+            ret = execAndGet(gitCommand(url) + " -C " + m_szWorkingPluginDirectory + " submodule update --init");
             if (m_bVerbose)
-                std::println("{}", verboseString("git submodule update --init returned: {}", ret));
+                progress.printMessageAbove(verboseString("git submodule update --init returned: {}", ret));
 
             break;
         }
@@ -295,6 +318,8 @@ bool CPluginManager::addNewPluginRepo(const std::string& url, const std::string&
         return false;
     }
 
+    prepareBuildEnvironment(progress);
+
     progress.m_iSteps = 3;
     progress.printMessageAbove(successString("Hyprland headers OK"));
     progress.m_szCurrentMessage = "Building plugin(s)";
@@ -312,12 +337,12 @@ bool CPluginManager::addNewPluginRepo(const std::string& url, const std::string&
         progress.printMessageAbove(infoString("Building {}", p.name));
 
         for (auto const& bs : p.buildSteps) {
-            const std::string& cmd = std::format("cd {} && PKG_CONFIG_PATH=\"{}/share/pkgconfig\" {}", m_szWorkingPluginDirectory, DataState::getHeadersPath(), bs);
-            out += " -> " + cmd + "\n" + execAndGet(cmd) + "\n";
+            const auto CMD = buildCommand(m_szWorkingPluginDirectory, bs);
+            out += " -> " + CMD + "\n" + execAndGet(CMD) + "\n";
         }
 
         if (m_bVerbose)
-            std::println("{}", verboseString("shell returned: {}", out));
+            progress.printMessageAbove(verboseString("shell returned: {}", out));
 
         if (!std::filesystem::exists(m_szWorkingPluginDirectory + "/" + p.output)) {
             progress.printMessageAbove(failureString("Plugin {} failed to build.\n"
@@ -391,6 +416,51 @@ bool CPluginManager::removePluginRepo(const std::string& urlOrName) {
 eHeadersErrors CPluginManager::headersValid() {
     const auto HLVER = getHyprlandVersion(false);
 
+    if (m_headersValid && m_headersValid->first == HLVER.hash)
+        return m_headersValid->second;
+
+    const auto STAMP = getCacheRoot().empty() || HLVER.hash.empty() ? std::string{} : getCacheRoot() + "headers-valid";
+
+    // a previous run already verified these headers if the stamp names our hash and is newer than the installed headers
+    if (!STAMP.empty()) {
+        std::error_code ec;
+        const auto      STAMPTIME = std::filesystem::last_write_time(STAMP, ec);
+        const auto      PCTIME    = ec ? STAMPTIME : std::filesystem::last_write_time(DataState::getHeadersPath() + "/share/pkgconfig/hyprland.pc", ec);
+
+        std::ifstream   ifs(STAMP);
+        std::string     stampHash;
+
+        if (!ec && STAMPTIME >= PCTIME && std::getline(ifs, stampHash) && stampHash == HLVER.hash) {
+            m_headersValid = {HLVER.hash, HEADERS_OK};
+            return HEADERS_OK;
+        }
+    }
+
+    const auto RESULT = verifyHeaders(HLVER.hash);
+    m_headersValid    = {HLVER.hash, RESULT};
+
+    if (RESULT == HEADERS_OK && !STAMP.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(getCacheRoot(), ec);
+
+        std::ofstream ofs(STAMP, std::ios::trunc);
+        ofs << HLVER.hash << "\n";
+    }
+
+    return RESULT;
+}
+
+void CPluginManager::invalidateHeadersCache() {
+    m_headersValid.reset();
+
+    if (getCacheRoot().empty())
+        return;
+
+    std::error_code ec;
+    std::filesystem::remove(getCacheRoot() + "headers-valid", ec);
+}
+
+eHeadersErrors CPluginManager::verifyHeaders(const std::string& expectedHash) {
     if (!std::filesystem::exists(DataState::getHeadersPath() + "/share/pkgconfig/hyprland.pc"))
         return HEADERS_MISSING;
 
@@ -441,7 +511,7 @@ eHeadersErrors CPluginManager::headersValid() {
     hash             = hash.substr(hash.find_first_of('"') + 1);
     hash             = hash.substr(0, hash.find_first_of('"'));
 
-    if (hash != HLVER.hash)
+    if (hash != expectedHash)
         return HEADERS_MISMATCHED;
 
     return HEADERS_OK;
@@ -588,6 +658,8 @@ bool CPluginManager::updateHeaders(bool force) {
     // remove build files
     std::filesystem::remove_all(WORKINGDIR);
 
+    invalidateHeadersCache();
+
     auto HEADERSVALID = headersValid();
     if (HEADERSVALID == HEADERS_OK) {
         progress.printMessageAbove(successString("installed headers"));
@@ -615,175 +687,273 @@ bool CPluginManager::updateHeaders(bool force) {
     return true;
 }
 
-bool CPluginManager::updatePlugins(bool forceUpdateAll) {
-    if (headersValid() != HEADERS_OK) {
-        std::println("{}", failureString("headers are not up-to-date, please run hyprpm update."));
-        return false;
+void CPluginManager::prepareBuildEnvironment(CProgressBar& progress) {
+    m_szBuildEnvironment = std::format("export PKG_CONFIG_PATH=\"{}/share/pkgconfig\"", DataState::getHeadersPath());
+
+    const auto CACHEROOT = getCacheRoot();
+    const auto CCACHE    = trim(execAndGet("command -v ccache"));
+
+    if (CACHEROOT.empty() || !CCACHE.starts_with("/")) {
+        if (m_bVerbose)
+            progress.printMessageAbove(verboseString("ccache not found, building without an object cache"));
+        return;
     }
 
-    const auto REPOS = DataState::getAllRepositories();
+    // ccache in masquerade mode: a dir of compiler names linking to ccache goes first in PATH,
+    // so it also catches build scripts that call g++ directly. Only for compilers that exist, or configure
+    // scripts would find ones that don't.
+    const auto      BINDIR    = CACHEROOT + "ccache-bin";
+    const auto      COMPILERS = execAndGet("command -v cc c++ gcc g++ clang clang++");
 
-    if (REPOS.size() < 1) {
-        std::println("{}", failureString("No repos to update."));
-        return true;
+    std::error_code ec;
+    std::filesystem::create_directories(BINDIR, ec);
+
+    for (const auto& path : std::views::split(COMPILERS, '\n')) {
+        const auto NAME = std::filesystem::path(std::string_view{path}).filename().string();
+        if (NAME.empty() || !std::string_view{path}.starts_with("/"))
+            continue;
+
+        const auto LINK = BINDIR + "/" + NAME;
+        if (std::filesystem::read_symlink(LINK, ec) == CCACHE)
+            continue;
+
+        std::filesystem::remove(LINK, ec);
+        std::filesystem::create_symlink(CCACHE, LINK, ec);
+        if (ec) {
+            progress.printMessageAbove(failureString("Couldn't set up ccache for {}, building without an object cache: {}", NAME, ec.message()));
+            return;
+        }
     }
 
-    const auto   HLVER = getHyprlandVersion(false);
+    // keep the user's cache if they have one. BASEDIR makes paths relative, so repos hit the cache no matter which working dir they get.
+    if (!getenv("CCACHE_DIR"))
+        m_szBuildEnvironment += std::format(" CCACHE_DIR=\"{}ccache\"", CACHEROOT);
 
-    CProgressBar progress;
-    progress.m_iMaxSteps        = REPOS.size() * 2 + 2;
-    progress.m_iSteps           = 0;
-    progress.m_szCurrentMessage = "Updating repositories";
-    progress.print();
+    m_szBuildEnvironment += std::format(" CCACHE_BASEDIR=\"{}\" CCACHE_NOHASHDIR=1 PATH=\"{}:$PATH\"", getTempRoot(), BINDIR);
 
-    const std::string USERNAME = getpwuid(getuid())->pw_name;
-    m_szWorkingPluginDirectory = getTempRoot() + USERNAME;
+    if (m_bVerbose)
+        progress.printMessageAbove(verboseString("building with ccache, environment: {}", m_szBuildEnvironment));
+}
 
-    for (auto const& repo : REPOS) {
-        bool update = forceUpdateAll;
+std::string CPluginManager::buildCommand(const std::string& dir, const std::string& step) {
+    // exported, build steps are often several commands chained together
+    return std::format("cd {} && {} && {}", dir, m_szBuildEnvironment, step);
+}
 
-        progress.m_iSteps++;
-        progress.m_szCurrentMessage = "Updating " + repo.name;
-        progress.print();
+SRepoUpdateResult CPluginManager::updateRepository(const SPluginRepository& repo, const std::string& dir, bool forceUpdate, const SHyprlandVersion& hlver,
+                                                   CProgressBar& progress) {
+    SRepoUpdateResult result;
+    bool              update = forceUpdate;
 
-        progress.printMessageAbove(infoString("checking for updates for {}", repo.name));
+    progress.step("Updating " + repo.name);
+    progress.printMessageAbove(infoString("checking for updates for {}", repo.name));
 
-        createSafeDirectory(m_szWorkingPluginDirectory);
+    if (!createSafeDirectory(dir)) {
+        progress.printMessageAbove(failureString("could not prepare working dir for {}", repo.name));
+        result.failed = true;
+        return result;
+    }
 
-        progress.printMessageAbove(infoString("Cloning {}", repo.url));
+    progress.printMessageAbove(infoString("Cloning {}", repo.url));
 
-        std::string ret = execAndGet(std::format("cd {} && git clone --recursive {} {}", getTempRoot(), repo.url, USERNAME));
+    // submodules of a local remote are pulled in by reset and pull as well, not just clone
+    const auto  GIT = gitCommand(repo.url);
 
-        if (!std::filesystem::exists(m_szWorkingPluginDirectory + "/.git")) {
-            std::println("{}", failureString("could not clone repo: shell returned: {}", ret));
-            return false;
-        }
+    std::string ret = execAndGet(std::format("{} clone --recursive {} {}", GIT, repo.url, dir));
 
-        if (!repo.rev.empty()) {
-            progress.printMessageAbove(infoString("Plugin has revision set, resetting: {}", repo.rev));
+    if (!std::filesystem::exists(dir + "/.git")) {
+        progress.printMessageAbove(failureString("could not clone {}: shell returned: {}", repo.name, ret));
+        result.failed = true;
+        return result;
+    }
 
-            std::string ret = execAndGet("git -C " + m_szWorkingPluginDirectory + " reset --hard --recurse-submodules " + repo.rev);
-            if (ret.compare(0, 6, "fatal:") == 0) {
-                std::println(stderr, "\n{}", failureString("could not check out revision {}: shell returned:\n{}", repo.rev, ret));
+    if (!repo.rev.empty()) {
+        progress.printMessageAbove(infoString("Plugin has revision set, resetting: {}", repo.rev));
 
-                return false;
-            }
+        std::string ret = execAndGet(GIT + " -C " + dir + " reset --hard --recurse-submodules " + repo.rev);
+        if (ret.compare(0, 6, "fatal:") == 0) {
+            progress.printMessageAbove(failureString("could not check out revision {} of {}: shell returned:\n{}", repo.rev, repo.name, ret));
+            result.failed = true;
+            return result;
         }
+    }
 
-        if (!update) {
-            // check if git has updates
-            std::string hash = execAndGet("cd " + m_szWorkingPluginDirectory + " && git rev-parse HEAD");
-            if (!hash.empty())
-                hash.pop_back();
+    if (!update) {
+        // check if git has updates
+        std::string hash = execAndGet("cd " + dir + " && git rev-parse HEAD");
+        if (!hash.empty())
+            hash.pop_back();
 
-            update = update || hash != repo.hash;
-        }
+        update = update || hash != repo.hash;
+    }
 
-        if (!update) {
-            std::filesystem::remove_all(m_szWorkingPluginDirectory);
-            progress.printMessageAbove(successString("repository {} is up-to-date.", repo.name));
-            progress.m_iSteps++;
-            progress.print();
-            continue;
-        }
+    if (!update) {
+        progress.printMessageAbove(successString("repository {} is up-to-date.", repo.name));
+        progress.step("Updated " + repo.name);
+        return result;
+    }
 
-        // we need to update
+    // we need to update
 
-        progress.printMessageAbove(successString("repository {} has updates.", repo.name));
-        progress.printMessageAbove(infoString("Building {}", repo.name));
-        progress.m_iSteps++;
-        progress.print();
+    progress.printMessageAbove(successString("repository {} has updates.", repo.name));
+    progress.step("Building " + repo.name);
+
+    std::unique_ptr<CManifest> pManifest;
 
-        std::unique_ptr<CManifest> pManifest;
+    if (std::filesystem::exists(dir + "/hyprpm.toml")) {
+        progress.printMessageAbove(successString("found hyprpm manifest in {}", repo.name));
+        pManifest = std::make_unique<CManifest>(MANIFEST_HYPRPM, dir + "/hyprpm.toml");
+    } else if (std::filesystem::exists(dir + "/hyprload.toml")) {
+        progress.printMessageAbove(successString("found hyprload manifest in {}", repo.name));
+        pManifest = std::make_unique<CManifest>(MANIFEST_HYPRLOAD, dir + "/hyprload.toml");
+    }
+
+    if (!pManifest) {
+        progress.printMessageAbove(failureString("The plugin repository {} does not have a valid manifest", repo.name));
+        return result;
+    }
 
-        if (std::filesystem::exists(m_szWorkingPluginDirectory + "/hyprpm.toml")) {
-            progress.printMessageAbove(successString("found hyprpm manifest"));
-            pManifest = std::make_unique<CManifest>(MANIFEST_HYPRPM, m_szWorkingPluginDirectory + "/hyprpm.toml");
-        } else if (std::filesystem::exists(m_szWorkingPluginDirectory + "/hyprload.toml")) {
-            progress.printMessageAbove(successString("found hyprload manifest"));
-            pManifest = std::make_unique<CManifest>(MANIFEST_HYPRLOAD, m_szWorkingPluginDirectory + "/hyprload.toml");
+    if (!pManifest->m_good) {
+        progress.printMessageAbove(failureString("The plugin repository {} has a bad manifest", repo.name));
+        return result;
+    }
+
+    if (repo.rev.empty() && !pManifest->m_repository.commitPins.empty()) {
+        // check commit pins unless a revision is specified
+
+        progress.printMessageAbove(infoString("Manifest of {} has {} pins, checking", repo.name, pManifest->m_repository.commitPins.size()));
+
+        for (auto const& [hl, plugin] : pManifest->m_repository.commitPins) {
+            if (hl != hlver.hash)
+                continue;
+
+            progress.printMessageAbove(successString("commit pin {} matched hl, resetting", plugin));
+
+            execAndGet("cd " + dir + " && " + GIT + " reset --hard --recurse-submodules " + plugin);
         }
+    }
+
+    for (auto& p : pManifest->m_plugins) {
+        std::string out;
 
-        if (!pManifest) {
-            std::println(stderr, "\n{}", failureString("The provided plugin repository does not have a valid manifest"));
+        if (p.since > hlver.commits && hlver.commits >= 1000 /* for shallow clones, we can't check this. 1000 is an arbitrary number I chose. */) {
+            progress.printMessageAbove(failureString("Not building {}: your Hyprland version is too old.\n", p.name));
+            p.failed = true;
             continue;
         }
 
-        if (!pManifest->m_good) {
-            std::println(stderr, "\n{}", failureString("The provided plugin repository has a bad manifest"));
+        progress.printMessageAbove(infoString("Building {}", p.name));
+
+        for (auto const& bs : p.buildSteps) {
+            const auto CMD = buildCommand(dir, bs);
+            out += " -> " + CMD + "\n" + execAndGet(CMD) + "\n";
+        }
+
+        if (m_bVerbose)
+            progress.printMessageAbove(verboseString("shell returned: {}", out));
+
+        if (!std::filesystem::exists(dir + "/" + p.output)) {
+            progress.printMessageAbove(failureString("Plugin {} failed to build.\n"
+                                                     "  This likely means that the plugin is either outdated, not yet available for your version, or broken.\n"
+                                                     "  If you are on -git, update first.\n"
+                                                     "  Try re-running with -v to see more verbose output.",
+                                                     p.name));
+            p.failed = true;
             continue;
         }
 
-        if (repo.rev.empty() && !pManifest->m_repository.commitPins.empty()) {
-            // check commit pins unless a revision is specified
+        progress.printMessageAbove(successString("built {} into {}", p.name, p.output));
+    }
 
-            progress.printMessageAbove(infoString("Manifest has {} pins, checking", pManifest->m_repository.commitPins.size()));
+    // the new repo state, installed by the caller
+    SPluginRepository newrepo = repo;
+    newrepo.plugins.clear();
+    execAndGet(std::format("cd {0} && {1} pull --recurse-submodules && {1} reset --hard --recurse-submodules", dir, GIT)); // repo hash in the state.toml has to match head and not any pin
+    std::string repohash = execAndGet("cd " + dir + " && git rev-parse HEAD");
+    if (repohash.length() > 0)
+        repohash.pop_back();
+    newrepo.hash = repohash;
+    for (auto const& p : pManifest->m_plugins) {
+        const auto OLDPLUGINIT = std::find_if(repo.plugins.begin(), repo.plugins.end(), [&](const auto& other) { return other.name == p.name; });
+        newrepo.plugins.push_back(SPlugin{p.name, dir + "/" + p.output, OLDPLUGINIT != repo.plugins.end() ? OLDPLUGINIT->enabled : false});
+    }
 
-            for (auto const& [hl, plugin] : pManifest->m_repository.commitPins) {
-                if (hl != HLVER.hash)
-                    continue;
+    result.updated = std::move(newrepo);
 
-                progress.printMessageAbove(successString("commit pin {} matched hl, resetting", plugin));
+    return result;
+}
 
-                execAndGet("cd " + m_szWorkingPluginDirectory + " && git reset --hard --recurse-submodules " + plugin);
-            }
-        }
+bool CPluginManager::updatePlugins(bool forceUpdateAll) {
+    if (headersValid() != HEADERS_OK) {
+        std::println("{}", failureString("headers are not up-to-date, please run hyprpm update."));
+        return false;
+    }
 
-        for (auto& p : pManifest->m_plugins) {
-            std::string out;
+    const auto REPOS = DataState::getAllRepositories();
 
-            if (p.since > HLVER.commits && HLVER.commits >= 1000 /* for shallow clones, we can't check this. 1000 is an arbitrary number I chose. */) {
-                progress.printMessageAbove(failureString("Not building {}: your Hyprland version is too old.\n", p.name));
-                p.failed = true;
-                continue;
-            }
+    if (REPOS.size() < 1) {
+        std::println("{}", failureString("No repos to update."));
+        return true;
+    }
 
-            progress.printMessageAbove(infoString("Building {}", p.name));
+    const auto HLVER = getHyprlandVersion(false);
+    const auto JOBS  = std::clamp<size_t>(m_iJobs > 0 ? m_iJobs : std::thread::hardware_concurrency(), 1, REPOS.size());
 
-            for (auto const& bs : p.buildSteps) {
-                const std::string& cmd = std::format("cd {} && PKG_CONFIG_PATH=\"{}/share/pkgconfig\" {}", m_szWorkingPluginDirectory, DataState::getHeadersPath(), bs);
-                out += " -> " + cmd + "\n" + execAndGet(cmd) + "\n";
-            }
+    CProgressBar progress;
+    progress.m_iMaxSteps        = REPOS.size() * 2 + 2;
+    progress.m_iSteps           = 0;
+    progress.m_szCurrentMessage = "Updating repositories";
+    progress.print();
 
-            if (m_bVerbose)
-                std::println("{}", verboseString("shell returned: {}", out));
-
-            if (!std::filesystem::exists(m_szWorkingPluginDirectory + "/" + p.output)) {
-                std::println(stderr,
-                             "\n{}\n"
-                             "  This likely means that the plugin is either outdated, not yet available for your version, or broken.\n"
-                             "If you are on -git, update first.\n"
-                             "Try re-running with -v to see more verbose output.",
-                             failureString("Plugin {} failed to build.", p.name));
-                p.failed = true;
-                continue;
-            }
+    prepareBuildEnvironment(progress);
+
+    progress.printMessageAbove(infoString("Updating {} repositories, {} at a time", REPOS.size(), JOBS));
 
-            progress.printMessageAbove(successString("built {} into {}", p.name, p.output));
+    // repos don't depend on each other, so each gets its own working dir and they're cloned and built in parallel.
+    // Only installing touches the state store, that's done here afterwards.
+    std::vector<std::string>       dirs;
+    std::vector<SRepoUpdateResult> results(REPOS.size());
+    std::atomic<size_t>            next = 0;
+
+    for (size_t i = 0; i < REPOS.size(); ++i) {
+        dirs.emplace_back(std::format("{}{}-{}", getTempRoot(), m_szUsername, i));
+    }
+
+    {
+        std::vector<std::jthread> workers;
+        for (size_t i = 0; i < JOBS; ++i) {
+            workers.emplace_back([&] {
+                for (size_t idx = next++; idx < REPOS.size(); idx = next++) {
+                    results[idx] = updateRepository(REPOS[idx], dirs[idx], forceUpdateAll, HLVER, progress);
+                }
+            });
         }
+    }
 
-        // add repo toml to DataState
-        SPluginRepository newrepo = repo;
-        newrepo.plugins.clear();
-        execAndGet("cd " + m_szWorkingPluginDirectory +
-                   " && git pull --recurse-submodules && git reset --hard --recurse-submodules"); // repo hash in the state.toml has to match head and not any pin
-        std::string repohash = execAndGet("cd " + m_szWorkingPluginDirectory + " && git rev-parse HEAD");
-        if (repohash.length() > 0)
-            repohash.pop_back();
-        newrepo.hash = repohash;
-        for (auto const& p : pManifest->m_plugins) {
-            const auto OLDPLUGINIT = std::find_if(repo.plugins.begin(), repo.plugins.end(), [&](const auto& other) { return other.name == p.name; });
-            newrepo.plugins.push_back(SPlugin{p.name, m_szWorkingPluginDirectory + "/" + p.output, OLDPLUGINIT != repo.plugins.end() ? OLDPLUGINIT->enabled : false});
+    bool failed = false;
+
+    for (size_t i = 0; i < REPOS.size(); ++i) {
+        failed = failed || results[i].failed;
+
+        if (results[i].updated) {
+            DataState::removePluginRepo(results[i].updated->name);
+            DataState::addNewPluginRepo(*results[i].updated);
+
+            progress.printMessageAbove(successString("updated {}", REPOS[i].name));
         }
-        DataState::removePluginRepo(newrepo.name);
-        DataState::addNewPluginRepo(newrepo);
 
-        std::filesystem::remove_all(m_szWorkingPluginDirectory);
+        std::error_code ec;
+        std::filesystem::remove_all(dirs[i], ec);
+    }
 
-        progress.printMessageAbove(successString("updated {}", repo.name));
+    if (failed) {
+        progress.m_szCurrentMessage = "Failed";
+        progress.print();
+        std::print("\n");
+        return false;
     }
 
-    progress.m_iSteps++;
+    progress.m_iSteps           = progress.m_iMaxSteps - 1;
     progress.m_szCurrentMessage = "Updating global state...";
     progress.print();
 
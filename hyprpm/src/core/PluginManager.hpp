@@ -2,8 +2,12 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include "Plugin.hpp"
+
+class CProgressBar;
 
 enum eHeadersErrors {
     HEADERS_OK = 0,
@@ -39,6 +43,11 @@ struct SHyprlandVersion {
     int         commits = 0;
 };
 
+struct SRepoUpdateResult {
+    bool                             failed = false; // couldn't even check the repo, the update as a whole fails
+    std::optional<SPluginRepository> updated;        // set if it was rebuilt, plugin filenames point into the working dir
+};
+
 class CPluginManager {
   public:
     CPluginManager();
@@ -65,16 +74,26 @@ class CPluginManager {
 
     bool                   m_bVerbose   = false;
     bool                   m_bNoShallow = false;
+    size_t                 m_iJobs      = 0; // repositories updated at once, 0 for one per core
     std::string            m_szCustomHlUrl, m_szUsername;
 
     // will delete recursively if exists!!
     bool createSafeDirectory(const std::string& path);
 
   private:
-    std::string headerError(const eHeadersErrors err);
-    std::string headerErrorShort(const eHeadersErrors err);
-
-    std::string m_szWorkingPluginDirectory;
+    std::string       headerError(const eHeadersErrors err);
+    std::string       headerErrorShort(const eHeadersErrors err);
+    eHeadersErrors    verifyHeaders(const std::string& expectedHash);
+    void              invalidateHeadersCache();
+    void              prepareBuildEnvironment(CProgressBar& progress);
+    std::string       buildCommand(const std::string& dir, const std::string& step);
+    SRepoUpdateResult updateRepository(const SPluginRepository& repo, const std::string& dir, bool forceUpdate, const SHyprlandVersion& hlver, CProgressBar& progress);
+
+    std::string       m_szWorkingPluginDirectory;
+    std::string       m_szBuildEnvironment;
+
+    // Hyprland hash → result, verifying means shelling out to pkgconf
+    std::optional<std::pair<std::string, eHeadersErrors>> m_headersValid;
 };
 
 inline std::unique_ptr<CPluginManager> g_pPluginManager;
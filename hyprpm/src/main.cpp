@@ -32,6 +32,7 @@ constexpr std::string_view HELP = R"#(┏ hyprpm, a Hyprland Plugin Manager
 ┣ --force        | -f    → Force an operation ignoring checks (e.g. update -f).
 ┣ --no-shallow   | -s    → Disable shallow cloning of Hyprland sources.
 ┣ --hl-url       |       → Pass a custom hyprland source url.
+┣ --jobs [n]     | -j    → Update at most n plugin repositories at once. Defaults to the core count.
 ┗
 )#";
 
@@ -49,6 +50,7 @@ int                        main(int argc, char** argv, char** envp) {
     std::vector<std::string> command;
     bool                     notify = false, verbose = false, force = false, noShallow = false;
     std::string              customHlUrl;
+    size_t                   jobs = 0;
 
     for (int i = 1; i < argc; ++i) {
         if (ARGS[i].starts_with("-")) {
@@ -72,6 +74,18 @@ int                        main(int argc, char** argv, char** envp) {
                 }
                 customHlUrl = ARGS[i + 1];
                 i++;
+            } else if (ARGS[i] == "--jobs" || ARGS[i] == "-j") {
+                if (i + 1 >= argc) {
+                    std::println(stderr, "Missing argument for --jobs");
+                    return 1;
+                }
+                try {
+                    jobs = std::stoul(ARGS[i + 1]);
+                } catch (...) {
+                    std::println(stderr, "Invalid argument for --jobs: {}", ARGS[i + 1]);
+                    return 1;
+                }
+                i++;
             } else if (ARGS[i] == "--force" || ARGS[i] == "-f") {
                 force = true;
                 std::println("{}", statusString("!", Colors::RED, "Using --force, I hope you know what you are doing."));
@@ -92,6 +106,7 @@ int                        main(int argc, char** argv, char** envp) {
     g_pPluginManager->m_bVerbose      = verbose;
     g_pPluginManager->m_bNoShallow    = noShallow;
     g_pPluginManager->m_szCustomHlUrl = customHlUrl;
+    g_pPluginManager->m_iJobs         = jobs;
 
     if (command[0] == "add") {
         if (command.size() < 2) {
@@ -25,13 +25,30 @@ static void clearCurrentLine() {
 }
 
 void CProgressBar::printMessageAbove(const std::string& msg) {
+    std::lock_guard lk(m_mutex);
+
     clearCurrentLine();
     std::print("\r{}\n", msg);
 
-    print(); // reprint bar underneath
+    printLocked(); // reprint bar underneath
+}
+
+void CProgressBar::step(const std::string& msg) {
+    std::lock_guard lk(m_mutex);
+
+    m_iSteps++;
+    m_szCurrentMessage = msg;
+
+    printLocked();
 }
 
 void CProgressBar::print() {
+    std::lock_guard lk(m_mutex);
+
+    printLocked();
+}
+
+void CProgressBar::printLocked() {
     const auto w = getTerminalSize();
 
     if (m_bFirstPrint) {
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <mutex>
 #include <string>
 
 class CProgressBar {
   public:
+    // all of these are safe to call from worker threads
     void        print();
     void        printMessageAbove(const std::string& msg);
+    void        step(const std::string& msg);
 
     std::string m_szCurrentMessage = "";
     size_t      m_iSteps           = 0;
@@ -13,5 +16,8 @@ class CProgressBar {
     float       m_fPercentage      = -1; // if != -1, use percentage
 
   private:
-    bool m_bFirstPrint = true;
+    void       printLocked();
+
+    bool       m_bFirstPrint = true;
+    std::mutex m_mutex;
 };
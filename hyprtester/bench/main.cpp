@@ -0,0 +1,551 @@
+// hyprbench: launches Hyprland headless, drives it with a bunch of synthetic clients for a fixed
+// duration and reports frame times, cpu time, commit -> present latency and memory as JSON, so
+// numbers can be compared between versions.
+
+// Frame times come from the built-in frame timeline (hyprctl trace), latencies from the clients'
+// wp_presentation feedback.
+
+// NOTE: Like hyprtester, this has to be ran from the hyprtester directory (or get --binary / --config).
+
+#include "../src/shared.hpp"
+#include "../src/hyprctlCompat.hpp"
+#include "../src/tests/clients/build.hpp"
+
+#include <hyprutils/os/Process.hpp>
+#include <hyprutils/memory/SharedPtr.hpp>
+#include <hyprutils/memory/Casts.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <print>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "../src/Log.hpp"
+
+using namespace Hyprutils::OS;
+using namespace Hyprutils::Memory;
+
+#define SP CSharedPointer
+
+struct SBenchOptions {
+    std::string binary;
+    std::string config;
+    std::string output; // empty = stdout
+    std::string buffer      = "shm";
+    int         clients     = 8;
+    int         duration    = 10; // s
+    int         warmup      = 2;  // s
+    int         rate        = 60;
+    int         damage      = 64;
+    int         titleChurn  = 0;
+    int         subsurfaces = 0;
+    int         groupSize   = 0;
+    int         resizeDrag  = 0;
+
+    std::vector<std::string> keywords; // "key value", applied with hyprctl keyword before the clients start
+};
+
+struct SCpuTimes {
+    double user   = 0; // s
+    double system = 0;
+};
+
+struct SClientTotals {
+    uint64_t              commits   = 0;
+    uint64_t              skipped   = 0;
+    uint64_t              presented = 0;
+    uint64_t              discarded = 0;
+    uint64_t              titles    = 0;
+    std::vector<uint64_t> latencies; // ns
+};
+
+static SBenchOptions     options;
+static SP<CProcess>      hyprlandProc;
+static const std::string cwd = std::filesystem::current_path().string();
+
+static void              help() {
+    NLog::log("usage: hyprbench [arg [...]].\n");
+    NLog::log(R"(Arguments:
+    --help                -h       - Show this message again
+    --binary FILE         -b FILE  - Hyprland binary to benchmark, ../build/Hyprland by default
+    --config FILE         -c FILE  - Config file to use, test.conf by default
+    --output FILE         -o FILE  - Write the JSON report to FILE instead of stdout
+    --clients N                    - Amount of synthetic clients (8)
+    --duration S                   - Seconds to measure for (10)
+    --warmup S                     - Seconds to let things settle before measuring (2)
+    --buffer shm|single-pixel      - Buffer type the clients use (shm)
+    --rate N                       - Commits per second per client, 0 follows frame callbacks (60)
+    --damage PX                    - Side of the square each commit damages (64)
+    --title-churn N                - Title changes per second per client (0)
+    --subsurfaces N                - Depth of each client's subsurface chain (0)
+    --group-size N                 - Put the clients' windows into groups of N, 0 leaves them ungrouped (0)
+    --resize-drag N                - Resize the active window back and forth N times per second while measuring,
+                                     e.g. --clients 200 --group-size 200 --resize-drag 60 (0)
+    --keyword "KEY VALUE"          - Set a config value before the clients start, can be repeated. E.g. to compare
+                                     the CM shader variants against the generic shader, run once with
+                                     --keyword "monitor ,preferred,auto,1,cm,wide" and once more adding
+                                     --keyword "render:cm_shader_variants 0")");
+}
+
+static bool parseArgs(int argc, char** argv) {
+    std::span<char*> args{argv + 1, sc<std::size_t>(argc - 1)};
+
+    for (auto it = args.begin(); it != args.end(); it++) {
+        std::string_view value = *it;
+
+        if (value == "--help" || value == "-h") {
+            help();
+            exit(0);
+        }
+
+        if (std::next(it) == args.end()) {
+            std::println(stderr, "[ ERROR ] {} needs a value", value);
+            return false;
+        }
+
+        const std::string NEXT = *++it;
+
+        try {
+            if (value == "--binary" || value == "-b")
+                options.binary = std::filesystem::canonical(NEXT);
+            else if (value == "--config" || value == "-c")
+                options.config = std::filesystem::canonical(NEXT);
+            else if (value == "--output" || value == "-o")
+                options.output = NEXT;
+            else if (value == "--clients")
+                options.clients = std::stoi(NEXT);
+            else if (value == "--duration")
+                options.duration = std::stoi(NEXT);
+            else if (value == "--warmup")
+                options.warmup = std::stoi(NEXT);
+            else if (value == "--buffer")
+                options.buffer = NEXT;
+            else if (value == "--rate")
+                options.rate = std::stoi(NEXT);
+            else if (value == "--damage")
+                options.damage = std::stoi(NEXT);
+            else if (value == "--title-churn")
+                options.titleChurn = std::stoi(NEXT);
+            else if (value == "--subsurfaces")
+                options.subsurfaces = std::stoi(NEXT);
+            else if (value == "--group-size")
+                options.groupSize = std::stoi(NEXT);
+            else if (value == "--resize-drag")
+                options.resizeDrag = std::stoi(NEXT);
+            else if (value == "--keyword")
+                options.keywords.emplace_back(NEXT);
+            else {
+                std::println(stderr, "[ ERROR ] Unknown option '{}' !", value);
+                return false;
+            }
+        } catch (...) {
+            std::println(stderr, "[ ERROR ] Invalid value '{}' for {}", NEXT, value);
+            return false;
+        }
+    }
+
+    if (options.buffer != "shm" && options.buffer != "single-pixel") {
+        std::println(stderr, "[ ERROR ] --buffer has to be shm or single-pixel");
+        return false;
+    }
+
+    if (options.clients < 0 || options.duration <= 0 || options.warmup < 0) {
+        std::println(stderr, "[ ERROR ] --clients, --duration and --warmup can't be negative");
+        return false;
+    }
+
+    if (options.groupSize < 0 || options.resizeDrag < 0) {
+        std::println(stderr, "[ ERROR ] --group-size and --resize-drag can't be negative");
+        return false;
+    }
+
+    if (options.binary.empty())
+        options.binary = cwd + "/../build/Hyprland";
+    if (options.config.empty())
+        options.config = cwd + "/test.conf";
+
+    return true;
+}
+
+// NLog goes to stdout, keep it clean when that's where the report goes
+template <typename... Args>
+static void progress(std::format_string<Args...> fmt, Args&&... args) {
+    std::println(stderr, fmt, std::forward<Args>(args)...);
+}
+
+static bool launchHyprland() {
+    std::error_code ec;
+    if (!std::filesystem::exists(options.binary, ec) || ec) {
+        progress("No Hyprland binary at {}", options.binary);
+        return false;
+    }
+
+    hyprlandProc = makeShared<CProcess>(options.binary, std::vector<std::string>{"--config", options.config});
+    hyprlandProc->addEnv("HYPRLAND_HEADLESS_ONLY", "1");
+
+    if (!hyprlandProc->runAsync())
+        return false;
+
+    // wait for the instance to show up instead of a fixed sleep
+    for (int i = 0; i < 100; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        for (const auto& instance : instances()) {
+            if (instance.pid != sc<uint64_t>(hyprlandProc->pid()))
+                continue;
+
+            HIS       = instance.id;
+            WLDISPLAY = instance.wlSocket;
+            return true;
+        }
+    }
+
+    progress("Hyprland didn't come up");
+    return false;
+}
+
+static SCpuTimes cpuTimes(pid_t pid) {
+    std::ifstream stat(std::format("/proc/{}/stat", pid));
+    std::string   line;
+    std::getline(stat, line);
+
+    // comm can contain spaces, fields are counted from after its closing paren
+    const auto POS = line.rfind(')');
+    if (POS == std::string::npos)
+        return {};
+
+    std::istringstream       fields(line.substr(POS + 2));
+    std::vector<std::string> parts;
+    for (std::string f; fields >> f;) {
+        parts.emplace_back(f);
+    }
+
+    // utime and stime are fields 14 and 15, the first one after comm is field 3
+    if (parts.size() < 13)
+        return {};
+
+    const double TICKS = sysconf(_SC_CLK_TCK);
+    return {.user = std::stoull(parts[11]) / TICKS, .system = std::stoull(parts[12]) / TICKS};
+}
+
+// in kB
+static uint64_t statusValue(pid_t pid, const std::string& field) {
+    std::ifstream status(std::format("/proc/{}/status", pid));
+    for (std::string line; std::getline(status, line);) {
+        if (!line.starts_with(field + ":"))
+            continue;
+
+        try {
+            return std::stoull(line.substr(field.length() + 1));
+        } catch (...) { return 0; }
+    }
+
+    return 0;
+}
+
+static void resetPeakRSS(pid_t pid) {
+    std::ofstream clearRefs(std::format("/proc/{}/clear_refs", pid));
+    clearRefs << "5";
+}
+
+static std::string clientStatsPath(int i) {
+    return std::format("/tmp/hyprbench-{}-client-{}.txt", getpid(), i);
+}
+
+static int windowCount() {
+    const auto CLIENTS = getFromSocket("/clients");
+    int        count   = 0;
+    for (auto pos = CLIENTS.find("focusHistoryID: "); pos != std::string::npos; pos = CLIENTS.find("focusHistoryID: ", pos + 1)) {
+        count++;
+    }
+
+    return count;
+}
+
+static bool waitForWindows(int n) {
+    for (int tries = 0; tries < 50; ++tries) {
+        if (windowCount() >= n)
+            return true;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    return false;
+}
+
+static std::vector<SP<CProcess>> spawnClients() {
+    std::vector<SP<CProcess>> clients;
+
+    for (int i = 0; i < options.clients; ++i) {
+        std::filesystem::remove(clientStatsPath(i));
+
+        auto proc = makeShared<CProcess>(binaryDir + "/bench-client",
+                                         std::vector<std::string>{"--id", std::to_string(i), "--out", clientStatsPath(i), "--buffer", options.buffer, "--rate",
+                                                                  std::to_string(options.rate), "--damage", std::to_string(options.damage), "--title-churn",
+                                                                  std::to_string(options.titleChurn), "--subsurfaces", std::to_string(options.subsurfaces)});
+        proc->addEnv("WAYLAND_DISPLAY", WLDISPLAY);
+        proc->runAsync();
+        clients.emplace_back(proc);
+
+        if (!options.groupSize)
+            continue;
+
+        // new windows join the focused group while it's unlocked, so the first one of each group starts it and the last one locks it
+        if (!waitForWindows(i + 1))
+            progress("client {} didn't map, groups will be off", i);
+
+        if (i % options.groupSize == 0)
+            getFromSocket("/dispatch togglegroup");
+        if ((i + 1) % options.groupSize == 0)
+            getFromSocket("/dispatch lockactivegroup lock");
+    }
+
+    return clients;
+}
+
+static SClientTotals stopClients(const std::vector<SP<CProcess>>& clients) {
+    SClientTotals totals;
+
+    for (const auto& c : clients) {
+        kill(c->pid(), SIGTERM);
+    }
+
+    for (int i = 0; i < sc<int>(clients.size()); ++i) {
+        // the stats are complete once "end" is in
+        std::vector<std::string> lines;
+        for (int tries = 0; tries < 50; ++tries) {
+            lines.clear();
+            std::ifstream file(clientStatsPath(i));
+            for (std::string line; std::getline(file, line);) {
+                lines.emplace_back(line);
+            }
+
+            if (!lines.empty() && lines.back() == "end")
+                break;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        if (lines.empty() || lines.back() != "end") {
+            progress("client {} didn't report its stats", i);
+            continue;
+        }
+
+        for (const auto& line : lines) {
+            const auto SPACE = line.find(' ');
+            if (SPACE == std::string::npos)
+                continue;
+
+            const auto KEY   = line.substr(0, SPACE);
+            const auto VALUE = std::stoull(line.substr(SPACE + 1));
+
+            if (KEY == "latency")
+                totals.latencies.push_back(VALUE);
+            else if (KEY == "commits")
+                totals.commits += VALUE;
+            else if (KEY == "skipped")
+                totals.skipped += VALUE;
+            else if (KEY == "presented")
+                totals.presented += VALUE;
+            else if (KEY == "discarded")
+                totals.discarded += VALUE;
+            else if (KEY == "titles")
+                totals.titles += VALUE;
+        }
+
+        std::filesystem::remove(clientStatsPath(i));
+    }
+
+    return totals;
+}
+
+// durations of every complete span with this name in the dump, in µs
+static std::vector<double> spanDurations(const std::string& trace, const std::string& name) {
+    std::vector<double> result;
+    const auto          NEEDLE = std::format("\"name\":\"{}\",\"ph\":\"X\"", name);
+
+    for (size_t pos = trace.find(NEEDLE); pos != std::string::npos; pos = trace.find(NEEDLE, pos + 1)) {
+        const auto DUR = trace.find("\"dur\":", pos);
+        if (DUR == std::string::npos)
+            break;
+
+        result.push_back(std::stod(trace.substr(DUR + 6, 32)));
+    }
+
+    return result;
+}
+
+// spans the compositor's ring overwrote before the dump, the stats above only cover what's left
+static uint64_t droppedSpans(const std::string& trace) {
+    const auto POS = trace.find("\"droppedSpans\":");
+    if (POS == std::string::npos)
+        return 0;
+
+    return std::stoull(trace.substr(POS + 15, 32));
+}
+
+// time between consecutive instants with this name, in µs
+static std::vector<double> instantIntervals(const std::string& trace, const std::string& name) {
+    std::vector<double> stamps;
+    const auto          NEEDLE = std::format("\"name\":\"{}\",\"ph\":\"i\"", name);
+
+    for (size_t pos = trace.find(NEEDLE); pos != std::string::npos; pos = trace.find(NEEDLE, pos + 1)) {
+        const auto TS = trace.find("\"ts\":", pos);
+        if (TS == std::string::npos)
+            break;
+
+        stamps.push_back(std::stod(trace.substr(TS + 5, 32)));
+    }
+
+    std::ranges::sort(stamps);
+
+    std::vector<double> result;
+    for (size_t i = 1; i < stamps.size(); ++i) {
+        result.push_back(stamps[i] - stamps[i - 1]);
+    }
+
+    return result;
+}
+
+template <typename T>
+static std::string percentiles(std::vector<T> values, double divisor) {
+    if (values.empty())
+        return "null";
+
+    std::ranges::sort(values);
+    auto at = [&values, divisor](double p) { return values[std::min(values.size() - 1, sc<size_t>(p * (values.size() - 1) + 0.5))] / divisor; };
+
+    return std::format(R"({{"count": {}, "p50": {:.3f}, "p90": {:.3f}, "p99": {:.3f}, "max": {:.3f}}})", values.size(), at(0.5), at(0.9), at(0.99), values.back() / divisor);
+}
+
+int main(int argc, char** argv) {
+    if (!parseArgs(argc, argv)) {
+        help();
+        return 1;
+    }
+
+    progress("launching Hyprland");
+    if (!launchHyprland()) {
+        if (hyprlandProc)
+            kill(hyprlandProc->pid(), SIGKILL);
+        return 1;
+    }
+
+    const pid_t PID = hyprlandProc->pid();
+
+    getFromSocket("/output create headless");
+    const auto VERSION = getFromSocket("j/version");
+
+    std::string keywordsJson;
+    for (const auto& kw : options.keywords) {
+        const auto RESULT = getFromSocket("/keyword " + kw);
+        if (RESULT != "ok")
+            progress("keyword {} failed: {}", kw, RESULT);
+
+        std::string escaped;
+        for (const char c : kw) {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+
+        keywordsJson += std::format("{}\"{}\"", keywordsJson.empty() ? "" : ", ", escaped);
+    }
+
+    progress("spawning {} clients", options.clients);
+    const auto CLIENTS = spawnClients();
+
+    std::this_thread::sleep_for(std::chrono::seconds(options.warmup));
+
+    progress("measuring for {}s", options.duration);
+
+    const auto TRACE_FILE = std::format("/tmp/hyprbench-{}-trace.json", getpid());
+    resetPeakRSS(PID);
+    const auto CPU_BEFORE = cpuTimes(PID);
+    const auto START      = std::chrono::steady_clock::now();
+    getFromSocket("/trace start");
+
+    if (options.resizeDrag > 0) {
+        const auto END      = START + std::chrono::seconds(options.duration);
+        const auto INTERVAL = std::chrono::nanoseconds(1000000000 / options.resizeDrag);
+        auto       next     = START;
+        for (int i = 0; std::chrono::steady_clock::now() < END; ++i) {
+            getFromSocket(std::format("/dispatch resizeactive {} 0", i % 2 ? -20 : 20));
+            next += INTERVAL;
+            std::this_thread::sleep_until(std::min(next, END));
+        }
+    } else
+        std::this_thread::sleep_for(std::chrono::seconds(options.duration));
+
+    getFromSocket("/trace stop");
+    const auto WALL      = std::chrono::duration<double>(std::chrono::steady_clock::now() - START).count();
+    const auto CPU_AFTER = cpuTimes(PID);
+    const auto RSS       = statusValue(PID, "VmRSS");
+    const auto PEAK_RSS  = statusValue(PID, "VmHWM");
+
+    getFromSocket(std::format("/trace dump {}", TRACE_FILE));
+
+    std::string trace;
+    {
+        std::ifstream     file(TRACE_FILE);
+        std::stringstream ss;
+        ss << file.rdbuf();
+        trace = ss.str();
+    }
+    std::filesystem::remove(TRACE_FILE);
+
+    progress("stopping clients");
+    const auto TOTALS = stopClients(CLIENTS);
+
+    getFromSocket("/dispatch exit");
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    kill(PID, SIGKILL);
+
+    const auto FRAMES  = spanDurations(trace, "renderMonitor");
+    const auto DROPPED = droppedSpans(trace);
+    const auto USER    = CPU_AFTER.user - CPU_BEFORE.user;
+    const auto SYSTEM  = CPU_AFTER.system - CPU_BEFORE.system;
+
+    if (DROPPED > 0)
+        progress("[ WARN ] the trace ring wrapped, {} spans were lost. Frame stats only cover the end of the run, use a shorter --duration", DROPPED);
+
+    const auto REPORT = std::format(R"({{
+"hyprland": {},
+"options": {{"clients": {}, "duration": {}, "warmup": {}, "buffer": "{}", "rate": {}, "damage": {}, "title_churn": {}, "subsurfaces": {},
+            "group_size": {}, "resize_drag": {}, "keywords": [{}]}},
+"wall_s": {:.3f},
+"frames": {},
+"dropped_spans": {},
+"frame_time_ms": {},
+"present_interval_ms": {},
+"commit_to_present_ms": {},
+"cpu_s": {{"user": {:.3f}, "system": {:.3f}, "utilization": {:.3f}}},
+"rss_kb": {{"end": {}, "peak": {}}},
+"clients": {{"commits": {}, "skipped": {}, "presented": {}, "discarded": {}, "titles": {}}}
+}}
+)",
+                                    VERSION.empty() ? "null" : VERSION, options.clients, options.duration, options.warmup, options.buffer, options.rate, options.damage,
+                                    options.titleChurn, options.subsurfaces, options.groupSize, options.resizeDrag, keywordsJson, WALL, FRAMES.size(), DROPPED,
+                                    percentiles(FRAMES, 1000.0), percentiles(instantIntervals(trace, "present"), 1000.0), percentiles(TOTALS.latencies, 1000000.0), USER,
+                                    SYSTEM, WALL > 0 ? (USER + SYSTEM) / WALL : 0.0, RSS, PEAK_RSS, TOTALS.commits, TOTALS.skipped, TOTALS.presented, TOTALS.discarded,
+                                    TOTALS.titles);
+
+    if (options.output.empty())
+        std::print("{}", REPORT);
+    else {
+        std::ofstream ofs(options.output, std::ios::trunc);
+        ofs << REPORT;
+        progress("report written to {}", options.output);
+    }
+
+    return 0;
+}
@@ -0,0 +1,484 @@
+// synthetic xdg_toplevel client for hyprbench.
+// Commits at a fixed rate (or as fast as frame callbacks allow), optionally churns its title and
+// stacks subsurfaces, and records commit -> present latency through wp_presentation.
+// On SIGTERM it writes its stats to the --out file and exits.
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <csignal>
+#include <ctime>
+#include <sys/poll.h>
+#include <sys/mman.h>
+#include <sys/timerfd.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <print>
+#include <format>
+#include <string>
+#include <fstream>
+#include <vector>
+#include <deque>
+
+#include <wayland-client.h>
+#include <wayland.hpp>
+#include <xdg-shell.hpp>
+#include <presentation-time.hpp>
+#include <single-pixel-buffer-v1.hpp>
+#include <viewporter.hpp>
+
+#include <hyprutils/memory/SharedPtr.hpp>
+#include <hyprutils/memory/Casts.hpp>
+#include <hyprutils/math/Vector2D.hpp>
+#include <hyprutils/os/FileDescriptor.hpp>
+
+using Hyprutils::Math::Vector2D;
+using Hyprutils::OS::CFileDescriptor;
+using namespace Hyprutils::Memory;
+
+enum eBufferType : uint8_t {
+    BUFFER_SHM = 0,
+    BUFFER_SINGLE_PIXEL,
+};
+
+struct SOptions {
+    eBufferType buffer      = BUFFER_SHM;
+    int         rate        = 60; // commits per second, 0 = whenever a frame callback comes in
+    int         damage      = 64; // side of the square damaged every commit, px
+    int         titleChurn  = 0;  // title changes per second
+    int         subsurfaces = 0;  // depth of the subsurface chain
+    Vector2D    size        = {640, 480};
+    std::string id          = "0";
+    std::string out;
+};
+
+struct SBuffer {
+    CSharedPointer<CCWlBuffer> buffer;
+    uint32_t*                  pixels = nullptr;
+    bool                       busy   = false;
+};
+
+struct SSurface {
+    CSharedPointer<CCWlSurface>    surf;
+    CSharedPointer<CCWlSubsurface> subsurf;
+    CSharedPointer<CCWpViewport>   viewport;
+    Vector2D                       size;
+    std::array<SBuffer, 2>         buffers;
+    size_t                         current = 0;
+};
+
+struct SPendingFeedback {
+    CSharedPointer<CCWpPresentationFeedback> feedback;
+    uint64_t                                 committedAt = 0;
+};
+
+struct SWlState {
+    wl_display*                  display;
+    CSharedPointer<CCWlRegistry> registry;
+
+    // protocols
+    CSharedPointer<CCWlCompositor>                 wlCompositor;
+    CSharedPointer<CCWlSubcompositor>              wlSubcompositor;
+    CSharedPointer<CCWlShm>                        wlShm;
+    CSharedPointer<CCXdgWmBase>                    xdgShell;
+    CSharedPointer<CCWpPresentation>               presentation;
+    CSharedPointer<CCWpSinglePixelBufferManagerV1> singlePixel;
+    CSharedPointer<CCWpViewporter>                 viewporter;
+    clockid_t                                      presentationClock = CLOCK_MONOTONIC;
+
+    // shm
+    CSharedPointer<CCWlShmPool> shmPool;
+    CFileDescriptor             shmFd;
+    uint8_t*                    shmData = nullptr;
+    size_t                      shmSize = 0;
+
+    // surfaces, [0] is the toplevel, the rest a chain of subsurfaces
+    std::vector<SSurface>         surfaces;
+    CSharedPointer<CCXdgSurface>  xdgSurf;
+    CSharedPointer<CCXdgToplevel> xdgToplevel;
+    CSharedPointer<CCWlCallback>  frameCallback;
+    bool                          configured       = false;
+    bool                          waitingForBuffer = false; // a frame driven commit was skipped, retry it on the next release
+
+    // stats
+    uint64_t                     commits   = 0;
+    uint64_t                     skipped   = 0; // no free buffer when a commit was due
+    uint64_t                     presented = 0;
+    uint64_t                     discarded = 0;
+    uint64_t                     titles    = 0;
+    std::vector<uint64_t>        latencies; // ns
+    std::deque<SPendingFeedback> feedbacks;
+};
+
+static SOptions              options;
+static volatile sig_atomic_t shouldExit = 0;
+
+static uint64_t              nowNs(clockid_t clock) {
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return sc<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+static bool bindRegistry(SWlState& state) {
+    state.registry = makeShared<CCWlRegistry>((wl_proxy*)wl_display_get_registry(state.display));
+
+    state.registry->setGlobal([&](CCWlRegistry* r, uint32_t id, const char* name, uint32_t version) {
+        const std::string NAME = name;
+        if (NAME == "wl_compositor")
+            state.wlCompositor = makeShared<CCWlCompositor>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wl_compositor_interface, 6));
+        else if (NAME == "wl_subcompositor")
+            state.wlSubcompositor = makeShared<CCWlSubcompositor>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wl_subcompositor_interface, 1));
+        else if (NAME == "wl_shm")
+            state.wlShm = makeShared<CCWlShm>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wl_shm_interface, 1));
+        else if (NAME == "xdg_wm_base")
+            state.xdgShell = makeShared<CCXdgWmBase>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &xdg_wm_base_interface, 1));
+        else if (NAME == "wp_presentation") {
+            state.presentation = makeShared<CCWpPresentation>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wp_presentation_interface, 1));
+            state.presentation->setClockId([&](CCWpPresentation* p, uint32_t clock) { state.presentationClock = sc<clockid_t>(clock); });
+        } else if (NAME == "wp_single_pixel_buffer_manager_v1")
+            state.singlePixel =
+                makeShared<CCWpSinglePixelBufferManagerV1>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wp_single_pixel_buffer_manager_v1_interface, 1));
+        else if (NAME == "wp_viewporter")
+            state.viewporter = makeShared<CCWpViewporter>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wp_viewporter_interface, 1));
+    });
+
+    wl_display_roundtrip(state.display);
+
+    if (!state.wlCompositor || !state.wlSubcompositor || !state.wlShm || !state.xdgShell || !state.presentation) {
+        std::println(stderr, "bench-client: missing protocols");
+        return false;
+    }
+
+    if (options.buffer == BUFFER_SINGLE_PIXEL && (!state.singlePixel || !state.viewporter)) {
+        std::println(stderr, "bench-client: single pixel buffers need wp_single_pixel_buffer_manager_v1 and wp_viewporter");
+        return false;
+    }
+
+    // for the clock id
+    wl_display_roundtrip(state.display);
+
+    return true;
+}
+
+// one pool for everything, two buffers per surface
+static void commit(SWlState& state);
+
+static bool createShm(SWlState& state) {
+    size_t total = 0;
+    for (const auto& s : state.surfaces) {
+        total += 2 * sc<size_t>(s.size.x) * s.size.y * 4;
+    }
+
+    const auto NAME = std::format("/wl-shm-bench-client-{}", getpid());
+    state.shmFd     = CFileDescriptor{shm_open(NAME.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600)};
+    if (!state.shmFd.isValid())
+        return false;
+
+    shm_unlink(NAME.c_str());
+    if (ftruncate(state.shmFd.get(), total) < 0)
+        return false;
+
+    state.shmData = sc<uint8_t*>(mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, state.shmFd.get(), 0));
+    if (state.shmData == MAP_FAILED)
+        return false;
+
+    state.shmSize = total;
+    state.shmPool = makeShared<CCWlShmPool>(state.wlShm->sendCreatePool(state.shmFd.get(), total));
+
+    size_t offset = 0;
+    for (auto& s : state.surfaces) {
+        const int W = s.size.x, H = s.size.y;
+        for (auto& b : s.buffers) {
+            b.buffer = makeShared<CCWlBuffer>(state.shmPool->sendCreateBuffer(offset, W, H, W * 4, WL_SHM_FORMAT_XRGB8888));
+            b.pixels = rc<uint32_t*>(state.shmData + offset);
+            b.buffer->setRelease([&b, &state](CCWlBuffer* p) {
+                b.busy = false;
+                // nothing was committed when the frame callback found no free buffer, so no new callback is coming either
+                if (state.waitingForBuffer) {
+                    state.waitingForBuffer = false;
+                    commit(state);
+                }
+            });
+            std::fill_n(b.pixels, W * H, 0xFF202020);
+            offset += sc<size_t>(W) * H * 4;
+        }
+    }
+
+    return true;
+}
+
+static void createSinglePixel(SWlState& state) {
+    for (auto& s : state.surfaces) {
+        uint32_t shade = 0x40000000;
+        for (auto& b : s.buffers) {
+            // single pixel buffers never get released while attached, but the compositor doesn't write to them either
+            b.buffer = makeShared<CCWlBuffer>(state.singlePixel->sendCreateU32RgbaBuffer(shade, shade, shade, 0xFFFFFFFF));
+            shade += 0x40000000;
+        }
+
+        s.viewport = makeShared<CCWpViewport>(state.viewporter->sendGetViewport(s.surf->resource()));
+        s.viewport->sendSetDestination(s.size.x, s.size.y);
+    }
+}
+
+static void scheduleFrame(SWlState& state);
+
+static void commit(SWlState& state) {
+    if (!state.configured)
+        return;
+
+    auto&      root = state.surfaces.front();
+    const auto NEXT = (root.current + 1) % root.buffers.size();
+
+    if (options.buffer == BUFFER_SHM && root.buffers[NEXT].busy) {
+        state.skipped++;
+        if (options.rate == 0)
+            state.waitingForBuffer = true;
+        return;
+    }
+
+    // a square moving along the diagonal, so damage doesn't always hit the same tiles
+    const int  D = std::min<int>(options.damage, std::min(root.size.x, root.size.y));
+    const auto POS =
+        Vector2D{sc<double>((state.commits * 7) % sc<uint64_t>(std::max<double>(1, root.size.x - D))), sc<double>((state.commits * 5) % sc<uint64_t>(std::max<double>(1, root.size.y - D)))};
+
+    if (options.buffer == BUFFER_SHM) {
+        auto&          buf   = root.buffers[NEXT];
+        const uint32_t COLOR = 0xFF000000 | ((state.commits * 0x010305) & 0xFFFFFF);
+
+        // the other buffer has last frame's content, bring it up to date. Full copies keep it simple, the compositor cost is what's measured.
+        std::memcpy(buf.pixels, root.buffers[root.current].pixels, sc<size_t>(root.size.x) * root.size.y * 4);
+        for (int y = POS.y; y < POS.y + D; ++y) {
+            std::fill_n(buf.pixels + sc<size_t>(y) * root.size.x + sc<int>(POS.x), D, COLOR);
+        }
+
+        buf.busy = true;
+    }
+
+    root.current = NEXT;
+    root.surf->sendAttach(root.buffers[NEXT].buffer.get(), 0, 0);
+    root.surf->sendDamage(POS.x, POS.y, D, D);
+
+    if (options.rate == 0)
+        scheduleFrame(state);
+
+    SPendingFeedback fb;
+    fb.feedback    = makeShared<CCWpPresentationFeedback>(state.presentation->sendFeedback(root.surf->resource()));
+    fb.committedAt = nowNs(state.presentationClock);
+
+    auto* raw = fb.feedback.get();
+    fb.feedback->setPresented([&state, raw](CCWpPresentationFeedback* p, uint32_t secHi, uint32_t secLo, uint32_t nsec, uint32_t refresh, uint32_t seqHi, uint32_t seqLo,
+                                            uint32_t flags) {
+        for (auto it = state.feedbacks.begin(); it != state.feedbacks.end(); ++it) {
+            if (it->feedback.get() != raw)
+                continue;
+
+            const uint64_t WHEN = ((sc<uint64_t>(secHi) << 32) | secLo) * 1000000000ULL + nsec;
+            if (WHEN > it->committedAt)
+                state.latencies.push_back(WHEN - it->committedAt);
+
+            state.presented++;
+            state.feedbacks.erase(it);
+            break;
+        }
+    });
+    fb.feedback->setDiscarded([&state, raw](CCWpPresentationFeedback* p) {
+        state.discarded++;
+        std::erase_if(state.feedbacks, [raw](const auto& f) { return f.feedback.get() == raw; });
+    });
+    state.feedbacks.emplace_back(std::move(fb));
+
+    // children first, they're synchronized and get applied with the root commit
+    for (size_t i = state.surfaces.size() - 1; i > 0; --i) {
+        state.surfaces[i].surf->sendDamage(0, 0, state.surfaces[i].size.x, state.surfaces[i].size.y);
+        state.surfaces[i].surf->sendCommit();
+    }
+
+    root.surf->sendCommit();
+    state.commits++;
+}
+
+static void scheduleFrame(SWlState& state) {
+    state.frameCallback = makeShared<CCWlCallback>(state.surfaces.front().surf->sendFrame());
+    state.frameCallback->setDone([&state](CCWlCallback* p, uint32_t time) { commit(state); });
+}
+
+static bool setupToplevel(SWlState& state) {
+    state.xdgShell->setPing([&](CCXdgWmBase* p, uint32_t serial) { state.xdgShell->sendPong(serial); });
+
+    state.surfaces.resize(1 + options.subsurfaces);
+    state.surfaces[0].surf = makeShared<CCWlSurface>(state.wlCompositor->sendCreateSurface());
+    state.surfaces[0].size = options.size;
+
+    for (size_t i = 1; i < state.surfaces.size(); ++i) {
+        auto& s   = state.surfaces[i];
+        s.surf    = makeShared<CCWlSurface>(state.wlCompositor->sendCreateSurface());
+        s.size    = {64, 64};
+        s.subsurf = makeShared<CCWlSubsurface>(state.wlSubcompositor->sendGetSubsurface(s.surf.get(), state.surfaces[i - 1].surf.get()));
+        s.subsurf->sendSetPosition(16, 16);
+    }
+
+    if (options.buffer == BUFFER_SHM) {
+        if (!createShm(state))
+            return false;
+    } else
+        createSinglePixel(state);
+
+    state.xdgSurf     = makeShared<CCXdgSurface>(state.xdgShell->sendGetXdgSurface(state.surfaces[0].surf->resource()));
+    state.xdgToplevel = makeShared<CCXdgToplevel>(state.xdgSurf->sendGetToplevel());
+
+    state.xdgToplevel->setClose([&](CCXdgToplevel* p) { shouldExit = 1; });
+
+    state.xdgSurf->setConfigure([&](CCXdgSurface* p, uint32_t serial) {
+        state.xdgSurf->sendAckConfigure(serial);
+
+        if (state.configured)
+            return;
+
+        state.configured = true;
+
+        for (size_t i = state.surfaces.size() - 1; i > 0; --i) {
+            state.surfaces[i].surf->sendAttach(state.surfaces[i].buffers[0].buffer.get(), 0, 0);
+            state.surfaces[i].surf->sendCommit();
+        }
+
+        commit(state);
+    });
+
+    state.xdgToplevel->sendSetTitle(std::format("bench-client {}", options.id).c_str());
+    state.xdgToplevel->sendSetAppId("bench-client");
+
+    state.surfaces[0].surf->sendCommit();
+
+    return true;
+}
+
+static uint64_t percentile(std::vector<uint64_t>& sorted, double p) {
+    if (sorted.empty())
+        return 0;
+    return sorted[std::min(sorted.size() - 1, sc<size_t>(p * (sorted.size() - 1) + 0.5))];
+}
+
+static void writeStats(SWlState& state) {
+    std::ofstream ofs(options.out, std::ios::trunc);
+    if (!ofs.good())
+        return;
+
+    // plain "key value" lines, hyprbench merges the latency samples of every client
+    ofs << std::format("commits {}\nskipped {}\npresented {}\ndiscarded {}\ntitles {}\n", state.commits, state.skipped, state.presented, state.discarded, state.titles);
+    for (const auto& l : state.latencies) {
+        ofs << "latency " << l << "\n";
+    }
+
+    ofs << "end\n";
+}
+
+static bool parseArgs(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string ARG = argv[i];
+        if (i + 1 >= argc) {
+            std::println(stderr, "bench-client: {} needs a value", ARG);
+            return false;
+        }
+
+        const std::string VALUE = argv[++i];
+
+        try {
+            if (ARG == "--buffer")
+                options.buffer = VALUE == "single-pixel" ? BUFFER_SINGLE_PIXEL : BUFFER_SHM;
+            else if (ARG == "--rate")
+                options.rate = std::stoi(VALUE);
+            else if (ARG == "--damage")
+                options.damage = std::stoi(VALUE);
+            else if (ARG == "--title-churn")
+                options.titleChurn = std::stoi(VALUE);
+            else if (ARG == "--subsurfaces")
+                options.subsurfaces = std::stoi(VALUE);
+            else if (ARG == "--id")
+                options.id = VALUE;
+            else if (ARG == "--out")
+                options.out = VALUE;
+            else {
+                std::println(stderr, "bench-client: unknown option {}", ARG);
+                return false;
+            }
+        } catch (...) {
+            std::println(stderr, "bench-client: invalid value {} for {}", VALUE, ARG);
+            return false;
+        }
+    }
+
+    return !options.out.empty();
+}
+
+static CFileDescriptor makeTimer(int perSecond) {
+    if (perSecond <= 0)
+        return {};
+
+    CFileDescriptor fd{timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)};
+    const long      NS = 1000000000L / perSecond;
+    itimerspec      spec{.it_interval = {.tv_sec = NS / 1000000000L, .tv_nsec = NS % 1000000000L}, .it_value = {.tv_sec = NS / 1000000000L, .tv_nsec = NS % 1000000000L}};
+    timerfd_settime(fd.get(), 0, &spec, nullptr);
+    return fd;
+}
+
+int main(int argc, char** argv) {
+    if (!parseArgs(argc, argv)) {
+        std::println(stderr, "usage: bench-client --out FILE [--buffer shm|single-pixel] [--rate N] [--damage PX] [--title-churn N] [--subsurfaces N] [--id ID]");
+        return 1;
+    }
+
+    signal(SIGTERM, [](int) { shouldExit = 1; });
+    signal(SIGINT, [](int) { shouldExit = 1; });
+
+    SWlState state;
+
+    // WAYLAND_DISPLAY env should be set to the correct one
+    state.display = wl_display_connect(nullptr);
+    if (!state.display) {
+        std::println(stderr, "bench-client: failed to connect to wayland display");
+        return 1;
+    }
+
+    if (!bindRegistry(state) || !setupToplevel(state))
+        return 1;
+
+    wl_display_flush(state.display);
+
+    const auto COMMITTIMER = makeTimer(options.rate);
+    const auto TITLETIMER  = makeTimer(options.titleChurn);
+
+    pollfd     fds[3] = {
+        {.fd = wl_display_get_fd(state.display), .events = POLLIN},
+        {.fd = COMMITTIMER.isValid() ? COMMITTIMER.get() : -1, .events = POLLIN},
+        {.fd = TITLETIMER.isValid() ? TITLETIMER.get() : -1, .events = POLLIN},
+    };
+
+    while (!shouldExit) {
+        wl_display_flush(state.display);
+
+        if (poll(fds, 3, 100) < 0)
+            continue; // EINTR from SIGTERM, loop condition takes it from here
+
+        if (fds[0].revents & POLLIN) {
+            if (wl_display_dispatch(state.display) < 0)
+                break;
+        }
+
+        uint64_t expirations = 0;
+        if ((fds[1].revents & POLLIN) && read(fds[1].fd, &expirations, sizeof(expirations)) > 0)
+            commit(state);
+
+        if ((fds[2].revents & POLLIN) && read(fds[2].fd, &expirations, sizeof(expirations)) > 0) {
+            state.xdgToplevel->sendSetTitle(std::format("bench-client {} #{}", options.id, ++state.titles).c_str());
+        }
+    }
+
+    writeStats(state);
+
+    wl_display* display = state.display;
+    state               = {};
+
+    wl_display_disconnect(display);
+    return 0;
+}
@@ -79,7 +79,7 @@ std::vector<SInstanceData> instances() {
     return result;
 }
 
-std::string getFromSocket(const std::string& cmd) {
+int connectToSocket(const std::string& name) {
     const auto SERVERSOCKET = socket(AF_UNIX, SOCK_STREAM, 0);
 
     auto       t = timeval{.tv_sec = 5, .tv_usec = 0};
@@ -87,21 +87,31 @@ std::string getFromSocket(const std::string& cmd) {
 
     if (SERVERSOCKET < 0) {
         std::println("socket: Couldn't open a socket (1)");
-        return "";
+        return -1;
     }
 
     sockaddr_un serverAddress = {0};
     serverAddress.sun_family  = AF_UNIX;
 
-    std::string socketPath = getRuntimeDir() + "/" + HIS + "/.socket.sock";
+    std::string socketPath = getRuntimeDir() + "/" + HIS + "/" + name;
 
     strncpy(serverAddress.sun_path, socketPath.c_str(), sizeof(serverAddress.sun_path) - 1);
 
     if (connect(SERVERSOCKET, rc<sockaddr*>(&serverAddress), SUN_LEN(&serverAddress)) < 0) {
         std::println("Couldn't connect to {}. (3)", socketPath);
-        return "";
+        close(SERVERSOCKET);
+        return -1;
     }
 
+    return SERVERSOCKET;
+}
+
+std::string getFromSocket(const std::string& cmd) {
+    const auto SERVERSOCKET = connectToSocket();
+
+    if (SERVERSOCKET < 0)
+        return "";
+
     auto sizeWritten = write(SERVERSOCKET, cmd.c_str(), cmd.length());
 
     if (sizeWritten < 0) {
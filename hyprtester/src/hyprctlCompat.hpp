@@ -13,4 +13,7 @@ struct SInstanceData {
 };
 
 std::vector<SInstanceData> instances();
-std::string                getFromSocket(const std::string& cmd);
\ No newline at end of file
+std::string                getFromSocket(const std::string& cmd);
+
+// a connection to one of the instance's sockets with a 5s read timeout, -1 on failure
+int connectToSocket(const std::string& name = ".socket.sock");
\ No newline at end of file
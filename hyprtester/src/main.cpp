@@ -13,6 +13,7 @@
 // Required runtime deps for checks:
 // - kitty
 // - xeyes
+// - xclip, wl-clipboard
 
 #include "shared.hpp"
 #include "hyprctlCompat.hpp"
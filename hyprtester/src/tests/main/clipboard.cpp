@@ -0,0 +1,136 @@
+#include "tests.hpp"
+#include "../../shared.hpp"
+#include "../../hyprctlCompat.hpp"
+#include "../shared.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+static int ret = 0;
+
+// the xwm bridges the clipboard in 64k chunks, give or take some slack for whatever else happens meanwhile
+constexpr size_t      PAYLOAD_SIZE      = 256ul * 1024 * 1024;
+constexpr size_t      MAX_PEAK_GROWTH   = 64ul * 1024 * 1024;
+constexpr const char* X_TO_WL_FILE      = "/tmp/hyprtester-clipboard-x2wl";
+constexpr const char* WL_TO_X_FILE      = "/tmp/hyprtester-clipboard-wl2x";
+constexpr auto        TRANSFER_DEADLINE = std::chrono::seconds(120);
+
+static std::string    hyprlandPID() {
+    auto pid = Tests::execAndGet("pgrep -nx Hyprland");
+    while (!pid.empty() && (pid.back() == '\n' || pid.back() == ' '))
+        pid.pop_back();
+    return pid;
+}
+
+// VmRSS / VmHWM from /proc/pid/status, in bytes
+static size_t statusBytes(const std::string& pid, const std::string& field) {
+    std::ifstream status("/proc/" + pid + "/status");
+    std::string   line;
+    while (std::getline(status, line)) {
+        if (!line.starts_with(field + ":"))
+            continue;
+
+        try {
+            return std::stoull(line.substr(field.length() + 1)) * 1024;
+        } catch (...) { return 0; }
+    }
+
+    return 0;
+}
+
+// resets VmHWM to the current rss
+static void resetPeak(const std::string& pid) {
+    std::ofstream clearRefs("/proc/" + pid + "/clear_refs");
+    clearRefs << "5";
+}
+
+static size_t waitForCount(const char* path) {
+    const auto START = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - START < TRANSFER_DEADLINE) {
+        std::ifstream file(path);
+        std::string   count;
+        if (file && std::getline(file, count) && !count.empty()) {
+            try {
+                return std::stoull(count);
+            } catch (...) { return 0; }
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    }
+
+    return 0;
+}
+
+static void focusXEyes() {
+    getFromSocket("/dispatch focuswindow class:XEyes");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+}
+
+static bool test() {
+    NLog::log("{}Testing the X11 <-> wayland clipboard bridge", Colors::GREEN);
+
+    if (!Tests::execAndGet("command -v xclip wl-copy wl-paste xeyes | wc -l").starts_with("4")) {
+        NLog::log("{}Skipping: xclip, wl-clipboard and xeyes are needed", Colors::YELLOW);
+        return !ret;
+    }
+
+    const auto PID = hyprlandPID();
+    EXPECT(PID.empty(), false);
+    if (PID.empty())
+        return !ret;
+
+    std::filesystem::remove(X_TO_WL_FILE);
+    std::filesystem::remove(WL_TO_X_FILE);
+
+    // selection requests are only served while an X window has focus
+    NLog::log("{}Spawning xeyes", Colors::YELLOW);
+    getFromSocket("/dispatch exec xeyes");
+    Tests::waitUntilWindowsN(1);
+    focusXEyes();
+
+    NLog::log("{}X11 -> wayland", Colors::YELLOW);
+    {
+        resetPeak(PID);
+        const auto RSS_BEFORE = statusBytes(PID, "VmRSS");
+
+        getFromSocket(std::format("/dispatch exec head -c {} /dev/zero | xclip -selection clipboard -i", PAYLOAD_SIZE));
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        getFromSocket(std::format("/dispatch exec wl-paste -n | wc -c > {}", X_TO_WL_FILE));
+
+        EXPECT(waitForCount(X_TO_WL_FILE), PAYLOAD_SIZE);
+
+        const auto GROWTH = statusBytes(PID, "VmHWM") - RSS_BEFORE;
+        NLog::log("{}peak rss grew by {} bytes", Colors::YELLOW, GROWTH);
+        EXPECT(GROWTH < MAX_PEAK_GROWTH, true);
+    }
+
+    NLog::log("{}wayland -> X11", Colors::YELLOW);
+    {
+        resetPeak(PID);
+        const auto RSS_BEFORE = statusBytes(PID, "VmRSS");
+
+        getFromSocket(std::format("/dispatch exec head -c {} /dev/zero | wl-copy", PAYLOAD_SIZE));
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        focusXEyes();
+        getFromSocket(std::format("/dispatch exec xclip -selection clipboard -o | wc -c > {}", WL_TO_X_FILE));
+
+        EXPECT(waitForCount(WL_TO_X_FILE), PAYLOAD_SIZE);
+
+        const auto GROWTH = statusBytes(PID, "VmHWM") - RSS_BEFORE;
+        NLog::log("{}peak rss grew by {} bytes", Colors::YELLOW, GROWTH);
+        EXPECT(GROWTH < MAX_PEAK_GROWTH, true);
+    }
+
+    Tests::execAndGet("pkill -x xclip; pkill -x wl-copy");
+    std::filesystem::remove(X_TO_WL_FILE);
+    std::filesystem::remove(WL_TO_X_FILE);
+
+    NLog::log("{}Killing all windows", Colors::YELLOW);
+    Tests::killAllWindows();
+    EXPECT(Tests::windowCount(), 0);
+
+    return !ret;
+}
+
+REGISTER_TEST_FN(test);
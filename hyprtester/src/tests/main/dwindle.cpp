@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <sstream>
 #include "../shared.hpp"
 #include "../../shared.hpp"
 #include "../../hyprctlCompat.hpp"
@@ -5,6 +7,30 @@
 
 static int  ret = 0;
 
+// sorted "at/size" of every window, the layout doesn't care which window got which tile
+static std::string tileGeometries() {
+    const auto               CLIENTS = getFromSocket("/clients");
+    std::vector<std::string> tiles;
+    std::istringstream       stream(CLIENTS);
+    std::string              line, at;
+
+    while (std::getline(stream, line)) {
+        if (line.starts_with("\tat: "))
+            at = line.substr(5);
+        else if (line.starts_with("\tsize: "))
+            tiles.emplace_back(at + " " + line.substr(7));
+    }
+
+    std::ranges::sort(tiles);
+
+    std::string result;
+    for (auto const& t : tiles) {
+        result += t + ";";
+    }
+
+    return result;
+}
+
 static void testFloatClamp() {
     for (auto const& win : {"a", "b", "c"}) {
         if (!Tests::spawnKitty(win)) {
@@ -36,6 +62,34 @@ static void testFloatClamp() {
     Tests::killAllWindows();
 }
 
+static void burstOpen() {
+    NLog::log("{}Opening 4 windows one by one", Colors::YELLOW);
+    for (auto const& win : {"burst1", "burst2", "burst3", "burst4"}) {
+        if (!Tests::spawnKitty(win)) {
+            NLog::log("{}Failed to spawn kitty with win class `{}`", Colors::RED, win);
+            ++TESTS_FAILED;
+            ret = 1;
+            return;
+        }
+    }
+
+    const auto ONE_BY_ONE = tileGeometries();
+    Tests::killAllWindows();
+
+    NLog::log("{}Opening the same windows in one burst", Colors::YELLOW);
+    for (int i = 0; i < 4; ++i) {
+        OK(getFromSocket("/dispatch exec kitty --class burst"));
+    }
+    Tests::waitUntilWindowsN(4);
+
+    EXPECT(Tests::windowCount(), 4);
+    EXPECT(tileGeometries(), ONE_BY_ONE);
+
+    // clean up
+    NLog::log("{}Killing all windows", Colors::YELLOW);
+    Tests::killAllWindows();
+}
+
 static bool test() {
     NLog::log("{}Testing Dwindle layout", Colors::GREEN);
 
@@ -43,6 +97,9 @@ static bool test() {
     NLog::log("{}Testing float clamp", Colors::GREEN);
     testFloatClamp();
 
+    NLog::log("{}Testing a burst of new windows", Colors::GREEN);
+    burstOpen();
+
     // clean up
     NLog::log("Cleaning up", Colors::YELLOW);
     getFromSocket("/dispatch workspace 1");
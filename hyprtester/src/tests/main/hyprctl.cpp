@@ -6,11 +6,24 @@
 #include <string>
 #include <thread>
 #include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
 #include <hyprutils/os/Process.hpp>
 #include <hyprutils/memory/WeakPtr.hpp>
+#include <hyprutils/memory/Casts.hpp>
 #include <csignal>
 #include <cerrno>
 #include "../shared.hpp"
+#include "../../../../src/debug/HyprCtlProtocol.hpp"
+#include "../../../../src/debug/StatePageLayout.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 static int ret = 0;
 
@@ -163,6 +176,292 @@ static bool testGetprop() {
     return true;
 }
 
+static uint64_t stateGeneration(const std::string& state) {
+    const auto POS = state.find("\"generation\": ");
+    if (POS == std::string::npos)
+        return 0;
+    return std::stoull(state.substr(POS + 14));
+}
+
+static bool testStateDeltas() {
+    NLog::log("{}Testing hyprctl state", Colors::GREEN);
+    if (!Tests::spawnKitty("state_test")) {
+        NLog::log("{}Error: kitty did not spawn", Colors::RED);
+        return false;
+    }
+
+    std::string state = getFromSocket("j/state");
+    EXPECT_CONTAINS(state, "\"full\": true");
+    EXPECT_CONTAINS(state, "\"class\": \"state_test\"");
+
+    // nothing happened, so nothing should be reported
+    const auto GEN = stateGeneration(state);
+    state          = getFromSocket("j/state " + std::to_string(GEN));
+    EXPECT_CONTAINS(state, "\"full\": false");
+    EXPECT_CONTAINS(state, "\"clients\": []");
+    EXPECT(stateGeneration(state), GEN);
+
+    // changed windows come back, and only those
+    getFromSocket("/dispatch togglefloating class:state_test");
+    state = getFromSocket("j/state " + std::to_string(GEN));
+    EXPECT_CONTAINS(state, "\"class\": \"state_test\"");
+    EXPECT(stateGeneration(state) > GEN, true);
+
+    // closed windows are reported as removed
+    const auto GEN2 = stateGeneration(state);
+    Tests::killAllWindows();
+    state = getFromSocket("j/state " + std::to_string(GEN2));
+    EXPECT_CONTAINS(state, "\"clients\": [\"0x");
+
+    EXPECT_STARTS_WITH(getFromSocket("/state nope"), "invalid generation");
+
+    return true;
+}
+
+static bool testTrace() {
+    NLog::log("{}Testing hyprctl trace", Colors::GREEN);
+
+    constexpr const char* TRACE_FILE = "/tmp/hyprtester-trace.json";
+    std::filesystem::remove(TRACE_FILE);
+
+    EXPECT(getFromSocket("/trace start"), "ok");
+
+    // render a few frames
+    for (int i = 0; i < 5; ++i) {
+        getFromSocket("/dispatch workspace e+1");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        getFromSocket("/dispatch workspace e-1");
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    EXPECT(getFromSocket("/trace stop"), "ok");
+    EXPECT_STARTS_WITH(getFromSocket(std::format("/trace dump {}", TRACE_FILE)), "dumped ");
+
+    std::ifstream     file(TRACE_FILE);
+    std::stringstream trace;
+    trace << file.rdbuf();
+    EXPECT_STARTS_WITH(trace.str(), "{\"displayTimeUnit\":\"ms\",\"droppedSpans\":0,\"traceEvents\":[");
+    EXPECT_CONTAINS(trace.str(), "\"name\":\"renderMonitor\",\"ph\":\"X\"");
+    EXPECT_CONTAINS(trace.str(), "\"name\":\"endRender\"");
+
+    EXPECT(getFromSocket("/trace dump relative.json"), "path must be absolute");
+    EXPECT(getFromSocket("/trace nope"), "unknown trace request");
+
+    std::filesystem::remove(TRACE_FILE);
+
+    return true;
+}
+
+static void appendFrame(std::string& out, uint32_t id, const std::string& request) {
+    const HyprCtlProtocol::SFrameHeader HEADER = {.id = id, .length = sc<uint32_t>(request.size())};
+    out.append(rc<const char*>(&HEADER), sizeof(HEADER));
+    out.append(request);
+}
+
+static bool writeAll(int fd, std::string_view data) {
+    while (!data.empty()) {
+        const auto WRITTEN = write(fd, data.data(), data.size());
+        if (WRITTEN <= 0)
+            return false;
+        data.remove_prefix(WRITTEN);
+    }
+    return true;
+}
+
+// id and payload of the next reply frame, nullopt on timeout or EOF
+static std::optional<std::pair<uint32_t, std::string>> readFrame(int fd, std::string& in) {
+    while (true) {
+        if (in.size() >= sizeof(HyprCtlProtocol::SFrameHeader)) {
+            HyprCtlProtocol::SFrameHeader header;
+            std::memcpy(&header, in.data(), sizeof(header));
+
+            if (in.size() - sizeof(header) >= header.length) {
+                auto frame = std::make_pair(header.id, in.substr(sizeof(header), header.length));
+                in.erase(0, sizeof(header) + header.length);
+                return frame;
+            }
+        }
+
+        std::array<char, 8192> buf;
+        const auto             LEN = read(fd, buf.data(), buf.size());
+        if (LEN <= 0)
+            return std::nullopt;
+
+        in.append(buf.data(), LEN);
+    }
+}
+
+static bool testBinaryFraming() {
+    NLog::log("{}Testing hyprctl binary framing", Colors::GREEN);
+
+    // ids are the client's, replies carry them back in request order
+    const std::vector<std::pair<uint32_t, std::string>> REQUESTS = {
+        {42, "/getoption general:border_size"},
+        {7, "j/workspaces"},
+        {1000, "/version"},
+        {3, "[[BATCH]]/getoption general:border_size;/getoption general:gaps_in"},
+        {7, "/getoption general:gaps_out"},
+    };
+
+    const auto FD = connectToSocket();
+    if (FD < 0) {
+        NLog::log("{}Error: couldn't connect to the socket", Colors::RED);
+        return false;
+    }
+
+    // everything in one write, hyprland has to take it apart on its own
+    std::string out(HyprCtlProtocol::BINARY_MAGIC.data(), HyprCtlProtocol::BINARY_MAGIC.size());
+    for (const auto& [id, request] : REQUESTS) {
+        appendFrame(out, id, request);
+    }
+
+    EXPECT(writeAll(FD, out), true);
+
+    std::string in;
+    for (const auto& [id, request] : REQUESTS) {
+        const auto FRAME = readFrame(FD, in);
+        EXPECT(FRAME.has_value(), true);
+        if (!FRAME)
+            break;
+
+        EXPECT(FRAME->first, id);
+        // same reply as in text mode, batches included
+        EXPECT(FRAME->second, getFromSocket(request));
+    }
+
+    // the connection stays open for more
+    out.clear();
+    appendFrame(out, 5, "/getoption general:border_size");
+    EXPECT(writeAll(FD, out), true);
+    const auto LAST = readFrame(FD, in);
+    EXPECT(LAST.has_value() && LAST->first == 5, true);
+
+    close(FD);
+
+    return true;
+}
+
+static bool testBinaryClientNotReading() {
+    NLog::log("{}Testing a binary hyprctl client that never reads its replies", Colors::GREEN);
+
+    const auto DESCRIPTIONS = getFromSocket("descriptions");
+    if (DESCRIPTIONS.empty()) {
+        NLog::log("{}Error: no descriptions", Colors::RED);
+        return false;
+    }
+
+    const auto FD = connectToSocket();
+    if (FD < 0) {
+        NLog::log("{}Error: couldn't connect to the socket", Colors::RED);
+        return false;
+    }
+
+    // well past what hyprland queues for a client before dropping it
+    const size_t COUNT = std::min<size_t>((32 * 1024 * 1024) / DESCRIPTIONS.size() + 1, 4096);
+
+    std::string  out(HyprCtlProtocol::BINARY_MAGIC.data(), HyprCtlProtocol::BINARY_MAGIC.size());
+    for (size_t i = 0; i < COUNT; ++i) {
+        appendFrame(out, i, "descriptions");
+    }
+
+    EXPECT(writeAll(FD, out), true);
+
+    // hyprland mustn't block on that client
+    const auto START = std::chrono::steady_clock::now();
+    EXPECT(getFromSocket("/getoption general:border_size").empty(), false);
+    EXPECT(std::chrono::steady_clock::now() - START < std::chrono::seconds(2), true);
+
+    // and it gets dropped: whatever made it into the socket, then EOF
+    std::array<char, 65536> buf;
+    ssize_t                 len = 0;
+    while ((len = read(FD, buf.data(), buf.size())) > 0) {
+        ;
+    }
+    EXPECT(len, 0);
+
+    close(FD);
+
+    return true;
+}
+
+static bool testStatePage() {
+    NLog::log("{}Testing the state page", Colors::GREEN);
+
+    if (!Tests::spawnKitty("statepage")) {
+        NLog::log("{}Error: kitty did not spawn", Colors::RED);
+        return false;
+    }
+
+    // the page is rewritten on the next loop iteration after the open
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    const auto FD = connectToSocket();
+    if (FD < 0) {
+        NLog::log("{}Error: couldn't connect to the socket", Colors::RED);
+        return false;
+    }
+
+    const std::string REQUEST = "/statepage";
+    EXPECT(writeAll(FD, REQUEST), true);
+
+    std::array<char, 256> reply = {};
+    iovec                 iov   = {.iov_base = reply.data(), .iov_len = reply.size()};
+    msghdr                msg   = {};
+
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int))> control = {};
+
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control.data();
+    msg.msg_controllen = control.size();
+
+    const auto LEN = recvmsg(FD, &msg, 0);
+    close(FD);
+
+    EXPECT(LEN > 0, true);
+    if (LEN <= 0)
+        return false;
+
+    EXPECT(std::string(reply.data(), LEN), std::format("ok, version {}", HYPRLAND_STATE_PAGE_VERSION));
+
+    const auto* CMSG = CMSG_FIRSTHDR(&msg);
+    EXPECT(CMSG && CMSG->cmsg_level == SOL_SOCKET && CMSG->cmsg_type == SCM_RIGHTS, true);
+    if (!CMSG || CMSG->cmsg_type != SCM_RIGHTS)
+        return false;
+
+    int pageFD = -1;
+    std::memcpy(&pageFD, CMSG_DATA(CMSG), sizeof(int));
+
+    // sealed: readers can't resize it, or map it writable where F_SEAL_FUTURE_WRITE exists
+    EXPECT(ftruncate(pageFD, 0) < 0, true);
+
+    auto* const MAPPED = mmap(nullptr, sizeof(hyprland_state_page), PROT_READ, MAP_SHARED, pageFD, 0);
+    close(pageFD);
+
+    EXPECT(MAPPED != MAP_FAILED, true);
+    if (MAPPED == MAP_FAILED)
+        return false;
+
+    hyprland_state_page page = {};
+    EXPECT(hyprland_state_page_read(sc<const hyprland_state_page*>(MAPPED), &page) != 0, true);
+    munmap(MAPPED, sizeof(hyprland_state_page));
+
+    EXPECT(page.magic, HYPRLAND_STATE_PAGE_MAGIC);
+    EXPECT(page.version >= HYPRLAND_STATE_PAGE_VERSION, true);
+    EXPECT(page.size >= sizeof(hyprland_state_page), true);
+    EXPECT(std::string(page.focused_class), "statepage");
+    EXPECT(page.window_count, sc<uint32_t>(Tests::windowCount()));
+
+    // "Window <address> -> <title>:"
+    const auto ACTIVE = getFromSocket("/activewindow");
+    EXPECT_STARTS_WITH(ACTIVE, "Window ");
+    EXPECT(std::format("{:x}", page.focused_window), ACTIVE.substr(7, ACTIVE.find(' ', 7) - 7));
+
+    Tests::killAllWindows();
+
+    return true;
+}
+
 static bool test() {
     NLog::log("{}Testing hyprctl", Colors::GREEN);
 
@@ -176,6 +475,11 @@ static bool test() {
 
     testGetprop();
     testDevicesActiveLayoutIndex();
+    testStateDeltas();
+    testTrace();
+    testBinaryFraming();
+    testBinaryClientNotReading();
+    testStatePage();
     getFromSocket("/reload");
 
     return !ret;
@@ -0,0 +1,158 @@
+#include "tests.hpp"
+#include "../../shared.hpp"
+#include "../../hyprctlCompat.hpp"
+#include "../shared.hpp"
+#include "../../../../src/helpers/JsonWriter.hpp"
+#include <hyprutils/os/Process.hpp>
+#include <chrono>
+#include <format>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+static int ret = 0;
+
+using namespace Hyprutils::OS;
+
+// the ostringstream escaper hyprctl used before JsonWriter, kept verbatim as the reference
+static std::string referenceEscape(const std::string& str) {
+    std::ostringstream oss;
+    for (auto const& c : str) {
+        switch (c) {
+            case '"': oss << "\\\""; break;
+            case '\\': oss << "\\\\"; break;
+            case '\b': oss << "\\b"; break;
+            case '\f': oss << "\\f"; break;
+            case '\n': oss << "\\n"; break;
+            case '\r': oss << "\\r"; break;
+            case '\t': oss << "\\t"; break;
+            default:
+                if ('\x00' <= c && c <= '\x1f') {
+                    oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+                } else {
+                    oss << c;
+                }
+        }
+    }
+    return oss.str();
+}
+
+static std::vector<std::string> makeCorpus() {
+    std::vector<std::string> corpus = {
+        "",
+        "kitty",
+        "a \"quoted\" title",
+        "C:\\path\\to\\file",
+        "tab\there, newline\nthere",
+        std::string("nul\0byte", 8),
+        "\x01\x02\x1f\x7f",
+        "zażółć gęślą jaźń 🦀",
+        "ends with a quote\"",
+        "\"starts with a quote",
+        "exactly8",
+        "exactly8\"",
+    };
+
+    // random titles, mostly printable with the occasional control char / quote / high byte
+    std::mt19937 rng(0x4879); // fixed seed, failures have to be reproducible
+    for (size_t i = 0; i < 2000; ++i) {
+        std::string s(rng() % 96, '\0');
+        for (auto& c : s) {
+            const auto ROLL = rng() % 32;
+            if (ROLL == 0)
+                c = static_cast<char>(rng() % 0x20);
+            else if (ROLL == 1)
+                c = "\"\\"[rng() % 2];
+            else if (ROLL == 2)
+                c = static_cast<char>(0x80 + rng() % 0x80);
+            else
+                c = static_cast<char>(' ' + rng() % 95);
+        }
+        corpus.emplace_back(std::move(s));
+    }
+
+    return corpus;
+}
+
+// runs hyprctl -j <command> through jq -e, the filter gets TITLE from the environment
+static int jqCheck(const std::string& command, const std::string& filter, const std::string& title = "") {
+    CProcess jq("bash", {"-c", std::format("hyprctl -j {} | jq -e \"$FILTER\" > /dev/null", command)});
+    jq.addEnv("HYPRLAND_INSTANCE_SIGNATURE", HIS);
+    jq.addEnv("FILTER", filter);
+    jq.addEnv("TITLE", title);
+    jq.runSync();
+    return jq.exitCode();
+}
+
+static bool test() {
+    NLog::log("{}Testing json escaping", Colors::GREEN);
+
+    const auto CORPUS = makeCorpus();
+
+    int        mismatches = 0;
+    for (const auto& s : CORPUS) {
+        std::string streamed;
+        escapeJSONInto(streamed, s);
+
+        const auto REF = referenceEscape(s);
+        if (streamed != REF || std::format("{}", SJsonEscaped{s}) != REF)
+            mismatches++;
+    }
+
+    EXPECT(mismatches, 0);
+
+    // micro-benchmark, informational only. Runs under a live compositor so timings are noisy.
+    constexpr size_t ROUNDS = 50;
+    size_t           sink   = 0;
+
+    const auto       REFSTART = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ROUNDS; ++i) {
+        for (const auto& s : CORPUS) {
+            sink += referenceEscape(s).size();
+        }
+    }
+    const auto  REFTIME = std::chrono::steady_clock::now() - REFSTART;
+
+    std::string buffer;
+    const auto  NEWSTART = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ROUNDS; ++i) {
+        buffer.clear();
+        for (const auto& s : CORPUS) {
+            escapeJSONInto(buffer, s);
+        }
+        sink += buffer.size();
+    }
+    const auto NEWTIME = std::chrono::steady_clock::now() - NEWSTART;
+
+    NLog::log("{}json escape: ostringstream {}us, streaming {}us ({} bytes)", Colors::YELLOW, std::chrono::duration_cast<std::chrono::microseconds>(REFTIME).count(),
+              std::chrono::duration_cast<std::chrono::microseconds>(NEWTIME).count(), sink);
+
+    // the big replies should still be well formed after going through the pooled buffers
+    for (const auto& cmd : {"/descriptions", "/binds", "/devices", "/layers", "/animations"}) {
+        const auto JSON = getFromSocket(std::string{"j"} + cmd);
+        EXPECT(!JSON.empty() && (JSON.front() == '[' || JSON.front() == '{'), true);
+    }
+
+    // twice in a row, the second one reuses the buffer of the first
+    EXPECT(getFromSocket("j/descriptions") == getFromSocket("j/descriptions"), true);
+
+    // the replies built with SJsonEscaped have to parse, with a title that needs escaping making it through intact
+    NLog::log("{}Testing clients, workspaces and monitors with jq", Colors::GREEN);
+
+    const std::string TITLE = "json \"quoted\" C:\\path\\ title";
+    if (!Tests::spawnKitty("json_check", {"-T", TITLE, "sleep", "60"})) {
+        NLog::log("{}Error: kitty did not spawn", Colors::RED);
+        return false;
+    }
+
+    EXPECT(jqCheck("clients", R"(type == "array" and any(.[]; .class == "json_check" and .title == env.TITLE))", TITLE), 0);
+    EXPECT(jqCheck("workspaces", R"(type == "array" and length > 0 and all(.[]; (.id | type) == "number" and (.name | type) == "string" and (.windows | type) == "number"))"),
+           0);
+    EXPECT(jqCheck("monitors", R"(type == "array" and length > 0 and all(.[]; (.name | type) == "string" and (.activeWorkspace.id | type) == "number"))"), 0);
+
+    Tests::killAllWindows();
+
+    return !ret;
+}
+
+REGISTER_TEST_FN(test);
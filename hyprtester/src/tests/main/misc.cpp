@@ -18,6 +18,49 @@ using namespace Hyprutils::Memory;
 #define UP CUniquePointer
 #define SP CSharedPointer
 
+static bool xwaylandRunning() {
+    return !Tests::execAndGet("pgrep -x Xwayland").empty();
+}
+
+static void testLazyXWayland() {
+    if (!Tests::execAndGet("command -v xeyes xprop | wc -l").starts_with("2")) {
+        NLog::log("{}Skipping, xeyes or xprop missing", Colors::YELLOW);
+        return;
+    }
+
+    OK(getFromSocket("/keyword xwayland:lazy_idle_timeout 1"));
+
+    NLog::log("{}Spawning xeyes, Xwayland has to come up for it", Colors::YELLOW);
+    getFromSocket("/dispatch exec xeyes");
+    Tests::waitUntilWindowsN(1);
+    EXPECT(Tests::windowCount(), 1);
+    EXPECT(xwaylandRunning(), true);
+
+    // xprop -spy holds a connection without creating any window
+    NLog::log("{}Closing the last X window while a windowless X client is connected", Colors::YELLOW);
+    getFromSocket("/dispatch exec xprop -root -spy");
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    Tests::killAllWindows();
+    std::this_thread::sleep_for(std::chrono::seconds(3));
+    EXPECT(xwaylandRunning(), true);
+
+    NLog::log("{}Disconnecting it, Xwayland should stop", Colors::YELLOW);
+    Tests::execAndGet("pkill -x xprop");
+    for (int i = 0; i < 50 && xwaylandRunning(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    EXPECT(xwaylandRunning(), false);
+
+    NLog::log("{}Spawning xeyes again, Xwayland should come back", Colors::YELLOW);
+    getFromSocket("/dispatch exec xeyes");
+    Tests::waitUntilWindowsN(1);
+    EXPECT(Tests::windowCount(), 1);
+    EXPECT(xwaylandRunning(), true);
+
+    OK(getFromSocket("/keyword xwayland:lazy_idle_timeout 0"));
+    Tests::killAllWindows();
+}
+
 static bool test() {
     NLog::log("{}Testing config: misc:", Colors::GREEN);
 
@@ -208,6 +251,35 @@ static bool test() {
     // become a zombie even if it terminates very quickly.
     EXPECT(Tests::execAndGet("pgrep -f 'sleep 0'").empty(), true);
 
+    // reloads skip steps whose config didn't change, but runtime keywords still have to be undone
+    NLog::log("{}Testing reload after a runtime keyword", Colors::YELLOW);
+    OK(getFromSocket("/reload"));
+    Tests::killAllWindows();
+    Tests::spawnKitty();
+
+    {
+        auto str = getFromSocket("/activewindow");
+        EXPECT_CONTAINS(str, "at: 22,22");
+    }
+
+    OK(getFromSocket("/keyword general:gaps_out 40"));
+
+    {
+        auto str = getFromSocket("/activewindow");
+        EXPECT_CONTAINS(str, "at: 42,42");
+    }
+
+    OK(getFromSocket("/reload"));
+
+    {
+        auto str = getFromSocket("/activewindow");
+        EXPECT_CONTAINS(str, "at: 22,22");
+    }
+
+    NLog::log("{}Testing lazy XWayland startup and idle shutdown", Colors::YELLOW);
+    Tests::killAllWindows();
+    testLazyXWayland();
+
     // kill all
     NLog::log("{}Killing all windows", Colors::YELLOW);
     Tests::killAllWindows();
@@ -4,6 +4,8 @@
 #include <cstring>
 #include <filesystem>
 #include <thread>
+#include <unistd.h>
+#include <sys/socket.h>
 #include <hyprutils/os/Process.hpp>
 #include <hyprutils/memory/WeakPtr.hpp>
 
@@ -343,6 +345,72 @@ static bool testWindowFocusOnFullscreenConflict() {
     return true;
 }
 
+// everything on socket2 until it's been quiet for a bit
+static std::string drainEvents(int fd) {
+    auto t = timeval{.tv_sec = 0, .tv_usec = 300000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &t, sizeof(t));
+
+    std::string events;
+    char        buf[4096];
+    ssize_t     len = 0;
+    while ((len = read(fd, buf, sizeof(buf))) > 0) {
+        events.append(buf, len);
+    }
+
+    return events;
+}
+
+static bool testTitleUpdateCoalescing() {
+    NLog::log("{}Testing misc:title_update_interval", Colors::GREEN);
+
+    OK(getFromSocket("/keyword misc:title_update_interval 500"));
+
+    const auto EVENTS_FD = connectToSocket(".socket2.sock");
+    if (EVENTS_FD < 0) {
+        NLog::log("{}Error: couldn't connect to socket2", Colors::RED);
+        return false;
+    }
+
+    // a burst of titles, then closing while the last ones are still being held back
+    if (!spawnKitty("title_burst", {"-e", "bash", "-c", R"(sleep 1; for i in $(seq 1 10); do printf '\e]2;burst%s\a' $i; sleep 0.02; done; exit)"}))
+        return false;
+
+    for (int i = 0; i < 50 && Tests::windowCount() > 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    EXPECT(Tests::windowCount(), 0);
+
+    // past the interval, a held back update would've fired by now
+    std::this_thread::sleep_for(std::chrono::milliseconds(700));
+
+    const auto EVENTS = drainEvents(EVENTS_FD);
+    close(EVENTS_FD);
+
+    const auto OPEN = EVENTS.find("openwindow>>");
+    if (OPEN == std::string::npos) {
+        NLog::log("{}Error: no openwindow event", Colors::RED);
+        ret = 1;
+        return false;
+    }
+
+    const auto ADDRESS = EVENTS.substr(OPEN + 12, EVENTS.find(',', OPEN) - OPEN - 12);
+    const auto TITLES  = Tests::countOccurrences(EVENTS, "windowtitlev2>>" + ADDRESS + ",burst");
+
+    // ten titles 20ms apart fit into one or two 500ms intervals
+    EXPECT(TITLES >= 1 && TITLES <= 2, true);
+
+    const auto CLOSE = EVENTS.find("closewindow>>" + ADDRESS);
+    EXPECT(CLOSE != std::string::npos, true);
+    if (CLOSE != std::string::npos) {
+        EXPECT_NOT_CONTAINS(EVENTS.substr(CLOSE), "windowtitle>>" + ADDRESS);
+        EXPECT_NOT_CONTAINS(EVENTS.substr(CLOSE), "windowtitlev2>>" + ADDRESS);
+    }
+
+    OK(getFromSocket("/keyword misc:title_update_interval 0"));
+
+    return true;
+}
+
 static bool test() {
     NLog::log("{}Testing windows", Colors::GREEN);
 
@@ -640,6 +708,26 @@ static bool test() {
     OK(getFromSocket("/reload"));
     Tests::killAllWindows();
 
+    // expressions are compiled when the rule is added, a broken one is a config error rather than a log line at map time
+    EXPECT_CONTAINS(getFromSocket("/keyword windowrule match:class expr_kitty, float yes, move 20+(monitor_w 10"), "invalid expression");
+
+    // move is evaluated after size, so window_w is the rule's size, and cursor_x is relative to the monitor
+    OK(getFromSocket("/dispatch movecursor 1000 600"));
+    OK(getFromSocket("/keyword windowrule match:class expr_kitty, float yes, size monitor_w*0.25 monitor_h*0.25, move cursor_x-(window_w*0.5) cursor_y-(window_h*0.5)"));
+
+    if (!spawnKitty("expr_kitty"))
+        return false;
+
+    {
+        auto str = getFromSocket("/activewindow");
+        EXPECT_CONTAINS(str, "floating: 1");
+        EXPECT_CONTAINS(str, "at: 760,465");
+        EXPECT_CONTAINS(str, "size: 480,270");
+    }
+
+    OK(getFromSocket("/reload"));
+    Tests::killAllWindows();
+
     OK(getFromSocket("/dispatch plugin:test:add_rule"));
     OK(getFromSocket("/reload"));
 
@@ -668,6 +756,7 @@ static bool test() {
     Tests::killAllWindows();
 
     testGroupRules();
+    testTitleUpdateCoalescing();
 
     NLog::log("{}Reloading config", Colors::YELLOW);
     OK(getFromSocket("/reload"));
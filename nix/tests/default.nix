@@ -11,6 +11,7 @@ in {
         jq
         kitty
         wl-clipboard
+        xclip
         xorg.xeyes
       ];
 
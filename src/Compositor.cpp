@@ -872,6 +872,9 @@ void CCompositor::removeWindowFromVectorSafe(PHLWINDOW pWindow) {
 
         std::erase_if(m_windows, [&](SP<CWindow>& el) { return el == pWindow; });
         std::erase_if(m_windowsFadingOut, [&](PHLWINDOWREF el) { return el.lock() == pWindow; });
+
+        if (pWindow->m_workspace)
+            pWindow->m_workspace->removeWindow(pWindow);
     }
 }
 
@@ -1231,6 +1234,9 @@ void CCompositor::changeWindowZOrder(PHLWINDOW pWindow, bool top) {
             }
         }
 
+        if (pw->m_workspace)
+            pw->m_workspace->moveWindowInZOrder(pw, top);
+
         if (pw->m_isMapped)
             g_pHyprRenderer->damageMonitor(pw->m_monitor.lock());
     };
@@ -1745,7 +1751,7 @@ void CCompositor::swapActiveWorkspaces(PHLMONITOR pMonitorA, PHLMONITOR pMonitor
     for (auto const& w : m_windows) {
         if (w->m_workspace == PWORKSPACEA) {
             if (w->m_pinned) {
-                w->m_workspace = PWORKSPACEB;
+                w->setWorkspace(PWORKSPACEB);
                 continue;
             }
 
@@ -1770,7 +1776,7 @@ void CCompositor::swapActiveWorkspaces(PHLMONITOR pMonitorA, PHLMONITOR pMonitor
     for (auto const& w : m_windows) {
         if (w->m_workspace == PWORKSPACEB) {
             if (w->m_pinned) {
-                w->m_workspace = PWORKSPACEA;
+                w->setWorkspace(PWORKSPACEA);
                 continue;
             }
 
@@ -1795,8 +1801,10 @@ void CCompositor::swapActiveWorkspaces(PHLMONITOR pMonitorA, PHLMONITOR pMonitor
     PWORKSPACEA->rememberPrevWorkspace(PWORKSPACEB);
     PWORKSPACEB->rememberPrevWorkspace(PWORKSPACEA);
 
-    g_pLayoutManager->getCurrentLayout()->recalculateMonitor(pMonitorA->m_id);
-    g_pLayoutManager->getCurrentLayout()->recalculateMonitor(pMonitorB->m_id);
+    // the focus fallback below looks for the window under the cursor
+    g_pLayoutManager->scheduleRecalc(pMonitorA->m_id);
+    g_pLayoutManager->scheduleRecalc(pMonitorB->m_id);
+    g_pLayoutManager->flushPendingRecalcs();
 
     g_pDesktopAnimationManager->setFullscreenFadeAnimation(
         PWORKSPACEB, PWORKSPACEB->m_hasFullscreenWindow ? CDesktopAnimationManager::ANIMATION_TYPE_IN : CDesktopAnimationManager::ANIMATION_TYPE_OUT);
@@ -1954,7 +1962,7 @@ void CCompositor::moveWorkspaceToMonitor(PHLWORKSPACE pWorkspace, PHLMONITOR pMo
     for (auto const& w : m_windows) {
         if (w->m_workspace == pWorkspace) {
             if (w->m_pinned) {
-                w->m_workspace = g_pCompositor->getWorkspaceByID(nextWorkspaceOnMonitorID);
+                w->setWorkspace(g_pCompositor->getWorkspaceByID(nextWorkspaceOnMonitorID));
                 continue;
             }
 
@@ -2002,7 +2010,9 @@ void CCompositor::moveWorkspaceToMonitor(PHLWORKSPACE pWorkspace, PHLMONITOR pMo
 
         pWorkspace->m_events.activeChanged.emit();
 
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(pMonitor->m_id);
+        // motion events below go to whatever is under the cursor now
+        g_pLayoutManager->scheduleRecalc(pMonitor->m_id);
+        g_pLayoutManager->flushPendingRecalcs();
 
         g_pDesktopAnimationManager->startAnimation(pWorkspace, CDesktopAnimationManager::ANIMATION_TYPE_IN, true, true);
         pWorkspace->m_visible = true;
@@ -2015,7 +2025,7 @@ void CCompositor::moveWorkspaceToMonitor(PHLWORKSPACE pWorkspace, PHLMONITOR pMo
 
     // finalize
     if (POLDMON) {
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(POLDMON->m_id);
+        g_pLayoutManager->scheduleRecalc(POLDMON->m_id);
         if (valid(POLDMON->m_activeWorkspace))
             g_pDesktopAnimationManager->setFullscreenFadeAnimation(POLDMON->m_activeWorkspace,
                                                                    POLDMON->m_activeWorkspace->m_hasFullscreenWindow ? CDesktopAnimationManager::ANIMATION_TYPE_IN :
@@ -2113,7 +2123,7 @@ void CCompositor::setWindowFullscreenState(const PHLWINDOW PWINDOW, SFullscreenS
         PWINDOW->m_ruleApplicator->propertiesChanged(Desktop::Rule::RULE_PROP_FULLSCREEN | Desktop::Rule::RULE_PROP_FULLSCREENSTATE_CLIENT |
                                                      Desktop::Rule::RULE_PROP_FULLSCREENSTATE_INTERNAL | Desktop::Rule::RULE_PROP_ON_WORKSPACE);
         PWINDOW->updateDecorationValues();
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(PWINDOW->monitorID());
+        g_pLayoutManager->scheduleRecalc(PWINDOW->monitorID());
         return;
     }
 
@@ -2130,7 +2140,9 @@ void CCompositor::setWindowFullscreenState(const PHLWINDOW PWINDOW, SFullscreenS
                                                  Desktop::Rule::RULE_PROP_FULLSCREENSTATE_INTERNAL | Desktop::Rule::RULE_PROP_ON_WORKSPACE);
 
     PWINDOW->updateDecorationValues();
-    g_pLayoutManager->getCurrentLayout()->recalculateMonitor(PWINDOW->monitorID());
+    // sizes are sent to the clients below
+    g_pLayoutManager->scheduleRecalc(PWINDOW->monitorID());
+    g_pLayoutManager->flushPendingRecalcs();
 
     // make all windows on the same workspace under the fullscreen window
     for (auto const& w : m_windows) {
@@ -2717,6 +2729,9 @@ void CCompositor::arrangeMonitors() {
 
     PROTO::xdgOutput->updateAllOutputs();
 
+    if (g_pHyprCtl)
+        g_pHyprCtl->m_statePage.scheduleUpdate();
+
 #ifndef NO_XWAYLAND
     CBox box = g_pCompositor->calculateX11WorkArea();
     if (!g_pXWayland || !g_pXWayland->m_wm)
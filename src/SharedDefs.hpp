@@ -64,3 +64,5 @@ using MONITORID   = int64_t;
 using WORKSPACEID = int64_t;
 
 using HOOK_CALLBACK_FN = std::function<void(void*, SCallbackInfo&, std::any)>;
+// for typed hook events, arg points to the event's argument (see HookSystemManager.hpp)
+using HOOK_TYPED_CALLBACK_FN = std::function<void(SCallbackInfo&, const void* arg)>;
@@ -1357,6 +1357,13 @@ inline static const std::vector<SConfigOptionDescription> CONFIG_OPTIONS = {
         .type        = CONFIG_OPTION_BOOL,
         .data        = SConfigOptionDescription::SBoolData{false},
     },
+    SConfigOptionDescription{
+        .value       = "misc:title_update_interval",
+        .description = "minimum time in ms between two title / class updates of a window reaching rules, IPC, protocols and the groupbar. Faster changes are coalesced "
+                       "into the latest one. 0 disables",
+        .type        = CONFIG_OPTION_INT,
+        .data        = SConfigOptionDescription::SRangeData{0, 0, 1000},
+    },
 
     /*
      * binds:
@@ -1477,6 +1484,18 @@ inline static const std::vector<SConfigOptionDescription> CONFIG_OPTIONS = {
         .type        = CONFIG_OPTION_BOOL,
         .data        = SConfigOptionDescription::SBoolData{false},
     },
+    SConfigOptionDescription{
+        .value       = "xwayland:lazy",
+        .description = "only start XWayland once an X11 client connects to DISPLAY. Requires a restart of XWayland to take effect.",
+        .type        = CONFIG_OPTION_BOOL,
+        .data        = SConfigOptionDescription::SBoolData{false},
+    },
+    SConfigOptionDescription{
+        .value       = "xwayland:lazy_idle_timeout",
+        .description = "with lazy, stop XWayland after this many seconds without any X11 windows, as long as no other X11 client is connected either. 0 keeps it running.",
+        .type        = CONFIG_OPTION_INT,
+        .data        = SConfigOptionDescription::SRangeData{0, 0, 3600},
+    },
 
     /*
      * opengl:
@@ -1512,6 +1531,12 @@ inline static const std::vector<SConfigOptionDescription> CONFIG_OPTIONS = {
         .type        = CONFIG_OPTION_BOOL,
         .data        = SConfigOptionDescription::SBoolData{true},
     },
+    SConfigOptionDescription{
+        .value       = "render:cull_occluded_windows",
+        .description = "Skip windows that are completely covered by opaque windows above them before building their render passes.",
+        .type        = CONFIG_OPTION_BOOL,
+        .data        = SConfigOptionDescription::SBoolData{true},
+    },
     SConfigOptionDescription{
         .value       = "render:ctm_animation",
         .description = "Whether to enable a fade animation for CTM changes (hyprsunset). 2 means 'auto' (Yes on everything but Nvidia).",
@@ -1561,6 +1586,24 @@ inline static const std::vector<SConfigOptionDescription> CONFIG_OPTIONS = {
         .type        = CONFIG_OPTION_CHOICE,
         .data        = SConfigOptionDescription::SChoiceData{0, "srgb,gamma22,gamma22force"},
     },
+    SConfigOptionDescription{
+        .value       = "render:cm_shader_variants",
+        .description = "Build color management shaders specialized for each transfer function combination, instead of using one shader that branches per pixel",
+        .type        = CONFIG_OPTION_BOOL,
+        .data        = SConfigOptionDescription::SBoolData{true},
+    },
+    SConfigOptionDescription{
+        .value       = "render:cm_lut",
+        .description = "Bake color conversions into 3D lookup textures in the background and use those instead of converting every pixel. Slightly less precise",
+        .type        = CONFIG_OPTION_BOOL,
+        .data        = SConfigOptionDescription::SBoolData{false},
+    },
+    SConfigOptionDescription{
+        .value       = "render:cm_lut_size",
+        .description = "Points per axis of the render:cm_lut lookup textures",
+        .type        = CONFIG_OPTION_INT,
+        .data        = SConfigOptionDescription::SRangeData{33, 2, 65},
+    },
 
     /*
      * cursor:
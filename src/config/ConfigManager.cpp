@@ -42,6 +42,8 @@
 
 #include "../managers/HookSystemManager.hpp"
 #include "../protocols/types/ContentType.hpp"
+#include "../helpers/JsonWriter.hpp"
+#include "../helpers/fs/FsUtils.hpp"
 #include <cstddef>
 #include <cstdint>
 #include <hyprutils/path/Path.hpp>
@@ -436,6 +438,11 @@ void CConfigManager::registerConfigVar(const char* name, Hyprlang::CUSTOMTYPE&&
     m_config->addConfigValue(name, std::move(val));
 }
 
+void CConfigManager::registerDeviceConfigVar(const char* name, const Hyprlang::CConfigValue& value) {
+    m_deviceConfigValues.emplace_back(name);
+    m_config->addSpecialConfigValue("device", name, value);
+}
+
 CConfigManager::CConfigManager() {
     const auto ERR = verifyConfigExists();
 
@@ -504,6 +511,7 @@ CConfigManager::CConfigManager() {
     registerConfigVar("misc:screencopy_force_8b", Hyprlang::INT{1});
     registerConfigVar("misc:disable_scale_notification", Hyprlang::INT{0});
     registerConfigVar("misc:size_limits_tiled", Hyprlang::INT{0});
+    registerConfigVar("misc:title_update_interval", Hyprlang::INT{0});
 
     registerConfigVar("group:insert_after_current", Hyprlang::INT{1});
     registerConfigVar("group:focus_removed_window", Hyprlang::INT{1});
@@ -716,6 +724,8 @@ CConfigManager::CConfigManager() {
     registerConfigVar("xwayland:use_nearest_neighbor", Hyprlang::INT{1});
     registerConfigVar("xwayland:force_zero_scaling", Hyprlang::INT{0});
     registerConfigVar("xwayland:create_abstract_socket", Hyprlang::INT{0});
+    registerConfigVar("xwayland:lazy", Hyprlang::INT{0});
+    registerConfigVar("xwayland:lazy_idle_timeout", Hyprlang::INT{0});
 
     registerConfigVar("opengl:nvidia_anti_flicker", Hyprlang::INT{1});
 
@@ -755,6 +765,7 @@ CConfigManager::CConfigManager() {
     registerConfigVar("render:direct_scanout", Hyprlang::INT{0});
     registerConfigVar("render:expand_undersized_textures", Hyprlang::INT{1});
     registerConfigVar("render:xp_mode", Hyprlang::INT{0});
+    registerConfigVar("render:cull_occluded_windows", Hyprlang::INT{1});
     registerConfigVar("render:ctm_animation", Hyprlang::INT{2});
     registerConfigVar("render:cm_fs_passthrough", Hyprlang::INT{2});
     registerConfigVar("render:cm_enabled", Hyprlang::INT{1});
@@ -763,6 +774,9 @@ CConfigManager::CConfigManager() {
     registerConfigVar("render:new_render_scheduling", Hyprlang::INT{0});
     registerConfigVar("render:non_shader_cm", Hyprlang::INT{3});
     registerConfigVar("render:cm_sdr_eotf", Hyprlang::INT{0});
+    registerConfigVar("render:cm_shader_variants", Hyprlang::INT{1});
+    registerConfigVar("render:cm_lut", Hyprlang::INT{0});
+    registerConfigVar("render:cm_lut_size", Hyprlang::INT{33});
 
     registerConfigVar("ecosystem:no_update_news", Hyprlang::INT{0});
     registerConfigVar("ecosystem:no_donation_nag", Hyprlang::INT{0});
@@ -772,48 +786,48 @@ CConfigManager::CConfigManager() {
 
     // devices
     m_config->addSpecialCategory("device", {"name"});
-    m_config->addSpecialConfigValue("device", "sensitivity", {0.F});
-    m_config->addSpecialConfigValue("device", "accel_profile", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "rotation", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "kb_file", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_layout", {"us"});
-    m_config->addSpecialConfigValue("device", "kb_variant", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_options", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_rules", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "kb_model", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "repeat_rate", Hyprlang::INT{25});
-    m_config->addSpecialConfigValue("device", "repeat_delay", Hyprlang::INT{600});
-    m_config->addSpecialConfigValue("device", "natural_scroll", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "tap_button_map", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "numlock_by_default", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "resolve_binds_by_sym", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "disable_while_typing", Hyprlang::INT{1});
-    m_config->addSpecialConfigValue("device", "clickfinger_behavior", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "middle_button_emulation", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "tap-to-click", Hyprlang::INT{1});
-    m_config->addSpecialConfigValue("device", "tap-and-drag", Hyprlang::INT{1});
-    m_config->addSpecialConfigValue("device", "drag_lock", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "left_handed", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "scroll_method", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "scroll_button", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "scroll_button_lock", Hyprlang::INT{0});
-    m_config->addSpecialConfigValue("device", "scroll_points", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "scroll_factor", Hyprlang::FLOAT{-1});
-    m_config->addSpecialConfigValue("device", "transform", Hyprlang::INT{-1});
-    m_config->addSpecialConfigValue("device", "output", {STRVAL_EMPTY});
-    m_config->addSpecialConfigValue("device", "enabled", Hyprlang::INT{1});                  // only for mice, touchpads, and touchdevices
-    m_config->addSpecialConfigValue("device", "region_position", Hyprlang::VEC2{0, 0});      // only for tablets
-    m_config->addSpecialConfigValue("device", "absolute_region_position", Hyprlang::INT{0}); // only for tablets
-    m_config->addSpecialConfigValue("device", "region_size", Hyprlang::VEC2{0, 0});          // only for tablets
-    m_config->addSpecialConfigValue("device", "relative_input", Hyprlang::INT{0});           // only for tablets
-    m_config->addSpecialConfigValue("device", "active_area_position", Hyprlang::VEC2{0, 0}); // only for tablets
-    m_config->addSpecialConfigValue("device", "active_area_size", Hyprlang::VEC2{0, 0});     // only for tablets
-    m_config->addSpecialConfigValue("device", "flip_x", Hyprlang::INT{0});                   // only for touchpads
-    m_config->addSpecialConfigValue("device", "flip_y", Hyprlang::INT{0});                   // only for touchpads
-    m_config->addSpecialConfigValue("device", "drag_3fg", Hyprlang::INT{0});                 // only for touchpads
-    m_config->addSpecialConfigValue("device", "keybinds", Hyprlang::INT{1});                 // enable/disable keybinds
-    m_config->addSpecialConfigValue("device", "share_states", Hyprlang::INT{0});             // only for virtualkeyboards
-    m_config->addSpecialConfigValue("device", "release_pressed_on_close", Hyprlang::INT{0}); // only for virtualkeyboards
+    registerDeviceConfigVar("sensitivity", {0.F});
+    registerDeviceConfigVar("accel_profile", {STRVAL_EMPTY});
+    registerDeviceConfigVar("rotation", Hyprlang::INT{0});
+    registerDeviceConfigVar("kb_file", {STRVAL_EMPTY});
+    registerDeviceConfigVar("kb_layout", {"us"});
+    registerDeviceConfigVar("kb_variant", {STRVAL_EMPTY});
+    registerDeviceConfigVar("kb_options", {STRVAL_EMPTY});
+    registerDeviceConfigVar("kb_rules", {STRVAL_EMPTY});
+    registerDeviceConfigVar("kb_model", {STRVAL_EMPTY});
+    registerDeviceConfigVar("repeat_rate", Hyprlang::INT{25});
+    registerDeviceConfigVar("repeat_delay", Hyprlang::INT{600});
+    registerDeviceConfigVar("natural_scroll", Hyprlang::INT{0});
+    registerDeviceConfigVar("tap_button_map", {STRVAL_EMPTY});
+    registerDeviceConfigVar("numlock_by_default", Hyprlang::INT{0});
+    registerDeviceConfigVar("resolve_binds_by_sym", Hyprlang::INT{0});
+    registerDeviceConfigVar("disable_while_typing", Hyprlang::INT{1});
+    registerDeviceConfigVar("clickfinger_behavior", Hyprlang::INT{0});
+    registerDeviceConfigVar("middle_button_emulation", Hyprlang::INT{0});
+    registerDeviceConfigVar("tap-to-click", Hyprlang::INT{1});
+    registerDeviceConfigVar("tap-and-drag", Hyprlang::INT{1});
+    registerDeviceConfigVar("drag_lock", Hyprlang::INT{0});
+    registerDeviceConfigVar("left_handed", Hyprlang::INT{0});
+    registerDeviceConfigVar("scroll_method", {STRVAL_EMPTY});
+    registerDeviceConfigVar("scroll_button", Hyprlang::INT{0});
+    registerDeviceConfigVar("scroll_button_lock", Hyprlang::INT{0});
+    registerDeviceConfigVar("scroll_points", {STRVAL_EMPTY});
+    registerDeviceConfigVar("scroll_factor", Hyprlang::FLOAT{-1});
+    registerDeviceConfigVar("transform", Hyprlang::INT{-1});
+    registerDeviceConfigVar("output", {STRVAL_EMPTY});
+    registerDeviceConfigVar("enabled", Hyprlang::INT{1});                  // only for mice, touchpads, and touchdevices
+    registerDeviceConfigVar("region_position", Hyprlang::VEC2{0, 0});      // only for tablets
+    registerDeviceConfigVar("absolute_region_position", Hyprlang::INT{0}); // only for tablets
+    registerDeviceConfigVar("region_size", Hyprlang::VEC2{0, 0});          // only for tablets
+    registerDeviceConfigVar("relative_input", Hyprlang::INT{0});           // only for tablets
+    registerDeviceConfigVar("active_area_position", Hyprlang::VEC2{0, 0}); // only for tablets
+    registerDeviceConfigVar("active_area_size", Hyprlang::VEC2{0, 0});     // only for tablets
+    registerDeviceConfigVar("flip_x", Hyprlang::INT{0});                   // only for touchpads
+    registerDeviceConfigVar("flip_y", Hyprlang::INT{0});                   // only for touchpads
+    registerDeviceConfigVar("drag_3fg", Hyprlang::INT{0});                 // only for touchpads
+    registerDeviceConfigVar("keybinds", Hyprlang::INT{1});                 // enable/disable keybinds
+    registerDeviceConfigVar("share_states", Hyprlang::INT{0});             // only for virtualkeyboards
+    registerDeviceConfigVar("release_pressed_on_close", Hyprlang::INT{0}); // only for virtualkeyboards
 
     m_config->addSpecialCategory("monitorv2", {.key = "output"});
     m_config->addSpecialConfigValue("monitorv2", "disabled", Hyprlang::INT{0});
@@ -1007,11 +1021,139 @@ static void clearHlVersionVars() {
     }
 }
 
+static void hashInto(uint64_t& seed, size_t v) {
+    seed ^= v + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+static void hashConfigValue(uint64_t& seed, Hyprlang::CConfigValue* value) {
+    if (!value) {
+        hashInto(seed, 0);
+        return;
+    }
+
+    const auto VAL = value->getValue();
+
+    hashInto(seed, value->m_bSetByUser);
+
+    if (typeid(Hyprlang::INT) == std::type_index(VAL.type()))
+        hashInto(seed, std::hash<Hyprlang::INT>{}(std::any_cast<Hyprlang::INT>(VAL)));
+    else if (typeid(Hyprlang::FLOAT) == std::type_index(VAL.type()))
+        hashInto(seed, std::hash<Hyprlang::FLOAT>{}(std::any_cast<Hyprlang::FLOAT>(VAL)));
+    else if (typeid(Hyprlang::STRING) == std::type_index(VAL.type()))
+        hashInto(seed, std::hash<std::string_view>{}(std::any_cast<Hyprlang::STRING>(VAL)));
+    else if (typeid(Hyprlang::VEC2) == std::type_index(VAL.type())) {
+        const auto V = std::any_cast<Hyprlang::VEC2>(VAL);
+        hashInto(seed, std::hash<float>{}(V.x));
+        hashInto(seed, std::hash<float>{}(V.y));
+    } else if (typeid(void*) == std::type_index(VAL.type()))
+        hashInto(seed, std::hash<std::string>{}(sc<ICustomConfigValueData*>(std::any_cast<void*>(VAL))->toString()));
+}
+
+static size_t hashFileContents(const std::string& path) {
+    const auto CONTENT = NFsUtils::readFileAsString(path);
+
+    // a missing file has to differ from an empty one
+    return CONTENT ? std::hash<std::string>{}(*CONTENT) : SIZE_MAX;
+}
+
+static std::vector<std::string> expandGlob(const std::string& pattern) {
+    std::vector<std::string> result;
+    glob_t                   buf = {};
+
+    if (glob(pattern.c_str(), GLOB_TILDE, nullptr, &buf) == 0) {
+        for (size_t i = 0; i < buf.gl_pathc; i++) {
+            result.emplace_back(buf.gl_pathv[i]);
+        }
+    }
+
+    globfree(&buf);
+    return result;
+}
+
+bool CConfigManager::configFilesChanged() {
+    if (m_configFileHashes.empty())
+        return true;
+
+    for (const auto& [path, hash] : m_configFileHashes) {
+        if (hashFileContents(path) != hash)
+            return true;
+    }
+
+    // files could've been added to or removed from a sourced directory
+    for (const auto& g : m_sourceGlobs) {
+        if (expandGlob(g.pattern) != g.matches)
+            return true;
+    }
+
+    return false;
+}
+
+uint64_t CConfigManager::inputConfigFingerprint() {
+    uint64_t fp = 0;
+
+    for (const auto& opt : CONFIG_OPTIONS) {
+        if (opt.value.starts_with("input:"))
+            hashConfigValue(fp, m_config->getConfigValuePtr(opt.value.c_str()));
+    }
+
+    for (const auto& dev : m_config->listKeysForSpecialCategory("device")) {
+        hashInto(fp, std::hash<std::string>{}(dev));
+
+        for (const auto& v : m_deviceConfigValues) {
+            hashConfigValue(fp, m_config->getSpecialConfigValuePtr("device", v, dev.c_str()));
+        }
+
+        const auto KBFILE = getDeviceString(dev, "kb_file");
+        if (!KBFILE.empty())
+            hashInto(fp, hashFileContents(absolutePath(KBFILE, getMainConfigPath())));
+    }
+
+    // the keymap file can change without the config changing
+    const auto KBFILE = std::string{std::any_cast<Hyprlang::STRING>(m_config->getConfigValue("input:kb_file"))};
+    if (!KBFILE.empty() && KBFILE != STRVAL_EMPTY)
+        hashInto(fp, hashFileContents(absolutePath(KBFILE, getMainConfigPath())));
+
+    return fp;
+}
+
+uint64_t CConfigManager::layoutConfigFingerprint() {
+    uint64_t fp = m_reloadFingerprints.workspaceRules;
+    hashInto(fp, m_reloadFingerprints.windowRules);
+
+    for (const auto& opt : CONFIG_OPTIONS) {
+        if (opt.value.starts_with("general:") || opt.value.starts_with("dwindle:") || opt.value.starts_with("master:") || opt.value.starts_with("group:") ||
+            opt.value.starts_with("decoration:"))
+            hashConfigValue(fp, m_config->getConfigValuePtr(opt.value.c_str()));
+    }
+
+    // the few layout inputs outside of those categories
+    for (const auto& v : {"misc:size_limits_tiled", "xwayland:force_zero_scaling"}) {
+        hashConfigValue(fp, m_config->getConfigValuePtr(v));
+    }
+
+    // plugin layouts and decorations read their own values
+    for (const auto& v : m_pluginVariables) {
+        hashConfigValue(fp, m_config->getConfigValuePtr(v.name.c_str()));
+    }
+
+    return fp;
+}
+
+void CConfigManager::reloadIfChanged() {
+    if (!m_dynamicKeywordsSet && !configFilesChanged()) {
+        Debug::log(LOG, "CConfigManager: config files unchanged, skipping reload");
+        return;
+    }
+
+    reload();
+}
+
 void CConfigManager::reload() {
     EMIT_HOOK_EVENT("preConfigReload", nullptr);
     setDefaultAnimationVars();
     resetHLConfig();
-    m_configCurrentPath = getMainConfigPath();
+    m_configCurrentPath  = getMainConfigPath();
+    m_dynamicKeywordsSet = false;
 
     exportHlVersionVars();
 
@@ -1109,6 +1251,12 @@ std::optional<std::string> CConfigManager::resetHLConfig() {
 
     const auto RET = verifyConfigExists();
 
+    m_configFileHashes.clear();
+    m_sourceGlobs.clear();
+    m_reloadFingerprints.workspaceRules = 0;
+    m_reloadFingerprints.windowRules    = 0;
+    m_configFileHashes[mainConfigPath]  = hashFileContents(mainConfigPath);
+
     reloadRuleConfigs();
 
     return RET;
@@ -1216,16 +1364,28 @@ std::optional<std::string> CConfigManager::addRuleFromConfigKey(const std::strin
 
     SP<Desktop::Rule::CWindowRule> rule = makeShared<Desktop::Rule::CWindowRule>(name);
 
+    hashInto(m_reloadFingerprints.windowRules, std::hash<std::string>{}(name));
+
     for (const auto& r : Desktop::Rule::allMatchPropStrings()) {
         auto VAL = m_config->getSpecialConfigValuePtr("windowrule", ("match:" + r).c_str(), name.c_str());
-        if (VAL && VAL->m_bSetByUser)
+        if (VAL && VAL->m_bSetByUser) {
+            hashInto(m_reloadFingerprints.windowRules, std::hash<std::string>{}(r));
+            hashConfigValue(m_reloadFingerprints.windowRules, VAL);
             rule->registerMatch(Desktop::Rule::matchPropFromString(r).value_or(Desktop::Rule::RULE_PROP_NONE), std::any_cast<Hyprlang::STRING>(VAL->getValue()));
+        }
     }
 
     for (const auto& e : Desktop::Rule::windowEffects()->allEffectStrings()) {
         auto VAL = m_config->getSpecialConfigValuePtr("windowrule", e.c_str(), name.c_str());
-        if (VAL && VAL->m_bSetByUser)
-            rule->addEffect(Desktop::Rule::windowEffects()->get(e).value_or(Desktop::Rule::WINDOW_RULE_EFFECT_NONE), std::any_cast<Hyprlang::STRING>(VAL->getValue()));
+        if (!VAL || !VAL->m_bSetByUser)
+            continue;
+
+        hashInto(m_reloadFingerprints.windowRules, std::hash<std::string>{}(e));
+        hashConfigValue(m_reloadFingerprints.windowRules, VAL);
+
+        const auto RES = rule->addEffect(Desktop::Rule::windowEffects()->get(e).value_or(Desktop::Rule::WINDOW_RULE_EFFECT_NONE), std::any_cast<Hyprlang::STRING>(VAL->getValue()));
+        if (RES)
+            return std::format("windowrule {}: {}", name, *RES);
     }
 
     Desktop::Rule::ruleEngine()->registerRule(std::move(rule));
@@ -1283,6 +1443,16 @@ Hyprlang::CParseResult CConfigManager::reloadRules() {
 void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
     updateWatcher();
 
+    // most reloads touch a single option, don't redo the expensive parts that didn't change
+    const auto INPUTFP       = inputConfigFingerprint();
+    const auto LAYOUTFP      = layoutConfigFingerprint();
+    const bool INPUTCHANGED  = !m_reloadFingerprints.valid || INPUTFP != m_reloadFingerprints.input;
+    const bool LAYOUTCHANGED = !m_reloadFingerprints.valid || LAYOUTFP != m_reloadFingerprints.layout;
+
+    m_reloadFingerprints.input  = INPUTFP;
+    m_reloadFingerprints.layout = LAYOUTFP;
+    m_reloadFingerprints.valid  = true;
+
     for (auto const& w : g_pCompositor->m_windows) {
         w->uncacheWindowDecos();
     }
@@ -1290,15 +1460,20 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
     static auto PZOOMFACTOR = CConfigValue<Hyprlang::FLOAT>("cursor:zoom_factor");
     for (auto const& m : g_pCompositor->m_monitors) {
         *(m->m_cursorZoom) = *PZOOMFACTOR;
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->m_id);
+
+        if (LAYOUTCHANGED)
+            g_pLayoutManager->scheduleRecalc(m->m_id);
     }
 
     // Update the keyboard layout to the cfg'd one if this is not the first launch
     if (!m_isFirstLaunch) {
-        g_pInputManager->setKeyboardLayout();
-        g_pInputManager->setPointerConfigs();
-        g_pInputManager->setTouchDeviceConfigs();
-        g_pInputManager->setTabletConfigs();
+        if (INPUTCHANGED) {
+            g_pInputManager->setKeyboardLayout();
+            g_pInputManager->setPointerConfigs();
+            g_pInputManager->setTouchDeviceConfigs();
+            g_pInputManager->setTabletConfigs();
+        } else
+            Debug::log(LOG, "CConfigManager: input config unchanged, not reapplying");
 
         g_pHyprOpenGL->m_reloadScreenShader = true;
     }
@@ -1410,7 +1585,7 @@ void CConfigManager::init() {
 
     g_pConfigWatcher->setOnChange([this](const CConfigWatcher::SConfigWatchEvent& e) {
         Debug::log(LOG, "CConfigManager: file {} modified, reloading", e.file);
-        reload();
+        reloadIfChanged();
     });
 
     const std::string CONFIGPATH = getMainConfigPath();
@@ -1422,10 +1597,14 @@ void CConfigManager::init() {
 std::string CConfigManager::parseKeyword(const std::string& COMMAND, const std::string& VALUE) {
     const auto RET = m_config->parseDynamic(COMMAND.c_str(), VALUE.c_str());
 
+    // the runtime state doesn't match the files anymore, the next reload has to reset and reapply everything
+    m_dynamicKeywordsSet       = true;
+    m_reloadFingerprints.valid = false;
+
     // invalidate layouts if they changed
     if (COMMAND == "monitor" || COMMAND.contains("gaps_") || COMMAND.starts_with("dwindle:") || COMMAND.starts_with("master:")) {
         for (auto const& m : g_pCompositor->m_monitors)
-            g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->m_id);
+            g_pLayoutManager->scheduleRecalc(m->m_id);
     }
 
     // Update window border colors
@@ -2543,6 +2722,8 @@ std::optional<std::string> CConfigManager::handleUnbind(const std::string& comma
 }
 
 std::optional<std::string> CConfigManager::handleWorkspaceRules(const std::string& command, const std::string& value) {
+    hashInto(m_reloadFingerprints.workspaceRules, std::hash<std::string>{}(value));
+
     // This can either be the monitor or the workspace identifier
     const auto FIRST_DELIM = value.find_first_of(',');
 
@@ -2682,12 +2863,19 @@ std::optional<std::string> CConfigManager::handleSource(const std::string& comma
                                                             }
                                                         }};
 
-    if (auto r = glob(absolutePath(rawpath, m_configCurrentPath).c_str(), GLOB_TILDE, nullptr, glob_buf.get()); r != 0) {
+    const auto PATTERN = absolutePath(rawpath, m_configCurrentPath);
+
+    if (auto r = glob(PATTERN.c_str(), GLOB_TILDE, nullptr, glob_buf.get()); r != 0) {
+        // still remember it, so that a file showing up later triggers a reload
+        m_sourceGlobs.emplace_back(SSourceGlob{.pattern = PATTERN});
+
         std::string err = std::format("source= globbing error: {}", r == GLOB_NOMATCH ? "found no match" : GLOB_ABORTED ? "read error" : "out of memory");
         Debug::log(ERR, "{}", err);
         return err;
     }
 
+    m_sourceGlobs.emplace_back(SSourceGlob{.pattern = PATTERN, .matches = {glob_buf->gl_pathv, glob_buf->gl_pathv + glob_buf->gl_pathc}});
+
     std::string errorsFromParsing;
 
     for (size_t i = 0; i < glob_buf->gl_pathc; i++) {
@@ -2703,6 +2891,7 @@ std::optional<std::string> CConfigManager::handleSource(const std::string& comma
 
         if (std::filesystem::is_regular_file(file_status)) {
             m_configPaths.emplace_back(value);
+            m_configFileHashes[value]    = hashFileContents(value);
             auto configCurrentPathBackup = m_configCurrentPath;
             m_configCurrentPath          = value;
             const auto THISRESULT        = m_config->parseFile(value.c_str());
@@ -2863,6 +3052,8 @@ std::optional<std::string> CConfigManager::handleGesture(const std::string& comm
 }
 
 std::optional<std::string> CConfigManager::handleWindowrule(const std::string& command, const std::string& value) {
+    hashInto(m_reloadFingerprints.windowRules, std::hash<std::string>{}(value));
+
     CVarList2                      data((std::string(value)));
 
     SP<Desktop::Rule::CWindowRule> rule = makeShared<Desktop::Rule::CWindowRule>();
@@ -2889,7 +3080,8 @@ std::optional<std::string> CConfigManager::handleWindowrule(const std::string& c
             const auto EFFECT = Desktop::Rule::windowEffects()->get(FIRST);
             if (!EFFECT.has_value())
                 return std::format("invalid effect {}", el);
-            rule->addEffect(*EFFECT, std::string{el.substr(spacePos + 1)});
+            if (const auto RES = rule->addEffect(*EFFECT, std::string{el.substr(spacePos + 1)}); RES)
+                return RES;
         } else
             return std::format("invalid field type {}", FIRST);
     }
@@ -2963,6 +3155,12 @@ bool CConfigManager::shouldUseSoftwareCursors(PHLMONITOR pMonitor) {
 }
 
 std::string SConfigOptionDescription::jsonify() const {
+    std::string json;
+    jsonifyInto(json);
+    return json;
+}
+
+void SConfigOptionDescription::jsonifyInto(std::string& out) const {
     auto parseData = [this]() -> std::string {
         return std::visit(
             [this](auto&& val) {
@@ -3051,7 +3249,7 @@ std::string SConfigOptionDescription::jsonify() const {
             data);
     };
 
-    std::string json = std::format(R"#({{
+    std::format_to(std::back_inserter(out), R"#({{
     "value": "{}",
     "description": "{}",
     "type": {},
@@ -3060,9 +3258,7 @@ std::string SConfigOptionDescription::jsonify() const {
         {}
     }}
 }})#",
-                                   value, escapeJSONStrings(description), sc<uint16_t>(type), sc<uint32_t>(flags), parseData());
-
-    return json;
+                   value, SJsonEscaped{description}, sc<uint16_t>(type), sc<uint32_t>(flags), parseData());
 }
 
 void CConfigManager::ensurePersistentWorkspacesPresent() {
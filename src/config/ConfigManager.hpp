@@ -66,6 +66,11 @@ struct SPluginVariable {
     std::string name   = "";
 };
 
+struct SSourceGlob {
+    std::string              pattern;
+    std::vector<std::string> matches;
+};
+
 enum eConfigOptionType : uint8_t {
     CONFIG_OPTION_BOOL         = 0,
     CONFIG_OPTION_INT          = 1, /* e.g. 0/1/2*/
@@ -125,6 +130,7 @@ struct SConfigOptionDescription {
     uint32_t          flags      = 0; // eConfigOptionFlags
 
     std::string       jsonify() const;
+    void              jsonifyInto(std::string& out) const;
 
     //
     std::variant<SBoolData, SRangeData, SFloatData, SStringData, SColorData, SChoiceData, SGradientData, SVectorData> data;
@@ -198,6 +204,8 @@ class CConfigManager {
 
     void                                                            init();
     void                                                            reload();
+    // reloads only if any of the config files changed, or runtime keywords need to be reset
+    void                                                            reloadIfChanged();
     std::string                                                     verify();
 
     int                                                             getDeviceInt(const std::string&, const std::string&, const std::string& fallback = "");
@@ -322,8 +330,28 @@ class CConfigManager {
 
     uint32_t                                         m_configValueNumber = 0;
 
+    std::vector<const char*>                         m_deviceConfigValues;
+
+    // content hashes of the files that went into the last parse, and what the source= globs expanded to
+    std::unordered_map<std::string, size_t>          m_configFileHashes;
+    std::vector<SSourceGlob>                         m_sourceGlobs;
+    bool                                             m_dynamicKeywordsSet = false;
+
+    // fingerprints of everything the expensive post-reload steps depend on, they are skipped when these don't change
+    struct {
+        uint64_t input          = 0;
+        uint64_t layout         = 0;
+        uint64_t workspaceRules = 0; // accumulated from workspace= keywords while parsing
+        uint64_t windowRules    = 0; // same for windowrule= keywords and windowrule blocks, rules change sizes and tiling
+        bool     valid          = false;
+    } m_reloadFingerprints;
+
     // internal methods
+    void                                      registerDeviceConfigVar(const char* name, const Hyprlang::CConfigValue& value);
     void                                      setDefaultAnimationVars();
+    bool                                      configFilesChanged();
+    uint64_t                                  inputConfigFingerprint();
+    uint64_t                                  layoutConfigFingerprint();
     std::optional<std::string>                resetHLConfig();
     std::optional<std::string>                generateConfig(std::string configPath);
     std::optional<std::string>                verifyConfigExists();
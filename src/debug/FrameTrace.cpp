@@ -0,0 +1,137 @@
+#include "FrameTrace.hpp"
+#include "Log.hpp"
+#include "../helpers/JsonWriter.hpp"
+#include "../helpers/memory/Memory.hpp"
+
+#include <array>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+namespace {
+    // each slot is a tiny seqlock: seq is odd while a writer is in it, and 2 * (index + 1) once it's done,
+    // so the reader can tell torn and overwritten slots apart from good ones without locking the writers out.
+    struct SSlot {
+        std::atomic<uint64_t>    seq   = 0;
+        std::atomic<const char*> name  = nullptr;
+        std::atomic<uint64_t>    begin = 0;
+        std::atomic<uint64_t>    end   = 0;
+        std::atomic<uint32_t>    tid   = 0;
+    };
+
+    constexpr size_t                RING_SIZE = 1 << 16; // a few seconds worth of frames with everything instrumented
+
+    std::array<SSlot, RING_SIZE>    ring;
+    std::atomic<uint64_t>           head         = 0;
+    uint64_t                        sessionStart = 0;
+
+    thread_local constinit uint32_t threadID = 0;
+}
+
+uint64_t FrameTrace::now() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return sc<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+void FrameTrace::record(const char* name, uint64_t begin, uint64_t end) {
+    if (!threadID)
+        threadID = gettid();
+
+    const auto IDX  = head.fetch_add(1, std::memory_order_relaxed);
+    auto&      slot = ring[IDX % RING_SIZE];
+
+    slot.seq.store(IDX * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(begin, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    slot.tid.store(threadID, std::memory_order_relaxed);
+
+    slot.seq.store(IDX * 2 + 2, std::memory_order_release);
+}
+
+void FrameTrace::start() {
+    if (m_active.load())
+        return;
+
+    sessionStart = head.load();
+    m_active.store(true);
+
+    Debug::log(LOG, "FrameTrace: recording started");
+}
+
+void FrameTrace::stop() {
+    if (!m_active.load())
+        return;
+
+    m_active.store(false);
+
+    Debug::log(LOG, "FrameTrace: recording stopped, {} spans recorded", head.load() - sessionStart);
+}
+
+std::expected<size_t, std::string> FrameTrace::dump(const std::string& path) {
+    std::ofstream ofs(path, std::ios::trunc);
+    if (!ofs.good())
+        return std::unexpected(std::format("can't open {} for writing", path));
+
+    const auto  PID  = getpid();
+    const auto  HEAD = head.load(std::memory_order_acquire);
+    const auto  LOW  = std::max(sessionStart, HEAD > RING_SIZE ? HEAD - RING_SIZE : 0);
+
+    std::string buffer;
+    auto        out     = std::back_inserter(buffer);
+    size_t      written = 0;
+
+    // droppedSpans isn't part of the trace format, viewers ignore it. It's there so tools can tell a wrapped ring from a quiet one
+    std::format_to(out, R"({{"displayTimeUnit":"ms","droppedSpans":{1},"traceEvents":[
+{{"name":"process_name","ph":"M","pid":{0},"tid":{0},"args":{{"name":"Hyprland"}}}},
+{{"name":"thread_name","ph":"M","pid":{0},"tid":{0},"args":{{"name":"main"}}}})",
+                   PID, LOW - sessionStart);
+
+    for (uint64_t i = LOW; i < HEAD; ++i) {
+        const auto& SLOT = ring[i % RING_SIZE];
+
+        const auto  SEQ = SLOT.seq.load(std::memory_order_acquire);
+        if (SEQ != i * 2 + 2)
+            continue; // still being written or overwritten already
+
+        const auto NAME  = SLOT.name.load(std::memory_order_relaxed);
+        const auto BEGIN = SLOT.begin.load(std::memory_order_relaxed);
+        const auto END   = SLOT.end.load(std::memory_order_relaxed);
+        const auto TID   = SLOT.tid.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (SLOT.seq.load(std::memory_order_relaxed) != SEQ || !NAME)
+            continue;
+
+        // chrome wants microseconds
+        if (BEGIN == END)
+            std::format_to(out, ",\n{{\"name\":\"{}\",\"ph\":\"i\",\"s\":\"t\",\"ts\":{:.3f},\"pid\":{},\"tid\":{}}}", SJsonEscaped{NAME}, BEGIN / 1000.0, PID, TID);
+        else
+            std::format_to(out, ",\n{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":{},\"tid\":{}}}", SJsonEscaped{NAME}, BEGIN / 1000.0, (END - BEGIN) / 1000.0,
+                           PID, TID);
+
+        written++;
+
+        if (buffer.size() > 1024 * 1024) {
+            ofs << buffer;
+            buffer.clear();
+        }
+    }
+
+    buffer += "\n]}\n";
+    ofs << buffer;
+
+    if (!ofs.good())
+        return std::unexpected(std::format("failed writing to {}", path));
+
+    if (LOW > sessionStart)
+        Debug::log(WARN, "FrameTrace: ring wrapped, the oldest {} spans of this session were overwritten", LOW - sessionStart);
+
+    Debug::log(LOG, "FrameTrace: dumped {} spans to {}", written, path);
+
+    return written;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <expected>
+#include <string>
+
+/*
+    Always compiled, runtime toggled frame timeline (hyprctl trace start|stop|dump).
+
+    Spans go into a fixed ring that wraps around once full, recording one is two clock reads and a
+    handful of relaxed stores, and never blocks. While stopped, a scope costs one relaxed load.
+    Dumps are Chrome trace JSON, which chrome://tracing and ui.perfetto.dev both open.
+
+    Span names are stored as pointers, so they have to outlive the trace (literals, passName()).
+*/
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+namespace FrameTrace {
+    inline std::atomic<bool>           m_active = false;
+
+    void                               start();
+    void                               stop();
+    // writes everything still in the ring since the last start, and how many spans the ring lost to wrapping. Returns the amount of spans written.
+    std::expected<size_t, std::string> dump(const std::string& path);
+
+    uint64_t                           now();
+    void                               record(const char* name, uint64_t begin, uint64_t end);
+
+    inline void                        instant(const char* name) {
+        if (m_active.load(std::memory_order_relaxed)) {
+            const auto NOW = now();
+            record(name, NOW, NOW);
+        }
+    }
+
+    class CScope {
+      public:
+        CScope(const char* name) : m_name(name) {
+            if (m_active.load(std::memory_order_relaxed))
+                m_begin = now();
+        }
+
+        ~CScope() {
+            // begin 0 means tracing was off when the scope was entered
+            if (m_begin)
+                record(m_name, m_begin, now());
+        }
+
+        CScope(const CScope&)            = delete;
+        CScope& operator=(const CScope&) = delete;
+
+      private:
+        const char* m_name  = nullptr;
+        uint64_t    m_begin = 0;
+    };
+}
+
+#define TRACE_SCOPE_CONCAT_(a, b) a##b
+#define TRACE_SCOPE_CONCAT(a, b)  TRACE_SCOPE_CONCAT_(a, b)
+#define TRACE_SCOPE(name)         FrameTrace::CScope TRACE_SCOPE_CONCAT(traceScope, __LINE__)(name)
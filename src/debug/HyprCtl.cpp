@@ -1,4 +1,5 @@
 #include "HyprCtl.hpp"
+#include "HyprCtlProtocol.hpp"
 #include "helpers/Monitor.hpp"
 
 #include <algorithm>
@@ -15,6 +16,7 @@
 #include <sys/utsname.h>
 #include <sys/un.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/poll.h>
 #include <filesystem>
 #include <ranges>
@@ -41,8 +43,10 @@ using namespace Hyprutils::OS;
 #include "../devices/Tablet.hpp"
 #include "../protocols/GlobalShortcuts.hpp"
 #include "debug/RollingLogFollow.hpp"
+#include "debug/FrameTrace.hpp"
 #include "config/ConfigManager.hpp"
 #include "helpers/MiscFunctions.hpp"
+#include "../helpers/JsonWriter.hpp"
 #include "../desktop/LayerSurface.hpp"
 #include "../desktop/rule/Engine.hpp"
 #include "../desktop/state/FocusState.hpp"
@@ -52,6 +56,7 @@ using namespace Hyprutils::OS;
 #include "../managers/input/InputManager.hpp"
 #include "../managers/XWaylandManager.hpp"
 #include "../managers/LayoutManager.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
 #include "../plugins/PluginSystem.hpp"
 #include "../managers/animation/AnimationManager.hpp"
 #include "../debug/HyprNotificationOverlay.hpp"
@@ -102,9 +107,9 @@ static std::string availableModesForOutput(PHLMONITOR pMonitor, eHyprCtlOutputFo
 
     for (auto const& m : pMonitor->m_output->modes) {
         if (format == FORMAT_NORMAL)
-            result += std::format("{}x{}@{:.2f}Hz ", m->pixelSize.x, m->pixelSize.y, m->refreshRate / 1000.0);
+            std::format_to(std::back_inserter(result), "{}x{}@{:.2f}Hz ", m->pixelSize.x, m->pixelSize.y, m->refreshRate / 1000.0);
         else
-            result += std::format("\"{}x{}@{:.2f}Hz\",", m->pixelSize.x, m->pixelSize.y, m->refreshRate / 1000.0);
+            std::format_to(std::back_inserter(result), "\"{}x{}@{:.2f}Hz\",", m->pixelSize.x, m->pixelSize.y, m->refreshRate / 1000.0);
     }
 
     trimTrailingComma(result);
@@ -200,12 +205,17 @@ std::string CHyprCtl::getTearingBlockedReason(Hyprutils::Memory::CSharedPointer<
 
 std::string CHyprCtl::getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format) {
     std::string result;
+    appendMonitorData(result, m, format);
+    return result;
+}
+
+void CHyprCtl::appendMonitorData(std::string& out, Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format) {
     if (!m->m_output || m->m_id == -1)
-        return "";
+        return;
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
 
-        result += std::format(
+        std::format_to(std::back_inserter(out),
             R"#({{
     "id": {},
     "name": "{}",
@@ -251,11 +261,11 @@ std::string CHyprCtl::getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor>
     "sdrMaxLuminance": {}
 }},)#",
 
-            m->m_id, escapeJSONStrings(m->m_name), escapeJSONStrings(m->m_shortDescription), escapeJSONStrings(m->m_output->make), escapeJSONStrings(m->m_output->model),
-            escapeJSONStrings(m->m_output->serial), sc<int>(m->m_pixelSize.x), sc<int>(m->m_pixelSize.y), sc<int>(m->m_output->physicalSize.x),
+            m->m_id, SJsonEscaped{m->m_name}, SJsonEscaped{m->m_shortDescription}, SJsonEscaped{m->m_output->make}, SJsonEscaped{m->m_output->model},
+            SJsonEscaped{m->m_output->serial}, sc<int>(m->m_pixelSize.x), sc<int>(m->m_pixelSize.y), sc<int>(m->m_output->physicalSize.x),
             sc<int>(m->m_output->physicalSize.y), m->m_refreshRate, sc<int>(m->m_position.x), sc<int>(m->m_position.y), m->activeWorkspaceID(),
-            (!m->m_activeWorkspace ? "" : escapeJSONStrings(m->m_activeWorkspace->m_name)), m->activeSpecialWorkspaceID(),
-            escapeJSONStrings(m->m_activeSpecialWorkspace ? m->m_activeSpecialWorkspace->m_name : ""), sc<int>(m->m_reservedTopLeft.x), sc<int>(m->m_reservedTopLeft.y),
+            SJsonEscaped{!m->m_activeWorkspace ? "" : m->m_activeWorkspace->m_name}, m->activeSpecialWorkspaceID(),
+            SJsonEscaped{m->m_activeSpecialWorkspace ? m->m_activeSpecialWorkspace->m_name : ""}, sc<int>(m->m_reservedTopLeft.x), sc<int>(m->m_reservedTopLeft.y),
             sc<int>(m->m_reservedBottomRight.x), sc<int>(m->m_reservedBottomRight.y), m->m_scale, sc<int>(m->m_transform),
             (m == Desktop::focusState()->monitor() ? "true" : "false"), (m->m_dpmsStatus ? "true" : "false"), (m->m_output->state->state().adaptiveSync ? "true" : "false"),
             rc<uint64_t>(m->m_solitaryClient.get()), getSolitaryBlockedReason(m, format), (m->m_tearingState.activelyTearing ? "true" : "false"),
@@ -264,7 +274,7 @@ std::string CHyprCtl::getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor>
             (NCMType::toString(m->m_cmType)), (m->m_sdrBrightness), (m->m_sdrSaturation), (m->m_sdrMinLuminance), (m->m_sdrMaxLuminance));
 
     } else {
-        result += std::format(
+        std::format_to(std::back_inserter(out),
             "Monitor {} (ID {}):\n\t{}x{}@{:.5f} at {}x{}\n\tdescription: {}\n\tmake: {}\n\tmodel: {}\n\tphysical size (mm): {}x{}\n\tserial: {}\n\tactive workspace: {} ({})\n\t"
             "special workspace: {} ({})\n\treserved: {} {} {} {}\n\tscale: {:.2f}\n\ttransform: {}\n\tfocused: {}\n\t"
             "dpmsStatus: {}\n\tvrr: {}\n\tsolitary: {:x}\n\tsolitaryBlockedBy: {}\n\tactivelyTearing: {}\n\ttearingBlockedBy: {}\n\tdirectScanoutTo: "
@@ -281,8 +291,6 @@ std::string CHyprCtl::getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor>
             m->m_mirrorOf ? std::format("{}", m->m_mirrorOf->m_id) : "none", availableModesForOutput(m, format), (NCMType::toString(m->m_cmType)), (m->m_sdrBrightness),
             (m->m_sdrSaturation), (m->m_sdrMinLuminance), (m->m_sdrMaxLuminance));
     }
-
-    return result;
 }
 
 static std::string monitorsRequest(eHyprCtlOutputFormat format, std::string request) {
@@ -295,12 +303,12 @@ static std::string monitorsRequest(eHyprCtlOutputFormat format, std::string requ
     if (vars.size() == 2 && vars[1] == "all")
         allMonitors = true;
 
-    std::string result = "";
+    auto result = g_pHyprCtl->acquireBuffer();
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "[";
 
         for (auto const& m : allMonitors ? g_pCompositor->m_realMonitors : g_pCompositor->m_monitors) {
-            result += CHyprCtl::getMonitorData(m, format);
+            CHyprCtl::appendMonitorData(result, m, format);
         }
 
         trimTrailingComma(result);
@@ -311,7 +319,7 @@ static std::string monitorsRequest(eHyprCtlOutputFormat format, std::string requ
             if (!m->m_output || m->m_id == -1)
                 continue;
 
-            result += CHyprCtl::getMonitorData(m, format);
+            CHyprCtl::appendMonitorData(result, m, format);
         }
     }
 
@@ -353,6 +361,12 @@ static std::string getGroupedData(PHLWINDOW w, eHyprCtlOutputFormat format) {
 }
 
 std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
+    std::string result;
+    appendWindowData(result, w, format);
+    return result;
+}
+
+void CHyprCtl::appendWindowData(std::string& out, PHLWINDOW w, eHyprCtlOutputFormat format) {
     auto getFocusHistoryID = [](PHLWINDOW wnd) -> int {
         for (size_t i = 0; i < Desktop::focusState()->windowHistory().size(); ++i) {
             if (Desktop::focusState()->windowHistory()[i].lock() == wnd)
@@ -362,7 +376,7 @@ std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
     };
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        return std::format(
+        std::format_to(std::back_inserter(out),
             R"#({{
     "address": "0x{:x}",
     "mapped": {},
@@ -392,34 +406,38 @@ std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
     "inhibitingIdle": {},
     "xdgTag": "{}",
     "xdgDescription": "{}",
-    "contentType": "{}"
+    "contentType": "{}",
+    "metaUpdates": {{
+        "received": {},
+        "delivered": {}
+    }}
 }},)#",
             rc<uintptr_t>(w.get()), (w->m_isMapped ? "true" : "false"), (w->isHidden() ? "true" : "false"), sc<int>(w->m_realPosition->goal().x),
             sc<int>(w->m_realPosition->goal().y), sc<int>(w->m_realSize->goal().x), sc<int>(w->m_realSize->goal().y), w->m_workspace ? w->workspaceID() : WORKSPACE_INVALID,
-            escapeJSONStrings(!w->m_workspace ? "" : w->m_workspace->m_name), (sc<int>(w->m_isFloating) == 1 ? "true" : "false"), (w->m_isPseudotiled ? "true" : "false"),
-            w->monitorID(), escapeJSONStrings(w->m_class), escapeJSONStrings(w->m_title), escapeJSONStrings(w->m_initialClass), escapeJSONStrings(w->m_initialTitle), w->getPID(),
+            SJsonEscaped{!w->m_workspace ? "" : w->m_workspace->m_name}, (sc<int>(w->m_isFloating) == 1 ? "true" : "false"), (w->m_isPseudotiled ? "true" : "false"),
+            w->monitorID(), SJsonEscaped{w->m_class}, SJsonEscaped{w->m_title}, SJsonEscaped{w->m_initialClass}, SJsonEscaped{w->m_initialTitle}, w->getPID(),
             (sc<int>(w->m_isX11) == 1 ? "true" : "false"), (w->m_pinned ? "true" : "false"), sc<uint8_t>(w->m_fullscreenState.internal), sc<uint8_t>(w->m_fullscreenState.client),
             getGroupedData(w, format), getTagsData(w, format), rc<uintptr_t>(w->m_swallowed.get()), getFocusHistoryID(w),
-            (g_pInputManager->isWindowInhibiting(w, false) ? "true" : "false"), escapeJSONStrings(w->xdgTag().value_or("")), escapeJSONStrings(w->xdgDescription().value_or("")),
-            escapeJSONStrings(NContentType::toString(w->getContentType())));
+            (g_pInputManager->isWindowInhibiting(w, false) ? "true" : "false"), SJsonEscaped{w->xdgTag().value_or("")}, SJsonEscaped{w->xdgDescription().value_or("")},
+            SJsonEscaped{NContentType::toString(w->getContentType())}, w->m_metaUpdates.received, w->m_metaUpdates.delivered);
     } else {
-        return std::format(
+        std::format_to(std::back_inserter(out),
             "Window {:x} -> {}:\n\tmapped: {}\n\thidden: {}\n\tat: {},{}\n\tsize: {},{}\n\tworkspace: {} ({})\n\tfloating: {}\n\tpseudo: {}\n\tmonitor: {}\n\tclass: {}\n\ttitle: "
             "{}\n\tinitialClass: {}\n\tinitialTitle: {}\n\tpid: "
             "{}\n\txwayland: {}\n\tpinned: "
             "{}\n\tfullscreen: {}\n\tfullscreenClient: {}\n\tgrouped: {}\n\ttags: {}\n\tswallowing: {:x}\n\tfocusHistoryID: {}\n\tinhibitingIdle: {}\n\txdgTag: "
-            "{}\n\txdgDescription: {}\n\tcontentType: {}\n\n",
+            "{}\n\txdgDescription: {}\n\tcontentType: {}\n\tmetaUpdates: {} received, {} delivered\n\n",
             rc<uintptr_t>(w.get()), w->m_title, sc<int>(w->m_isMapped), sc<int>(w->isHidden()), sc<int>(w->m_realPosition->goal().x), sc<int>(w->m_realPosition->goal().y),
             sc<int>(w->m_realSize->goal().x), sc<int>(w->m_realSize->goal().y), w->m_workspace ? w->workspaceID() : WORKSPACE_INVALID,
             (!w->m_workspace ? "" : w->m_workspace->m_name), sc<int>(w->m_isFloating), sc<int>(w->m_isPseudotiled), w->monitorID(), w->m_class, w->m_title, w->m_initialClass,
             w->m_initialTitle, w->getPID(), sc<int>(w->m_isX11), sc<int>(w->m_pinned), sc<uint8_t>(w->m_fullscreenState.internal), sc<uint8_t>(w->m_fullscreenState.client),
             getGroupedData(w, format), getTagsData(w, format), rc<uintptr_t>(w->m_swallowed.get()), getFocusHistoryID(w), sc<int>(g_pInputManager->isWindowInhibiting(w, false)),
-            w->xdgTag().value_or(""), w->xdgDescription().value_or(""), NContentType::toString(w->getContentType()));
+            w->xdgTag().value_or(""), w->xdgDescription().value_or(""), NContentType::toString(w->getContentType()), w->m_metaUpdates.received, w->m_metaUpdates.delivered);
     }
 }
 
 static std::string clientsRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string result = "";
+    auto result = g_pHyprCtl->acquireBuffer();
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "[";
 
@@ -427,7 +445,7 @@ static std::string clientsRequest(eHyprCtlOutputFormat format, std::string reque
             if (!w->m_isMapped && !g_pHyprCtl->m_currentRequestParams.all)
                 continue;
 
-            result += CHyprCtl::getWindowData(w, format);
+            CHyprCtl::appendWindowData(result, w, format);
         }
 
         trimTrailingComma(result);
@@ -438,7 +456,7 @@ static std::string clientsRequest(eHyprCtlOutputFormat format, std::string reque
             if (!w->m_isMapped && !g_pHyprCtl->m_currentRequestParams.all)
                 continue;
 
-            result += CHyprCtl::getWindowData(w, format);
+            CHyprCtl::appendWindowData(result, w, format);
         }
 
         if (result.empty())
@@ -448,10 +466,16 @@ static std::string clientsRequest(eHyprCtlOutputFormat format, std::string reque
 }
 
 std::string CHyprCtl::getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat format) {
+    std::string result;
+    appendWorkspaceData(result, w, format);
+    return result;
+}
+
+void CHyprCtl::appendWorkspaceData(std::string& out, PHLWORKSPACE w, eHyprCtlOutputFormat format) {
     const auto PLASTW   = w->getLastFocusedWindow();
     const auto PMONITOR = w->m_monitor.lock();
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        return std::format(R"#({{
+        std::format_to(std::back_inserter(out), R"#({{
     "id": {},
     "name": "{}",
     "monitor": "{}",
@@ -462,11 +486,11 @@ std::string CHyprCtl::getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat form
     "lastwindowtitle": "{}",
     "ispersistent": {}
 }})#",
-                           w->m_id, escapeJSONStrings(w->m_name), escapeJSONStrings(PMONITOR ? PMONITOR->m_name : "?"),
-                           escapeJSONStrings(PMONITOR ? std::to_string(PMONITOR->m_id) : "null"), w->getWindows(), w->m_hasFullscreenWindow ? "true" : "false",
-                           rc<uintptr_t>(PLASTW.get()), PLASTW ? escapeJSONStrings(PLASTW->m_title) : "", w->isPersistent() ? "true" : "false");
+                           w->m_id, SJsonEscaped{w->m_name}, SJsonEscaped{PMONITOR ? PMONITOR->m_name : "?"},
+                           SJsonEscaped{PMONITOR ? std::to_string(PMONITOR->m_id) : "null"}, w->getWindows(), w->m_hasFullscreenWindow ? "true" : "false",
+                           rc<uintptr_t>(PLASTW.get()), SJsonEscaped{PLASTW ? PLASTW->m_title : ""}, w->isPersistent() ? "true" : "false");
     } else {
-        return std::format(
+        std::format_to(std::back_inserter(out),
             "workspace ID {} ({}) on monitor {}:\n\tmonitorID: {}\n\twindows: {}\n\thasfullscreen: {}\n\tlastwindow: 0x{:x}\n\tlastwindowtitle: {}\n\tispersistent: {}\n\n",
             w->m_id, w->m_name, PMONITOR ? PMONITOR->m_name : "?", PMONITOR ? std::to_string(PMONITOR->m_id) : "null", w->getWindows(), sc<int>(w->m_hasFullscreenWindow),
             rc<uintptr_t>(PLASTW.get()), PLASTW ? PLASTW->m_title : "", sc<int>(w->isPersistent()));
@@ -476,7 +500,7 @@ std::string CHyprCtl::getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat form
 static std::string getWorkspaceRuleData(const SWorkspaceRule& r, eHyprCtlOutputFormat format) {
     const auto boolToString = [](const bool b) -> std::string { return b ? "true" : "false"; };
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        const std::string monitor     = r.monitor.empty() ? "" : std::format(",\n    \"monitor\": \"{}\"", escapeJSONStrings(r.monitor));
+        const std::string monitor     = r.monitor.empty() ? "" : std::format(",\n    \"monitor\": \"{}\"", SJsonEscaped{r.monitor});
         const std::string default_    = sc<bool>(r.isDefault) ? std::format(",\n    \"default\": {}", boolToString(r.isDefault)) : "";
         const std::string persistent  = sc<bool>(r.isPersistent) ? std::format(",\n    \"persistent\": {}", boolToString(r.isPersistent)) : "";
         const std::string gapsIn      = sc<bool>(r.gapsIn) ?
@@ -490,17 +514,17 @@ static std::string getWorkspaceRuleData(const SWorkspaceRule& r, eHyprCtlOutputF
         const std::string rounding    = sc<bool>(r.noRounding) ? std::format(",\n    \"rounding\": {}", boolToString(!r.noRounding.value())) : "";
         const std::string decorate    = sc<bool>(r.decorate) ? std::format(",\n    \"decorate\": {}", boolToString(r.decorate.value())) : "";
         const std::string shadow      = sc<bool>(r.noShadow) ? std::format(",\n    \"shadow\": {}", boolToString(!r.noShadow.value())) : "";
-        const std::string defaultName = r.defaultName.has_value() ? std::format(",\n    \"defaultName\": \"{}\"", escapeJSONStrings(r.defaultName.value())) : "";
+        const std::string defaultName = r.defaultName.has_value() ? std::format(",\n    \"defaultName\": \"{}\"", SJsonEscaped{r.defaultName.value()}) : "";
 
         std::string       result =
             std::format(R"#({{
     "workspaceString": "{}"{}{}{}{}{}{}{}{}{}{}{}
 }})#",
-                        escapeJSONStrings(r.workspaceString), monitor, default_, persistent, gapsIn, gapsOut, borderSize, border, rounding, decorate, shadow, defaultName);
+                        SJsonEscaped{r.workspaceString}, monitor, default_, persistent, gapsIn, gapsOut, borderSize, border, rounding, decorate, shadow, defaultName);
 
         return result;
     } else {
-        const std::string monitor    = std::format("\tmonitor: {}\n", r.monitor.empty() ? "<unset>" : escapeJSONStrings(r.monitor));
+        const std::string monitor    = std::format("\tmonitor: {}\n", SJsonEscaped{r.monitor.empty() ? "<unset>" : r.monitor});
         const std::string default_   = std::format("\tdefault: {}\n", sc<bool>(r.isDefault) ? boolToString(r.isDefault) : "<unset>");
         const std::string persistent = std::format("\tpersistent: {}\n", sc<bool>(r.isPersistent) ? boolToString(r.isPersistent) : "<unset>");
         const std::string gapsIn     = sc<bool>(r.gapsIn) ? std::format("\tgapsIn: {} {} {} {}\n", std::to_string(r.gapsIn.value().m_top), std::to_string(r.gapsIn.value().m_right),
@@ -517,7 +541,7 @@ static std::string getWorkspaceRuleData(const SWorkspaceRule& r, eHyprCtlOutputF
         const std::string shadow     = std::format("\tshadow: {}\n", sc<bool>(r.noShadow) ? boolToString(!r.noShadow.value()) : "<unset>");
         const std::string defaultName = std::format("\tdefaultName: {}\n", r.defaultName.value_or("<unset>"));
 
-        std::string       result = std::format("Workspace rule {}:\n{}{}{}{}{}{}{}{}{}{}{}\n", escapeJSONStrings(r.workspaceString), monitor, default_, persistent, gapsIn, gapsOut,
+        std::string       result = std::format("Workspace rule {}:\n{}{}{}{}{}{}{}{}{}{}{}\n", SJsonEscaped{r.workspaceString}, monitor, default_, persistent, gapsIn, gapsOut,
                                                borderSize, border, rounding, decorate, shadow, defaultName);
 
         return result;
@@ -538,12 +562,12 @@ static std::string activeWorkspaceRequest(eHyprCtlOutputFormat format, std::stri
 }
 
 static std::string workspacesRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string result = "";
+    auto result = g_pHyprCtl->acquireBuffer();
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "[";
         for (auto const& w : g_pCompositor->getWorkspaces()) {
-            result += CHyprCtl::getWorkspaceData(w.lock(), format);
+            CHyprCtl::appendWorkspaceData(result, w.lock(), format);
             result += ",";
         }
 
@@ -551,15 +575,76 @@ static std::string workspacesRequest(eHyprCtlOutputFormat format, std::string re
         result += "]";
     } else {
         for (auto const& w : g_pCompositor->getWorkspaces()) {
-            result += CHyprCtl::getWorkspaceData(w.lock(), format);
+            CHyprCtl::appendWorkspaceData(result, w.lock(), format);
         }
     }
 
     return result;
 }
 
+static std::string stateRequest(eHyprCtlOutputFormat format, std::string request) {
+    CVarList vars(request, 0, ' ');
+    uint64_t since = 0;
+
+    if (vars.size() > 2)
+        return "too many args";
+
+    if (vars.size() == 2) {
+        try {
+            since = std::stoull(vars[1]);
+        } catch (...) { return "invalid generation"; }
+    }
+
+    return g_pHyprCtl->m_stateTracker.write(since, format);
+}
+
+static std::string statePageRequest(eHyprCtlOutputFormat format, std::string request) {
+    auto fd = g_pHyprCtl->m_statePage.share();
+    if (!fd.isValid())
+        return "couldn't create the state page";
+
+    g_pHyprCtl->m_currentRequestParams.passFD = std::move(fd);
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON)
+        return std::format(R"#({{"version": {}}})#", HYPRLAND_STATE_PAGE_VERSION);
+
+    return std::format("ok, version {}", HYPRLAND_STATE_PAGE_VERSION);
+}
+
+static std::string traceRequest(eHyprCtlOutputFormat format, std::string request) {
+    CVarList vars(request, 0, ' ');
+
+    if (vars.size() < 2)
+        return "not enough args";
+
+    const auto OPERATION = vars[1];
+
+    if (OPERATION == "start")
+        FrameTrace::start();
+    else if (OPERATION == "stop")
+        FrameTrace::stop();
+    else if (OPERATION == "dump") {
+        if (vars.size() < 3)
+            return "not enough args";
+
+        const auto PATH = vars.join(" ", 2);
+
+        if (!PATH.starts_with('/'))
+            return "path must be absolute";
+
+        const auto RESULT = FrameTrace::dump(PATH);
+        if (!RESULT)
+            return RESULT.error();
+
+        return format == eHyprCtlOutputFormat::FORMAT_JSON ? std::format("{{\"spans\": {}}}", *RESULT) : std::format("dumped {} spans to {}", *RESULT, PATH);
+    } else
+        return "unknown trace request";
+
+    return "ok";
+}
+
 static std::string workspaceRulesRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string result = "";
+    auto result = g_pHyprCtl->acquireBuffer();
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "[";
         for (auto const& r : g_pConfigManager->getAllWorkspaceRules()) {
@@ -593,27 +678,27 @@ static std::string activeWindowRequest(eHyprCtlOutputFormat format, std::string
 }
 
 static std::string layersRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string result = "";
+    auto result = g_pHyprCtl->acquireBuffer();
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "{\n";
 
         for (auto const& mon : g_pCompositor->m_monitors) {
-            result += std::format(
+            std::format_to(std::back_inserter(result),
                 R"#("{}": {{
     "levels": {{
 )#",
-                escapeJSONStrings(mon->m_name));
+                SJsonEscaped{mon->m_name});
 
             int layerLevel = 0;
             for (auto const& level : mon->m_layerSurfaceLayers) {
-                result += std::format(
+                std::format_to(std::back_inserter(result),
                     R"#(
         "{}": [
 )#",
                     layerLevel);
                 for (auto const& layer : level) {
-                    result += std::format(
+                    std::format_to(std::back_inserter(result),
                         R"#(                {{
                     "address": "0x{:x}",
                     "x": {},
@@ -624,7 +709,7 @@ static std::string layersRequest(eHyprCtlOutputFormat format, std::string reques
                     "pid": {}
                 }},)#",
                         rc<uintptr_t>(layer.get()), layer->m_geometry.x, layer->m_geometry.y, layer->m_geometry.width, layer->m_geometry.height,
-                        escapeJSONStrings(layer->m_namespace), layer->getPID());
+                        SJsonEscaped{layer->m_namespace}, layer->getPID());
                 }
 
                 trimTrailingComma(result);
@@ -674,7 +759,7 @@ static std::string layoutsRequest(eHyprCtlOutputFormat format, std::string reque
         result += "[";
 
         for (auto const& m : g_pLayoutManager->getAllLayoutNames()) {
-            result += std::format(
+            std::format_to(std::back_inserter(result),
                 R"#(
     "{}",)#",
                 m);
@@ -697,11 +782,11 @@ static std::string configErrorsRequest(eHyprCtlOutputFormat format, std::string
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "[";
         for (const auto& line : errLines) {
-            result += std::format(
+            std::format_to(std::back_inserter(result),
                 R"#(
 	"{}",)#",
 
-                escapeJSONStrings(line));
+                SJsonEscaped{line});
         }
         trimTrailingComma(result);
         result += "\n]\n";
@@ -714,9 +799,9 @@ static std::string configErrorsRequest(eHyprCtlOutputFormat format, std::string
 }
 
 static std::string devicesRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string result = "";
+    auto result = g_pHyprCtl->acquireBuffer();
 
-    auto        getModState = [](SP<IKeyboard> keyboard, const char* xkbModName) -> bool {
+    auto getModState = [](SP<IKeyboard> keyboard, const char* xkbModName) -> bool {
         auto IDX = xkb_keymap_mod_get_index(keyboard->m_xkbKeymap, xkbModName);
 
         if (IDX == XKB_MOD_INVALID)
@@ -730,14 +815,14 @@ static std::string devicesRequest(eHyprCtlOutputFormat format, std::string reque
         result += "\"mice\": [\n";
 
         for (auto const& m : g_pInputManager->m_pointers) {
-            result += std::format(
+            std::format_to(std::back_inserter(result),
                 R"#(    {{
         "address": "0x{:x}",
         "name": "{}",
         "defaultSpeed": {:.5f},
         "scrollFactor": {:.2f}
     }},)#",
-                rc<uintptr_t>(m.get()), escapeJSONStrings(m->m_hlName),
+                rc<uintptr_t>(m.get()), SJsonEscaped{m->m_hlName},
                 m->aq() && m->aq()->getLibinputHandle() ? libinput_device_config_accel_get_default_speed(m->aq()->getLibinputHandle()) : 0.f, m->m_scrollFactor.value_or(-1));
         }
 
@@ -749,7 +834,7 @@ static std::string devicesRequest(eHyprCtlOutputFormat format, std::string reque
             const auto INDEX_OPT = k->getActiveLayoutIndex();
             const auto KI        = INDEX_OPT.has_value() ? std::to_string(INDEX_OPT.value()) : "none";
             const auto KM        = k->getActiveLayout();
-            result += std::format(
+            std::format_to(std::back_inserter(result),
                 R"#(    {{
         "address": "0x{:x}",
         "name": "{}",
@@ -764,8 +849,8 @@ static std::string devicesRequest(eHyprCtlOutputFormat format, std::string reque
         "numLock": {},
         "main": {}
     }},)#",
-                rc<uintptr_t>(k.get()), escapeJSONStrings(k->m_hlName), escapeJSONStrings(k->m_currentRules.rules), escapeJSONStrings(k->m_currentRules.model),
-                escapeJSONStrings(k->m_currentRules.layout), escapeJSONStrings(k->m_currentRules.variant), escapeJSONStrings(k->m_currentRules.options), KI, escapeJSONStrings(KM),
+                rc<uintptr_t>(k.get()), SJsonEscaped{k->m_hlName}, SJsonEscaped{k->m_currentRules.rules}, SJsonEscaped{k->m_currentRules.model},
+                SJsonEscaped{k->m_currentRules.layout}, SJsonEscaped{k->m_currentRules.variant}, SJsonEscaped{k->m_currentRules.options}, KI, SJsonEscaped{KM},
                 (getModState(k, XKB_MOD_NAME_CAPS) ? "true" : "false"), (getModState(k, XKB_MOD_NAME_NUM) ? "true" : "false"), (k->m_active ? "true" : "false"));
         }
 
@@ -775,7 +860,7 @@ static std::string devicesRequest(eHyprCtlOutputFormat format, std::string reque
         result += "\"tablets\": [\n";
 
         for (auto const& d : g_pInputManager->m_tabletPads) {
-            result += std::format(
+            std::format_to(std::back_inserter(result),
                 R"#(    {{
         "address": "0x{:x}",
         "type": "tabletPad",
@@ -784,20 +869,20 @@ static std::string devicesRequest(eHyprCtlOutputFormat format, std::string reque
             "name": "{}"
         }}
     }},)#",
-                rc<uintptr_t>(d.get()), rc<uintptr_t>(d->m_parent.get()), escapeJSONStrings(d->m_parent ? d->m_parent->m_hlName : ""));
+                rc<uintptr_t>(d.get()), rc<uintptr_t>(d->m_parent.get()), SJsonEscaped{d->m_parent ? d->m_parent->m_hlName : ""});
         }
 
         for (auto const& d : g_pInputManager->m_tablets) {
-            result += std::format(
+            std::format_to(std::back_inserter(result),
                 R"#(    {{
         "address": "0x{:x}",
         "name": "{}"
     }},)#",
-                rc<uintptr_t>(d.get()), escapeJSONStrings(d->m_hlName));
+                rc<uintptr_t>(d.get()), SJsonEscaped{d->m_hlName});
         }
 
         for (auto const& d : g_pInputManager->m_tabletTools) {
-            result += std::format(
+            std::format_to(std::back_inserter(result),
                 R"#(    {{
         "address": "0x{:x}",
         "type": "tabletTool",
@@ -811,12 +896,12 @@ static std::string devicesRequest(eHyprCtlOutputFormat format, std::string reque
         result += "\"touch\": [\n";
 
         for (auto const& d : g_pInputManager->m_touches) {
-            result += std::format(
+            std::format_to(std::back_inserter(result),
                 R"#(    {{
         "address": "0x{:x}",
         "name": "{}"
     }},)#",
-                rc<uintptr_t>(d.get()), escapeJSONStrings(d->m_hlName));
+                rc<uintptr_t>(d.get()), SJsonEscaped{d->m_hlName});
         }
 
         trimTrailingComma(result);
@@ -825,12 +910,12 @@ static std::string devicesRequest(eHyprCtlOutputFormat format, std::string reque
         result += "\"switches\": [\n";
 
         for (auto const& d : g_pInputManager->m_switches) {
-            result += std::format(
+            std::format_to(std::back_inserter(result),
                 R"#(    {{
         "address": "0x{:x}",
         "name": "{}"
     }},)#",
-                rc<uintptr_t>(&d), escapeJSONStrings(d.pDevice ? d.pDevice->getName() : ""));
+                rc<uintptr_t>(&d), SJsonEscaped{d.pDevice ? d.pDevice->getName() : ""});
         }
 
         trimTrailingComma(result);
@@ -893,7 +978,7 @@ static std::string devicesRequest(eHyprCtlOutputFormat format, std::string reque
 }
 
 static std::string animationsRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string ret = "";
+    auto ret = g_pHyprCtl->acquireBuffer();
     if (format == eHyprCtlOutputFormat::FORMAT_NORMAL) {
         ret += "animations:\n";
 
@@ -914,7 +999,7 @@ static std::string animationsRequest(eHyprCtlOutputFormat format, std::string re
 
         ret += "[[";
         for (auto const& ac : g_pConfigManager->getAnimationConfig()) {
-            ret += std::format(R"#(
+            std::format_to(std::back_inserter(ret), R"#(
 {{
     "name": "{}",
     "overridden": {},
@@ -923,8 +1008,8 @@ static std::string animationsRequest(eHyprCtlOutputFormat format, std::string re
     "speed": {:.2f},
     "style": "{}"
 }},)#",
-                               ac.first, ac.second->overridden ? "true" : "false", escapeJSONStrings(ac.second->internalBezier), ac.second->internalEnabled ? "true" : "false",
-                               ac.second->internalSpeed, escapeJSONStrings(ac.second->internalStyle));
+                               ac.first, ac.second->overridden ? "true" : "false", SJsonEscaped{ac.second->internalBezier}, ac.second->internalEnabled ? "true" : "false",
+                               ac.second->internalSpeed, SJsonEscaped{ac.second->internalStyle});
         }
 
         ret[ret.length() - 1] = ']';
@@ -933,7 +1018,7 @@ static std::string animationsRequest(eHyprCtlOutputFormat format, std::string re
 
         for (auto const& bz : g_pAnimationManager->getAllBeziers()) {
             auto& controlPoints = bz.second->getControlPoints();
-            ret += std::format(R"#(
+            std::format_to(std::back_inserter(ret), R"#(
 {{
     "name": "{}",
     "X0": {:.2f},
@@ -941,7 +1026,7 @@ static std::string animationsRequest(eHyprCtlOutputFormat format, std::string re
     "X1": {:.2f},
     "Y1": {:.2f}
 }},)#",
-                               escapeJSONStrings(bz.first), controlPoints[1].x, controlPoints[1].y, controlPoints[2].x, controlPoints[2].y);
+                               SJsonEscaped{bz.first}, controlPoints[1].x, controlPoints[1].y, controlPoints[2].x, controlPoints[2].y);
         }
 
         trimTrailingComma(ret);
@@ -957,7 +1042,7 @@ static std::string rollinglogRequest(eHyprCtlOutputFormat format, std::string re
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "[\n\"log\":\"";
-        result += escapeJSONStrings(Debug::m_rollingLog);
+        escapeJSONInto(result, Debug::m_rollingLog);
         result += "\"]";
     } else {
         result = Debug::m_rollingLog;
@@ -967,8 +1052,8 @@ static std::string rollinglogRequest(eHyprCtlOutputFormat format, std::string re
 }
 
 static std::string globalShortcutsRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string ret       = "";
-    const auto  SHORTCUTS = PROTO::globalShortcuts->getAllShortcuts();
+    auto       ret       = g_pHyprCtl->acquireBuffer();
+    const auto SHORTCUTS = PROTO::globalShortcuts->getAllShortcuts();
     if (format == eHyprCtlOutputFormat::FORMAT_NORMAL) {
         for (auto const& sh : SHORTCUTS) {
             ret += std::format("{}:{} -> {}\n", sh.appid, sh.id, sh.description);
@@ -978,12 +1063,12 @@ static std::string globalShortcutsRequest(eHyprCtlOutputFormat format, std::stri
     } else {
         ret += "[";
         for (auto const& sh : SHORTCUTS) {
-            ret += std::format(R"#(
+            std::format_to(std::back_inserter(ret), R"#(
 {{
     "name": "{}",
     "description": "{}"
 }},)#",
-                               escapeJSONStrings(sh.appid + ":" + sh.id), escapeJSONStrings(sh.description));
+                               SJsonEscaped{sh.appid + ":" + sh.id}, SJsonEscaped{sh.description});
         }
         trimTrailingComma(ret);
         ret += "]\n";
@@ -993,7 +1078,7 @@ static std::string globalShortcutsRequest(eHyprCtlOutputFormat format, std::stri
 }
 
 static std::string bindsRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string ret = "";
+    auto ret = g_pHyprCtl->acquireBuffer();
     if (format == eHyprCtlOutputFormat::FORMAT_NORMAL) {
         for (auto const& kb : g_pKeybindManager->m_keybinds) {
             ret += "bind";
@@ -1017,7 +1102,7 @@ static std::string bindsRequest(eHyprCtlOutputFormat format, std::string request
         // json
         ret += "[";
         for (auto const& kb : g_pKeybindManager->m_keybinds) {
-            ret += std::format(
+            std::format_to(std::back_inserter(ret),
                 R"#(
 {{
     "locked": {},
@@ -1038,9 +1123,9 @@ static std::string bindsRequest(eHyprCtlOutputFormat format, std::string request
     "arg": "{}"
 }},)#",
                 kb->locked ? "true" : "false", kb->mouse ? "true" : "false", kb->release ? "true" : "false", kb->repeat ? "true" : "false", kb->longPress ? "true" : "false",
-                kb->nonConsuming ? "true" : "false", kb->hasDescription ? "true" : "false", kb->modmask, escapeJSONStrings(kb->submap.name), kb->submapUniversal,
-                escapeJSONStrings(kb->key), kb->keycode, kb->catchAll ? "true" : "false", escapeJSONStrings(kb->description), escapeJSONStrings(kb->handler),
-                escapeJSONStrings(kb->arg));
+                kb->nonConsuming ? "true" : "false", kb->hasDescription ? "true" : "false", kb->modmask, SJsonEscaped{kb->submap.name}, kb->submapUniversal,
+                SJsonEscaped{kb->key}, kb->keycode, kb->catchAll ? "true" : "false", SJsonEscaped{kb->description}, SJsonEscaped{kb->handler},
+                SJsonEscaped{kb->arg});
         }
         trimTrailingComma(ret);
         ret += "]";
@@ -1098,7 +1183,7 @@ std::string versionRequest(eHyprCtlOutputFormat format, std::string request) {
     "systemHyprcursor": "{}",
     "systemHyprgraphics": "{}",
     "flags": [)#",
-            GIT_BRANCH, GIT_COMMIT_HASH, HYPRLAND_VERSION, (strcmp(GIT_DIRTY, "dirty") == 0 ? "true" : "false"), escapeJSONStrings(commitMsg), GIT_COMMIT_DATE, GIT_TAG,
+            GIT_BRANCH, GIT_COMMIT_HASH, HYPRLAND_VERSION, (strcmp(GIT_DIRTY, "dirty") == 0 ? "true" : "false"), SJsonEscaped{commitMsg}, GIT_COMMIT_DATE, GIT_TAG,
             GIT_COMMITS, AQUAMARINE_VERSION, HYPRLANG_VERSION, HYPRUTILS_VERSION, HYPRCURSOR_VERSION, HYPRGRAPHICS_VERSION, getSystemLibraryVersion("aquamarine"),
             getSystemLibraryVersion("hyprlang"), getSystemLibraryVersion("hyprutils"), getSystemLibraryVersion("hyprcursor"), getSystemLibraryVersion("hyprgraphics"));
 
@@ -1319,7 +1404,7 @@ static std::string dispatchKeyword(eHyprCtlOutputFormat format, std::string in)
         for (auto const& m : g_pCompositor->m_monitors) {
             *(m->m_cursorZoom) = *PZOOMFACTOR;
             g_pHyprRenderer->damageMonitor(m);
-            g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->m_id);
+            g_pLayoutManager->scheduleRecalc(m->m_id);
         }
     }
 
@@ -1761,7 +1846,7 @@ static std::string dispatchGetOption(eHyprCtlOutputFormat format, std::string re
             return std::format(R"({{"option": "{}", "vec2": [{},{}], "set": {} }})", curitem, std::any_cast<Hyprlang::VEC2>(VAL).x, std::any_cast<Hyprlang::VEC2>(VAL).y,
                                VAR->m_bSetByUser);
         else if (TYPE == typeid(Hyprlang::STRING))
-            return std::format(R"({{"option": "{}", "str": "{}", "set": {} }})", curitem, escapeJSONStrings(std::any_cast<Hyprlang::STRING>(VAL)), VAR->m_bSetByUser);
+            return std::format(R"({{"option": "{}", "str": "{}", "set": {} }})", curitem, SJsonEscaped{std::any_cast<Hyprlang::STRING>(VAL)}, VAR->m_bSetByUser);
         else if (TYPE == typeid(void*))
             return std::format(R"({{"option": "{}", "custom": "{}", "set": {} }})", curitem, sc<ICustomConfigValueData*>(std::any_cast<void*>(VAL))->toString(), VAR->m_bSetByUser);
     }
@@ -1896,7 +1981,7 @@ static std::string dispatchPlugin(eHyprCtlOutputFormat format, std::string reque
                 return "[]";
 
             for (auto const& p : PLUGINS) {
-                result += std::format(
+                std::format_to(std::back_inserter(result),
                     R"#(
 {{
     "name": "{}",
@@ -1905,7 +1990,7 @@ static std::string dispatchPlugin(eHyprCtlOutputFormat format, std::string reque
     "version": "{}",
     "description": "{}"
 }},)#",
-                    escapeJSONStrings(p->m_name), escapeJSONStrings(p->m_author), rc<uintptr_t>(p->m_handle), escapeJSONStrings(p->m_version), escapeJSONStrings(p->m_description));
+                    SJsonEscaped{p->m_name}, SJsonEscaped{p->m_author}, rc<uintptr_t>(p->m_handle), SJsonEscaped{p->m_version}, SJsonEscaped{p->m_description});
             }
             trimTrailingComma(result);
             result += "]";
@@ -2015,11 +2100,14 @@ static std::string getIsLocked(eHyprCtlOutputFormat format, std::string request)
 }
 
 static std::string getDescriptions(eHyprCtlOutputFormat format, std::string request) {
-    std::string json  = "[";
+    auto        json  = g_pHyprCtl->acquireBuffer();
     const auto& DESCS = g_pConfigManager->getAllDescriptions();
 
+    json += "[";
+
     for (const auto& d : DESCS) {
-        json += d.jsonify() + ",\n";
+        d.jsonifyInto(json);
+        json += ",\n";
     }
 
     json.pop_back();
@@ -2034,7 +2122,7 @@ static std::string submapRequest(eHyprCtlOutputFormat format, std::string reques
     if (submap.empty())
         submap = "default";
 
-    return format == FORMAT_JSON ? std::format("{{\"{}\"}}\n", escapeJSONStrings(submap)) : (submap + "\n");
+    return format == FORMAT_JSON ? std::format("{{\"{}\"}}\n", SJsonEscaped{submap}) : (submap + "\n");
 }
 
 static std::string reloadShaders(eHyprCtlOutputFormat format, std::string request) {
@@ -2066,9 +2154,12 @@ CHyprCtl::CHyprCtl() {
     registerCommand(SHyprCtlCommand{"locked", true, getIsLocked});
     registerCommand(SHyprCtlCommand{"descriptions", true, getDescriptions});
     registerCommand(SHyprCtlCommand{"submap", true, submapRequest});
+    registerCommand(SHyprCtlCommand{"statepage", true, statePageRequest});
     registerCommand(SHyprCtlCommand{.name = "reloadshaders", .exact = true, .fn = reloadShaders});
 
     registerCommand(SHyprCtlCommand{"monitors", false, monitorsRequest});
+    registerCommand(SHyprCtlCommand{"state", false, stateRequest});
+    registerCommand(SHyprCtlCommand{"trace", false, traceRequest});
     registerCommand(SHyprCtlCommand{"reload", false, reloadRequest});
     registerCommand(SHyprCtlCommand{"plugin", false, dispatchPlugin});
     registerCommand(SHyprCtlCommand{"notify", false, dispatchNotify});
@@ -2090,16 +2181,50 @@ CHyprCtl::CHyprCtl() {
 CHyprCtl::~CHyprCtl() {
     if (m_eventSource)
         wl_event_source_remove(m_eventSource);
+    for (const auto& c : m_binaryClients) {
+        if (c->eventSource)
+            wl_event_source_remove(c->eventSource);
+    }
     if (!m_socketPath.empty())
         unlink(m_socketPath.c_str());
 }
 
 SP<SHyprCtlCommand> CHyprCtl::registerCommand(SHyprCtlCommand cmd) {
-    return m_commands.emplace_back(makeShared<SHyprCtlCommand>(cmd));
+    const auto& CMD = m_commands.emplace_back(makeShared<SHyprCtlCommand>(cmd));
+    (CMD->exact ? m_exactCommands : m_prefixCommands).try_emplace(CMD->name, CMD);
+    return CMD;
 }
 
 void CHyprCtl::unregisterCommand(const SP<SHyprCtlCommand>& cmd) {
     std::erase(m_commands, cmd);
+    rebuildCommandIndex();
+}
+
+void CHyprCtl::rebuildCommandIndex() {
+    m_exactCommands.clear();
+    m_prefixCommands.clear();
+
+    // earlier registrations win, like they did when the list was searched in order
+    for (const auto& cmd : m_commands) {
+        (cmd->exact ? m_exactCommands : m_prefixCommands).try_emplace(cmd->name, cmd);
+    }
+}
+
+SP<SHyprCtlCommand> CHyprCtl::findCommand(const std::string& request) {
+    if (const auto IT = m_exactCommands.find(request); IT != m_exactCommands.end())
+        return IT->second;
+
+    // non-exact commands are almost always the first word of the request
+    if (const auto IT = m_prefixCommands.find(request.substr(0, request.find(' '))); IT != m_prefixCommands.end())
+        return IT->second;
+
+    // but they're matched by prefix, e.g. [[BATCH]] isn't followed by a space
+    for (auto const& cmd : m_commands) {
+        if (!cmd->exact && request.starts_with(cmd->name))
+            return cmd;
+    }
+
+    return nullptr;
 }
 
 std::string CHyprCtl::getReply(std::string request) {
@@ -2139,29 +2264,13 @@ std::string CHyprCtl::getReply(std::string request) {
             request = request.substr(sepIndex + 1); // remove flags and separator so we can compare the rest of the string
     }
 
-    std::string result = "";
+    // queries should see the layout as it will be drawn, not as it was before the pending recalcs
+    g_pLayoutManager->flushPendingRecalcs();
 
-    // parse exact cmds first, then non-exact.
-    for (auto const& cmd : m_commands) {
-        if (!cmd->exact)
-            continue;
-
-        if (cmd->name == request) {
-            result = cmd->fn(format, request);
-            break;
-        }
-    }
-
-    if (result.empty())
-        for (auto const& cmd : m_commands) {
-            if (cmd->exact)
-                continue;
+    std::string result = "";
 
-            if (request.starts_with(cmd->name)) {
-                result = cmd->fn(format, request);
-                break;
-            }
-        }
+    if (const auto CMD = findCommand(request); CMD)
+        result = CMD->fn(format, request);
 
     if (result.empty())
         return "unknown request";
@@ -2193,7 +2302,7 @@ std::string CHyprCtl::getReply(std::string request) {
 
         for (auto const& m : g_pCompositor->m_monitors) {
             g_pHyprRenderer->damageMonitor(m);
-            g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->m_id);
+            g_pLayoutManager->scheduleRecalc(m->m_id);
         }
     }
 
@@ -2201,20 +2310,92 @@ std::string CHyprCtl::getReply(std::string request) {
 }
 
 std::string CHyprCtl::makeDynamicCall(const std::string& input) {
-    return getReply(input);
+    auto reply = getReply(input);
+    // there's no socket to pass an fd over here
+    m_currentRequestParams.passFD.reset();
+    return reply;
 }
 
-static bool successWrite(int fd, const std::string& data, bool needLog = true) {
-    if (write(fd, data.c_str(), data.length()) > 0)
-        return true;
+std::string CHyprCtl::acquireBuffer() {
+    if (m_bufferPool.empty())
+        return {};
 
-    if (errno == EAGAIN)
-        return true;
+    auto buffer = std::move(m_bufferPool.back());
+    m_bufferPool.pop_back();
+    return buffer;
+}
+
+void CHyprCtl::recycleBuffer(std::string&& buffer) {
+    // don't hold onto a one-off huge reply forever
+    if (buffer.capacity() > MAX_POOLED_BUFFER_SIZE || m_bufferPool.size() >= MAX_POOLED_BUFFERS)
+        return;
+
+    buffer.clear();
+    m_bufferPool.emplace_back(std::move(buffer));
+}
+
+static bool successWrite(int fd, std::string_view data, bool needLog = true) {
+    // send straight from the reply buffer. Big replies can take more than one send, keep going until all of it is out.
+    while (!data.empty()) {
+        const auto WRITTEN = send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+
+        if (WRITTEN > 0) {
+            data.remove_prefix(sc<size_t>(WRITTEN));
+            continue;
+        }
+
+        if (WRITTEN < 0 && errno == EINTR)
+            continue;
+
+        if (WRITTEN < 0 && errno == EAGAIN) {
+            pollfd pfd = {.fd = fd, .events = POLLOUT};
+            if (poll(&pfd, 1, 1000) > 0)
+                continue;
+        }
 
-    if (needLog)
-        Debug::log(ERR, "Couldn't write to socket. Error: " + std::string(strerror(errno)));
+        if (needLog)
+            Debug::log(ERR, "Couldn't write to socket. Error: " + std::string(strerror(errno)));
+
+        return false;
+    }
+
+    return true;
+}
+
+// a single sendmsg of data with passFD attached as SCM_RIGHTS, returns what send would
+static ssize_t sendWithFD(int fd, std::string_view data, int passFD) {
+    iovec  iov = {.iov_base = const_cast<char*>(data.data()), .iov_len = data.size()};
+    msghdr msg = {};
+
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int))> control = {};
+
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = control.data();
+    msg.msg_controllen = control.size();
+
+    auto*  cmsg      = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type  = SCM_RIGHTS;
+    cmsg->cmsg_len   = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &passFD, sizeof(int));
+
+    return sendmsg(fd, &msg, MSG_NOSIGNAL);
+}
+
+// like successWrite, but the first chunk carries passFD as SCM_RIGHTS
+static bool successWriteWithFD(int fd, std::string_view data, int passFD) {
+    ssize_t written = 0;
+    do {
+        written = sendWithFD(fd, data, passFD);
+    } while (written < 0 && errno == EINTR);
+
+    if (written <= 0) {
+        Debug::log(ERR, "Couldn't pass an fd over the socket. Error: {}", strerror(errno));
+        return false;
+    }
 
-    return false;
+    return successWrite(fd, data.substr(sc<size_t>(written)));
 }
 
 static void runWritingDebugLogThread(const int conn) {
@@ -2283,6 +2464,13 @@ static int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
         return 0;
     }
 
+    std::array<char, HyprCtlProtocol::BINARY_MAGIC.size()> magic = {};
+    if (recv(ACCEPTEDCONNECTION, magic.data(), magic.size(), MSG_PEEK) == sc<ssize_t>(magic.size()) && magic == HyprCtlProtocol::BINARY_MAGIC) {
+        g_pHyprCtl->onBinaryClient(CFileDescriptor{ACCEPTEDCONNECTION}, g_pHyprCtl->m_currentRequestParams.pid);
+        g_pHyprCtl->m_currentRequestParams.pid = 0;
+        return 0;
+    }
+
     std::string request;
     while (true) {
         readBuffer.fill(0);
@@ -2297,6 +2485,8 @@ static int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
 
     std::string reply = "";
 
+    g_pHyprCtl->m_currentRequestParams.passFD.reset();
+
     try {
         reply = g_pHyprCtl->getReply(request);
     } catch (std::exception& e) {
@@ -2317,7 +2507,11 @@ static int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
 
         g_pHyprCtl->m_currentRequestParams.pendingPromise.reset();
     } else {
-        successWrite(ACCEPTEDCONNECTION, reply);
+        if (g_pHyprCtl->m_currentRequestParams.passFD.isValid()) {
+            successWriteWithFD(ACCEPTEDCONNECTION, reply, g_pHyprCtl->m_currentRequestParams.passFD.get());
+            g_pHyprCtl->m_currentRequestParams.passFD.reset();
+        } else
+            successWrite(ACCEPTEDCONNECTION, reply);
 
         if (isFollowUpRollingLogRequest(request)) {
             Debug::log(LOG, "Followup rollinglog request received. Starting thread to write to socket.");
@@ -2327,6 +2521,8 @@ static int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
         } else
             close(ACCEPTEDCONNECTION);
 
+        g_pHyprCtl->recycleBuffer(std::move(reply));
+
         if (g_pConfigManager->m_wantsMonitorReload)
             g_pConfigManager->ensureMonitorStatus();
 
@@ -2336,6 +2532,226 @@ static int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
     return 0;
 }
 
+static int binaryClientTick(int fd, uint32_t mask, void* data) {
+    return g_pHyprCtl->onBinaryClientEvent(sc<CHyprCtl::SBinaryClient*>(data), mask);
+}
+
+void CHyprCtl::onBinaryClient(CFileDescriptor&& fd, pid_t pid) {
+    // drop the magic, frames follow
+    std::array<char, HyprCtlProtocol::BINARY_MAGIC.size()> magic = {};
+    if (read(fd.get(), magic.data(), magic.size()) != sc<ssize_t>(magic.size()))
+        return;
+
+    fcntl(fd.get(), F_SETFL, fcntl(fd.get(), F_GETFL) | O_NONBLOCK);
+
+    auto client         = makeShared<SBinaryClient>();
+    client->fd          = std::move(fd);
+    client->pid         = pid;
+    client->eventMask   = WL_EVENT_READABLE;
+    client->eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, client->fd.get(), client->eventMask, binaryClientTick, client.get());
+
+    m_binaryClients.emplace_back(std::move(client));
+
+    Debug::log(LOG, "Hyprctl: connection from pid {} switched to binary framing", pid);
+}
+
+int CHyprCtl::onBinaryClientEvent(SBinaryClient* client, uint32_t mask) {
+    const auto IT = std::ranges::find_if(m_binaryClients, [client](const auto& c) { return c.get() == client; });
+    if (IT == m_binaryClients.end())
+        return 0;
+
+    // keep it alive, a request can end up removing it
+    const auto CLIENT = *IT;
+
+    const bool HUNG_UP = mask & (WL_EVENT_ERROR | WL_EVENT_HANGUP);
+
+    if (!HUNG_UP && (mask & WL_EVENT_WRITABLE)) {
+        if (!flushBinaryClient(CLIENT) || (CLIENT->readClosed && CLIENT->writeQueue.empty())) {
+            removeBinaryClient(CLIENT.get());
+            return 0;
+        }
+    }
+
+    if (!HUNG_UP && !(mask & WL_EVENT_READABLE))
+        return 0;
+
+    bool closed = HUNG_UP;
+    bool eof    = false;
+
+    while (!closed) {
+        std::array<char, 4096> buf;
+        const auto             LEN = read(CLIENT->fd.get(), buf.data(), buf.size());
+
+        if (LEN > 0) {
+            CLIENT->readBuffer.append(buf.data(), LEN);
+            continue;
+        }
+
+        if (LEN < 0 && errno == EINTR)
+            continue;
+
+        eof    = LEN == 0;
+        closed = eof || errno != EAGAIN;
+        break;
+    }
+
+    // requests that fully arrived still get answered, the client may have only shut down its writing side
+    size_t offset = 0;
+    while (!CLIENT->dropped && CLIENT->readBuffer.size() - offset >= sizeof(HyprCtlProtocol::SFrameHeader)) {
+        HyprCtlProtocol::SFrameHeader header;
+        std::memcpy(&header, CLIENT->readBuffer.data() + offset, sizeof(header));
+
+        if (header.length > HyprCtlProtocol::MAX_REQUEST_LENGTH) {
+            Debug::log(ERR, "Hyprctl: binary request of {} bytes is too big, dropping the connection", header.length);
+            closed = true;
+            eof    = false;
+            break;
+        }
+
+        if (CLIENT->readBuffer.size() - offset - sizeof(header) < header.length)
+            break;
+
+        handleBinaryRequest(CLIENT, header.id, CLIENT->readBuffer.substr(offset + sizeof(header), header.length));
+        offset += sizeof(header) + header.length;
+    }
+
+    CLIENT->readBuffer.erase(0, offset);
+
+    if (!closed)
+        return 0;
+
+    // it can still read, hand it the rest of its replies first
+    if (eof && !CLIENT->dropped && !CLIENT->writeQueue.empty()) {
+        CLIENT->readClosed = true;
+        if (flushBinaryClient(CLIENT) && !CLIENT->writeQueue.empty())
+            return 0;
+    }
+
+    removeBinaryClient(CLIENT.get());
+
+    return 0;
+}
+
+void CHyprCtl::handleBinaryRequest(const SP<SBinaryClient>& client, uint32_t id, std::string&& request) {
+    m_currentRequestParams.pid = client->pid;
+    m_currentRequestParams.passFD.reset();
+
+    std::string reply = "";
+
+    try {
+        reply = getReply(std::move(request));
+    } catch (std::exception& e) {
+        Debug::log(ERR, "Error in request: {}", e.what());
+        reply = "Err: " + std::string(e.what());
+    }
+
+    // taken now, a request coming in before a pending promise resolves would set its own
+    auto passFD = std::move(m_currentRequestParams.passFD);
+
+    if (m_currentRequestParams.pendingPromise) {
+        // other requests on this connection go on meanwhile, this one replies whenever it's done
+        m_currentRequestParams.pendingPromise->then(
+            [weak = WP<SBinaryClient>{client}, id, fd = makeShared<CFileDescriptor>(std::move(passFD))](SP<CPromiseResult<std::string>> result) {
+                if (!g_pHyprCtl || weak.expired())
+                    return;
+
+                g_pHyprCtl->sendBinaryReply(weak.lock(), id, result->hasError() ? result->error() : result->result(), std::move(*fd));
+            });
+
+        m_currentRequestParams.pendingPromise.reset();
+    } else {
+        sendBinaryReply(client, id, reply, std::move(passFD));
+        recycleBuffer(std::move(reply));
+
+        if (g_pConfigManager->m_wantsMonitorReload)
+            g_pConfigManager->ensureMonitorStatus();
+    }
+
+    m_currentRequestParams.pid = 0;
+}
+
+void CHyprCtl::sendBinaryReply(const SP<SBinaryClient>& client, uint32_t id, std::string_view reply, CFileDescriptor&& passFD) {
+    if (client->dropped)
+        return;
+
+    const HyprCtlProtocol::SFrameHeader HEADER = {.id = id, .length = sc<uint32_t>(reply.size())};
+
+    auto frame = acquireBuffer();
+    frame.append(rc<const char*>(&HEADER), sizeof(HEADER));
+    frame.append(reply);
+
+    client->queuedBytes += frame.size();
+    client->writeQueue.emplace_back(SBinaryClient::SQueuedFrame{.data = std::move(frame), .passFD = std::move(passFD)});
+
+    // never wait on the client from the event loop, what doesn't fit now goes out once it's writable
+    bool ok = flushBinaryClient(client);
+
+    if (ok && client->queuedBytes > MAX_QUEUED_REPLY_BYTES) {
+        Debug::log(ERR, "Hyprctl: binary client (pid {}) isn't reading its replies, dropping the connection", client->pid);
+        ok = false;
+    }
+
+    if (ok)
+        return;
+
+    // removing it right away could pull it out from under its own event handler
+    client->dropped = true;
+    g_pEventLoopManager->doLater([c = WP<SBinaryClient>{client}] {
+        if (g_pHyprCtl && !c.expired())
+            g_pHyprCtl->removeBinaryClient(c.get());
+    });
+}
+
+bool CHyprCtl::flushBinaryClient(const SP<SBinaryClient>& client) {
+    while (!client->writeQueue.empty()) {
+        auto&      frame = client->writeQueue.front();
+        const auto LEFT  = std::string_view{frame.data}.substr(frame.sent);
+
+        const auto WRITTEN = frame.passFD.isValid() ? sendWithFD(client->fd.get(), LEFT, frame.passFD.get()) : send(client->fd.get(), LEFT.data(), LEFT.size(), MSG_NOSIGNAL);
+
+        if (WRITTEN < 0 && errno == EINTR)
+            continue;
+
+        if (WRITTEN < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+
+        if (WRITTEN <= 0) {
+            Debug::log(ERR, "Hyprctl: couldn't write to a binary client. Error: {}", strerror(errno));
+            return false;
+        }
+
+        // the fd went along with the first chunk
+        frame.passFD.reset();
+        frame.sent += sc<size_t>(WRITTEN);
+        client->queuedBytes -= sc<size_t>(WRITTEN);
+
+        if (frame.sent == frame.data.size()) {
+            recycleBuffer(std::move(frame.data));
+            client->writeQueue.pop_front();
+        }
+    }
+
+    // only wake up for writability while something is queued
+    const uint32_t MASK = (client->readClosed ? 0 : WL_EVENT_READABLE) | (client->writeQueue.empty() ? 0 : WL_EVENT_WRITABLE);
+    if (MASK != client->eventMask) {
+        client->eventMask = MASK;
+        wl_event_source_fd_update(client->eventSource, MASK);
+    }
+
+    return true;
+}
+
+void CHyprCtl::removeBinaryClient(SBinaryClient* client) {
+    const auto IT = std::ranges::find_if(m_binaryClients, [client](const auto& c) { return c.get() == client; });
+    if (IT == m_binaryClients.end())
+        return;
+
+    if ((*IT)->eventSource)
+        wl_event_source_remove((*IT)->eventSource);
+
+    m_binaryClients.erase(IT);
+}
+
 void CHyprCtl::startHyprCtlSocket() {
     m_socketFD = CFileDescriptor{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
 
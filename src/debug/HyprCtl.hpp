@@ -4,7 +4,11 @@
 #include "../helpers/MiscFunctions.hpp"
 #include "../helpers/defer/Promise.hpp"
 #include "../desktop/Window.hpp"
+#include "StateTracker.hpp"
+#include "StatePage.hpp"
 #include <functional>
+#include <deque>
+#include <unordered_map>
 #include <sys/types.h>
 #include <hyprutils/os/FileDescriptor.hpp>
 
@@ -22,16 +26,25 @@ class CHyprCtl {
     void                           unregisterCommand(const SP<SHyprCtlCommand>& cmd);
     std::string                    getReply(std::string);
 
+    // pooled reply buffers, big replies (descriptions, clients) keep their capacity between requests.
+    // a buffer goes back into the pool once its reply has been sent.
+    std::string                    acquireBuffer();
+    void                           recycleBuffer(std::string&& buffer);
+
     Hyprutils::OS::CFileDescriptor m_socketFD;
 
     struct {
-        bool                      all              = false;
-        bool                      sysInfoConfig    = false;
-        bool                      isDynamicKeyword = false;
-        pid_t                     pid              = 0;
-        SP<CPromise<std::string>> pendingPromise;
+        bool                           all              = false;
+        bool                           sysInfoConfig    = false;
+        bool                           isDynamicKeyword = false;
+        pid_t                          pid              = 0;
+        SP<CPromise<std::string>>      pendingPromise;
+        Hyprutils::OS::CFileDescriptor passFD; // sent along with the reply as SCM_RIGHTS
     } m_currentRequestParams;
 
+    CStateTracker m_stateTracker;
+    CStatePage    m_statePage;
+
     static std::string getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format);
     static std::string getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat format);
     static std::string getSolitaryBlockedReason(Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format);
@@ -39,12 +52,58 @@ class CHyprCtl {
     static std::string getTearingBlockedReason(Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format);
     static std::string getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format);
 
+    // same as the above, but write into out instead of allocating
+    static void appendWindowData(std::string& out, PHLWINDOW w, eHyprCtlOutputFormat format);
+    static void appendWorkspaceData(std::string& out, PHLWORKSPACE w, eHyprCtlOutputFormat format);
+    static void appendMonitorData(std::string& out, Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format);
+
+    // a connection that switched to binary framing, see HyprCtlProtocol.hpp
+    struct SBinaryClient {
+        // a reply frame that hasn't fully gone out yet
+        struct SQueuedFrame {
+            std::string                    data;
+            size_t                         sent = 0;
+            Hyprutils::OS::CFileDescriptor passFD; // goes along with the first byte
+        };
+
+        Hyprutils::OS::CFileDescriptor fd;
+        wl_event_source*               eventSource = nullptr;
+        pid_t                          pid         = 0;
+        std::string                    readBuffer;
+        std::deque<SQueuedFrame>       writeQueue;
+        size_t                         queuedBytes = 0;
+        uint32_t                       eventMask   = 0;     // what eventSource currently waits for
+        bool                           readClosed  = false; // sent EOF, stays around until its replies are out
+        bool                           dropped     = false; // removal is pending, ignore anything it still sends
+    };
+
+    void onBinaryClient(Hyprutils::OS::CFileDescriptor&& fd, pid_t pid);
+    int  onBinaryClientEvent(SBinaryClient* client, uint32_t mask);
+
   private:
     void                             startHyprCtlSocket();
+    void                             rebuildCommandIndex();
+    SP<SHyprCtlCommand>              findCommand(const std::string& request);
+
+    void                             handleBinaryRequest(const SP<SBinaryClient>& client, uint32_t id, std::string&& request);
+    void                             sendBinaryReply(const SP<SBinaryClient>& client, uint32_t id, std::string_view reply, Hyprutils::OS::CFileDescriptor&& passFD);
+    bool                             flushBinaryClient(const SP<SBinaryClient>& client);
+    void                             removeBinaryClient(SBinaryClient* client);
 
     std::vector<SP<SHyprCtlCommand>> m_commands;
+    std::vector<std::string>         m_bufferPool;
     wl_event_source*                 m_eventSource = nullptr;
     std::string                      m_socketPath;
+
+    // name -> first registered command with it, exact and prefix ones separately
+    std::unordered_map<std::string, SP<SHyprCtlCommand>> m_exactCommands;
+    std::unordered_map<std::string, SP<SHyprCtlCommand>> m_prefixCommands;
+
+    std::vector<SP<SBinaryClient>>                       m_binaryClients;
+
+    static constexpr size_t                              MAX_POOLED_BUFFERS     = 4;
+    static constexpr size_t                              MAX_POOLED_BUFFER_SIZE = 4 * 1024 * 1024;
+    static constexpr size_t                              MAX_QUEUED_REPLY_BYTES = 16 * 1024 * 1024; // unread replies a binary client can pile up before it's dropped
 };
 
 inline UP<CHyprCtl> g_pHyprCtl;
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/*
+    Binary framing for .socket.sock, shared with hyprctl.
+
+    A client that starts the connection with BINARY_MAGIC (in one write) switches it to frames.
+    Every frame is an SFrameHeader followed by length bytes of payload. A request's payload is
+    exactly what would be sent in text mode, flags included (e.g. "j/clients"), and the reply
+    frame carries the request's id with the reply text as payload.
+
+    Any number of requests can be sent without waiting for replies. Replies come in request order,
+    except for commands that finish asynchronously, which reply once they're done.
+    The connection stays open until the client closes it. A client that stops reading its replies
+    is disconnected once too many of them pile up.
+
+    Native byte order, it's a unix socket.
+*/
+namespace HyprCtlProtocol {
+    inline constexpr std::array<char, 8> BINARY_MAGIC = {'H', 'Y', 'P', 'R', 'B', 'I', 'N', '1'};
+
+    struct SFrameHeader {
+        uint32_t id     = 0; // picked by the client, echoed in the reply
+        uint32_t length = 0; // of the payload following the header
+    };
+
+    // a bigger request frame drops the connection
+    inline constexpr uint32_t MAX_REQUEST_LENGTH = 1024 * 1024;
+};
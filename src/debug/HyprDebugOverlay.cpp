@@ -41,6 +41,36 @@ void CHyprMonitorDebugOverlay::renderDataNoOverlay(PHLMONITOR pMonitor, float du
         m_monitor = pMonitor;
 }
 
+void CHyprMonitorDebugOverlay::drawCallData(PHLMONITOR pMonitor, size_t drawCalls, size_t quads) {
+    static auto PDEBUGOVERLAY = CConfigValue<Hyprlang::INT>("debug:overlay");
+
+    if (!*PDEBUGOVERLAY)
+        return;
+
+    m_lastDrawCalls.emplace_back(drawCalls, quads);
+
+    if (m_lastDrawCalls.size() > sc<long unsigned int>(pMonitor->m_refreshRate))
+        m_lastDrawCalls.pop_front();
+
+    if (!m_monitor)
+        m_monitor = pMonitor;
+}
+
+void CHyprMonitorDebugOverlay::occlusionData(PHLMONITOR pMonitor, size_t culled, size_t considered) {
+    static auto PDEBUGOVERLAY = CConfigValue<Hyprlang::INT>("debug:overlay");
+
+    if (!*PDEBUGOVERLAY)
+        return;
+
+    m_lastOcclusion.emplace_back(culled, considered);
+
+    if (m_lastOcclusion.size() > sc<long unsigned int>(pMonitor->m_refreshRate))
+        m_lastOcclusion.pop_front();
+
+    if (!m_monitor)
+        m_monitor = pMonitor;
+}
+
 void CHyprMonitorDebugOverlay::frameData(PHLMONITOR pMonitor) {
     static auto PDEBUGOVERLAY = CConfigValue<Hyprlang::INT>("debug:overlay");
 
@@ -125,6 +155,26 @@ int CHyprMonitorDebugOverlay::draw(int offset) {
     float varAnimMgrTick = maxAnimMgrTick - minAnimMgrTick;
     avgAnimMgrTick /= m_lastAnimationTicks.empty() ? 1 : m_lastAnimationTicks.size();
 
+    // and draw calls
+    float avgDrawCalls = 0;
+    float avgQuads     = 0;
+    for (auto const& [calls, quads] : m_lastDrawCalls) {
+        avgDrawCalls += calls;
+        avgQuads += quads;
+    }
+    avgDrawCalls /= m_lastDrawCalls.empty() ? 1 : m_lastDrawCalls.size();
+    avgQuads /= m_lastDrawCalls.empty() ? 1 : m_lastDrawCalls.size();
+
+    // and occlusion culling
+    float avgCulled     = 0;
+    float avgConsidered = 0;
+    for (auto const& [culled, considered] : m_lastOcclusion) {
+        avgCulled += culled;
+        avgConsidered += considered;
+    }
+    avgCulled /= m_lastOcclusion.empty() ? 1 : m_lastOcclusion.size();
+    avgConsidered /= m_lastOcclusion.empty() ? 1 : m_lastOcclusion.size();
+
     const float           FPS      = 1.f / (avgFrametime / 1000.f); // frametimes are in ms
     const float           idealFPS = m_lastFrametimes.size();
 
@@ -193,6 +243,12 @@ int CHyprMonitorDebugOverlay::draw(int offset) {
     text = std::format("Avg Anim Tick: {:.2f}ms (var {:.2f}ms) ({:.2f} TPS)", avgAnimMgrTick, varAnimMgrTick, 1.0 / (avgAnimMgrTick / 1000.0));
     showText(text.c_str(), 10);
 
+    text = std::format("Avg Draw Calls: {:.1f} ({:.1f} quads)", avgDrawCalls, avgQuads);
+    showText(text.c_str(), 10);
+
+    text = std::format("Avg Culled Windows: {:.1f} of {:.1f}", avgCulled, avgConsidered);
+    showText(text.c_str(), 10);
+
     pango_font_description_free(pangoFD);
     g_object_unref(layoutText);
 
@@ -225,6 +281,24 @@ void CHyprDebugOverlay::renderDataNoOverlay(PHLMONITOR pMonitor, float durationU
     m_monitorOverlays[pMonitor].renderDataNoOverlay(pMonitor, durationUs);
 }
 
+void CHyprDebugOverlay::drawCallData(PHLMONITOR pMonitor, size_t drawCalls, size_t quads) {
+    static auto PDEBUGOVERLAY = CConfigValue<Hyprlang::INT>("debug:overlay");
+
+    if (!*PDEBUGOVERLAY)
+        return;
+
+    m_monitorOverlays[pMonitor].drawCallData(pMonitor, drawCalls, quads);
+}
+
+void CHyprDebugOverlay::occlusionData(PHLMONITOR pMonitor, size_t culled, size_t considered) {
+    static auto PDEBUGOVERLAY = CConfigValue<Hyprlang::INT>("debug:overlay");
+
+    if (!*PDEBUGOVERLAY)
+        return;
+
+    m_monitorOverlays[pMonitor].occlusionData(pMonitor, culled, considered);
+}
+
 void CHyprDebugOverlay::frameData(PHLMONITOR pMonitor) {
     static auto PDEBUGOVERLAY = CConfigValue<Hyprlang::INT>("debug:overlay");
 
@@ -14,6 +14,8 @@ class CHyprMonitorDebugOverlay {
 
     void renderData(PHLMONITOR pMonitor, float durationUs);
     void renderDataNoOverlay(PHLMONITOR pMonitor, float durationUs);
+    void drawCallData(PHLMONITOR pMonitor, size_t drawCalls, size_t quads);
+    void occlusionData(PHLMONITOR pMonitor, size_t culled, size_t considered);
     void frameData(PHLMONITOR pMonitor);
 
   private:
@@ -21,6 +23,8 @@ class CHyprMonitorDebugOverlay {
     std::deque<float>                              m_lastRenderTimes;
     std::deque<float>                              m_lastRenderTimesNoOverlay;
     std::deque<float>                              m_lastAnimationTicks;
+    std::deque<std::pair<size_t, size_t>>          m_lastDrawCalls; // draw calls, quads
+    std::deque<std::pair<size_t, size_t>>          m_lastOcclusion; // culled windows, considered windows
     std::chrono::high_resolution_clock::time_point m_lastFrame;
     PHLMONITORREF                                  m_monitor;
     CBox                                           m_lastDrawnBox;
@@ -34,6 +38,8 @@ class CHyprDebugOverlay {
     void draw();
     void renderData(PHLMONITOR, float durationUs);
     void renderDataNoOverlay(PHLMONITOR, float durationUs);
+    void drawCallData(PHLMONITOR, size_t drawCalls, size_t quads);
+    void occlusionData(PHLMONITOR, size_t culled, size_t considered);
     void frameData(PHLMONITOR);
 
   private:
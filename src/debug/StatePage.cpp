@@ -0,0 +1,156 @@
+#include "StatePage.hpp"
+#include "Log.hpp"
+#include "../Compositor.hpp"
+#include "../helpers/Monitor.hpp"
+#include "../desktop/state/FocusState.hpp"
+#include "../devices/IKeyboard.hpp"
+#include "../managers/HookSystemManager.hpp"
+#include "../managers/KeybindManager.hpp"
+#include "../managers/SeatManager.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace Hyprutils::OS;
+
+// whole pages, so the mapping size the readers get is exact
+static constexpr size_t PAGE_SIZE_ALIGNED = (sizeof(hyprland_state_page) + 4095) & ~sc<size_t>(4095);
+
+template <size_t N>
+static void copyString(char (&dst)[N], std::string_view src) {
+    const auto LEN = std::min(src.size(), N - 1);
+    std::memcpy(dst, src.data(), LEN);
+    std::memset(dst + LEN, 0, N - LEN);
+}
+
+CStatePage::~CStatePage() {
+    if (m_page)
+        munmap(m_page, PAGE_SIZE_ALIGNED);
+}
+
+bool CStatePage::init() {
+    m_fd = CFileDescriptor{memfd_create("hyprland-state", MFD_CLOEXEC | MFD_ALLOW_SEALING)};
+    if (!m_fd.isValid()) {
+        Debug::log(ERR, "CStatePage: memfd_create failed: {}", strerror(errno));
+        return false;
+    }
+
+    if (ftruncate(m_fd.get(), PAGE_SIZE_ALIGNED) < 0) {
+        Debug::log(ERR, "CStatePage: ftruncate failed: {}", strerror(errno));
+        m_fd.reset();
+        return false;
+    }
+
+    auto* const MAPPED = mmap(nullptr, PAGE_SIZE_ALIGNED, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd.get(), 0);
+    if (MAPPED == MAP_FAILED) {
+        Debug::log(ERR, "CStatePage: mmap failed: {}", strerror(errno));
+        m_fd.reset();
+        return false;
+    }
+
+    // our mapping stays writable, nobody else gets to write or resize it. Kernels before 5.1 don't know
+    // F_SEAL_FUTURE_WRITE and reject the whole set with EINVAL, so retry without it there.
+    constexpr int SEALS = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+#ifdef F_SEAL_FUTURE_WRITE
+    int ret = fcntl(m_fd.get(), F_ADD_SEALS, SEALS | F_SEAL_FUTURE_WRITE);
+    if (ret < 0 && errno == EINVAL) {
+        Debug::log(WARN, "CStatePage: F_SEAL_FUTURE_WRITE isn't supported, readers will be able to write to the page");
+        ret = fcntl(m_fd.get(), F_ADD_SEALS, SEALS);
+    }
+#else
+    int ret = fcntl(m_fd.get(), F_ADD_SEALS, SEALS);
+#endif
+
+    // a reader could shrink an unsealed memfd under everyone else's mappings and SIGBUS them, don't hand that out
+    if (ret < 0) {
+        Debug::log(ERR, "CStatePage: couldn't seal the page: {}", strerror(errno));
+        munmap(MAPPED, PAGE_SIZE_ALIGNED);
+        m_fd.reset();
+        return false;
+    }
+
+    m_page          = sc<hyprland_state_page*>(MAPPED);
+    m_page->magic   = HYPRLAND_STATE_PAGE_MAGIC;
+    m_page->version = HYPRLAND_STATE_PAGE_VERSION;
+    m_page->size    = PAGE_SIZE_ALIGNED;
+
+    update();
+
+    // monitor positions and scales change without an event
+    m_monitorLayoutHook = g_pHookSystem->hookDynamic("monitorLayoutChanged", [this](void* self, SCallbackInfo& info, std::any param) { scheduleUpdate(); });
+
+    Debug::log(LOG, "CStatePage: created the state page, {} bytes", PAGE_SIZE_ALIGNED);
+
+    return true;
+}
+
+CFileDescriptor CStatePage::share() {
+    if (!m_page && !init())
+        return {};
+
+    return m_fd.duplicate();
+}
+
+void CStatePage::scheduleUpdate() {
+    if (!m_page || m_updateScheduled)
+        return;
+
+    m_updateScheduled = true;
+    g_pEventLoopManager->doLater([this] {
+        m_updateScheduled = false;
+        update();
+    });
+}
+
+void CStatePage::update() {
+    if (!m_page)
+        return;
+
+    std::atomic_ref<uint64_t> sequence(m_page->sequence);
+    const auto                SEQ = sequence.load(std::memory_order_relaxed);
+
+    // odd while writing, see hyprland_state_page_read
+    sequence.store(SEQ + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const auto PWINDOW  = Desktop::focusState()->window();
+    const auto PMONITOR = Desktop::focusState()->monitor();
+    const auto KEYBOARD = g_pSeatManager->m_keyboard.lock();
+
+    m_page->focused_window  = PWINDOW ? rc<uintptr_t>(PWINDOW.get()) : 0;
+    m_page->window_count    = std::ranges::count_if(g_pCompositor->m_windows, [](const auto& w) { return w->m_isMapped; });
+    m_page->keyboard_layout = KEYBOARD ? KEYBOARD->getActiveLayoutIndex().value_or(0) : 0;
+
+    copyString(m_page->focused_class, PWINDOW ? PWINDOW->m_class : "");
+    copyString(m_page->focused_title, PWINDOW ? PWINDOW->m_title : "");
+    copyString(m_page->submap, g_pKeybindManager->getCurrentSubmap().name);
+
+    uint32_t count = 0;
+    for (const auto& m : g_pCompositor->m_monitors) {
+        if (count >= HYPRLAND_STATE_PAGE_MAX_MONITORS)
+            break;
+
+        auto& mon = m_page->monitors[count++];
+
+        mon.id                          = m->m_id;
+        mon.active_workspace_id         = m->activeWorkspaceID();
+        mon.active_special_workspace_id = m->activeSpecialWorkspaceID();
+        mon.x                           = m->m_position.x;
+        mon.y                           = m->m_position.y;
+        mon.width                       = m->m_size.x;
+        mon.height                      = m->m_size.y;
+        mon.scale                       = m->m_scale;
+        mon.focused                     = m == PMONITOR;
+
+        copyString(mon.name, m->m_name);
+    }
+
+    m_page->monitor_count = count;
+
+    sequence.store(SEQ + 2, std::memory_order_release);
+}
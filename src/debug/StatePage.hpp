@@ -0,0 +1,33 @@
+#pragma once
+
+#include "StatePageLayout.h"
+#include "../managers/HookSystemManager.hpp"
+#include <hyprutils/os/FileDescriptor.hpp>
+
+/*
+    Writer side of the state page (see StatePageLayout.h). The memfd only gets created
+    once somebody asks for it, until then scheduleUpdate() is a no-op.
+*/
+class CStatePage {
+  public:
+    CStatePage() = default;
+    ~CStatePage();
+
+    CStatePage(const CStatePage&) = delete;
+    CStatePage(CStatePage&&)      = delete;
+
+    // returns a new fd for the page, creating it if needed. Invalid on error.
+    Hyprutils::OS::CFileDescriptor share();
+
+    // rewrites the page on the next event loop iteration, so a burst of changes is one update
+    void scheduleUpdate();
+
+  private:
+    bool                           init();
+    void                           update();
+
+    Hyprutils::OS::CFileDescriptor m_fd;
+    hyprland_state_page*           m_page            = nullptr;
+    bool                           m_updateScheduled = false;
+    SP<HOOK_CALLBACK_FN>           m_monitorLayoutHook;
+};
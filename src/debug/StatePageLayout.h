@@ -0,0 +1,81 @@
+#pragma once
+
+/*
+    Layout of the read-only state page, for status bars and other IPC consumers.
+
+    Get it with the "statepage" request on .socket.sock. The reply carries a memfd as SCM_RIGHTS
+    ancillary data, receive it with recvmsg() and mmap() sizeof(struct hyprland_state_page) of it
+    PROT_READ, MAP_SHARED. The page stays valid for as long as it's mapped, and Hyprland updates
+    it in place.
+
+    The page is protected by a seqlock. sequence is odd while Hyprland is writing, and changes
+    with every update, so a reader can tell something changed by just comparing it. To read,
+    use hyprland_state_page_read() below, or do the same: load sequence, copy what you need,
+    and retry if sequence was odd or changed in the meantime.
+
+    Fields are only ever appended. Check magic and that version is at least what you need,
+    size is the size of the whole memfd.
+
+    C compatible on purpose.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#define HYPRLAND_STATE_PAGE_MAGIC        0x52505948u /* "HYPR" */
+#define HYPRLAND_STATE_PAGE_VERSION      1u
+#define HYPRLAND_STATE_PAGE_MAX_MONITORS 16
+
+struct hyprland_state_page_monitor {
+    int64_t  id;
+    int64_t  active_workspace_id;
+    int64_t  active_special_workspace_id; /* 0 if none is open */
+
+    /* logical layout, as in hyprctl monitors */
+    int32_t  x, y;
+    int32_t  width, height;
+    float    scale;
+
+    uint32_t focused; /* 1 for the monitor that has focus */
+    char     name[64];
+};
+
+struct hyprland_state_page {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;
+    uint32_t monitor_count;
+
+    uint64_t sequence;
+
+    uint64_t focused_window;  /* the window address hyprctl prints, 0 if nothing is focused */
+    uint32_t window_count;    /* mapped windows */
+    uint32_t keyboard_layout; /* active layout index of the main keyboard */
+
+    /* NUL terminated, truncated if they don't fit */
+    char                               focused_class[256];
+    char                               focused_title[512];
+    char                               submap[128]; /* empty for the default submap */
+
+    struct hyprland_state_page_monitor monitors[HYPRLAND_STATE_PAGE_MAX_MONITORS];
+};
+
+/*
+    Copies a consistent snapshot of page into out. Doesn't make syscalls or allocate.
+    Returns 0 if Hyprland kept writing for all of the attempts, nonzero on success.
+*/
+static inline int hyprland_state_page_read(const struct hyprland_state_page* page, struct hyprland_state_page* out) {
+    for (int attempt = 0; attempt < 64; ++attempt) {
+        const uint64_t begin = __atomic_load_n(&page->sequence, __ATOMIC_ACQUIRE);
+        if (begin & 1)
+            continue;
+
+        memcpy(out, page, sizeof(*out));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&page->sequence, __ATOMIC_RELAXED) == begin)
+            return 1;
+    }
+
+    return 0;
+}
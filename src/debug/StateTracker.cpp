@@ -0,0 +1,321 @@
+#include "StateTracker.hpp"
+#include "HyprCtl.hpp"
+#include "../Compositor.hpp"
+#include "../helpers/Monitor.hpp"
+#include "../desktop/Workspace.hpp"
+#include "../desktop/state/FocusState.hpp"
+#include "../managers/input/InputManager.hpp"
+
+#include <format>
+#include <iterator>
+
+static void hashInto(uint64_t& seed, uint64_t v) {
+    seed ^= v + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+template <typename T>
+static void hashInto(uint64_t& seed, const T& v) {
+    hashInto(seed, sc<uint64_t>(std::hash<T>{}(v)));
+}
+
+static void trimTrailingComma(std::string& str) {
+    if (!str.empty() && str.back() == ',')
+        str.pop_back();
+}
+
+uint64_t CStateTracker::fingerprintWindow(PHLWINDOW w) {
+    uint64_t fp = 0;
+
+    hashInto(fp, w->m_isMapped);
+    hashInto(fp, w->isHidden());
+    hashInto(fp, w->m_realPosition->goal().x);
+    hashInto(fp, w->m_realPosition->goal().y);
+    hashInto(fp, w->m_realSize->goal().x);
+    hashInto(fp, w->m_realSize->goal().y);
+    hashInto(fp, w->m_workspace ? w->workspaceID() : WORKSPACE_INVALID);
+    hashInto(fp, w->m_workspace ? w->m_workspace->m_name : std::string{});
+    hashInto(fp, w->m_isFloating);
+    hashInto(fp, w->m_isPseudotiled);
+    hashInto(fp, w->monitorID());
+    hashInto(fp, w->m_class);
+    hashInto(fp, w->m_title);
+    hashInto(fp, w->m_initialClass);
+    hashInto(fp, w->m_initialTitle);
+    hashInto(fp, w->getPID());
+    hashInto(fp, w->m_isX11);
+    hashInto(fp, w->m_pinned);
+    hashInto(fp, sc<uint8_t>(w->m_fullscreenState.internal));
+    hashInto(fp, sc<uint8_t>(w->m_fullscreenState.client));
+    hashInto(fp, rc<uintptr_t>(w->m_swallowed.get()));
+    hashInto(fp, g_pInputManager->isWindowInhibiting(w, false));
+    hashInto(fp, w->xdgTag().value_or(""));
+    hashInto(fp, w->xdgDescription().value_or(""));
+    hashInto(fp, sc<uint8_t>(w->getContentType()));
+
+    for (const auto& tag : w->m_ruleApplicator->m_tagKeeper.getTags()) {
+        hashInto(fp, tag);
+    }
+
+    // membership of the whole group is reported for every member
+    if (!w->m_groupData.pNextWindow.expired()) {
+        const auto HEAD = w->getGroupHead();
+        auto       curr = HEAD;
+        do {
+            hashInto(fp, rc<uintptr_t>(curr.get()));
+            curr = curr->m_groupData.pNextWindow.lock();
+        } while (curr && curr != HEAD);
+    }
+
+    const auto& HISTORY = Desktop::focusState()->windowHistory();
+    for (size_t i = 0; i < HISTORY.size(); ++i) {
+        if (HISTORY[i].get() == w.get()) {
+            hashInto(fp, i);
+            break;
+        }
+    }
+
+    return fp;
+}
+
+uint64_t CStateTracker::fingerprintWorkspace(PHLWORKSPACE w) {
+    uint64_t   fp       = 0;
+    const auto PLASTW   = w->getLastFocusedWindow();
+    const auto PMONITOR = w->m_monitor.lock();
+
+    hashInto(fp, w->m_name);
+    hashInto(fp, PMONITOR ? PMONITOR->m_id : MONITOR_INVALID);
+    hashInto(fp, w->getWindows());
+    hashInto(fp, w->m_hasFullscreenWindow);
+    hashInto(fp, rc<uintptr_t>(PLASTW.get()));
+    hashInto(fp, PLASTW ? PLASTW->m_title : std::string{});
+    hashInto(fp, w->isPersistent());
+
+    return fp;
+}
+
+uint64_t CStateTracker::fingerprintMonitor(PHLMONITOR m) {
+    uint64_t fp = 0;
+
+    hashInto(fp, m->m_name);
+    hashInto(fp, m->m_pixelSize.x);
+    hashInto(fp, m->m_pixelSize.y);
+    hashInto(fp, m->m_refreshRate);
+    hashInto(fp, m->m_position.x);
+    hashInto(fp, m->m_position.y);
+    hashInto(fp, m->activeWorkspaceID());
+    hashInto(fp, m->m_activeWorkspace ? m->m_activeWorkspace->m_name : std::string{});
+    hashInto(fp, m->activeSpecialWorkspaceID());
+    hashInto(fp, m->m_reservedTopLeft.x);
+    hashInto(fp, m->m_reservedTopLeft.y);
+    hashInto(fp, m->m_reservedBottomRight.x);
+    hashInto(fp, m->m_reservedBottomRight.y);
+    hashInto(fp, m->m_scale);
+    hashInto(fp, sc<int>(m->m_transform));
+    hashInto(fp, m == Desktop::focusState()->monitor());
+    hashInto(fp, m->m_dpmsStatus);
+    hashInto(fp, m->m_output->state->state().adaptiveSync);
+    hashInto(fp, rc<uintptr_t>(m->m_solitaryClient.get()));
+    hashInto(fp, m->m_tearingState.activelyTearing);
+    hashInto(fp, rc<uintptr_t>(m->m_lastScanout.get()));
+    hashInto(fp, m->m_enabled);
+    hashInto(fp, m->m_output->state->state().drmFormat);
+    hashInto(fp, m->m_mirrorOf ? m->m_mirrorOf->m_id : MONITOR_INVALID);
+    hashInto(fp, sc<int>(m->m_cmType));
+    hashInto(fp, m->m_sdrBrightness);
+    hashInto(fp, m->m_sdrSaturation);
+    hashInto(fp, m->m_sdrMinLuminance);
+    hashInto(fp, m->m_sdrMaxLuminance);
+
+    return fp;
+}
+
+bool CStateTracker::update(SEntry& entry, uint64_t fingerprint, uint64_t generation) {
+    entry.seen = true;
+
+    if (entry.generation != 0 && entry.fingerprint == fingerprint)
+        return false;
+
+    entry.fingerprint = fingerprint;
+    entry.generation  = generation;
+    return true;
+}
+
+void CStateTracker::bury(eEntityType type, int64_t id, uint64_t generation) {
+    m_removed.emplace_back(SRemoved{.type = type, .id = id, .generation = generation});
+
+    if (m_removed.size() <= MAX_REMOVED)
+        return;
+
+    // drop the older half, deltas from before that are not possible anymore
+    const auto DROP = m_removed.begin() + MAX_REMOVED / 2;
+    m_removedFloor  = (DROP - 1)->generation;
+    m_removed.erase(m_removed.begin(), DROP);
+}
+
+void CStateTracker::refresh() {
+    const uint64_t NEXT    = m_generation + 1;
+    bool           changed = false;
+
+    for (auto& [k, e] : m_windows) {
+        e.seen = false;
+    }
+    for (auto& [k, e] : m_workspaces) {
+        e.seen = false;
+    }
+    for (auto& [k, e] : m_monitors) {
+        e.seen = false;
+    }
+
+    for (auto const& w : g_pCompositor->m_windows) {
+        if (!w->m_isMapped)
+            continue;
+
+        auto& entry = m_windows[w.get()];
+
+        // address got reused by a new window, clients just see an update
+        if (entry.generation != 0 && entry.window.get() != w.get())
+            entry = {};
+
+        entry.window = w;
+        changed |= update(entry, fingerprintWindow(w), NEXT);
+    }
+
+    for (auto const& ref : g_pCompositor->getWorkspaces()) {
+        const auto w = ref.lock();
+        if (!valid(w))
+            continue;
+
+        changed |= update(m_workspaces[w->m_id], fingerprintWorkspace(w), NEXT);
+    }
+
+    for (auto const& m : g_pCompositor->m_monitors) {
+        if (!m->m_output || m->m_id == -1)
+            continue;
+
+        changed |= update(m_monitors[m->m_id], fingerprintMonitor(m), NEXT);
+    }
+
+    changed |= std::erase_if(m_windows, [this, NEXT](const auto& e) {
+                   if (e.second.seen)
+                       return false;
+                   bury(ENTITY_WINDOW, rc<int64_t>(e.first), NEXT);
+                   return true;
+               }) > 0;
+
+    changed |= std::erase_if(m_workspaces, [this, NEXT](const auto& e) {
+                   if (e.second.seen)
+                       return false;
+                   bury(ENTITY_WORKSPACE, e.first, NEXT);
+                   return true;
+               }) > 0;
+
+    changed |= std::erase_if(m_monitors, [this, NEXT](const auto& e) {
+                   if (e.second.seen)
+                       return false;
+                   bury(ENTITY_MONITOR, e.first, NEXT);
+                   return true;
+               }) > 0;
+
+    if (changed)
+        m_generation = NEXT;
+}
+
+uint64_t CStateTracker::generation() const {
+    return m_generation;
+}
+
+std::string& CStateTracker::write(uint64_t since, eHyprCtlOutputFormat format) {
+    refresh();
+
+    const bool FULL = since == 0 || since < m_removedFloor || since > m_generation;
+    const bool JSON = format == eHyprCtlOutputFormat::FORMAT_JSON;
+
+    auto       wanted = [FULL, since](const SEntry& e) { return FULL || e.generation > since; };
+    auto       out    = std::back_inserter(m_buffer);
+
+    m_buffer.clear();
+
+    if (JSON)
+        std::format_to(out, "{{\n\"generation\": {},\n\"full\": {},\n\"monitors\": [", m_generation, FULL ? "true" : "false");
+    else
+        std::format_to(out, "generation: {}\nfull: {}\n\n", m_generation, FULL ? "yes" : "no");
+
+    for (auto const& m : g_pCompositor->m_monitors) {
+        const auto IT = m_monitors.find(m->m_id);
+        if (IT == m_monitors.end() || !wanted(IT->second))
+            continue;
+
+        CHyprCtl::appendMonitorData(m_buffer, m, format);
+    }
+
+    if (JSON) {
+        trimTrailingComma(m_buffer);
+        m_buffer += "],\n\"workspaces\": [";
+    }
+
+    for (auto const& ref : g_pCompositor->getWorkspaces()) {
+        const auto w = ref.lock();
+        if (!valid(w))
+            continue;
+
+        const auto IT = m_workspaces.find(w->m_id);
+        if (IT == m_workspaces.end() || !wanted(IT->second))
+            continue;
+
+        CHyprCtl::appendWorkspaceData(m_buffer, w, format);
+
+        if (JSON)
+            m_buffer += ',';
+    }
+
+    if (JSON) {
+        trimTrailingComma(m_buffer);
+        m_buffer += "],\n\"clients\": [";
+    }
+
+    for (auto const& w : g_pCompositor->m_windows) {
+        const auto IT = m_windows.find(w.get());
+        if (IT == m_windows.end() || !wanted(IT->second))
+            continue;
+
+        CHyprCtl::appendWindowData(m_buffer, w, format);
+    }
+
+    if (JSON) {
+        trimTrailingComma(m_buffer);
+        m_buffer += "],\n\"removed\": {";
+    }
+
+    if (!FULL) {
+        for (const auto TYPE : {ENTITY_MONITOR, ENTITY_WORKSPACE, ENTITY_WINDOW}) {
+            if (JSON)
+                std::format_to(out, "\n\"{}\": [", TYPE == ENTITY_MONITOR ? "monitors" : (TYPE == ENTITY_WORKSPACE ? "workspaces" : "clients"));
+
+            for (const auto& r : m_removed) {
+                if (r.type != TYPE || r.generation <= since)
+                    continue;
+
+                if (TYPE == ENTITY_WINDOW && JSON)
+                    std::format_to(out, "\"0x{:x}\",", r.id);
+                else if (TYPE == ENTITY_WINDOW)
+                    std::format_to(out, "removed window 0x{:x}\n", r.id);
+                else if (JSON)
+                    std::format_to(out, "{},", r.id);
+                else
+                    std::format_to(out, "removed {} {}\n", TYPE == ENTITY_MONITOR ? "monitor" : "workspace", r.id);
+            }
+
+            if (JSON) {
+                trimTrailingComma(m_buffer);
+                m_buffer += "],";
+            }
+        }
+    }
+
+    if (JSON) {
+        trimTrailingComma(m_buffer);
+        m_buffer += "}\n}";
+    }
+
+    return m_buffer;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "../desktop/DesktopTypes.hpp"
+#include "../SharedDefs.hpp"
+#include <unordered_map>
+#include <vector>
+#include <string>
+
+/*
+    Versioned view of the state hyprctl exposes (clients, workspaces, monitors).
+
+    Every entity carries the generation it last changed at. Changes are detected by
+    fingerprinting the serialized fields when a state request comes in, which is a lot
+    cheaper than formatting everything, and doesn't need every mutation site to report in.
+    Clients can then ask for everything that changed since a generation they've seen.
+*/
+class CStateTracker {
+  public:
+    // re-fingerprints all entities and bumps the generation of the ones that changed
+    void        refresh();
+
+    uint64_t    generation() const;
+
+    // writes a full snapshot if since is 0 or too old to produce a delta from, a delta otherwise.
+    // returns the internal buffer, which is reused between requests.
+    std::string& write(uint64_t since, eHyprCtlOutputFormat format);
+
+  private:
+    enum eEntityType : uint8_t {
+        ENTITY_WINDOW = 0,
+        ENTITY_WORKSPACE,
+        ENTITY_MONITOR,
+    };
+
+    struct SEntry {
+        uint64_t fingerprint = 0;
+        uint64_t generation  = 0;
+        bool     seen        = false;
+    };
+
+    struct SWindowEntry : SEntry {
+        PHLWINDOWREF window;
+    };
+
+    struct SRemoved {
+        eEntityType type       = ENTITY_WINDOW;
+        int64_t     id         = 0; // workspace / monitor id, or window address
+        uint64_t    generation = 0;
+    };
+
+    bool                                       update(SEntry& entry, uint64_t fingerprint, uint64_t generation);
+    void                                       bury(eEntityType type, int64_t id, uint64_t generation);
+
+    static uint64_t                            fingerprintWindow(PHLWINDOW w);
+    static uint64_t                            fingerprintWorkspace(PHLWORKSPACE w);
+    static uint64_t                            fingerprintMonitor(PHLMONITOR m);
+
+    uint64_t                                   m_generation = 0;
+
+    std::unordered_map<CWindow*, SWindowEntry> m_windows;
+    std::unordered_map<WORKSPACEID, SEntry>    m_workspaces;
+    std::unordered_map<MONITORID, SEntry>      m_monitors;
+
+    // tombstones for deltas. Once they get dropped, anything older than the floor gets a full snapshot
+    std::vector<SRemoved>   m_removed;
+    uint64_t                m_removedFloor = 0;
+
+    std::string             m_buffer;
+
+    static constexpr size_t MAX_REMOVED = 512;
+};
@@ -1,4 +1,5 @@
 #include "LayerSurface.hpp"
+#include "../managers/LayoutManager.hpp"
 #include "state/FocusState.hpp"
 #include "../Compositor.hpp"
 #include "../events/Events.hpp"
@@ -114,7 +115,7 @@ void CLayerSurface::onDestroy() {
     // rearrange to fix the reserved areas
     if (PMONITOR) {
         g_pHyprRenderer->arrangeLayersForMonitor(PMONITOR->m_id);
-        PMONITOR->m_scheduledRecalc = true;
+        g_pLayoutManager->scheduleRecalc(PMONITOR->m_id);
 
         // and damage
         CBox geomFixed = {m_geometry.x + PMONITOR->m_position.x, m_geometry.y + PMONITOR->m_position.y, m_geometry.width, m_geometry.height};
@@ -152,7 +153,7 @@ void CLayerSurface::onMap() {
     if (!PMONITOR)
         return;
 
-    PMONITOR->m_scheduledRecalc = true;
+    g_pLayoutManager->scheduleRecalc(PMONITOR->m_id);
 
     g_pHyprRenderer->arrangeLayersForMonitor(PMONITOR->m_id);
 
@@ -325,7 +326,7 @@ void CLayerSurface::onCommit() {
 
         g_pHyprRenderer->arrangeLayersForMonitor(PMONITOR->m_id);
 
-        PMONITOR->m_scheduledRecalc = true;
+        g_pLayoutManager->scheduleRecalc(PMONITOR->m_id);
     } else {
         m_position = Vector2D(m_geometry.x, m_geometry.y);
 
@@ -30,12 +30,11 @@
 #include "../protocols/FractionalScale.hpp"
 #include "../xwayland/XWayland.hpp"
 #include "../helpers/Color.hpp"
-#include "../helpers/math/Expression.hpp"
 #include "../events/Events.hpp"
 #include "../managers/XWaylandManager.hpp"
 #include "../render/Renderer.hpp"
 #include "../managers/LayoutManager.hpp"
-#include "../managers/HookSystemManager.hpp"
+#include "../managers/HookEvents.hpp"
 #include "../managers/EventManager.hpp"
 #include "../managers/input/InputManager.hpp"
 
@@ -134,6 +133,9 @@ CWindow::~CWindow() {
 
     m_events.destroy.emit();
 
+    if (m_metaUpdates.timer && g_pEventLoopManager)
+        g_pEventLoopManager->removeTimer(m_metaUpdates.timer);
+
     if (!g_pHyprOpenGL)
         return;
 
@@ -449,17 +451,20 @@ void CWindow::moveToWorkspace(PHLWORKSPACE pWorkspace) {
         m_monitorMovedFrom = OLDWORKSPACE ? OLDWORKSPACE->monitorID() : -1;
     }
 
-    m_workspace = pWorkspace;
+    setWorkspace(pWorkspace);
 
     setAnimationsToMove();
 
     OLDWORKSPACE->updateWindows();
     OLDWORKSPACE->updateWindowData();
-    g_pLayoutManager->getCurrentLayout()->recalculateMonitor(OLDWORKSPACE->monitorID());
+    g_pLayoutManager->scheduleRecalc(OLDWORKSPACE);
 
     pWorkspace->updateWindows();
     pWorkspace->updateWindowData();
-    g_pLayoutManager->getCurrentLayout()->recalculateMonitor(monitorID());
+    g_pLayoutManager->scheduleRecalc(pWorkspace);
+
+    // dispatchers focus and warp to the moved window right after this
+    g_pLayoutManager->flushPendingRecalcs();
 
     g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
@@ -482,6 +487,19 @@ void CWindow::moveToWorkspace(PHLWORKSPACE pWorkspace) {
     }
 }
 
+void CWindow::setWorkspace(PHLWORKSPACE pWorkspace) {
+    if (m_workspace == pWorkspace)
+        return;
+
+    if (m_workspace)
+        m_workspace->removeWindow(m_self.lock());
+
+    m_workspace = pWorkspace;
+
+    if (m_workspace)
+        m_workspace->addWindow(m_self.lock());
+}
+
 PHLWINDOW CWindow::x11TransientFor() {
     if (!m_xwaylandSurface || !m_xwaylandSurface->m_parent)
         return nullptr;
@@ -526,6 +544,10 @@ void CWindow::onUnmap() {
         }
     }
 
+    // a folded title / class update would otherwise fire for a window that's gone
+    if (m_metaUpdates.timer)
+        m_metaUpdates.timer->updateTimeout(std::nullopt);
+
     m_lastWorkspace = m_workspace->m_id;
 
     // if the special workspace now has 0 windows, it will be closed, and this
@@ -549,10 +571,10 @@ void CWindow::onUnmap() {
         m_workspace->updateWindows();
         m_workspace->updateWindowData();
     }
-    g_pLayoutManager->getCurrentLayout()->recalculateMonitor(monitorID());
+    g_pLayoutManager->scheduleRecalc(monitorID());
     g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
-    m_workspace.reset();
+    setWorkspace(nullptr);
 
     if (m_isX11)
         return;
@@ -708,7 +730,7 @@ void CWindow::createGroup() {
             m_workspace->updateWindows();
             m_workspace->updateWindowData();
         }
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(monitorID());
+        g_pLayoutManager->scheduleRecalc(monitorID());
         g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
         g_pEventManager->postEvent(SHyprIPCEvent{.event = "togglegroup", .data = std::format("1,{:x}", rc<uintptr_t>(this))});
@@ -730,7 +752,7 @@ void CWindow::destroyGroup() {
             m_workspace->updateWindows();
             m_workspace->updateWindowData();
         }
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(monitorID());
+        g_pLayoutManager->scheduleRecalc(monitorID());
         g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
         g_pEventManager->postEvent(SHyprIPCEvent{.event = "togglegroup", .data = std::format("0,{:x}", rc<uintptr_t>(this))});
@@ -770,7 +792,7 @@ void CWindow::destroyGroup() {
         m_workspace->updateWindows();
         m_workspace->updateWindowData();
     }
-    g_pLayoutManager->getCurrentLayout()->recalculateMonitor(monitorID());
+    g_pLayoutManager->scheduleRecalc(monitorID());
     g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
     if (!addresses.empty())
@@ -1320,6 +1342,40 @@ void CWindow::onUpdateState() {
 }
 
 void CWindow::onUpdateMeta() {
+    static auto PINTERVAL = CConfigValue<Hyprlang::INT>("misc:title_update_interval");
+
+    m_metaUpdates.received++;
+
+    if (*PINTERVAL <= 0) {
+        applyMetaUpdate();
+        return;
+    }
+
+    // already waiting for the interval to end, the latest title and class get picked up then
+    if (m_metaUpdates.timer && m_metaUpdates.timer->armed())
+        return;
+
+    const auto NOW  = Time::steadyNow();
+    const auto NEXT = m_metaUpdates.lastDelivered + std::chrono::milliseconds(*PINTERVAL);
+
+    if (NOW >= NEXT) {
+        applyMetaUpdate();
+        return;
+    }
+
+    if (!m_metaUpdates.timer) {
+        m_metaUpdates.timer = makeShared<CEventLoopTimer>(std::nullopt, [this](SP<CEventLoopTimer> self, void* data) { applyMetaUpdate(); }, nullptr);
+        g_pEventLoopManager->addTimer(m_metaUpdates.timer);
+    }
+
+    m_metaUpdates.timer->updateTimeout(NEXT - NOW);
+}
+
+void CWindow::applyMetaUpdate() {
+    // nothing to tell anyone about a window that isn't there, mapping picks up the current title and class
+    if (!m_isMapped)
+        return;
+
     const auto NEWTITLE = fetchTitle();
     bool       doUpdate = false;
 
@@ -1327,7 +1383,7 @@ void CWindow::onUpdateMeta() {
         m_title = NEWTITLE;
         g_pEventManager->postEvent(SHyprIPCEvent{.event = "windowtitle", .data = std::format("{:x}", rc<uintptr_t>(this))});
         g_pEventManager->postEvent(SHyprIPCEvent{.event = "windowtitlev2", .data = std::format("{:x},{}", rc<uintptr_t>(this), m_title)});
-        EMIT_HOOK_EVENT("windowTitle", m_self.lock());
+        EMIT_HOOK(HOOK_EVENT_WINDOW_TITLE, m_self.lock());
 
         if (m_self == Desktop::focusState()->window()) { // if it's the active, let's post an event to update others
             g_pEventManager->postEvent(SHyprIPCEvent{.event = "activewindow", .data = m_class + "," + m_title});
@@ -1356,6 +1412,9 @@ void CWindow::onUpdateMeta() {
     if (doUpdate) {
         m_ruleApplicator->propertiesChanged(Desktop::Rule::RULE_PROP_TITLE | Desktop::Rule::RULE_PROP_CLASS);
         updateToplevel();
+
+        m_metaUpdates.lastDelivered = Time::steadyNow();
+        m_metaUpdates.delivered++;
     }
 }
 
@@ -1457,7 +1516,7 @@ void CWindow::onX11ConfigureRequest(CBox box) {
     if (!m_workspace || !m_workspace->isVisible())
         return; // further things are only for visible windows
 
-    m_workspace = g_pCompositor->getMonitorFromVector(m_realPosition->goal() + m_realSize->goal() / 2.f)->m_activeWorkspace;
+    setWorkspace(g_pCompositor->getMonitorFromVector(m_realPosition->goal() + m_realSize->goal() / 2.f)->m_activeWorkspace);
 
     g_pCompositor->changeWindowZOrder(m_self.lock(), true);
 
@@ -1844,36 +1903,3 @@ void CWindow::updateDecorationValues() {
 
     updateWindowDecos();
 }
-
-std::optional<double> CWindow::calculateSingleExpr(const std::string& s) {
-    const auto        PMONITOR     = m_monitor ? m_monitor : Desktop::focusState()->monitor();
-    const auto        CURSOR_LOCAL = g_pInputManager->getMouseCoordsInternal() - (PMONITOR ? PMONITOR->m_position : Vector2D{});
-
-    Math::CExpression expr;
-    expr.addVariable("window_w", m_realSize->goal().x);
-    expr.addVariable("window_h", m_realSize->goal().y);
-    expr.addVariable("window_x", m_realPosition->goal().x - (PMONITOR ? PMONITOR->m_position.x : 0));
-    expr.addVariable("window_y", m_realPosition->goal().y - (PMONITOR ? PMONITOR->m_position.y : 0));
-
-    expr.addVariable("monitor_w", PMONITOR ? PMONITOR->m_size.x : 1920);
-    expr.addVariable("monitor_h", PMONITOR ? PMONITOR->m_size.y : 1080);
-
-    expr.addVariable("cursor_x", CURSOR_LOCAL.x);
-    expr.addVariable("cursor_y", CURSOR_LOCAL.y);
-
-    return expr.compute(s);
-}
-
-std::optional<Vector2D> CWindow::calculateExpression(const std::string& s) {
-    auto spacePos = s.find(' ');
-    if (spacePos == std::string::npos)
-        return std::nullopt;
-
-    const auto LHS = calculateSingleExpr(s.substr(0, spacePos));
-    const auto RHS = calculateSingleExpr(s.substr(spacePos + 1));
-
-    if (!LHS || !RHS)
-        return std::nullopt;
-
-    return Vector2D{*LHS, *RHS};
-}
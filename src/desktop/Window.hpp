@@ -9,6 +9,7 @@
 #include "../helpers/TagKeeper.hpp"
 #include "../macros.hpp"
 #include "../managers/XWaylandManager.hpp"
+#include "../managers/eventLoop/EventLoopTimer.hpp"
 #include "../render/decorations/IHyprWindowDecoration.hpp"
 #include "../render/Transformer.hpp"
 #include "DesktopTypes.hpp"
@@ -125,9 +126,17 @@ class CWindow {
     std::string      m_class           = "";
     std::string      m_initialTitle    = "";
     std::string      m_initialClass    = "";
-    PHLWORKSPACE     m_workspace;
+    PHLWORKSPACE     m_workspace; // assign with setWorkspace(), workspaces keep a list of their windows
     PHLMONITORREF    m_monitor;
 
+    // title / class changes closer together than misc:title_update_interval are folded into one, see onUpdateMeta
+    struct {
+        SP<CEventLoopTimer> timer;
+        Time::steady_tp     lastDelivered;
+        uint64_t            received  = 0;
+        uint64_t            delivered = 0;
+    } m_metaUpdates;
+
     bool             m_isMapped = false;
 
     bool             m_requestsFloat = false;
@@ -258,6 +267,7 @@ class CWindow {
     void                       updateToplevel();
     void                       updateSurfaceScaleTransformDetails(bool force = false);
     void                       moveToWorkspace(PHLWORKSPACE);
+    void                       setWorkspace(PHLWORKSPACE);
     PHLWINDOW                  x11TransientFor();
     void                       onUnmap();
     void                       onMap();
@@ -311,6 +321,7 @@ class CWindow {
     void                       onFocusAnimUpdate();
     void                       onUpdateState();
     void                       onUpdateMeta();
+    void                       applyMetaUpdate();
     void                       onX11ConfigureRequest(CBox box);
     void                       onResourceChangeX11();
     std::string                fetchTitle();
@@ -337,7 +348,6 @@ class CWindow {
     bool                       priorityFocus();
     SP<CWLSurfaceResource>     getSolitaryResource();
     Vector2D                   getReportedSize();
-    std::optional<Vector2D>    calculateExpression(const std::string& s);
 
     CBox                       getWindowMainSurfaceBox() const {
         return {m_realPosition->value().x, m_realPosition->value().y, m_realSize->value().x, m_realSize->value().y};
@@ -368,8 +378,6 @@ class CWindow {
     } m_listeners;
 
   private:
-    std::optional<double> calculateSingleExpr(const std::string& s);
-
     // For hidden windows and stuff
     bool        m_hidden        = false;
     bool        m_suspended     = false;
@@ -6,6 +6,8 @@
 #include "../managers/EventManager.hpp"
 #include "../managers/HookSystemManager.hpp"
 
+#include <ranges>
+
 #include <hyprutils/animation/AnimatedVariable.hpp>
 #include <hyprutils/string/String.hpp>
 using namespace Hyprutils::String;
@@ -405,15 +407,6 @@ MONITORID CWorkspace::monitorID() {
     return m_monitor ? m_monitor->m_id : MONITOR_INVALID;
 }
 
-PHLWINDOW CWorkspace::getFullscreenWindow() {
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->m_workspace == m_self && w->isFullscreen())
-            return w;
-    }
-
-    return nullptr;
-}
-
 bool CWorkspace::isVisible() {
     return m_visible;
 }
@@ -426,74 +419,140 @@ bool CWorkspace::isVisibleNotCovered() {
     return PMONITOR->m_activeWorkspace->m_id == m_id;
 }
 
-int CWorkspace::getWindows(std::optional<bool> onlyTiled, std::optional<bool> onlyPinned, std::optional<bool> onlyVisible) {
-    int no = 0;
+void CWorkspace::addWindow(PHLWINDOW window) {
+    std::erase_if(m_windows, [&window](const auto& w) { return w.expired() || w == window; });
+
+    // keep compositor order. Windows rarely change workspaces, so walking all of them here is fine.
+    auto it = m_windows.begin();
     for (auto const& w : g_pCompositor->m_windows) {
-        if (w->workspaceID() != m_id || !w->m_isMapped)
-            continue;
-        if (onlyTiled.has_value() && w->m_isFloating == onlyTiled.value())
-            continue;
-        if (onlyPinned.has_value() && w->m_pinned != onlyPinned.value())
-            continue;
-        if (onlyVisible.has_value() && w->isHidden() == onlyVisible.value())
-            continue;
-        no++;
+        if (w == window)
+            break;
+
+        if (it != m_windows.end() && *it == w)
+            ++it;
     }
 
-    return no;
+    m_windows.insert(it, window);
 }
 
-int CWorkspace::getGroups(std::optional<bool> onlyTiled, std::optional<bool> onlyPinned, std::optional<bool> onlyVisible) {
-    int no = 0;
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->workspaceID() != m_id || !w->m_isMapped)
-            continue;
-        if (!w->m_groupData.head)
-            continue;
-        if (onlyTiled.has_value() && w->m_isFloating == onlyTiled.value())
-            continue;
-        if (onlyPinned.has_value() && w->m_pinned != onlyPinned.value())
-            continue;
-        if (onlyVisible.has_value() && w->isHidden() == onlyVisible.value())
-            continue;
-        no++;
+void CWorkspace::removeWindow(PHLWINDOW window) {
+    std::erase_if(m_windows, [&window](const auto& w) { return w.expired() || w == window; });
+}
+
+void CWorkspace::moveWindowInZOrder(PHLWINDOW window, bool top) {
+    const auto IT = std::ranges::find_if(m_windows, [&window](const auto& w) { return w == window; });
+    if (IT == m_windows.end())
+        return;
+
+    if (top)
+        std::rotate(IT, IT + 1, m_windows.end());
+    else
+        std::rotate(m_windows.begin(), IT, IT + 1);
+}
+
+auto CWorkspace::members() {
+    return m_windows | std::views::transform([](const auto& w) { return w.lock(); }) |
+        std::views::filter([this](const PHLWINDOW& w) { return w && w->m_workspace == m_self; });
+}
+
+// The queries below run over the member list. Debug builds run them over every window as well,
+// which catches m_workspace being assigned without CWindow::setWorkspace.
+template <typename F>
+auto CWorkspace::verified(std::string_view query, F&& fn) {
+    const auto RESULT = fn(members());
+
+    if constexpr (ISDEBUG) {
+        if (!m_inert && RESULT != fn(g_pCompositor->m_windows | std::views::filter([this](const auto& w) { return w->m_workspace == m_self; })))
+            Debug::log(ERR, "CWorkspace::{}: the window list of workspace {} is out of sync", query, m_id);
     }
-    return no;
+
+    return RESULT;
+}
+
+PHLWINDOW CWorkspace::getFullscreenWindow() {
+    return verified("getFullscreenWindow", [](auto&& windows) -> PHLWINDOW {
+        for (auto const& w : windows) {
+            if (w->isFullscreen())
+                return w;
+        }
+
+        return nullptr;
+    });
+}
+
+int CWorkspace::getWindows(std::optional<bool> onlyTiled, std::optional<bool> onlyPinned, std::optional<bool> onlyVisible) {
+    return verified("getWindows", [&](auto&& windows) {
+        int no = 0;
+        for (auto const& w : windows) {
+            if (!w->m_isMapped)
+                continue;
+            if (onlyTiled.has_value() && w->m_isFloating == onlyTiled.value())
+                continue;
+            if (onlyPinned.has_value() && w->m_pinned != onlyPinned.value())
+                continue;
+            if (onlyVisible.has_value() && w->isHidden() == onlyVisible.value())
+                continue;
+            no++;
+        }
+
+        return no;
+    });
+}
+
+int CWorkspace::getGroups(std::optional<bool> onlyTiled, std::optional<bool> onlyPinned, std::optional<bool> onlyVisible) {
+    return verified("getGroups", [&](auto&& windows) {
+        int no = 0;
+        for (auto const& w : windows) {
+            if (!w->m_isMapped)
+                continue;
+            if (!w->m_groupData.head)
+                continue;
+            if (onlyTiled.has_value() && w->m_isFloating == onlyTiled.value())
+                continue;
+            if (onlyPinned.has_value() && w->m_pinned != onlyPinned.value())
+                continue;
+            if (onlyVisible.has_value() && w->isHidden() == onlyVisible.value())
+                continue;
+            no++;
+        }
+        return no;
+    });
 }
 
 PHLWINDOW CWorkspace::getFirstWindow() {
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->m_workspace == m_self && w->m_isMapped && !w->isHidden())
-            return w;
-    }
+    return verified("getFirstWindow", [](auto&& windows) -> PHLWINDOW {
+        for (auto const& w : windows) {
+            if (w->m_isMapped && !w->isHidden())
+                return w;
+        }
 
-    return nullptr;
+        return nullptr;
+    });
 }
 
 PHLWINDOW CWorkspace::getTopLeftWindow() {
     const auto PMONITOR = m_monitor.lock();
 
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->m_workspace != m_self || !w->m_isMapped || w->isHidden())
-            continue;
+    return verified("getTopLeftWindow", [&PMONITOR](auto&& windows) -> PHLWINDOW {
+        for (auto const& w : windows) {
+            if (!w->m_isMapped || w->isHidden())
+                continue;
 
-        const auto WINDOWIDEALBB = w->getWindowIdealBoundingBoxIgnoreReserved();
+            const auto WINDOWIDEALBB = w->getWindowIdealBoundingBoxIgnoreReserved();
 
-        if (WINDOWIDEALBB.x <= PMONITOR->m_position.x + 1 && WINDOWIDEALBB.y <= PMONITOR->m_position.y + 1)
-            return w;
-    }
-    return nullptr;
+            if (WINDOWIDEALBB.x <= PMONITOR->m_position.x + 1 && WINDOWIDEALBB.y <= PMONITOR->m_position.y + 1)
+                return w;
+        }
+        return nullptr;
+    });
 }
 
 bool CWorkspace::hasUrgentWindow() {
-    return std::ranges::any_of(g_pCompositor->m_windows, [this](const auto& w) { return w->m_workspace == m_self && w->m_isMapped && w->m_isUrgent; });
+    return verified("hasUrgentWindow", [](auto&& windows) { return std::ranges::any_of(windows, [](const auto& w) { return w->m_isMapped && w->m_isUrgent; }); });
 }
 
 void CWorkspace::updateWindowDecos() {
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->m_workspace != m_self)
-            continue;
-
+    for (auto const& w : members()) {
         w->updateWindowDecos();
     }
 }
@@ -501,17 +560,14 @@ void CWorkspace::updateWindowDecos() {
 void CWorkspace::updateWindowData() {
     const auto WORKSPACERULE = g_pConfigManager->getWorkspaceRuleFor(m_self.lock());
 
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->m_workspace != m_self)
-            continue;
-
+    for (auto const& w : members()) {
         w->updateWindowData(WORKSPACERULE);
     }
 }
 
 void CWorkspace::forceReportSizesToWindows() {
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->m_workspace != m_self || !w->m_isMapped || w->isHidden())
+    for (auto const& w : members()) {
+        if (!w->m_isMapped || w->isHidden())
             continue;
 
         w->sendWindowSize(true);
@@ -536,10 +592,10 @@ void CWorkspace::rename(const std::string& name) {
 }
 
 void CWorkspace::updateWindows() {
-    m_hasFullscreenWindow = std::ranges::any_of(g_pCompositor->m_windows, [this](const auto& w) { return w->m_isMapped && w->m_workspace == m_self && w->isFullscreen(); });
+    m_hasFullscreenWindow = std::ranges::any_of(members(), [](const auto& w) { return w->m_isMapped && w->isFullscreen(); });
 
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (!w->m_isMapped || w->m_workspace != m_self)
+    for (auto const& w : members()) {
+        if (!w->m_isMapped)
             continue;
 
         w->m_ruleApplicator->propertiesChanged(Desktop::Rule::RULE_PROP_ON_WORKSPACE);
@@ -83,6 +83,11 @@ class CWorkspace {
     void             setPersistent(bool persistent);
     bool             isPersistent();
 
+    // membership bookkeeping for CWindow::setWorkspace and CCompositor, don't call these yourself
+    void addWindow(PHLWINDOW window);
+    void removeWindow(PHLWINDOW window);
+    void moveWindowInZOrder(PHLWINDOW window, bool top);
+
     struct {
         CSignalT<> destroy;
         CSignalT<> renamed;
@@ -92,6 +97,10 @@ class CWorkspace {
 
   private:
     void init(PHLWORKSPACE self);
+    auto members();
+    template <typename F>
+    auto verified(std::string_view query, F&& fn);
+
     // Previous workspace ID and name is stored during a workspace change, allowing travel
     // to the previous workspace.
     SWorkspaceIDName     m_prevWorkspace;
@@ -101,6 +110,9 @@ class CWorkspace {
 
     SP<CWorkspace>       m_selfPersistent; // for persistent workspaces.
     bool                 m_persistent = false;
+
+    // windows with m_workspace == this, in g_pCompositor->m_windows order
+    std::vector<PHLWINDOWREF> m_windows;
 };
 
 inline bool valid(const PHLWORKSPACE& ref) {
@@ -0,0 +1,68 @@
+#include "GeometryExpression.hpp"
+#include "../../Window.hpp"
+#include "../../state/FocusState.hpp"
+#include "../../../helpers/Monitor.hpp"
+#include "../../../managers/input/InputManager.hpp"
+
+using namespace Desktop;
+using namespace Desktop::Rule;
+
+CGeometryExpression::CGeometryExpression() {
+    for (auto* e : {&m_x, &m_y}) {
+        e->bindVariable("window_w", &m_vars.windowW);
+        e->bindVariable("window_h", &m_vars.windowH);
+        e->bindVariable("window_x", &m_vars.windowX);
+        e->bindVariable("window_y", &m_vars.windowY);
+
+        e->bindVariable("monitor_w", &m_vars.monitorW);
+        e->bindVariable("monitor_h", &m_vars.monitorH);
+
+        e->bindVariable("cursor_x", &m_vars.cursorX);
+        e->bindVariable("cursor_y", &m_vars.cursorY);
+    }
+}
+
+std::expected<void, std::string> CGeometryExpression::compile(const std::string& s) {
+    m_source = s;
+
+    auto spacePos = s.find(' ');
+    if (spacePos == std::string::npos)
+        return std::unexpected(std::format("expected two expressions in \"{}\"", s));
+
+    if (auto res = m_x.compile(s.substr(0, spacePos)); !res)
+        return std::unexpected(std::format("invalid expression in \"{}\": {}", s, res.error()));
+
+    if (auto res = m_y.compile(s.substr(spacePos + 1)); !res)
+        return std::unexpected(std::format("invalid expression in \"{}\": {}", s, res.error()));
+
+    return {};
+}
+
+std::optional<Vector2D> CGeometryExpression::evaluate(PHLWINDOW w) {
+    const auto PMONITOR     = w->m_monitor ? w->m_monitor.lock() : Desktop::focusState()->monitor();
+    const auto MONPOS       = PMONITOR ? PMONITOR->m_position : Vector2D{};
+    const auto CURSOR_LOCAL = g_pInputManager->getMouseCoordsInternal() - MONPOS;
+
+    m_vars.windowW = w->m_realSize->goal().x;
+    m_vars.windowH = w->m_realSize->goal().y;
+    m_vars.windowX = w->m_realPosition->goal().x - MONPOS.x;
+    m_vars.windowY = w->m_realPosition->goal().y - MONPOS.y;
+
+    m_vars.monitorW = PMONITOR ? PMONITOR->m_size.x : 1920;
+    m_vars.monitorH = PMONITOR ? PMONITOR->m_size.y : 1080;
+
+    m_vars.cursorX = CURSOR_LOCAL.x;
+    m_vars.cursorY = CURSOR_LOCAL.y;
+
+    const auto X = m_x.evaluate();
+    const auto Y = m_y.evaluate();
+
+    if (!X || !Y)
+        return std::nullopt;
+
+    return Vector2D{*X, *Y};
+}
+
+const std::string& CGeometryExpression::source() {
+    return m_source;
+}
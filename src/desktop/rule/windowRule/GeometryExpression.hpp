@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../../DesktopTypes.hpp"
+#include "../../../helpers/math/Math.hpp"
+#include "../../../helpers/math/Expression.hpp"
+
+#include <expected>
+
+namespace Desktop::Rule {
+
+    // the "x y" value of a move or size effect, parsed once when the rule is added
+    class CGeometryExpression {
+      public:
+        CGeometryExpression();
+        ~CGeometryExpression() = default;
+
+        CGeometryExpression(const CGeometryExpression&) = delete;
+        CGeometryExpression(CGeometryExpression&&)      = delete;
+
+        std::expected<void, std::string> compile(const std::string& s);
+        std::optional<Vector2D>          evaluate(PHLWINDOW w);
+
+        const std::string&               source();
+
+      private:
+        // bound to both expressions, filled in from the window on every evaluate()
+        struct {
+            double windowW = 0, windowH = 0, windowX = 0, windowY = 0;
+            double monitorW = 0, monitorH = 0;
+            double cursorX = 0, cursorY = 0;
+        } m_vars;
+
+        Math::CExpression m_x, m_y;
+        std::string       m_source;
+    };
+};
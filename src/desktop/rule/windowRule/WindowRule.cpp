@@ -16,9 +16,18 @@ eRuleType CWindowRule::type() {
     return RULE_TYPE_WINDOW;
 }
 
-void CWindowRule::addEffect(CWindowRule::storageType e, const std::string& result) {
+std::optional<std::string> CWindowRule::addEffect(CWindowRule::storageType e, const std::string& result) {
+    if (e == WINDOW_RULE_EFFECT_MOVE || e == WINDOW_RULE_EFFECT_SIZE) {
+        auto expr = makeShared<CGeometryExpression>();
+        if (auto res = expr->compile(result); !res)
+            return res.error();
+
+        m_geometry[e] = std::move(expr);
+    }
+
     m_effects.emplace_back(std::make_pair<>(e, result));
     m_effectSet.emplace(e);
+    return std::nullopt;
 }
 
 const std::vector<std::pair<CWindowRule::storageType, std::string>>& CWindowRule::effects() {
@@ -139,7 +148,8 @@ SP<CWindowRule> CWindowRule::buildFromExecString(std::string&& s) {
             if (!EFFECT.has_value() || *EFFECT == WINDOW_RULE_EFFECT_NONE)
                 continue; // invalid...
 
-            wr->addEffect(*EFFECT, std::string{el.substr(spacePos + 1)});
+            if (const auto RES = wr->addEffect(*EFFECT, std::string{el.substr(spacePos + 1)}); RES)
+                Debug::log(ERR, "CWindowRule::buildFromExecString: {}", *RES);
             continue;
         }
 
@@ -164,3 +174,8 @@ SP<CWindowRule> CWindowRule::buildFromExecString(std::string&& s) {
 const std::unordered_set<CWindowRule::storageType>& CWindowRule::effectsSet() {
     return m_effectSet;
 }
+
+SP<CGeometryExpression> CWindowRule::geometryFor(CWindowRule::storageType e) {
+    const auto IT = m_geometry.find(e);
+    return IT == m_geometry.end() ? nullptr : IT->second;
+}
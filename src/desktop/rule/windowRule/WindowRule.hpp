@@ -3,9 +3,11 @@
 #include "../Rule.hpp"
 #include "../../DesktopTypes.hpp"
 #include "WindowRuleEffectContainer.hpp"
+#include "GeometryExpression.hpp"
 #include "../../../helpers/math/Math.hpp"
 
 #include <unordered_set>
+#include <unordered_map>
 
 namespace Desktop::Rule {
     constexpr const char* EXEC_RULE_ENV_NAME = "HL_EXEC_RULE_TOKEN";
@@ -22,14 +24,16 @@ namespace Desktop::Rule {
 
         virtual eRuleType                                       type();
 
-        void                                                    addEffect(storageType e, const std::string& result);
+        std::optional<std::string>                              addEffect(storageType e, const std::string& result); // error if the value can't be parsed, effect is dropped
         const std::vector<std::pair<storageType, std::string>>& effects();
         const std::unordered_set<storageType>&                  effectsSet();
+        SP<CGeometryExpression>                                 geometryFor(storageType e); // compiled value of a move / size effect
 
         bool                                                    matches(PHLWINDOW w, bool allowEnvLookup = false);
 
       private:
-        std::vector<std::pair<storageType, std::string>> m_effects;
-        std::unordered_set<storageType>                  m_effectSet;
+        std::vector<std::pair<storageType, std::string>>         m_effects;
+        std::unordered_set<storageType>                          m_effectSet;
+        std::unordered_map<storageType, SP<CGeometryExpression>> m_geometry;
     };
 };
@@ -5,7 +5,7 @@
 #include "../../Window.hpp"
 #include "../../types/OverridableVar.hpp"
 #include "../../../managers/LayoutManager.hpp"
-#include "../../../managers/HookSystemManager.hpp"
+#include "../../../managers/HookEvents.hpp"
 
 #include <hyprutils/string/String.hpp>
 
@@ -481,11 +481,11 @@ CWindowRuleApplicator::SRuleResult CWindowRuleApplicator::applyStaticRule(const
                 break;
             }
             case WINDOW_RULE_EFFECT_MOVE: {
-                static_.position = effect;
+                static_.position = rule->geometryFor(key);
                 break;
             }
             case WINDOW_RULE_EFFECT_SIZE: {
-                static_.size = effect;
+                static_.size = rule->geometryFor(key);
                 break;
             }
             case WINDOW_RULE_EFFECT_CENTER: {
@@ -632,5 +632,5 @@ void CWindowRuleApplicator::propertiesChanged(std::underlying_type_t<eRuleProper
         g_pDecorationPositioner->forceRecalcFor(m_window.lock());
 
     // for plugins
-    EMIT_HOOK_EVENT("windowUpdateRules", m_window.lock());
+    EMIT_HOOK(HOOK_EVENT_WINDOW_UPDATE_RULES, m_window.lock());
 }
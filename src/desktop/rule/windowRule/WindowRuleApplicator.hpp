@@ -4,6 +4,7 @@
 #include <unordered_set>
 
 #include "WindowRuleEffectContainer.hpp"
+#include "GeometryExpression.hpp"
 #include "../../DesktopTypes.hpp"
 #include "../Rule.hpp"
 #include "../../types/OverridableVar.hpp"
@@ -54,7 +55,7 @@ namespace Desktop::Rule {
             std::optional<int>       content;
             std::optional<int>       noCloseFor;
 
-            std::string              size, position;
+            SP<CGeometryExpression>  size, position;
 
             std::vector<std::string> suppressEvent;
         } static_;
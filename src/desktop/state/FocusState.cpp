@@ -156,7 +156,7 @@ void CFocusState::rawWindowFocus(PHLWINDOW pWindow, SP<CWLSurfaceResource> surfa
         return;
 
     if (pWindow->m_pinned)
-        pWindow->m_workspace = m_focusMonitor->m_activeWorkspace;
+        pWindow->setWorkspace(m_focusMonitor->m_activeWorkspace);
 
     const auto PMONITOR = pWindow->m_monitor.lock();
 
@@ -68,14 +68,15 @@ void Events::listener_mapWindow(void* owner, void* data) {
     }
     auto PWORKSPACE          = PMONITOR->m_activeSpecialWorkspace ? PMONITOR->m_activeSpecialWorkspace : PMONITOR->m_activeWorkspace;
     PWINDOW->m_monitor       = PMONITOR;
-    PWINDOW->m_workspace     = PWORKSPACE;
     PWINDOW->m_isMapped      = true;
     PWINDOW->m_readyToDelete = false;
     PWINDOW->m_fadingOut     = false;
     PWINDOW->m_title         = PWINDOW->fetchTitle();
+    PWINDOW->m_class         = PWINDOW->fetchClass();
     PWINDOW->m_firstMap      = true;
     PWINDOW->m_initialTitle  = PWINDOW->m_title;
-    PWINDOW->m_initialClass  = PWINDOW->fetchClass();
+    PWINDOW->m_initialClass  = PWINDOW->m_class;
+    PWINDOW->setWorkspace(PWORKSPACE);
 
     // check for token
     std::string requestedWorkspace = "";
@@ -160,8 +161,8 @@ void Events::listener_mapWindow(void* owner, void* data) {
                         g_pKeybindManager->m_dispatchers["focusmonitor"](std::to_string(PWINDOW->monitorID()));
                         PMONITOR = PMONITORFROMID;
                     }
-                    PWINDOW->m_workspace = PMONITOR->m_activeSpecialWorkspace ? PMONITOR->m_activeSpecialWorkspace : PMONITOR->m_activeWorkspace;
-                    PWORKSPACE           = PWINDOW->m_workspace;
+                    PWINDOW->setWorkspace(PMONITOR->m_activeSpecialWorkspace ? PMONITOR->m_activeSpecialWorkspace : PMONITOR->m_activeWorkspace);
+                    PWORKSPACE = PWINDOW->m_workspace;
 
                     Debug::log(LOG, "Rule monitor, applying to {:mw}", PWINDOW);
                     requestedFSMonitor = MONITOR_INVALID;
@@ -312,8 +313,8 @@ void Events::listener_mapWindow(void* owner, void* data) {
 
             PWORKSPACE = pWorkspace;
 
-            PWINDOW->m_workspace = pWorkspace;
-            PWINDOW->m_monitor   = pWorkspace->m_monitor;
+            PWINDOW->setWorkspace(pWorkspace);
+            PWINDOW->m_monitor = pWorkspace->m_monitor;
 
             if (PWINDOW->m_monitor.lock()->m_activeSpecialWorkspace && !pWorkspace->m_isSpecialWorkspace)
                 workspaceSilent = true;
@@ -344,8 +345,8 @@ void Events::listener_mapWindow(void* owner, void* data) {
             g_pKeybindManager->m_dispatchers["focusmonitor"](std::to_string(PWINDOW->monitorID()));
             PMONITOR = PMONITORFROMID;
         }
-        PWINDOW->m_workspace = PMONITOR->m_activeSpecialWorkspace ? PMONITOR->m_activeSpecialWorkspace : PMONITOR->m_activeWorkspace;
-        PWORKSPACE           = PWINDOW->m_workspace;
+        PWINDOW->setWorkspace(PMONITOR->m_activeSpecialWorkspace ? PMONITOR->m_activeSpecialWorkspace : PMONITOR->m_activeWorkspace);
+        PWORKSPACE = PWINDOW->m_workspace;
 
         Debug::log(LOG, "Requested monitor, applying to {:mw}", PWINDOW);
     }
@@ -375,20 +376,20 @@ void Events::listener_mapWindow(void* owner, void* data) {
         g_pLayoutManager->getCurrentLayout()->onWindowCreated(PWINDOW);
         PWINDOW->m_createdOverFullscreen = true;
 
-        if (!PWINDOW->m_ruleApplicator->static_.size.empty()) {
-            const auto COMPUTED = PWINDOW->calculateExpression(PWINDOW->m_ruleApplicator->static_.size);
+        if (PWINDOW->m_ruleApplicator->static_.size) {
+            const auto COMPUTED = PWINDOW->m_ruleApplicator->static_.size->evaluate(PWINDOW);
             if (!COMPUTED)
-                Debug::log(ERR, "failed to parse {} as an expression", PWINDOW->m_ruleApplicator->static_.size);
+                Debug::log(ERR, "failed to evaluate {} as an expression", PWINDOW->m_ruleApplicator->static_.size->source());
             else {
                 *PWINDOW->m_realSize = *COMPUTED;
                 PWINDOW->setHidden(false);
             }
         }
 
-        if (!PWINDOW->m_ruleApplicator->static_.position.empty()) {
-            const auto COMPUTED = PWINDOW->calculateExpression(PWINDOW->m_ruleApplicator->static_.position);
+        if (PWINDOW->m_ruleApplicator->static_.position) {
+            const auto COMPUTED = PWINDOW->m_ruleApplicator->static_.position->evaluate(PWINDOW);
             if (!COMPUTED)
-                Debug::log(ERR, "failed to parse {} as an expression", PWINDOW->m_ruleApplicator->static_.position);
+                Debug::log(ERR, "failed to evaluate {} as an expression", PWINDOW->m_ruleApplicator->static_.position->source());
             else {
                 *PWINDOW->m_realPosition = *COMPUTED + PMONITOR->m_position;
                 PWINDOW->setHidden(false);
@@ -410,10 +411,10 @@ void Events::listener_mapWindow(void* owner, void* data) {
 
         bool setPseudo = false;
 
-        if (!PWINDOW->m_ruleApplicator->static_.size.empty()) {
-            const auto COMPUTED = PWINDOW->calculateExpression(PWINDOW->m_ruleApplicator->static_.size);
+        if (PWINDOW->m_ruleApplicator->static_.size) {
+            const auto COMPUTED = PWINDOW->m_ruleApplicator->static_.size->evaluate(PWINDOW);
             if (!COMPUTED)
-                Debug::log(ERR, "failed to parse {} as an expression", PWINDOW->m_ruleApplicator->static_.size);
+                Debug::log(ERR, "failed to evaluate {} as an expression", PWINDOW->m_ruleApplicator->static_.size->source());
             else {
                 setPseudo             = true;
                 PWINDOW->m_pseudoSize = *COMPUTED;
@@ -501,7 +502,7 @@ void Events::listener_mapWindow(void* owner, void* data) {
         g_pLayoutManager->getCurrentLayout()->onWindowRemoved(SWALLOWER);
         g_pHyprRenderer->damageWindow(SWALLOWER);
         SWALLOWER->setHidden(true);
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(PWINDOW->monitorID());
+        g_pLayoutManager->scheduleRecalc(PWINDOW->monitorID());
     }
 
     PWINDOW->m_firstMap = false;
@@ -847,7 +848,7 @@ void Events::listener_unmanagedSetGeometry(void* owner, void* data) {
         PWINDOW->m_position = PWINDOW->m_realPosition->goal();
         PWINDOW->m_size     = PWINDOW->m_realSize->goal();
 
-        PWINDOW->m_workspace = g_pCompositor->getMonitorFromVector(PWINDOW->m_realPosition->value() + PWINDOW->m_realSize->value() / 2.f)->m_activeWorkspace;
+        PWINDOW->setWorkspace(g_pCompositor->getMonitorFromVector(PWINDOW->m_realPosition->value() + PWINDOW->m_realSize->value() / 2.f)->m_activeWorkspace);
 
         g_pCompositor->changeWindowZOrder(PWINDOW, true);
         PWINDOW->updateWindowDecos();
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string>
+#include <string_view>
+
+/*
+    Streaming JSON string escaping.
+
+    Escapes in a single pass, straight into the destination: runs of bytes that don't need
+    escaping are copied in bulk, and the scan looks at 8 bytes at a time, so the common case
+    (plain ascii / utf-8 without quotes) is a handful of ALU ops per word.
+
+    Output is byte-identical to the old ostringstream based escapeJSONStrings (\u00xx in lowercase hex).
+    This header only depends on the standard library, so hyprtester can check that against a copy of
+    the old implementation.
+*/
+
+namespace NJson {
+    constexpr uint64_t SWAR_ONES  = 0x0101010101010101ULL;
+    constexpr uint64_t SWAR_HIGHS = 0x8080808080808080ULL;
+
+    // true if any byte in the word is a control char, a quote or a backslash
+    constexpr bool wordNeedsEscape(uint64_t w) {
+        const uint64_t CONTROL   = (w - SWAR_ONES * 0x20) & ~w;
+        const uint64_t QUOTES    = w ^ (SWAR_ONES * '"');
+        const uint64_t SLASHES   = w ^ (SWAR_ONES * '\\');
+        const uint64_t QUOTE     = (QUOTES - SWAR_ONES) & ~QUOTES;
+        const uint64_t BACKSLASH = (SLASHES - SWAR_ONES) & ~SLASHES;
+        return (CONTROL | QUOTE | BACKSLASH) & SWAR_HIGHS;
+    }
+
+    constexpr bool byteNeedsEscape(unsigned char c) {
+        return c < 0x20 || c == '"' || c == '\\';
+    }
+
+    // the escape sequence for a byte that needs escaping. Returns the length written to buf (max 6)
+    inline size_t escapeByte(unsigned char c, char* buf) {
+        constexpr const char* HEX = "0123456789abcdef";
+
+        buf[0] = '\\';
+        switch (c) {
+            case '"': buf[1] = '"'; return 2;
+            case '\\': buf[1] = '\\'; return 2;
+            case '\b': buf[1] = 'b'; return 2;
+            case '\f': buf[1] = 'f'; return 2;
+            case '\n': buf[1] = 'n'; return 2;
+            case '\r': buf[1] = 'r'; return 2;
+            case '\t': buf[1] = 't'; return 2;
+            default: break;
+        }
+
+        buf[1] = 'u';
+        buf[2] = '0';
+        buf[3] = '0';
+        buf[4] = HEX[c >> 4];
+        buf[5] = HEX[c & 0xF];
+        return 6;
+    }
+
+    // calls emit(const char*, size_t) for every chunk of the escaped output, in order
+    template <typename Emit>
+    void escape(std::string_view str, Emit&& emit) {
+        const char* p   = str.data();
+        const char* end = p + str.size();
+        const char* run = p; // start of the current run of bytes that are copied verbatim
+        char        esc[6];
+
+        while (p < end) {
+            if (end - p >= 8) {
+                uint64_t w;
+                std::memcpy(&w, p, sizeof(w));
+                if (!wordNeedsEscape(w)) {
+                    p += 8;
+                    continue;
+                }
+            }
+
+            const char* stop = std::min(p + 8, end);
+            for (; p < stop; ++p) {
+                const auto C = static_cast<unsigned char>(*p);
+                if (!byteNeedsEscape(C))
+                    continue;
+
+                if (p != run)
+                    emit(run, static_cast<size_t>(p - run));
+
+                emit(esc, escapeByte(C, esc));
+                run = p + 1;
+            }
+        }
+
+        if (end != run)
+            emit(run, static_cast<size_t>(end - run));
+    }
+}
+
+// appends the escaped str to out
+inline void escapeJSONInto(std::string& out, std::string_view str) {
+    NJson::escape(str, [&out](const char* data, size_t len) { out.append(data, len); });
+}
+
+// wraps a string to be escaped while being formatted, e.g. std::format("\"{}\"", SJsonEscaped{name})
+struct SJsonEscaped {
+    std::string_view str;
+};
+
+template <typename CharT>
+struct std::formatter<SJsonEscaped, CharT> : std::formatter<std::basic_string_view<CharT>, CharT> {
+    template <typename FormatContext>
+    auto format(const SJsonEscaped& s, FormatContext& ctx) const {
+        auto out = ctx.out();
+        NJson::escape(s.str, [&out](const char* data, size_t len) { out = std::copy(data, data + len, out); });
+        return out;
+    }
+};
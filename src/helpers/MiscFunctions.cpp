@@ -7,6 +7,7 @@
 #include "Monitor.hpp"
 #include "../config/ConfigManager.hpp"
 #include "fs/FsUtils.hpp"
+#include "JsonWriter.hpp"
 #include <optional>
 #include <cstring>
 #include <climits>
@@ -78,25 +79,10 @@ std::string absolutePath(const std::string& rawpath, const std::string& currentP
 }
 
 std::string escapeJSONStrings(const std::string& str) {
-    std::ostringstream oss;
-    for (auto const& c : str) {
-        switch (c) {
-            case '"': oss << "\\\""; break;
-            case '\\': oss << "\\\\"; break;
-            case '\b': oss << "\\b"; break;
-            case '\f': oss << "\\f"; break;
-            case '\n': oss << "\\n"; break;
-            case '\r': oss << "\\r"; break;
-            case '\t': oss << "\\t"; break;
-            default:
-                if ('\x00' <= c && c <= '\x1f') {
-                    oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << sc<int>(c);
-                } else {
-                    oss << c;
-                }
-        }
-    }
-    return oss.str();
+    std::string result;
+    result.reserve(str.size());
+    escapeJSONInto(result, str);
+    return result;
 }
 
 std::optional<float> getPlusMinusKeywordResult(std::string source, float relative) {
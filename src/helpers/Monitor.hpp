@@ -111,6 +111,12 @@ class CMonitor {
     Vector2D                    m_reservedTopLeft     = Vector2D(0, 0);
     Vector2D                    m_reservedBottomRight = Vector2D(0, 0);
 
+    // what the layout last got arranged for, arranging layers again with the same result doesn't recalc the layout
+    struct {
+        Vector2D position, size, reservedTopLeft, reservedBottomRight;
+        bool     valid = false;
+    } m_lastArrange;
+
     drmModeModeInfo             m_customDrmMode = {};
 
     CMonitorState               m_state;
@@ -119,7 +125,6 @@ class CMonitor {
     SP<Aquamarine::IOutput>     m_output;
     float                       m_refreshRate     = 60; // Hz
     int                         m_forceFullFrames = 0;
-    bool                        m_scheduledRecalc = false;
     wl_output_transform         m_transform       = WL_OUTPUT_TRANSFORM_NORMAL;
     float                       m_xwaylandScale   = 1.f;
     Mat3x3                      m_projMatrix;
@@ -20,3 +20,31 @@ std::optional<double> CExpression::compute(const std::string& expr) {
 
     return std::nullopt;
 }
+
+void CExpression::bindVariable(const std::string& name, double* val) {
+    m_parser->DefineVar(name, val);
+}
+
+std::expected<void, std::string> CExpression::compile(const std::string& expr) {
+    m_compiled = false;
+
+    try {
+        m_parser->SetExpr(expr);
+        // mu only parses on the first Eval, after which it runs the bytecode
+        m_parser->Eval();
+    } catch (mu::Parser::exception_type& e) { return std::unexpected(e.GetMsg()); }
+
+    m_compiled = true;
+    return {};
+}
+
+std::optional<double> CExpression::evaluate() {
+    if (!m_compiled)
+        return std::nullopt;
+
+    try {
+        return m_parser->Eval();
+    } catch (mu::Parser::exception_type& e) { Debug::log(ERR, "CExpression::evaluate: mu threw: {}", e.GetMsg()); }
+
+    return std::nullopt;
+}
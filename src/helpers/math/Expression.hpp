@@ -3,6 +3,7 @@
 #include "../memory/Memory.hpp"
 #include <string>
 #include <optional>
+#include <expected>
 
 namespace mu {
     class Parser;
@@ -22,7 +23,15 @@ namespace Math {
 
         std::optional<double> compute(const std::string& expr);
 
+        // binds a variable to storage that is read on every evaluate(). Has to outlive the expression.
+        void                             bindVariable(const std::string& name, double* val);
+
+        // parses expr into bytecode once, so evaluate() doesn't touch the string again
+        std::expected<void, std::string> compile(const std::string& expr);
+        std::optional<double>            evaluate();
+
       private:
         UP<mu::Parser> m_parser;
+        bool           m_compiled = false;
     };
-};
\ No newline at end of file
+};
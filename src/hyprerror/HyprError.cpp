@@ -6,7 +6,7 @@
 #include "../render/pass/TexPassElement.hpp"
 #include "../managers/animation/AnimationManager.hpp"
 #include "../render/Renderer.hpp"
-#include "../managers/HookSystemManager.hpp"
+#include "../managers/HookEvents.hpp"
 #include "../desktop/state/FocusState.hpp"
 
 #include <hyprutils/utils/ScopeGuard.hpp>
@@ -23,7 +23,7 @@ CHyprError::CHyprError() {
         m_monitorChanged = true;
     });
 
-    static auto P2 = g_pHookSystem->hookDynamic("preRender", [&](void* self, SCallbackInfo& info, std::any param) {
+    static auto P2 = g_pHookSystem->hook<HOOK_EVENT_PRE_RENDER>([&](SCallbackInfo& info, const PHLMONITOR& monitor) {
         if (!m_isCreated)
             return;
 
@@ -238,6 +238,8 @@ void CHyprDwindleLayout::applyNodeDataToWindow(SDwindleNodeData* pNode, bool for
                                PMONITOR->m_size.y + PMONITOR->m_position.y - PMONITOR->m_reservedBottomRight.y - gapsOut.m_bottom - calcSize.y - borderSize);
     }
 
+    bool geometryChanged = false;
+
     if (PWINDOW->onSpecialWorkspace() && !PWINDOW->isFullscreen()) {
         // if special, we adjust the coords a bit
         static auto PSCALEFACTOR = CConfigValue<Hyprlang::FLOAT>("dwindle:special_scale_factor");
@@ -245,14 +247,20 @@ void CHyprDwindleLayout::applyNodeDataToWindow(SDwindleNodeData* pNode, bool for
         CBox        wb = {calcPos + (calcSize - calcSize * *PSCALEFACTOR) / 2.f, calcSize * *PSCALEFACTOR};
         wb.round(); // avoid rounding mess
 
-        *PWINDOW->m_realPosition = wb.pos();
-        *PWINDOW->m_realSize     = wb.size();
+        if (wb.pos() != PWINDOW->m_realPosition->goal() || wb.size() != PWINDOW->m_realSize->goal()) {
+            *PWINDOW->m_realPosition = wb.pos();
+            *PWINDOW->m_realSize     = wb.size();
+            geometryChanged          = true;
+        }
     } else {
         CBox wb = {calcPos, calcSize};
         wb.round(); // avoid rounding mess
 
-        *PWINDOW->m_realSize     = wb.size();
-        *PWINDOW->m_realPosition = wb.pos();
+        if (wb.pos() != PWINDOW->m_realPosition->goal() || wb.size() != PWINDOW->m_realSize->goal()) {
+            *PWINDOW->m_realSize     = wb.size();
+            *PWINDOW->m_realPosition = wb.pos();
+            geometryChanged          = true;
+        }
     }
 
     if (force) {
@@ -264,7 +272,9 @@ void CHyprDwindleLayout::applyNodeDataToWindow(SDwindleNodeData* pNode, bool for
         g_pHyprRenderer->damageWindow(PWINDOW);
     }
 
-    PWINDOW->updateWindowDecos();
+    // decos were already updated for this box above, only redo them if the goal moved
+    if (geometryChanged || force)
+        PWINDOW->updateWindowDecos();
 }
 
 void CHyprDwindleLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection direction) {
@@ -480,7 +490,8 @@ void CHyprDwindleLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dir
 
     NEWPARENT->recalcSizePosRecursive(false, horizontalOverride, verticalOverride);
 
-    recalculateMonitor(pWindow->monitorID());
+    // the new split is already applied, the rest of the tree can be done in the coalesced pass
+    g_pLayoutManager->scheduleRecalc(pWindow->m_workspace);
     pWindow->m_workspace->updateWindows();
 }
 
@@ -554,6 +565,17 @@ void CHyprDwindleLayout::recalculateMonitor(const MONITORID& monid) {
 #endif
 }
 
+void CHyprDwindleLayout::recalculateWorkspace(const PHLWORKSPACE& pWorkspace) {
+    const auto PMONITOR = pWorkspace->m_monitor.lock();
+
+    if (!PMONITOR)
+        return;
+
+    g_pHyprRenderer->damageMonitor(PMONITOR);
+
+    calculateWorkspace(pWorkspace);
+}
+
 void CHyprDwindleLayout::calculateWorkspace(const PHLWORKSPACE& pWorkspace) {
     const auto PMONITOR = pWorkspace->m_monitor.lock();
 
@@ -48,6 +48,7 @@ class CHyprDwindleLayout : public IHyprLayout {
     virtual void                     onWindowRemovedTiling(PHLWINDOW);
     virtual bool                     isWindowTiled(PHLWINDOW);
     virtual void                     recalculateMonitor(const MONITORID&);
+    virtual void                     recalculateWorkspace(const PHLWORKSPACE&);
     virtual void                     recalculateWindow(PHLWINDOW);
     virtual void                     onBeginDragWindow();
     virtual void                     resizeActiveWindow(const Vector2D&, eRectCorner corner = CORNER_NONE, PHLWINDOW pWindow = nullptr);
@@ -16,6 +16,10 @@
 #include "../managers/cursor/CursorShapeOverrideController.hpp"
 #include "../desktop/rule/windowRule/WindowRule.hpp"
 
+void IHyprLayout::recalculateWorkspace(const PHLWORKSPACE& pWorkspace) {
+    recalculateMonitor(pWorkspace->monitorID());
+}
+
 void IHyprLayout::onWindowCreated(PHLWINDOW pWindow, eDirection direction) {
     CBox       desiredGeometry = g_pXWaylandManager->getGeometryForWindow(pWindow);
 
@@ -173,9 +177,9 @@ void IHyprLayout::onWindowCreatedFloating(PHLWINDOW pWindow) {
             if (!pWindow->m_isX11) {
                 if (const auto PARENT = pWindow->parent(); PARENT) {
                     *pWindow->m_realPosition = PARENT->m_realPosition->goal() + PARENT->m_realSize->goal() / 2.F - desiredGeometry.size() / 2.F;
-                    pWindow->m_workspace     = PARENT->m_workspace;
                     pWindow->m_monitor       = PARENT->m_monitor;
                     centeredOnParent         = true;
+                    pWindow->setWorkspace(PARENT->m_workspace);
                 }
             }
             if (!centeredOnParent)
@@ -968,8 +972,8 @@ Vector2D IHyprLayout::predictSizeForNewWindowFloating(PHLWINDOW pWindow) { // ge
             return STOREDSIZE.value();
         }
 
-        if (!pWindow->m_ruleApplicator->static_.size.empty()) {
-            const auto SIZE = pWindow->calculateExpression(pWindow->m_ruleApplicator->static_.size);
+        if (pWindow->m_ruleApplicator->static_.size) {
+            const auto SIZE = pWindow->m_ruleApplicator->static_.size->evaluate(pWindow);
             if (SIZE)
                 return SIZE.value();
         }
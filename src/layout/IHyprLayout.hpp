@@ -83,6 +83,12 @@ class IHyprLayout {
     */
     virtual void recalculateMonitor(const MONITORID&) = 0;
 
+    /*
+        Called when a coalesced recalc is flushed for a single visible workspace.
+        Defaults to recalculating the whole monitor the workspace is on.
+    */
+    virtual void recalculateWorkspace(const PHLWORKSPACE&);
+
     /*
         Called when the compositor requests a window
         to be recalculated, e.g. when pseudo is toggled.
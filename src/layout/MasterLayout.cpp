@@ -229,8 +229,8 @@ void CHyprMasterLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dire
         }
     }
 
-    // recalc
-    recalculateMonitor(pWindow->monitorID());
+    // a burst of new windows is laid out once, recalculateWindow places this one now if it's needed right away
+    g_pLayoutManager->scheduleRecalc(pWindow->m_workspace);
     pWindow->m_workspace->updateWindows();
 }
 
@@ -281,7 +281,7 @@ void CHyprMasterLayout::onWindowRemovedTiling(PHLWINDOW pWindow) {
             }
         }
     }
-    recalculateMonitor(pWindow->monitorID());
+    g_pLayoutManager->scheduleRecalc(pWindow->monitorID());
     pWindow->m_workspace->updateWindows();
 }
 
@@ -306,6 +306,17 @@ void CHyprMasterLayout::recalculateMonitor(const MONITORID& monid) {
 #endif
 }
 
+void CHyprMasterLayout::recalculateWorkspace(const PHLWORKSPACE& pWorkspace) {
+    const auto PMONITOR = pWorkspace->m_monitor.lock();
+
+    if (!PMONITOR)
+        return;
+
+    g_pHyprRenderer->damageMonitor(PMONITOR);
+
+    calculateWorkspace(pWorkspace);
+}
+
 void CHyprMasterLayout::calculateWorkspace(PHLWORKSPACE pWorkspace) {
     const auto PMONITOR = pWorkspace->m_monitor.lock();
 
@@ -724,23 +735,33 @@ void CHyprMasterLayout::applyNodeDataToWindow(SMasterNodeData* pNode) {
                                PMONITOR->m_size.y + PMONITOR->m_position.y - PMONITOR->m_reservedBottomRight.y - gapsOut.m_bottom - calcSize.y - borderSize);
     }
 
+    bool geometryChanged = false;
+
     if (PWINDOW->onSpecialWorkspace() && !PWINDOW->isFullscreen()) {
         static auto PSCALEFACTOR = CConfigValue<Hyprlang::FLOAT>("master:special_scale_factor");
 
         CBox        wb = {calcPos + (calcSize - calcSize * *PSCALEFACTOR) / 2.f, calcSize * *PSCALEFACTOR};
         wb.round(); // avoid rounding mess
 
-        *PWINDOW->m_realPosition = wb.pos();
-        *PWINDOW->m_realSize     = wb.size();
+        if (wb.pos() != PWINDOW->m_realPosition->goal() || wb.size() != PWINDOW->m_realSize->goal()) {
+            *PWINDOW->m_realPosition = wb.pos();
+            *PWINDOW->m_realSize     = wb.size();
+            geometryChanged          = true;
+        }
     } else {
         CBox wb = {calcPos, calcSize};
         wb.round(); // avoid rounding mess
 
-        *PWINDOW->m_realPosition = wb.pos();
-        *PWINDOW->m_realSize     = wb.size();
+        if (wb.pos() != PWINDOW->m_realPosition->goal() || wb.size() != PWINDOW->m_realSize->goal()) {
+            *PWINDOW->m_realPosition = wb.pos();
+            *PWINDOW->m_realSize     = wb.size();
+            geometryChanged          = true;
+        }
     }
 
-    if (m_forceWarps && !*PANIMATE) {
+    const bool WARP = m_forceWarps && !*PANIMATE;
+
+    if (WARP) {
         g_pHyprRenderer->damageWindow(PWINDOW);
 
         PWINDOW->m_realPosition->warp();
@@ -749,7 +770,9 @@ void CHyprMasterLayout::applyNodeDataToWindow(SMasterNodeData* pNode) {
         g_pHyprRenderer->damageWindow(PWINDOW);
     }
 
-    PWINDOW->updateWindowDecos();
+    // decos were already updated for this box above, only redo them if the goal moved
+    if (geometryChanged || WARP)
+        PWINDOW->updateWindowDecos();
 }
 
 bool CHyprMasterLayout::isWindowTiled(PHLWINDOW pWindow) {
@@ -954,10 +977,11 @@ void CHyprMasterLayout::fullscreenRequestForWindow(PHLWINDOW pWindow, const eFul
 void CHyprMasterLayout::recalculateWindow(PHLWINDOW pWindow) {
     const auto PNODE = getNodeFromWindow(pWindow);
 
-    if (!PNODE)
+    if (!PNODE || !pWindow->m_workspace)
         return;
 
-    recalculateMonitor(pWindow->monitorID());
+    // every tile of the workspace depends on the others, but nothing outside of it does
+    recalculateWorkspace(pWindow->m_workspace);
 }
 
 SWindowRenderLayoutHints CHyprMasterLayout::requestRenderHints(PHLWINDOW pWindow) {
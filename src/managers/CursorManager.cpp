@@ -106,6 +106,12 @@ CCursorManager::CCursorManager() {
     // and then later is disabled.
     m_xcursor->loadTheme(getenv("XCURSOR_THEME") ? getenv("XCURSOR_THEME") : "default", m_size, m_cursorScale);
 
+    // shapes decode in the background, the default cursor is shown until the one asked for is ready
+    m_xcursor->m_events.shapeDecoded.listenStatic([this](const std::string& shape) {
+        if (m_ourBufferConnected && shape == m_currentXcursorShape)
+            setCursorFromName(shape);
+    });
+
     m_animationTimer = makeShared<CEventLoopTimer>(std::nullopt, cursorAnimTimer, this);
     g_pEventLoopManager->addTimer(m_animationTimer);
 
@@ -165,12 +171,13 @@ void CCursorManager::setCursorFromName(const std::string& name) {
     auto        setXCursor = [this](auto const& name) {
         float scale = std::ceil(m_cursorScale);
 
-        auto  xcursor = m_xcursor->getShape(name, m_size, m_cursorScale);
+        auto  xcursor = m_xcursor->getShape(name, m_size, m_cursorScale, true);
         auto& icon    = xcursor->images.front();
         auto  buf     = makeShared<CCursorBuffer>(rc<uint8_t*>(icon.pixels.data()), icon.size, icon.hotspot);
         setCursorBuffer(buf, icon.hotspot / scale, scale);
 
-        m_currentXcursor = xcursor;
+        m_currentXcursor      = xcursor;
+        m_currentXcursorShape = name;
 
         int delay = 0;
         int frame = 0;
@@ -222,6 +229,8 @@ void CCursorManager::setCursorFromName(const std::string& name) {
         return true;
     };
 
+    m_currentXcursorShape.clear();
+
     if (!m_hyprcursor->valid() || !*PUSEHYPRCURSOR || !setHyprCursor(name))
         setXCursor(name);
 }
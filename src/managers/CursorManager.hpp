@@ -64,6 +64,7 @@ class CCursorManager {
     UP<Hyprcursor::CHyprcursorManager> m_hyprcursor;
     UP<CXCursorManager>                m_xcursor;
     SP<SXCursors>                      m_currentXcursor;
+    std::string                        m_currentXcursorShape;
 
     std::string                        m_theme       = "";
     int                                m_size        = 0;
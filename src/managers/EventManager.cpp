@@ -1,5 +1,6 @@
 #include "EventManager.hpp"
 #include "../Compositor.hpp"
+#include "../debug/HyprCtl.hpp"
 
 #include <algorithm>
 #include <netinet/in.h>
@@ -146,6 +147,10 @@ void CEventManager::postEvent(const SHyprIPCEvent& event) {
         return;
     }
 
+    // everything on the state page changes along with one of the events
+    if (g_pHyprCtl)
+        g_pHyprCtl->m_statePage.scheduleUpdate();
+
     const size_t MAX_QUEUED_EVENTS = 64;
     auto         sharedEvent       = makeShared<std::string>(formatEvent(event));
     for (auto it = m_clients.begin(); it != m_clients.end();) {
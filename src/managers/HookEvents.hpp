@@ -0,0 +1,76 @@
+#pragma once
+
+#include "HookSystemManager.hpp"
+#include "../devices/IPointer.hpp"
+#include "../devices/ITouch.hpp"
+#include "../devices/IKeyboard.hpp"
+#include "../devices/Tablet.hpp"
+
+#include <unordered_map>
+
+/*
+    Argument types of the typed hook events. box() builds what hookDynamic listeners of the
+    same event got before the typed API existed, and only runs when there are such listeners.
+*/
+
+struct SKeyPressHookArg {
+    SP<IKeyboard>       keyboard;
+    IKeyboard::SKeyEvent event;
+};
+
+template <typename T>
+struct SPlainHookEvent {
+    using arg = T;
+
+    static std::any box(const arg& a) {
+        return a;
+    }
+};
+
+template <>
+struct SHookEvent<HOOK_EVENT_RENDER> : SPlainHookEvent<eRenderStage> {};
+template <>
+struct SHookEvent<HOOK_EVENT_PRE_RENDER> : SPlainHookEvent<PHLMONITOR> {};
+template <>
+struct SHookEvent<HOOK_EVENT_TICK> : SPlainHookEvent<std::nullptr_t> {};
+template <>
+struct SHookEvent<HOOK_EVENT_MOUSE_MOVE> : SPlainHookEvent<Vector2D> {};
+template <>
+struct SHookEvent<HOOK_EVENT_MOUSE_BUTTON> : SPlainHookEvent<IPointer::SButtonEvent> {};
+template <>
+struct SHookEvent<HOOK_EVENT_TOUCH_DOWN> : SPlainHookEvent<ITouch::SDownEvent> {};
+template <>
+struct SHookEvent<HOOK_EVENT_TOUCH_UP> : SPlainHookEvent<ITouch::SUpEvent> {};
+template <>
+struct SHookEvent<HOOK_EVENT_TOUCH_MOVE> : SPlainHookEvent<ITouch::SMotionEvent> {};
+template <>
+struct SHookEvent<HOOK_EVENT_SWIPE_UPDATE> : SPlainHookEvent<IPointer::SSwipeUpdateEvent> {};
+template <>
+struct SHookEvent<HOOK_EVENT_PINCH_UPDATE> : SPlainHookEvent<IPointer::SPinchUpdateEvent> {};
+template <>
+struct SHookEvent<HOOK_EVENT_TABLET_TIP> : SPlainHookEvent<CTablet::STipEvent> {};
+template <>
+struct SHookEvent<HOOK_EVENT_PRE_MONITOR_COMMIT> : SPlainHookEvent<PHLMONITOR> {};
+template <>
+struct SHookEvent<HOOK_EVENT_WINDOW_UPDATE_RULES> : SPlainHookEvent<PHLWINDOW> {};
+template <>
+struct SHookEvent<HOOK_EVENT_WINDOW_TITLE> : SPlainHookEvent<PHLWINDOW> {};
+
+// these two used to be passed as a map
+template <>
+struct SHookEvent<HOOK_EVENT_MOUSE_AXIS> {
+    using arg = IPointer::SAxisEvent;
+
+    static std::any box(const arg& a) {
+        return std::unordered_map<std::string, std::any>{{"event", a}};
+    }
+};
+
+template <>
+struct SHookEvent<HOOK_EVENT_KEY_PRESS> {
+    using arg = SKeyPressHookArg;
+
+    static std::any box(const arg& a) {
+        return std::unordered_map<std::string, std::any>{{"keyboard", a.keyboard}, {"event", a.event}};
+    }
+};
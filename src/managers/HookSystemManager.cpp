@@ -3,13 +3,17 @@
 #include "../plugins/PluginSystem.hpp"
 
 CHookSystemManager::CHookSystemManager() {
-    ; //
+    // unordered_map values don't move, so these stay valid
+    for (size_t i = 0; i < HOOK_EVENT_COUNT; ++i) {
+        m_typedHooks[i].legacy = &m_registeredHooks[HOOK_EVENT_NAMES[i]];
+    }
 }
 
 // returns the pointer to the function
 SP<HOOK_CALLBACK_FN> CHookSystemManager::hookDynamic(const std::string& event, HOOK_CALLBACK_FN fn, HANDLE handle) {
     SP<HOOK_CALLBACK_FN> hookFN = makeShared<HOOK_CALLBACK_FN>(fn);
     m_registeredHooks[event].emplace_back(SCallbackFNPtr{.fn = hookFN, .handle = handle});
+    updateListenerCounts();
     return hookFN;
 }
 
@@ -21,6 +25,92 @@ void CHookSystemManager::unhook(SP<HOOK_CALLBACK_FN> fn) {
             return fn_.get() == fn.get();
         });
     }
+
+    updateListenerCounts();
+}
+
+SP<HOOK_TYPED_CALLBACK_FN> CHookSystemManager::hookTyped(eHookEvent event, HOOK_TYPED_CALLBACK_FN fn, HANDLE handle) {
+    SP<HOOK_TYPED_CALLBACK_FN> hookFN = makeShared<HOOK_TYPED_CALLBACK_FN>(std::move(fn));
+    m_typedHooks[event].callbacks.emplace_back(STypedCallbackFNPtr{.fn = hookFN, .handle = handle});
+    updateListenerCounts();
+    return hookFN;
+}
+
+void CHookSystemManager::unhook(SP<HOOK_TYPED_CALLBACK_FN> fn) {
+    for (auto& slot : m_typedHooks) {
+        std::erase_if(slot.callbacks, [&](const auto& other) { return other.fn.expired() || other.fn.get() == fn.get(); });
+    }
+
+    updateListenerCounts();
+}
+
+void CHookSystemManager::removeAllTypedHooksFrom(HANDLE handle) {
+    for (auto& slot : m_typedHooks) {
+        std::erase_if(slot.callbacks, [&](const auto& other) { return other.handle == handle; });
+    }
+
+    updateListenerCounts();
+}
+
+void CHookSystemManager::updateListenerCounts() {
+    for (auto& slot : m_typedHooks) {
+        slot.listeners = slot.callbacks.size() + slot.legacy->size();
+    }
+}
+
+void CHookSystemManager::unloadFaulty(const std::vector<HANDLE>& handles) {
+    for (auto const& h : handles)
+        g_pPluginSystem->unloadPlugin(g_pPluginSystem->getPluginByHandle(h), true);
+}
+
+void CHookSystemManager::emitTyped(STypedEventSlot& slot, SCallbackInfo& info, const void* arg) {
+    std::vector<HANDLE> faultyHandles;
+    volatile bool       needsDeadCleanup = false;
+
+    // by index, a callback may register another one
+    for (size_t i = 0; i < slot.callbacks.size(); ++i) {
+        const auto CB = slot.callbacks[i];
+
+        m_currentEventPlugin = false;
+
+        if (!CB.handle) {
+            // we don't guard hl hooks, and don't set up the jump buffer for them either
+
+            if (SP<HOOK_TYPED_CALLBACK_FN> fn = CB.fn.lock())
+                (*fn)(info, arg);
+            else
+                needsDeadCleanup = true;
+            continue;
+        }
+
+        m_currentEventPlugin = true;
+
+        if (std::ranges::find(faultyHandles, CB.handle) != faultyHandles.end())
+            continue;
+
+        try {
+            if (!setjmp(m_hookFaultJumpBuf)) {
+                if (SP<HOOK_TYPED_CALLBACK_FN> fn = CB.fn.lock())
+                    (*fn)(info, arg);
+                else
+                    needsDeadCleanup = true;
+            } else {
+                // this module crashed.
+                throw std::exception();
+            }
+        } catch (std::exception& e) {
+            faultyHandles.push_back(CB.handle);
+            Debug::log(ERR, "[hookSystem] Hook from plugin {:x} caused a SIGSEGV, queueing for unloading.", rc<uintptr_t>(CB.handle));
+        }
+    }
+
+    if (needsDeadCleanup) {
+        std::erase_if(slot.callbacks, [](const auto& fn) { return fn.fn.expired(); });
+        updateListenerCounts();
+    }
+
+    if (!faultyHandles.empty())
+        unloadFaulty(faultyHandles);
 }
 
 void CHookSystemManager::emit(std::vector<SCallbackFNPtr>* const callbacks, SCallbackInfo& info, std::any data) {
@@ -66,13 +156,13 @@ void CHookSystemManager::emit(std::vector<SCallbackFNPtr>* const callbacks, SCal
         }
     }
 
-    if (needsDeadCleanup)
+    if (needsDeadCleanup) {
         std::erase_if(*callbacks, [](const auto& fn) { return !fn.fn.lock(); });
-
-    if (!faultyHandles.empty()) {
-        for (auto const& h : faultyHandles)
-            g_pPluginSystem->unloadPlugin(g_pPluginSystem->getPluginByHandle(h), true);
+        updateListenerCounts();
     }
+
+    if (!faultyHandles.empty())
+        unloadFaulty(faultyHandles);
 }
 
 std::vector<SCallbackFNPtr>* CHookSystemManager::getVecForEvent(const std::string& event) {
@@ -20,6 +20,51 @@ struct SCallbackFNPtr {
     HANDLE               handle = nullptr;
 };
 
+/*
+    Typed hook events. These are the ones emitted per frame or per input event, so they skip the std::any boxing
+    and the plugin fault guard unless someone actually needs them: with nobody listening an emit is a single branch.
+
+    Each event has a concrete argument type, see SHookEvent in HookEvents.hpp. Their string names keep working
+    through hookDynamic, those listeners get the same std::any payload as before.
+*/
+enum eHookEvent : uint8_t {
+    HOOK_EVENT_RENDER = 0,
+    HOOK_EVENT_PRE_RENDER,
+    HOOK_EVENT_TICK,
+    HOOK_EVENT_MOUSE_MOVE,
+    HOOK_EVENT_MOUSE_BUTTON,
+    HOOK_EVENT_MOUSE_AXIS,
+    HOOK_EVENT_KEY_PRESS,
+    HOOK_EVENT_TOUCH_DOWN,
+    HOOK_EVENT_TOUCH_UP,
+    HOOK_EVENT_TOUCH_MOVE,
+    HOOK_EVENT_SWIPE_UPDATE,
+    HOOK_EVENT_PINCH_UPDATE,
+    HOOK_EVENT_TABLET_TIP,
+    HOOK_EVENT_PRE_MONITOR_COMMIT,
+    HOOK_EVENT_WINDOW_UPDATE_RULES,
+    HOOK_EVENT_WINDOW_TITLE,
+
+    HOOK_EVENT_COUNT,
+};
+
+// the string names of the above, for hookDynamic
+constexpr std::array<const char*, HOOK_EVENT_COUNT> HOOK_EVENT_NAMES = {"render",    "preRender", "tick",      "mouseMove",   "mouseButton", "mouseAxis",        "keyPress",
+                                                                        "touchDown", "touchUp",   "touchMove", "swipeUpdate", "pinchUpdate", "tabletTip",        "preMonitorCommit",
+                                                                        "windowUpdateRules", "windowTitle"};
+
+// specialized for each eHookEvent in HookEvents.hpp, with the argument type and the legacy std::any payload
+template <eHookEvent E>
+struct SHookEvent;
+
+template <eHookEvent E>
+using HOOK_EVENT_ARG = typename SHookEvent<E>::arg;
+
+struct STypedCallbackFNPtr {
+    WP<HOOK_TYPED_CALLBACK_FN> fn;
+    HANDLE                     handle = nullptr;
+};
+
 #define EMIT_HOOK_EVENT(name, param)                                                                                                                                               \
     {                                                                                                                                                                              \
         static auto* const PEVENTVEC = g_pHookSystem->getVecForEvent(name);                                                                                                        \
@@ -36,6 +81,21 @@ struct SCallbackFNPtr {
             return;                                                                                                                                                                \
     }
 
+// typed events need HookEvents.hpp where they're emitted
+#define EMIT_HOOK(event, param)                                                                                                                                                    \
+    {                                                                                                                                                                              \
+        SCallbackInfo info;                                                                                                                                                        \
+        g_pHookSystem->emit<event>(info, param);                                                                                                                                   \
+    }
+
+#define EMIT_HOOK_CANCELLABLE(event, param)                                                                                                                                        \
+    {                                                                                                                                                                              \
+        SCallbackInfo info;                                                                                                                                                        \
+        g_pHookSystem->emit<event>(info, param);                                                                                                                                   \
+        if (info.cancelled)                                                                                                                                                        \
+            return;                                                                                                                                                                \
+    }
+
 class CHookSystemManager {
   public:
     CHookSystemManager();
@@ -47,6 +107,30 @@ class CHookSystemManager {
                                                                                                              HANDLE handle = nullptr);
     void                                                                                         unhook(SP<HOOK_CALLBACK_FN> fn);
 
+    // same as hookDynamic, for typed events. Plugins have to pass their handle.
+    template <eHookEvent E>
+    [[nodiscard("Losing this pointer instantly unregisters the callback")]] SP<HOOK_TYPED_CALLBACK_FN> hook(std::function<void(SCallbackInfo&, const HOOK_EVENT_ARG<E>&)> fn,
+                                                                                                       HANDLE handle = nullptr) {
+        return hookTyped(E, [fn = std::move(fn)](SCallbackInfo& info, const void* arg) { fn(info, *sc<const HOOK_EVENT_ARG<E>*>(arg)); }, handle);
+    }
+
+    void unhook(SP<HOOK_TYPED_CALLBACK_FN> fn);
+    void removeAllTypedHooksFrom(HANDLE handle);
+
+    template <eHookEvent E>
+    void emit(SCallbackInfo& info, const HOOK_EVENT_ARG<E>& arg) {
+        auto& slot = m_typedHooks[E];
+
+        if (!slot.listeners) [[likely]]
+            return;
+
+        if (!slot.callbacks.empty())
+            emitTyped(slot, info, &arg);
+
+        if (!slot.legacy->empty())
+            emit(slot.legacy, info, SHookEvent<E>::box(arg));
+    }
+
     void                         emit(std::vector<SCallbackFNPtr>* const callbacks, SCallbackInfo& info, std::any data = 0);
     std::vector<SCallbackFNPtr>* getVecForEvent(const std::string& event);
 
@@ -54,7 +138,21 @@ class CHookSystemManager {
     jmp_buf                      m_hookFaultJumpBuf;
 
   private:
+    struct STypedEventSlot {
+        std::vector<STypedCallbackFNPtr> callbacks;
+        std::vector<SCallbackFNPtr>*     legacy = nullptr; // the hookDynamic listeners for the event's string name
+
+        // callbacks + legacy, kept up to date on (un)registration so emit only needs to check this
+        size_t listeners = 0;
+    };
+
+    SP<HOOK_TYPED_CALLBACK_FN>                                   hookTyped(eHookEvent event, HOOK_TYPED_CALLBACK_FN fn, HANDLE handle);
+    void                                                         emitTyped(STypedEventSlot& slot, SCallbackInfo& info, const void* arg);
+    void                                                         unloadFaulty(const std::vector<HANDLE>& handles);
+    void                                                         updateListenerCounts();
+
     std::unordered_map<std::string, std::vector<SCallbackFNPtr>> m_registeredHooks;
+    std::array<STypedEventSlot, HOOK_EVENT_COUNT>                m_typedHooks;
 };
 
 inline UP<CHookSystemManager> g_pHookSystem;
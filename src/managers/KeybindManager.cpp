@@ -1130,7 +1130,7 @@ static SDispatchResult toggleActiveFloatingCore(std::string args, std::optional<
         PWINDOW->m_workspace->updateWindowData();
     }
 
-    g_pLayoutManager->getCurrentLayout()->recalculateMonitor(PWINDOW->monitorID());
+    g_pLayoutManager->scheduleRecalc(PWINDOW->monitorID());
     g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
     return {};
@@ -1953,7 +1953,7 @@ SDispatchResult CKeybindManager::workspaceOpt(std::string args) {
     }
 
     // recalc mon
-    g_pLayoutManager->getCurrentLayout()->recalculateMonitor(Desktop::focusState()->monitor()->m_id);
+    g_pLayoutManager->scheduleRecalc(Desktop::focusState()->monitor()->m_id);
 
     return {};
 }
@@ -2721,7 +2721,7 @@ SDispatchResult CKeybindManager::pinActive(std::string args) {
         return {.success = false, .error = "pin: window not found"};
     }
 
-    PWINDOW->m_workspace = PMONITOR->m_activeWorkspace;
+    PWINDOW->setWorkspace(PMONITOR->m_activeWorkspace);
 
     PWINDOW->m_ruleApplicator->propertiesChanged(Desktop::Rule::RULE_PROP_PINNED);
 
@@ -3293,7 +3293,7 @@ SDispatchResult CKeybindManager::setProp(std::string args) {
         g_pConfigManager->ensureVRR(PWINDOW->m_monitor.lock());
 
     for (auto const& m : g_pCompositor->m_monitors)
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->m_id);
+        g_pLayoutManager->scheduleRecalc(m->m_id);
 
     return {};
 }
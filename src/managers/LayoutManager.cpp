@@ -1,4 +1,8 @@
 #include "LayoutManager.hpp"
+#include "../Compositor.hpp"
+#include "../desktop/Workspace.hpp"
+#include "eventLoop/EventLoopManager.hpp"
+#include "../xwayland/XWayland.hpp"
 
 CLayoutManager::CLayoutManager() {
     m_layouts.emplace_back(std::make_pair<>("dwindle", &m_dwindleLayout));
@@ -16,6 +20,7 @@ void CLayoutManager::switchToLayout(std::string layout) {
                 return;
 
             getCurrentLayout()->onDisable();
+            m_pendingRecalcs.workspaces.clear();
             m_currentLayoutID = i;
             getCurrentLayout()->onEnable();
             return;
@@ -58,3 +63,65 @@ std::vector<std::string> CLayoutManager::getAllLayoutNames() {
         results[i] = m_layouts[i].first;
     return results;
 }
+
+void CLayoutManager::scheduleRecalc(const MONITORID& id) {
+    const auto PMONITOR = g_pCompositor->getMonitorFromID(id);
+
+    if (!PMONITOR)
+        return;
+
+    // the layout only ever arranges what's visible, so that's what we mark
+    if (PMONITOR->m_activeSpecialWorkspace)
+        scheduleRecalc(PMONITOR->m_activeSpecialWorkspace);
+
+    if (PMONITOR->m_activeWorkspace)
+        scheduleRecalc(PMONITOR->m_activeWorkspace);
+}
+
+void CLayoutManager::scheduleRecalc(const PHLWORKSPACE& workspace) {
+    if (!workspace)
+        return;
+
+    m_pendingRecalcs.workspaces.emplace(workspace->m_id);
+
+    if (m_pendingRecalcs.idleScheduled || !g_pEventLoopManager)
+        return;
+
+    m_pendingRecalcs.idleScheduled = true;
+
+    g_pEventLoopManager->doLater([this] {
+        m_pendingRecalcs.idleScheduled = false;
+        flushPendingRecalcs();
+    });
+}
+
+void CLayoutManager::flushPendingRecalcs() {
+    if (m_pendingRecalcs.workspaces.empty())
+        return;
+
+    // take the set first, recalcs can schedule more recalcs
+    const auto DIRTY = std::move(m_pendingRecalcs.workspaces);
+    m_pendingRecalcs.workspaces.clear();
+
+    for (const auto& id : DIRTY) {
+        const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(id);
+
+        if (!valid(PWORKSPACE))
+            continue;
+
+        // hidden workspaces get recalculated when they are shown again
+        const auto PMONITOR = PWORKSPACE->m_monitor.lock();
+        if (!PMONITOR || (PMONITOR->m_activeWorkspace != PWORKSPACE && PMONITOR->m_activeSpecialWorkspace != PWORKSPACE))
+            continue;
+
+        getCurrentLayout()->recalculateWorkspace(PWORKSPACE);
+    }
+
+#ifndef NO_XWAYLAND
+    if (!g_pXWayland || !g_pXWayland->m_wm)
+        return;
+
+    CBox box = g_pCompositor->calculateX11WorkArea();
+    g_pXWayland->m_wm->updateWorkArea(box.x, box.y, box.w, box.h);
+#endif
+}
@@ -3,6 +3,8 @@
 #include "../layout/DwindleLayout.hpp"
 #include "../layout/MasterLayout.hpp"
 
+#include <unordered_set>
+
 class CLayoutManager {
   public:
     CLayoutManager();
@@ -15,6 +17,12 @@ class CLayoutManager {
     bool                     removeLayout(IHyprLayout* layout);
     std::vector<std::string> getAllLayoutNames();
 
+    // Coalesced layout recalcs. Requests are collected per workspace and
+    // applied in one pass before the next frame (or on idle, whichever is first)
+    void                     scheduleRecalc(const MONITORID& id);
+    void                     scheduleRecalc(const PHLWORKSPACE& workspace);
+    void                     flushPendingRecalcs();
+
   private:
     enum eHyprLayouts : uint8_t {
         LAYOUT_DWINDLE = 0,
@@ -26,6 +34,11 @@ class CLayoutManager {
     CHyprDwindleLayout                                m_dwindleLayout;
     CHyprMasterLayout                                 m_masterLayout;
     std::vector<std::pair<std::string, IHyprLayout*>> m_layouts;
+
+    struct {
+        std::unordered_set<WORKSPACEID> workspaces;
+        bool                            idleScheduled = false;
+    } m_pendingRecalcs;
 };
 
 inline UP<CLayoutManager> g_pLayoutManager;
@@ -11,7 +11,7 @@
 #include "eventLoop/EventLoopManager.hpp"
 #include "../render/pass/TexPassElement.hpp"
 #include "../managers/input/InputManager.hpp"
-#include "../managers/HookSystemManager.hpp"
+#include "../managers/HookEvents.hpp"
 #include "../render/Renderer.hpp"
 #include "../render/OpenGL.hpp"
 #include "../desktop/state/FocusState.hpp"
@@ -38,8 +38,8 @@ CPointerManager::CPointerManager() {
         });
     });
 
-    m_hooks.monitorPreRender = g_pHookSystem->hookDynamic("preMonitorCommit", [this](void* self, SCallbackInfo& info, std::any data) {
-        auto state = stateFor(std::any_cast<PHLMONITOR>(data));
+    m_hooks.monitorPreRender = g_pHookSystem->hook<HOOK_EVENT_PRE_MONITOR_COMMIT>([this](SCallbackInfo& info, const PHLMONITOR& monitor) {
+        auto state = stateFor(monitor);
         if (!state)
             return;
 
@@ -181,8 +181,8 @@ class CPointerManager {
     bool                                  setHWCursorBuffer(SP<SMonitorPointerState> state, SP<Aquamarine::IBuffer> buf);
 
     struct {
-        SP<HOOK_CALLBACK_FN> monitorAdded;
-        SP<HOOK_CALLBACK_FN> monitorPreRender;
+        SP<HOOK_CALLBACK_FN>       monitorAdded;
+        SP<HOOK_TYPED_CALLBACK_FN> monitorPreRender;
     } m_hooks;
 };
 
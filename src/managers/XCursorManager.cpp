@@ -14,10 +14,32 @@ extern "C" {
 #include "helpers/CursorShapes.hpp"
 #include "../managers/CursorManager.hpp"
 #include "debug/Log.hpp"
+#include "helpers/MainLoopExecutor.hpp"
+#include "managers/eventLoop/EventLoopManager.hpp"
+#include "render/AsyncResourceGatherer.hpp"
 #include "XCursorManager.hpp"
 #include <memory>
 #include <variant>
 
+// decodes one shape on a gatherer thread. m_cursor is only read on the main thread once finished fired.
+class CXCursorDecodeResource : public Hyprgraphics::IAsyncResource {
+  public:
+    CXCursorDecodeResource(std::string shape, std::string path, int size) : m_shape(std::move(shape)), m_path(std::move(path)), m_size(size) {
+        ;
+    }
+
+    virtual void render() {
+        m_cursor = CXCursorManager::decodeFile(m_shape, m_path, m_size);
+    }
+
+    SP<SXCursors> m_cursor;
+
+  private:
+    std::string m_shape;
+    std::string m_path;
+    int         m_size = 0;
+};
+
 // clang-format off
 static std::vector<uint32_t> HYPR_XCURSOR_PIXELS = {
     0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x1b001816, 0x01000101, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
@@ -109,6 +131,8 @@ CXCursorManager::CXCursorManager() {
     m_defaultCursor     = m_hyprCursor;
 }
 
+CXCursorManager::~CXCursorManager() = default;
+
 void CXCursorManager::loadTheme(std::string const& name, int size, float scale) {
     if (m_lastLoadSize == (size * std::ceil(scale)) && m_themeName == name && m_lastLoadScale == scale)
         return;
@@ -118,6 +142,12 @@ void CXCursorManager::loadTheme(std::string const& name, int size, float scale)
     m_themeName     = name.empty() ? "default" : name;
     m_defaultCursor.reset();
     m_cursors.clear();
+    m_index.clear();
+    m_lru.clear();
+    m_lruLookup.clear();
+
+    // decodes still in flight are for the old theme, they get dropped once they land
+    m_themeGeneration++;
 
     auto paths = themePaths(m_themeName);
     if (paths.empty()) {
@@ -126,14 +156,12 @@ void CXCursorManager::loadTheme(std::string const& name, int size, float scale)
     } else {
         for (auto const& p : paths) {
             try {
-                auto dirCursors = loadAllFromDir(p, m_lastLoadSize);
-                std::ranges::copy_if(dirCursors, std::back_inserter(m_cursors),
-                                     [this](auto const& p) { return std::ranges::none_of(m_cursors, [&p](auto const& dp) { return dp->shape == p->shape; }); });
-            } catch (std::exception& e) { Debug::log(ERR, "XCursor path {} can't be loaded: threw error {}", p, e.what()); }
+                indexDir(p);
+            } catch (std::exception& e) { Debug::log(ERR, "XCursor path {} can't be indexed: threw error {}", p, e.what()); }
         }
     }
 
-    if (m_cursors.empty()) {
+    if (m_cursors.empty() && m_index.empty()) {
         Debug::log(ERR, "XCursor failed finding any shapes in theme \"{}\".", m_themeName);
         m_defaultCursor = m_hyprCursor;
         return;
@@ -144,6 +172,23 @@ void CXCursorManager::loadTheme(std::string const& name, int size, float scale)
         if (legacyName.empty())
             continue;
 
+        if (!m_index.empty()) {
+            if (m_index.contains(shape)) {
+                Debug::log(LOG, "XCursor already has a shape {} indexed, skipping", shape);
+                continue;
+            }
+
+            const auto IT = m_index.find(legacyName);
+            if (IT == m_index.end()) {
+                Debug::log(LOG, "XCursor failed to find a legacy shape with name {}, skipping", legacyName);
+                continue;
+            }
+
+            auto file = IT->second;
+            m_index.emplace(shape, std::move(file));
+            continue;
+        }
+
         auto it = std::ranges::find_if(m_cursors, [&legacyName](auto const& c) { return c->shape == legacyName; });
 
         if (it == m_cursors.end()) {
@@ -163,24 +208,134 @@ void CXCursorManager::loadTheme(std::string const& name, int size, float scale)
         m_cursors.emplace_back(cursor);
     }
 
+    // the default is what gets shown while other shapes decode, so it's the one shape decoded right away
+    if (!m_index.empty()) {
+        for (auto const& shape : {"left_ptr", "arrow"}) {
+            if (m_defaultCursor)
+                break;
+
+            if (m_index.contains(shape))
+                m_defaultCursor = decodeFile(shape, m_index.at(shape), m_lastLoadSize);
+        }
+
+        // broken theme.. just set it.
+        for (auto it = m_index.begin(); !m_defaultCursor && it != m_index.end(); ++it) {
+            m_defaultCursor = decodeFile(it->first, it->second, m_lastLoadSize);
+        }
+
+        if (!m_defaultCursor) {
+            Debug::log(ERR, "XCursor failed decoding any shape in theme \"{}\".", m_themeName);
+            m_defaultCursor = m_hyprCursor;
+        } else
+            cache(std::format("{}@{}x{}", m_defaultCursor->shape, size, scale), m_defaultCursor);
+    }
+
+    Debug::log(LOG, "XCursor indexed {} shapes for theme \"{}\"", m_index.empty() ? m_cursors.size() : m_index.size(), m_themeName);
+
     syncGsettings();
 }
 
-SP<SXCursors> CXCursorManager::getShape(std::string const& shape, int size, float scale) {
-    // monitor scaling changed etc, so reload theme with new size.
-    if ((size * std::ceil(scale)) != m_lastLoadSize || scale != m_lastLoadScale)
-        loadTheme(m_themeName, size, scale);
+SP<SXCursors> CXCursorManager::getShape(std::string const& shape, int size, float scale, bool async) {
+    // without a library path everything got loaded upfront at one size, reload for a new one
+    if (m_index.empty()) {
+        if ((size * std::ceil(scale)) != m_lastLoadSize || scale != m_lastLoadScale)
+            loadTheme(m_themeName, size, scale);
 
-    // try to get an icon we know if we have one
-    for (auto const& c : m_cursors) {
-        if (c->shape != shape)
-            continue;
+        for (auto const& c : m_cursors) {
+            if (c->shape != shape)
+                continue;
+
+            return c;
+        }
+
+        Debug::log(WARN, "XCursor couldn't find shape {} , using default cursor instead", shape);
+        return m_defaultCursor;
+    }
+
+    const auto KEY = std::format("{}@{}x{}", shape, size, scale);
+
+    if (const auto IT = m_lruLookup.find(KEY); IT != m_lruLookup.end()) {
+        m_lru.splice(m_lru.begin(), m_lru, IT->second);
+        return IT->second->cursor;
+    }
+
+    const auto FILE = m_index.find(shape);
+    if (FILE == m_index.end()) {
+        Debug::log(WARN, "XCursor couldn't find shape {} , using default cursor instead", shape);
+        return m_defaultCursor;
+    }
+
+    const int PIXELSIZE = size * std::ceil(scale);
+
+    if (async && g_pAsyncResourceGatherer) {
+        if (!m_pending.contains(KEY))
+            decodeAsync(KEY, shape, FILE->second, PIXELSIZE);
+
+        return m_defaultCursor;
+    }
+
+    auto cursor = decodeFile(shape, FILE->second, PIXELSIZE);
+    if (!cursor) {
+        Debug::log(WARN, "XCursor failed to decode {}, using default cursor instead", FILE->second);
+        cursor = m_defaultCursor;
+    }
+
+    // failures get cached as the default too, no point in hitting the disk for them again
+    cache(KEY, cursor);
+    return cursor;
+}
+
+void CXCursorManager::cache(std::string const& key, SP<SXCursors> cursor) {
+    if (const auto IT = m_lruLookup.find(key); IT != m_lruLookup.end()) {
+        IT->second->cursor = cursor;
+        m_lru.splice(m_lru.begin(), m_lru, IT->second);
+        return;
+    }
+
+    m_lru.emplace_front(SCachedShape{.key = key, .cursor = cursor});
+    m_lruLookup[key] = m_lru.begin();
+
+    while (m_lru.size() > MAX_CACHED_SHAPES) {
+        m_lruLookup.erase(m_lru.back().key);
+        m_lru.pop_back();
+    }
+}
+
+void CXCursorManager::decodeAsync(std::string const& key, std::string const& shape, std::string const& path, int size) {
+    auto       resource   = makeAtomicShared<CXCursorDecodeResource>(shape, path, size);
+    const auto GENERATION = m_themeGeneration;
+
+    // owned by the resource through the listener, so the resource can't be dropped from inside the executor
+    SP<CMainLoopExecutor> executor = makeShared<CMainLoopExecutor>([this, key, shape, GENERATION] {
+        g_pEventLoopManager->doLater([this, key, shape, GENERATION] { onDecoded(key, shape, GENERATION); });
+    });
+
+    resource->m_events.finished.listenStatic([executor] {
+        // this is in the worker thread.
+        executor->signal();
+    });
+
+    m_pending[key] = SPendingDecode{.resource = resource, .generation = GENERATION};
+    g_pAsyncResourceGatherer->enqueue(resource);
+}
+
+void CXCursorManager::onDecoded(std::string const& key, std::string const& shape, uint64_t generation) {
+    const auto IT = m_pending.find(key);
+    if (IT == m_pending.end() || IT->second.generation != generation)
+        return;
+
+    const auto CURSOR = IT->second.resource->m_cursor;
+    m_pending.erase(IT);
+
+    // a stale one still gets announced, whoever waited for it asks again and gets it decoded from the new theme
+    if (generation == m_themeGeneration) {
+        if (!CURSOR)
+            Debug::log(WARN, "XCursor failed to decode shape {}, using default cursor instead", shape);
 
-        return c;
+        cache(key, CURSOR ? CURSOR : m_defaultCursor);
     }
 
-    Debug::log(WARN, "XCursor couldn't find shape {} , using default cursor instead", shape);
-    return m_defaultCursor;
+    m_events.shapeDecoded.emit(shape);
 }
 
 SP<SXCursors> CXCursorManager::createCursor(std::string const& shape, void* ximages) {
@@ -521,52 +676,44 @@ std::vector<SP<SXCursors>> CXCursorManager::loadStandardCursors(std::string cons
     return newCursors;
 }
 
-std::vector<SP<SXCursors>> CXCursorManager::loadAllFromDir(std::string const& path, int size) {
-    std::vector<SP<SXCursors>> newCursors;
-
-    if (std::filesystem::exists(path) && std::filesystem::is_directory(path)) {
-        for (const auto& entry : std::filesystem::directory_iterator(path)) {
-            std::error_code e1, e2;
-            if ((!entry.is_regular_file(e1) && !entry.is_symlink(e2)) || e1 || e2) {
-                Debug::log(WARN, "XCursor failed to load shape {}: {}", entry.path().stem().string(), e1 ? e1.message() : e2.message());
-                continue;
-            }
-
-            auto const& full = entry.path().string();
-            using PcloseType = int (*)(FILE*);
-            const std::unique_ptr<FILE, PcloseType> f(fopen(full.c_str(), "r"), fclose);
+void CXCursorManager::indexDir(std::string const& path) {
+    if (!std::filesystem::exists(path) || !std::filesystem::is_directory(path))
+        return;
 
-            if (!f)
-                continue;
+    for (const auto& entry : std::filesystem::directory_iterator(path)) {
+        std::error_code e1, e2;
+        if ((!entry.is_regular_file(e1) && !entry.is_symlink(e2)) || e1 || e2) {
+            Debug::log(WARN, "XCursor failed to index shape {}: {}", entry.path().stem().string(), e1 ? e1.message() : e2.message());
+            continue;
+        }
 
-            auto xImages = XcursorFileLoadImages(f.get(), size);
+        // first theme path providing a shape wins
+        m_index.try_emplace(entry.path().filename().string(), entry.path().string());
+    }
+}
 
-            if (!xImages) {
-                Debug::log(WARN, "XCursor failed to load image {}, trying size 24.", full);
-                xImages = XcursorFileLoadImages(f.get(), 24);
+// runs on the gatherer threads too, so no logging in here
+SP<SXCursors> CXCursorManager::decodeFile(std::string const& shape, std::string const& path, int size) {
+    using PcloseType = int (*)(FILE*);
+    const std::unique_ptr<FILE, PcloseType> f(fopen(path.c_str(), "r"), fclose);
 
-                if (!xImages) {
-                    Debug::log(WARN, "XCursor failed to load image {}, skipping", full);
-                    continue;
-                }
-            }
+    if (!f)
+        return nullptr;
 
-            auto const& shape  = entry.path().filename().string();
-            auto        cursor = createCursor(shape, xImages);
-            newCursors.emplace_back(cursor);
+    auto xImages = XcursorFileLoadImages(f.get(), size);
 
-            if (!m_defaultCursor && (shape == "left_ptr" || shape == "arrow"))
-                m_defaultCursor = cursor;
+    if (!xImages) {
+        rewind(f.get());
+        xImages = XcursorFileLoadImages(f.get(), 24);
 
-            XcursorImagesDestroy(xImages);
-        }
+        if (!xImages)
+            return nullptr;
     }
 
-    // broken theme.. just set it.
-    if (!newCursors.empty() && !m_defaultCursor)
-        m_defaultCursor = newCursors.front();
+    auto cursor = createCursor(shape, xImages);
+    XcursorImagesDestroy(xImages);
 
-    return newCursors;
+    return cursor;
 }
 
 void CXCursorManager::syncGsettings() {
@@ -3,9 +3,12 @@
 #include <vector>
 #include <set>
 #include <array>
+#include <list>
+#include <unordered_map>
 #include <cstdint>
 #include <hyprutils/math/Vector2D.hpp>
 #include "helpers/memory/Memory.hpp"
+#include "helpers/signal/Signal.hpp"
 
 // gangsta bootleg XCursor impl. adidas balkanized
 struct SXCursorImage {
@@ -20,26 +23,65 @@ struct SXCursors {
     std::string                shape;
 };
 
+class CXCursorDecodeResource;
+
+/*
+    Loading a theme only indexes which file provides which shape, images get decoded the first time
+    a shape is asked for and are kept in a small LRU keyed by (shape, size, scale).
+*/
 class CXCursorManager {
   public:
     CXCursorManager();
-    ~CXCursorManager() = default;
+    ~CXCursorManager();
 
     void          loadTheme(const std::string& name, int size, float scale);
-    SP<SXCursors> getShape(std::string const& shape, int size, float scale);
+    // with async, a shape that isn't decoded yet gets decoded on the resource gatherer and the default cursor is returned meanwhile.
+    // m_events.shapeDecoded fires once it can be asked for again.
+    SP<SXCursors> getShape(std::string const& shape, int size, float scale, bool async = false);
     void          syncGsettings();
 
+    struct {
+        CSignalT<std::string> shapeDecoded;
+    } m_events;
+
   private:
-    SP<SXCursors>              createCursor(std::string const& shape, void* /* XcursorImages* */ xImages);
+    struct SCachedShape {
+        std::string   key;
+        SP<SXCursors> cursor;
+    };
+
+    struct SPendingDecode {
+        ASP<CXCursorDecodeResource> resource;
+        uint64_t                    generation = 0;
+    };
+
+    static SP<SXCursors>       createCursor(std::string const& shape, void* /* XcursorImages* */ xImages);
+    static SP<SXCursors>       decodeFile(std::string const& shape, std::string const& path, int size);
     std::set<std::string>      themePaths(std::string const& theme);
     std::string                getLegacyShapeName(std::string const& shape);
     std::vector<SP<SXCursors>> loadStandardCursors(std::string const& name, int size);
-    std::vector<SP<SXCursors>> loadAllFromDir(std::string const& path, int size);
+    void                       indexDir(std::string const& path);
+    void                       cache(std::string const& key, SP<SXCursors> cursor);
+    void                       decodeAsync(std::string const& key, std::string const& shape, std::string const& path, int size);
+    void                       onDecoded(std::string const& key, std::string const& shape, uint64_t generation);
 
     int                        m_lastLoadSize  = 0;
     float                      m_lastLoadScale = 0;
     std::string                m_themeName     = "";
     SP<SXCursors>              m_defaultCursor;
     SP<SXCursors>              m_hyprCursor;
+
+    // shape name -> file providing it, legacy names included
+    std::unordered_map<std::string, std::string> m_index;
+    // only used without a library path, where the standard shapes get loaded upfront
     std::vector<SP<SXCursors>> m_cursors;
+
+    std::list<SCachedShape>                                             m_lru; // most recently used first
+    std::unordered_map<std::string, std::list<SCachedShape>::iterator> m_lruLookup;
+    std::unordered_map<std::string, SPendingDecode>                     m_pending;
+    uint64_t                                                            m_themeGeneration = 0;
+
+    static constexpr size_t                                             MAX_CACHED_SHAPES = 32;
+
+    friend class CXCursorDecodeResource;
 };
@@ -102,15 +102,15 @@ void CHyprXWaylandManager::sendCloseWindow(PHLWINDOW pWindow) {
 bool CHyprXWaylandManager::shouldBeFloated(PHLWINDOW pWindow, bool pending) {
     if (pWindow->m_isX11) {
         for (const auto& a : pWindow->m_xwaylandSurface->m_atoms)
-            if (a == HYPRATOMS["_NET_WM_WINDOW_TYPE_DIALOG"] || a == HYPRATOMS["_NET_WM_WINDOW_TYPE_SPLASH"] || a == HYPRATOMS["_NET_WM_WINDOW_TYPE_TOOLBAR"] ||
-                a == HYPRATOMS["_NET_WM_WINDOW_TYPE_UTILITY"] || a == HYPRATOMS["_NET_WM_WINDOW_TYPE_TOOLTIP"] || a == HYPRATOMS["_NET_WM_WINDOW_TYPE_POPUP_MENU"] ||
-                a == HYPRATOMS["_NET_WM_WINDOW_TYPE_DOCK"] || a == HYPRATOMS["_NET_WM_WINDOW_TYPE_DROPDOWN_MENU"] || a == HYPRATOMS["_NET_WM_WINDOW_TYPE_MENU"] ||
-                a == HYPRATOMS["_KDE_NET_WM_WINDOW_TYPE_OVERRIDE"]) {
+            if (a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_DIALOG] || a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_SPLASH] || a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_TOOLBAR] ||
+                a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_UTILITY] || a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_TOOLTIP] || a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_POPUP_MENU] ||
+                a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_DOCK] || a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_DROPDOWN_MENU] || a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_MENU] ||
+                a == HYPRATOMS[HA_KDE_NET_WM_WINDOW_TYPE_OVERRIDE]) {
 
-                if (a == HYPRATOMS["_NET_WM_WINDOW_TYPE_DROPDOWN_MENU"] || a == HYPRATOMS["_NET_WM_WINDOW_TYPE_MENU"])
+                if (a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_DROPDOWN_MENU] || a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_MENU])
                     pWindow->m_X11ShouldntFocus = true;
 
-                if (a != HYPRATOMS["_NET_WM_WINDOW_TYPE_DIALOG"])
+                if (a != HYPRATOMS[HA_NET_WM_WINDOW_TYPE_DIALOG])
                     pWindow->m_noInitialFocus = true;
 
                 return true;
@@ -142,9 +142,9 @@ void CHyprXWaylandManager::checkBorders(PHLWINDOW pWindow) {
         return;
 
     for (auto const& a : pWindow->m_xwaylandSurface->m_atoms) {
-        if (a == HYPRATOMS["_NET_WM_WINDOW_TYPE_POPUP_MENU"] || a == HYPRATOMS["_NET_WM_WINDOW_TYPE_NOTIFICATION"] || a == HYPRATOMS["_NET_WM_WINDOW_TYPE_DROPDOWN_MENU"] ||
-            a == HYPRATOMS["_NET_WM_WINDOW_TYPE_COMBO"] || a == HYPRATOMS["_NET_WM_WINDOW_TYPE_MENU"] || a == HYPRATOMS["_NET_WM_WINDOW_TYPE_SPLASH"] ||
-            a == HYPRATOMS["_NET_WM_WINDOW_TYPE_TOOLTIP"]) {
+        if (a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_POPUP_MENU] || a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_NOTIFICATION] || a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_DROPDOWN_MENU] ||
+            a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_COMBO] || a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_MENU] || a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_SPLASH] ||
+            a == HYPRATOMS[HA_NET_WM_WINDOW_TYPE_TOOLTIP]) {
 
             pWindow->m_X11DoesntWantBorders = true;
             return;
@@ -1,6 +1,6 @@
 #include "AnimationManager.hpp"
 #include "../../Compositor.hpp"
-#include "../HookSystemManager.hpp"
+#include "../HookEvents.hpp"
 #include "../../config/ConfigManager.hpp"
 #include "../../desktop/DesktopTypes.hpp"
 #include "../../helpers/AnimatedVariable.hpp"
@@ -255,7 +255,7 @@ void CHyprAnimationManager::frameTick() {
         m_lastTickValid = true;
 
         tick();
-        EMIT_HOOK_EVENT("tick", nullptr);
+        EMIT_HOOK(HOOK_EVENT_TICK, nullptr);
     }
 
     if (shouldTickForNext())
@@ -36,10 +36,11 @@
 #include "../../managers/SeatManager.hpp"
 #include "../../managers/KeybindManager.hpp"
 #include "../../render/Renderer.hpp"
-#include "../../managers/HookSystemManager.hpp"
+#include "../../managers/HookEvents.hpp"
 #include "../../managers/EventManager.hpp"
 #include "../../managers/LayoutManager.hpp"
 #include "../../managers/permissions/DynamicPermissionManager.hpp"
+#include "../../debug/FrameTrace.hpp"
 
 #include "../../helpers/time/Time.hpp"
 #include "../../helpers/MiscFunctions.hpp"
@@ -111,6 +112,8 @@ CInputManager::~CInputManager() {
 }
 
 void CInputManager::onMouseMoved(IPointer::SMotionEvent e) {
+    TRACE_SCOPE("input: motion");
+
     static auto PNOACCEL = CConfigValue<Hyprlang::INT>("input:force_no_accel");
 
     Vector2D    delta   = e.delta;
@@ -220,7 +223,7 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus, bool mouse, st
     PHLWINDOW              pFoundWindow;
     PHLLS                  pFoundLayerSurface;
 
-    EMIT_HOOK_EVENT_CANCELLABLE("mouseMove", MOUSECOORDSFLOORED);
+    EMIT_HOOK_CANCELLABLE(HOOK_EVENT_MOUSE_MOVE, MOUSECOORDSFLOORED);
 
     m_lastCursorPosFloored = MOUSECOORDSFLOORED;
 
@@ -621,7 +624,9 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus, bool mouse, st
 }
 
 void CInputManager::onMouseButton(IPointer::SButtonEvent e) {
-    EMIT_HOOK_EVENT_CANCELLABLE("mouseButton", e);
+    TRACE_SCOPE("input: button");
+
+    EMIT_HOOK_CANCELLABLE(HOOK_EVENT_MOUSE_BUTTON, e);
 
     if (e.mouse)
         recheckMouseWarpOnMouseInput();
@@ -826,6 +831,8 @@ void CInputManager::processMouseDownKill(const IPointer::SButtonEvent& e) {
 }
 
 void CInputManager::onMouseWheel(IPointer::SAxisEvent e, SP<IPointer> pointer) {
+    TRACE_SCOPE("input: axis");
+
     static auto POFFWINDOWAXIS        = CConfigValue<Hyprlang::INT>("input:off_window_axis_events");
     static auto PINPUTSCROLLFACTOR    = CConfigValue<Hyprlang::FLOAT>("input:scroll_factor");
     static auto PTOUCHPADSCROLLFACTOR = CConfigValue<Hyprlang::FLOAT>("input:touchpad:scroll_factor");
@@ -838,8 +845,7 @@ void CInputManager::onMouseWheel(IPointer::SAxisEvent e, SP<IPointer> pointer) {
     if (pointer && pointer->m_scrollFactor.has_value())
         factor = *pointer->m_scrollFactor;
 
-    const auto EMAP = std::unordered_map<std::string, std::any>{{"event", e}};
-    EMIT_HOOK_EVENT_CANCELLABLE("mouseAxis", EMAP);
+    EMIT_HOOK_CANCELLABLE(HOOK_EVENT_MOUSE_AXIS, e);
 
     if (e.mouse)
         recheckMouseWarpOnMouseInput();
@@ -1422,6 +1428,8 @@ void CInputManager::updateKeyboardsLeds(SP<IKeyboard> pKeyboard) {
 }
 
 void CInputManager::onKeyboardKey(const IKeyboard::SKeyEvent& event, SP<IKeyboard> pKeyboard) {
+    TRACE_SCOPE("input: key");
+
     if (!pKeyboard->m_enabled || !pKeyboard->m_allowed)
         return;
 
@@ -1431,8 +1439,8 @@ void CInputManager::onKeyboardKey(const IKeyboard::SKeyEvent& event, SP<IKeyboar
     const bool HASIME = IME && IME->hasGrab();
     const bool USEIME = HASIME && !DISALLOWACTION;
 
-    const auto EMAP = std::unordered_map<std::string, std::any>{{"keyboard", pKeyboard}, {"event", event}};
-    EMIT_HOOK_EVENT_CANCELLABLE("keyPress", EMAP);
+    const auto HOOKARG = SKeyPressHookArg{.keyboard = pKeyboard, .event = event};
+    EMIT_HOOK_CANCELLABLE(HOOK_EVENT_KEY_PRESS, HOOKARG);
 
     bool passEvent = DISALLOWACTION;
 
@@ -1997,7 +2005,7 @@ void CInputManager::onSwipeBegin(IPointer::SSwipeBeginEvent e) {
 }
 
 void CInputManager::onSwipeUpdate(IPointer::SSwipeUpdateEvent e) {
-    EMIT_HOOK_EVENT_CANCELLABLE("swipeUpdate", e);
+    EMIT_HOOK_CANCELLABLE(HOOK_EVENT_SWIPE_UPDATE, e);
 
     g_pTrackpadGestures->gestureUpdate(e);
 
@@ -2021,7 +2029,7 @@ void CInputManager::onPinchBegin(IPointer::SPinchBeginEvent e) {
 }
 
 void CInputManager::onPinchUpdate(IPointer::SPinchUpdateEvent e) {
-    EMIT_HOOK_EVENT_CANCELLABLE("pinchUpdate", e);
+    EMIT_HOOK_CANCELLABLE(HOOK_EVENT_PINCH_UPDATE, e);
 
     g_pTrackpadGestures->gestureUpdate(e);
 
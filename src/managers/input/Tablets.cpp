@@ -2,7 +2,7 @@
 #include "../../desktop/Window.hpp"
 #include "../../protocols/Tablet.hpp"
 #include "../../devices/Tablet.hpp"
-#include "../../managers/HookSystemManager.hpp"
+#include "../../managers/HookEvents.hpp"
 #include "../../managers/PointerManager.hpp"
 #include "../../managers/SeatManager.hpp"
 #include "../../protocols/PointerConstraints.hpp"
@@ -169,7 +169,7 @@ void CInputManager::onTabletAxis(CTablet::SAxisEvent e) {
 }
 
 void CInputManager::onTabletTip(CTablet::STipEvent e) {
-    EMIT_HOOK_EVENT_CANCELLABLE("tabletTip", e);
+    EMIT_HOOK_CANCELLABLE(HOOK_EVENT_TABLET_TIP, e);
 
     const auto PTAB  = e.tablet;
     const auto PTOOL = ensureTabletToolPresent(e.tool);
@@ -8,11 +8,14 @@
 #include "../../helpers/Monitor.hpp"
 #include "../../devices/ITouch.hpp"
 #include "../SeatManager.hpp"
-#include "../HookSystemManager.hpp"
+#include "../HookEvents.hpp"
 #include "debug/Log.hpp"
+#include "debug/FrameTrace.hpp"
 #include "UnifiedWorkspaceSwipeGesture.hpp"
 
 void CInputManager::onTouchDown(ITouch::SDownEvent e) {
+    TRACE_SCOPE("input: touch down");
+
     m_lastInputTouch = true;
 
     static auto PSWIPETOUCH  = CConfigValue<Hyprlang::INT>("gestures:workspace_swipe_touch");
@@ -22,7 +25,7 @@ void CInputManager::onTouchDown(ITouch::SDownEvent e) {
     auto        gapsOut     = *PGAPSOUT;
     static auto PBORDERSIZE = CConfigValue<Hyprlang::INT>("general:border_size");
     static auto PSWIPEINVR  = CConfigValue<Hyprlang::INT>("gestures:workspace_swipe_touch_invert");
-    EMIT_HOOK_EVENT_CANCELLABLE("touchDown", e);
+    EMIT_HOOK_CANCELLABLE(HOOK_EVENT_TOUCH_DOWN, e);
 
     auto PMONITOR = g_pCompositor->getMonitorFromName(!e.device->m_boundOutput.empty() ? e.device->m_boundOutput : "");
 
@@ -107,9 +110,11 @@ void CInputManager::onTouchDown(ITouch::SDownEvent e) {
 }
 
 void CInputManager::onTouchUp(ITouch::SUpEvent e) {
+    TRACE_SCOPE("input: touch up");
+
     m_lastInputTouch = true;
 
-    EMIT_HOOK_EVENT_CANCELLABLE("touchUp", e);
+    EMIT_HOOK_CANCELLABLE(HOOK_EVENT_TOUCH_UP, e);
     if (g_pUnifiedWorkspaceSwipe->isGestureInProgress()) {
         // If there was a swipe from this finger, end it.
         if (e.touchID == g_pUnifiedWorkspaceSwipe->m_touchID)
@@ -122,11 +127,13 @@ void CInputManager::onTouchUp(ITouch::SUpEvent e) {
 }
 
 void CInputManager::onTouchMove(ITouch::SMotionEvent e) {
+    TRACE_SCOPE("input: touch motion");
+
     m_lastInputTouch = true;
 
     m_lastCursorMovement.reset();
 
-    EMIT_HOOK_EVENT_CANCELLABLE("touchMove", e);
+    EMIT_HOOK_CANCELLABLE(HOOK_EVENT_TOUCH_MOVE, e);
     if (g_pUnifiedWorkspaceSwipe->isGestureInProgress()) {
         // Do nothing if this is using a different finger.
         if (e.touchID != g_pUnifiedWorkspaceSwipe->m_touchID)
@@ -151,6 +151,9 @@ namespace HyprlandAPI {
         returns: a pointer to the newly allocated function. nullptr on fail.
 
         WARNING: Losing this pointer will unregister the callback!
+
+        For the per-frame and input events (see eHookEvent), g_pHookSystem->hook<EVENT>(fn, handle) gets
+        the argument typed, without going through std::any.
     */
     APICALL [[nodiscard]] SP<HOOK_CALLBACK_FN> registerCallbackDynamic(HANDLE handle, const std::string& event, HOOK_CALLBACK_FN fn);
 
@@ -160,6 +160,7 @@ void CPluginSystem::unloadPlugin(const CPlugin* plugin, bool eject) {
     for (auto const& l : ls)
         g_pLayoutManager->removeLayout(l);
 
+    g_pHookSystem->removeAllTypedHooksFrom(plugin->m_handle);
     g_pFunctionHookSystem->removeAllHooksFrom(plugin->m_handle);
 
     const auto rd = plugin->m_registeredDecorations;
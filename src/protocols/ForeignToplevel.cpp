@@ -1,6 +1,6 @@
 #include "ForeignToplevel.hpp"
 #include "../Compositor.hpp"
-#include "../managers/HookSystemManager.hpp"
+#include "../managers/HookEvents.hpp"
 
 CForeignToplevelHandle::CForeignToplevelHandle(SP<CExtForeignToplevelHandleV1> resource_, PHLWINDOW pWindow_) : m_resource(resource_), m_window(pWindow_) {
     if UNLIKELY (!resource_->resource())
@@ -145,9 +145,7 @@ CForeignToplevelProtocol::CForeignToplevelProtocol(const wl_interface* iface, co
         }
     });
 
-    static auto P2 = g_pHookSystem->hookDynamic("windowTitle", [this](void* self, SCallbackInfo& info, std::any data) {
-        auto window = std::any_cast<PHLWINDOW>(data);
-
+    static auto P2 = g_pHookSystem->hook<HOOK_EVENT_WINDOW_TITLE>([this](SCallbackInfo& info, const PHLWINDOW& window) {
         if (!windowValidForForeign(window))
             return;
 
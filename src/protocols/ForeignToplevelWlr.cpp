@@ -5,7 +5,7 @@
 #include "../managers/input/InputManager.hpp"
 #include "../desktop/state/FocusState.hpp"
 #include "../render/Renderer.hpp"
-#include "../managers/HookSystemManager.hpp"
+#include "../managers/HookEvents.hpp"
 #include "../managers/EventManager.hpp"
 
 CForeignToplevelHandleWlr::CForeignToplevelHandleWlr(SP<CZwlrForeignToplevelHandleV1> resource_, PHLWINDOW pWindow_) : m_resource(resource_), m_window(pWindow_) {
@@ -359,9 +359,7 @@ CForeignToplevelWlrProtocol::CForeignToplevelWlrProtocol(const wl_interface* ifa
         }
     });
 
-    static auto P2 = g_pHookSystem->hookDynamic("windowTitle", [this](void* self, SCallbackInfo& info, std::any data) {
-        const auto PWINDOW = std::any_cast<PHLWINDOW>(data);
-
+    static auto P2 = g_pHookSystem->hook<HOOK_EVENT_WINDOW_TITLE>([this](SCallbackInfo& info, const PHLWINDOW& PWINDOW) {
         if (!windowValidForForeign(PWINDOW))
             return;
 
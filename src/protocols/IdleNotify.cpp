@@ -1,81 +1,59 @@
 #include "IdleNotify.hpp"
 #include "../managers/eventLoop/EventLoopManager.hpp"
 
-static int onTimer(SP<CEventLoopTimer> self, void* data) {
-
-    const auto NOTIF = sc<CExtIdleNotification*>(data);
-
-    NOTIF->onTimerFired();
-
-    return 0;
-}
-
 CExtIdleNotification::CExtIdleNotification(SP<CExtIdleNotificationV1> resource_, uint32_t timeoutMs_, bool obeyInhibitors_) :
-    m_resource(resource_), m_timeoutMs(timeoutMs_), m_obeyInhibitors(obeyInhibitors_) {
+    m_resource(resource_), m_timeoutMs(timeoutMs_), m_since(Time::steadyNow()), m_obeyInhibitors(obeyInhibitors_) {
     if UNLIKELY (!resource_->resource())
         return;
 
     m_resource->setDestroy([this](CExtIdleNotificationV1* r) { PROTO::idle->destroyNotification(this); });
     m_resource->setOnDestroy([this](CExtIdleNotificationV1* r) { PROTO::idle->destroyNotification(this); });
 
-    m_timer = makeShared<CEventLoopTimer>(std::nullopt, onTimer, this);
-    g_pEventLoopManager->addTimer(m_timer);
-
-    update();
-
     LOGM(LOG, "Registered idle-notification for {}ms", timeoutMs_);
 }
 
-CExtIdleNotification::~CExtIdleNotification() {
-    g_pEventLoopManager->removeTimer(m_timer);
-    m_timer.reset();
-}
-
 bool CExtIdleNotification::good() {
     return m_resource->resource();
 }
 
-void CExtIdleNotification::update(uint32_t elapsedMs) {
-    m_timer->updateTimeout(std::nullopt);
+std::optional<Time::steady_tp> CExtIdleNotification::deadline() {
+    if (m_obeyInhibitors && PROTO::idle->isInhibited && !PROTO::idle->m_forced)
+        return std::nullopt;
 
-    if (elapsedMs == 0 && PROTO::idle->isInhibited && m_obeyInhibitors) {
-        reset();
-        return;
-    }
-
-    if (m_timeoutMs > elapsedMs) {
-        reset();
-        m_timer->updateTimeout(std::chrono::milliseconds(m_timeoutMs - elapsedMs));
-    } else
-        onTimerFired();
-}
-
-void CExtIdleNotification::update() {
-    update(0);
+    return std::max(m_since, PROTO::idle->m_lastActivity) + std::chrono::milliseconds(m_timeoutMs);
 }
 
-void CExtIdleNotification::onTimerFired() {
+void CExtIdleNotification::idle() {
     if (m_idled)
         return;
 
     m_resource->sendIdled();
     m_idled = true;
+    PROTO::idle->m_idledCount++;
 }
 
-void CExtIdleNotification::reset() {
+void CExtIdleNotification::resume() {
     if (!m_idled)
         return;
 
     m_resource->sendResumed();
     m_idled = false;
+    PROTO::idle->m_idledCount--;
 }
 
 bool CExtIdleNotification::inhibitorsAreObeyed() const {
     return m_obeyInhibitors;
 }
 
-CIdleNotifyProtocol::CIdleNotifyProtocol(const wl_interface* iface, const int& ver, const std::string& name) : IWaylandProtocol(iface, ver, name) {
-    ;
+CIdleNotifyProtocol::CIdleNotifyProtocol(const wl_interface* iface, const int& ver, const std::string& name) :
+    IWaylandProtocol(iface, ver, name), m_lastActivity(Time::steadyNow()) {
+    m_timer = makeShared<CEventLoopTimer>(std::nullopt, [this](SP<CEventLoopTimer> self, void* data) { checkDeadlines(); }, nullptr);
+    g_pEventLoopManager->addTimer(m_timer);
+}
+
+CIdleNotifyProtocol::~CIdleNotifyProtocol() {
+    if (g_pEventLoopManager)
+        g_pEventLoopManager->removeTimer(m_timer);
 }
 
 void CIdleNotifyProtocol::bindManager(wl_client* client, void* data, uint32_t ver, uint32_t id) {
@@ -94,6 +72,9 @@ void CIdleNotifyProtocol::onManagerResourceDestroy(wl_resource* res) {
 }
 
 void CIdleNotifyProtocol::destroyNotification(CExtIdleNotification* notif) {
+    if (notif->m_idled)
+        m_idledCount--;
+
     std::erase_if(m_notifications, [&](const auto& other) { return other.get() == notif; });
 }
 
@@ -107,24 +88,75 @@ void CIdleNotifyProtocol::onGetNotification(CExtIdleNotifierV1* pMgr, uint32_t i
         m_notifications.pop_back();
         return;
     }
+
+    checkDeadlines();
+}
+
+void CIdleNotifyProtocol::checkDeadlines() {
+    const auto                     NOW = Time::steadyNow();
+    std::optional<Time::steady_tp> next;
+
+    for (auto const& n : m_notifications) {
+        if (n->m_idled)
+            continue;
+
+        const auto DEADLINE = n->deadline();
+        if (!DEADLINE)
+            continue;
+
+        if (*DEADLINE <= NOW) {
+            n->idle();
+            continue;
+        }
+
+        if (!next || *DEADLINE < *next)
+            next = DEADLINE;
+    }
+
+    m_timer->updateTimeout(next ? std::optional<Time::steady_dur>{*next - NOW} : std::nullopt);
 }
 
 void CIdleNotifyProtocol::onActivity() {
+    m_lastActivity = Time::steadyNow();
+    m_forced       = false;
+
+    // the armed timer may be for a deadline that just moved, it'll rearm itself when it fires
+    if (m_idledCount == 0)
+        return;
+
     for (auto const& n : m_notifications) {
-        n->update();
+        n->resume();
     }
+
+    checkDeadlines();
 }
 
 void CIdleNotifyProtocol::setInhibit(bool inhibited) {
     isInhibited = inhibited;
+
+    const auto NOW = Time::steadyNow();
     for (auto const& n : m_notifications) {
-        if (n->inhibitorsAreObeyed())
-            n->update();
+        if (!n->inhibitorsAreObeyed())
+            continue;
+
+        // idle time of the ones that obey starts over once the inhibitor is gone
+        n->m_since = NOW;
+        if (inhibited)
+            n->resume();
     }
+
+    checkDeadlines();
 }
 
 void CIdleNotifyProtocol::setTimers(uint32_t elapsedMs) {
+    m_lastActivity = Time::steadyNow() - std::chrono::milliseconds(elapsedMs);
+    m_forced       = true;
+
     for (auto const& n : m_notifications) {
-        n->update(elapsedMs);
+        n->m_since = m_lastActivity;
+        if (n->m_timeoutMs > elapsedMs)
+            n->resume();
     }
+
+    checkDeadlines();
 }
@@ -4,37 +4,45 @@
 #include <unordered_map>
 #include "WaylandProtocol.hpp"
 #include "ext-idle-notify-v1.hpp"
+#include "../helpers/time/Time.hpp"
 
 class CEventLoopTimer;
 
 class CExtIdleNotification {
   public:
     CExtIdleNotification(SP<CExtIdleNotificationV1> resource_, uint32_t timeoutMs, bool obeyInhibitors);
-    ~CExtIdleNotification();
+    ~CExtIdleNotification() = default;
 
     bool good();
-    void onTimerFired();
 
     bool inhibitorsAreObeyed() const;
 
   private:
     SP<CExtIdleNotificationV1> m_resource;
     uint32_t                   m_timeoutMs = 0;
-    SP<CEventLoopTimer>        m_timer;
 
-    bool                       m_idled          = false;
-    bool                       m_obeyInhibitors = false;
+    // idle time counts from whichever is later, this or the last activity
+    Time::steady_tp m_since;
 
-    void                       reset();
-    void                       update();
-    void                       update(uint32_t elapsedMs);
+    bool            m_idled          = false;
+    bool            m_obeyInhibitors = false;
+
+    // nullopt if an inhibitor keeps this from idling
+    std::optional<Time::steady_tp> deadline();
+    void                           idle();
+    void                           resume();
 
     friend class CIdleNotifyProtocol;
 };
 
+/*
+    Input only bumps m_lastActivity. A single timer is armed for the earliest deadline, and
+    when it fires the deadlines are checked against the activity time as it is by then.
+*/
 class CIdleNotifyProtocol : public IWaylandProtocol {
   public:
     CIdleNotifyProtocol(const wl_interface* iface, const int& ver, const std::string& name);
+    virtual ~CIdleNotifyProtocol();
 
     virtual void bindManager(wl_client* client, void* data, uint32_t ver, uint32_t id);
 
@@ -47,11 +55,20 @@ class CIdleNotifyProtocol : public IWaylandProtocol {
     void destroyNotification(CExtIdleNotification* notif);
     void onGetNotification(CExtIdleNotifierV1* pMgr, uint32_t id, uint32_t timeout, wl_resource* seat, bool obeyInhibitors);
 
+    // idles whatever is past its deadline and rearms the timer for the next one
+    void checkDeadlines();
+
     bool isInhibited = false;
 
+    // set by setTimers, makes inhibitors ignored until the next activity
+    bool            m_forced     = false;
+    size_t          m_idledCount = 0;
+    Time::steady_tp m_lastActivity;
+
     //
     std::vector<UP<CExtIdleNotifierV1>>   m_managers;
     std::vector<SP<CExtIdleNotification>> m_notifications;
+    SP<CEventLoopTimer>                   m_timer;
 
     friend class CExtIdleNotification;
 };
@@ -4,6 +4,7 @@
 #include "../managers/PointerManager.hpp"
 #include "../managers/input/InputManager.hpp"
 #include "../managers/EventManager.hpp"
+#include "../managers/HookEvents.hpp"
 #include "../managers/permissions/DynamicPermissionManager.hpp"
 #include "../render/Renderer.hpp"
 #include "../render/OpenGL.hpp"
@@ -440,7 +441,7 @@ CScreencopyClient::CScreencopyClient(SP<CZwlrScreencopyManagerV1> resource_) : m
 
     m_lastMeasure.reset();
     m_lastFrame.reset();
-    m_tickCallback = g_pHookSystem->hookDynamic("tick", [&](void* self, SCallbackInfo& info, std::any data) { onTick(); });
+    m_tickCallback = g_pHookSystem->hook<HOOK_EVENT_TICK>([&](SCallbackInfo& info, std::nullptr_t) { onTick(); });
 }
 
 void CScreencopyClient::captureOutput(uint32_t frame, int32_t overlayCursor_, wl_resource* output, CBox box) {
@@ -43,7 +43,7 @@ class CScreencopyClient {
     CTimer                       m_lastMeasure;
     bool                         m_sentScreencast = false;
 
-    SP<HOOK_CALLBACK_FN>         m_tickCallback;
+    SP<HOOK_TYPED_CALLBACK_FN>   m_tickCallback;
     void                         onTick();
 
     void                         captureOutput(uint32_t frame, int32_t overlayCursor, wl_resource* output, CBox box);
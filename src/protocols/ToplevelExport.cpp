@@ -7,6 +7,7 @@
 #include "types/Buffer.hpp"
 #include "../helpers/Format.hpp"
 #include "../managers/EventManager.hpp"
+#include "../managers/HookEvents.hpp"
 #include "../managers/input/InputManager.hpp"
 #include "../managers/permissions/DynamicPermissionManager.hpp"
 #include "../render/Renderer.hpp"
@@ -29,7 +30,7 @@ CToplevelExportClient::CToplevelExportClient(SP<CHyprlandToplevelExportManagerV1
 
     m_lastMeasure.reset();
     m_lastFrame.reset();
-    m_tickCallback = g_pHookSystem->hookDynamic("tick", [&](void* self, SCallbackInfo& info, std::any data) { onTick(); });
+    m_tickCallback = g_pHookSystem->hook<HOOK_EVENT_TICK>([&](SCallbackInfo& info, std::nullptr_t) { onTick(); });
 }
 
 void CToplevelExportClient::captureToplevel(CHyprlandToplevelExportManagerV1* pMgr, uint32_t frame, int32_t overlayCursor_, PHLWINDOW handle) {
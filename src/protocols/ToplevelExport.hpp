@@ -30,7 +30,7 @@ class CToplevelExportClient {
     CTimer                               m_lastMeasure;
     bool                                 m_sentScreencast = false;
 
-    SP<HOOK_CALLBACK_FN>                 m_tickCallback;
+    SP<HOOK_TYPED_CALLBACK_FN>           m_tickCallback;
     void                                 onTick();
 
     void                                 captureToplevel(CHyprlandToplevelExportManagerV1* pMgr, uint32_t frame, int32_t overlayCursor, PHLWINDOW handle);
@@ -10,7 +10,7 @@
 #include "../../xwayland/XWayland.hpp"
 #include "../../xwayland/Server.hpp"
 #include "../../managers/input/InputManager.hpp"
-#include "../../managers/HookSystemManager.hpp"
+#include "../../managers/HookEvents.hpp"
 #include "../../managers/cursor/CursorShapeOverrideController.hpp"
 #include "../../helpers/Monitor.hpp"
 #include "../../render/Renderer.hpp"
@@ -579,29 +579,26 @@ void CWLDataDeviceProtocol::initiateDrag(WP<CWLDataSourceResource> currentSource
         });
     }
 
-    m_dnd.mouseButton = g_pHookSystem->hookDynamic("mouseButton", [this](void* self, SCallbackInfo& info, std::any e) {
-        auto E = std::any_cast<IPointer::SButtonEvent>(e);
+    m_dnd.mouseButton = g_pHookSystem->hook<HOOK_EVENT_MOUSE_BUTTON>([this](SCallbackInfo& info, const IPointer::SButtonEvent& E) {
         if (E.state == WL_POINTER_BUTTON_STATE_RELEASED) {
             LOGM(LOG, "Dropping drag on mouseUp");
             dropDrag();
         }
     });
 
-    m_dnd.touchUp = g_pHookSystem->hookDynamic("touchUp", [this](void* self, SCallbackInfo& info, std::any e) {
+    m_dnd.touchUp = g_pHookSystem->hook<HOOK_EVENT_TOUCH_UP>([this](SCallbackInfo& info, const ITouch::SUpEvent& e) {
         LOGM(LOG, "Dropping drag on touchUp");
         dropDrag();
     });
 
-    m_dnd.tabletTip = g_pHookSystem->hookDynamic("tabletTip", [this](void* self, SCallbackInfo& info, std::any e) {
-        auto E = std::any_cast<CTablet::STipEvent>(e);
+    m_dnd.tabletTip = g_pHookSystem->hook<HOOK_EVENT_TABLET_TIP>([this](SCallbackInfo& info, const CTablet::STipEvent& E) {
         if (!E.in) {
             LOGM(LOG, "Dropping drag on tablet tipUp");
             dropDrag();
         }
     });
 
-    m_dnd.mouseMove = g_pHookSystem->hookDynamic("mouseMove", [this](void* self, SCallbackInfo& info, std::any e) {
-        auto V = std::any_cast<const Vector2D>(e);
+    m_dnd.mouseMove = g_pHookSystem->hook<HOOK_EVENT_MOUSE_MOVE>([this](SCallbackInfo& info, const Vector2D& V) {
         if (m_dnd.focusedDevice && g_pSeatManager->m_state.dndPointerFocus) {
             auto surf = CWLSurface::fromResource(g_pSeatManager->m_state.dndPointerFocus.lock());
 
@@ -618,8 +615,7 @@ void CWLDataDeviceProtocol::initiateDrag(WP<CWLDataSourceResource> currentSource
         }
     });
 
-    m_dnd.touchMove = g_pHookSystem->hookDynamic("touchMove", [this](void* self, SCallbackInfo& info, std::any e) {
-        auto E = std::any_cast<ITouch::SMotionEvent>(e);
+    m_dnd.touchMove = g_pHookSystem->hook<HOOK_EVENT_TOUCH_MOVE>([this](SCallbackInfo& info, const ITouch::SMotionEvent& E) {
         if (m_dnd.focusedDevice && g_pSeatManager->m_state.dndPointerFocus) {
             auto surf = CWLSurface::fromResource(g_pSeatManager->m_state.dndPointerFocus.lock());
 
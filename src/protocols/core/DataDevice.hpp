@@ -176,11 +176,11 @@ class CWLDataDeviceProtocol : public IWaylandProtocol {
         CHyprSignalListener    dndSurfaceCommit;
 
         // for ending a dnd
-        SP<HOOK_CALLBACK_FN> mouseMove;
-        SP<HOOK_CALLBACK_FN> mouseButton;
-        SP<HOOK_CALLBACK_FN> touchUp;
-        SP<HOOK_CALLBACK_FN> touchMove;
-        SP<HOOK_CALLBACK_FN> tabletTip;
+        SP<HOOK_TYPED_CALLBACK_FN> mouseMove;
+        SP<HOOK_TYPED_CALLBACK_FN> mouseButton;
+        SP<HOOK_TYPED_CALLBACK_FN> touchUp;
+        SP<HOOK_TYPED_CALLBACK_FN> touchMove;
+        SP<HOOK_TYPED_CALLBACK_FN> tabletTip;
     } m_dnd;
 
     void abortDrag();
@@ -0,0 +1,273 @@
+#include "ColorLUT.hpp"
+#include "../protocols/types/ColorManagement.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+using namespace NColorManagement;
+
+// a port of CM.glsl, keep the two in sync. Matrices are column major like in glsl.
+namespace {
+    using vec3 = std::array<double, 3>;
+    using mat3 = std::array<double, 9>;
+
+    constexpr double SRGB_POW   = 2.4;
+    constexpr double SRGB_CUT   = 0.0031308;
+    constexpr double SRGB_SCALE = 12.92;
+    constexpr double SRGB_ALPHA = 1.055;
+
+    constexpr double BT1886_POW   = 1.0 / 0.45;
+    constexpr double BT1886_CUT   = 0.018053968510807;
+    constexpr double BT1886_SCALE = 4.5;
+    constexpr double BT1886_ALPHA = 1.0 + 5.5 * BT1886_CUT;
+
+    constexpr double ST240_POW   = 1.0 / 0.45;
+    constexpr double ST240_CUT   = 0.0228;
+    constexpr double ST240_SCALE = 4.0;
+    constexpr double ST240_ALPHA = 1.1115;
+
+    constexpr double ST428_POW   = 2.6;
+    constexpr double ST428_SCALE = 52.37 / 48.0;
+
+    constexpr double PQ_M1 = 0.1593017578125;
+    constexpr double PQ_M2 = 78.84375;
+    constexpr double PQ_C1 = 0.8359375;
+    constexpr double PQ_C2 = 18.8515625;
+    constexpr double PQ_C3 = 18.6875;
+
+    constexpr double HLG_D_CUT = 1.0 / 12.0;
+    constexpr double HLG_E_CUT = 0.5;
+    constexpr double HLG_A     = 0.17883277;
+    constexpr double HLG_B     = 0.28466892;
+    constexpr double HLG_C     = 0.55991073;
+
+    constexpr double SDR_MAX_LUMINANCE = 80.0;
+    constexpr double HDR_MAX_LUMINANCE = 10000.0;
+
+    constexpr mat3   BT2020_TO_LMS = {0.3592, 0.6976, -0.0358, -0.1922, 1.1004, 0.0755, 0.0070, 0.0749, 0.8434};
+    constexpr mat3   LMS_TO_BT2020 = {2.0701800566956135096,    -1.3264568761030210255,    0.20661600684785517081,    0.36498825003265747974, 0.68046736285223514102,
+                                      -0.045421753075853231409, -0.049595542238932107896, -0.049421161186757487412, 1.1879959417328034394};
+    constexpr mat3   ICTCP_PQ      = {0.5, 1.61376953125, 4.378173828125, 0.5, -3.323486328125, -4.24560546875, 0.0, 1.709716796875, -0.132568359375};
+    constexpr mat3   ICTCP_PQ_INV  = {1.0, 1.0, 1.0, 0.0086090370379327566, -0.0086090370379327566, 0.560031335710679118, 0.11102962500302595656, -0.11102962500302595656,
+                                      -0.32062717498731885185};
+
+    vec3 mul(const mat3& m, const vec3& v) {
+        return {m[0] * v[0] + m[3] * v[1] + m[6] * v[2], m[1] * v[0] + m[4] * v[1] + m[7] * v[2], m[2] * v[0] + m[5] * v[1] + m[8] * v[2]};
+    }
+
+    mat3 mul(const mat3& a, const mat3& b) {
+        mat3 result;
+        for (int c = 0; c < 3; ++c) {
+            for (int r = 0; r < 3; ++r) {
+                result[c * 3 + r] = a[r] * b[c * 3] + a[3 + r] * b[c * 3 + 1] + a[6 + r] * b[c * 3 + 2];
+            }
+        }
+        return result;
+    }
+
+    mat3 inverse(const mat3& m) {
+        // element (row r, column c) is m[c * 3 + r]
+        const double a = m[0], b = m[3], c = m[6];
+        const double d = m[1], e = m[4], f = m[7];
+        const double g = m[2], h = m[5], i = m[8];
+
+        const double A = e * i - f * h, B = -(d * i - f * g), C = d * h - e * g;
+        const double det = a * A + b * B + c * C;
+        if (det == 0)
+            return {};
+
+        const double inv = 1.0 / det;
+        // column major again
+        return {A * inv, B * inv, C * inv, -(b * i - c * h) * inv, (a * i - c * g) * inv, -(a * h - b * g) * inv, (b * f - c * e) * inv, -(a * f - c * d) * inv,
+                (a * e - b * d) * inv};
+    }
+
+    vec3 xy2xyz(double x, double y) {
+        if (y == 0.0)
+            return {0, 0, 0};
+
+        return {x / y, 1.0, (1.0 - x - y) / y};
+    }
+
+    mat3 primaries2xyz(const std::array<float, 8>& p) {
+        const auto r = xy2xyz(p[0], p[1]);
+        const auto g = xy2xyz(p[2], p[3]);
+        const auto b = xy2xyz(p[4], p[5]);
+        const auto w = xy2xyz(p[6], p[7]);
+        const auto s = mul(inverse({r[0], r[1], r[2], g[0], g[1], g[2], b[0], b[1], b[2]}), w);
+
+        return {s[0] * r[0], s[0] * r[1], s[0] * r[2], s[1] * g[0], s[1] * g[1], s[1] * g[2], s[2] * b[0], s[2] * b[1], s[2] * b[2]};
+    }
+
+    double sign(double v) {
+        return v > 0 ? 1.0 : (v < 0 ? -1.0 : 0.0);
+    }
+
+    double tfInvPQ(double c) {
+        const double E = std::pow(std::clamp(c, 0.0, 1.0), 1.0 / PQ_M2);
+        return std::pow(std::max(E - PQ_C1, 0.0) / (PQ_C2 - PQ_C3 * E), 1.0 / PQ_M1);
+    }
+
+    double tfInvHLG(double c) {
+        return c <= HLG_E_CUT ? c * c / 3.0 : (std::exp((c - HLG_C) / HLG_A) + HLG_B) / 12.0;
+    }
+
+    double tfInvLinPow(double c, double gamma, double thres, double scale, double alpha) {
+        return c <= thres * scale ? c / scale : std::pow((c + alpha - 1.0) / alpha, gamma);
+    }
+
+    double tfPQ(double c) {
+        const double E = std::pow(std::clamp(c, 0.0, 1.0), PQ_M1);
+        return std::pow((PQ_C1 + PQ_C2 * E) / (1.0 + PQ_C3 * E), PQ_M2);
+    }
+
+    double tfHLG(double c) {
+        return c <= HLG_D_CUT ? std::sqrt(std::max(c, 0.0) * 3.0) : HLG_A * std::log(std::max(12.0 * c - HLG_B, 0.0001)) + HLG_C;
+    }
+
+    double tfLinPow(double c, double gamma, double thres, double scale, double alpha) {
+        return c <= thres ? c * scale : std::pow(c, 1.0 / gamma) * alpha - (alpha - 1.0);
+    }
+
+    double toLinear(double c, int tf) {
+        switch (tf) {
+            case CM_TRANSFER_FUNCTION_EXT_LINEAR: return c;
+            case CM_TRANSFER_FUNCTION_ST2084_PQ: return tfInvPQ(c);
+            case CM_TRANSFER_FUNCTION_GAMMA22: return std::pow(std::max(c, 0.0), 2.2);
+            case CM_TRANSFER_FUNCTION_GAMMA28: return std::pow(std::max(c, 0.0), 2.8);
+            case CM_TRANSFER_FUNCTION_HLG: return tfInvHLG(c);
+            case CM_TRANSFER_FUNCTION_EXT_SRGB: return sign(c) * tfInvLinPow(std::abs(c), SRGB_POW, SRGB_CUT, SRGB_SCALE, SRGB_ALPHA);
+            case CM_TRANSFER_FUNCTION_BT1886: return tfInvLinPow(c, BT1886_POW, BT1886_CUT, BT1886_SCALE, BT1886_ALPHA);
+            case CM_TRANSFER_FUNCTION_ST240: return tfInvLinPow(c, ST240_POW, ST240_CUT, ST240_SCALE, ST240_ALPHA);
+            case CM_TRANSFER_FUNCTION_LOG_100: return c <= 0.0 ? 0.0 : std::exp((c - 1.0) * 2.0 * std::numbers::ln10);
+            case CM_TRANSFER_FUNCTION_LOG_316: return c <= 0.0 ? 0.0 : std::exp((c - 1.0) * 2.5 * std::numbers::ln10);
+            case CM_TRANSFER_FUNCTION_XVYCC: return sign(c) * tfInvLinPow(std::abs(c), BT1886_POW, BT1886_CUT, BT1886_SCALE, BT1886_ALPHA);
+            case CM_TRANSFER_FUNCTION_ST428: return std::pow(std::max(c, 0.0), ST428_POW) * ST428_SCALE;
+            case CM_TRANSFER_FUNCTION_SRGB:
+            default: return tfInvLinPow(c, SRGB_POW, SRGB_CUT, SRGB_SCALE, SRGB_ALPHA);
+        }
+    }
+
+    double fromLinear(double c, int tf) {
+        switch (tf) {
+            case CM_TRANSFER_FUNCTION_EXT_LINEAR: return c;
+            case CM_TRANSFER_FUNCTION_ST2084_PQ: return tfPQ(c);
+            case CM_TRANSFER_FUNCTION_GAMMA22: return std::pow(std::max(c, 0.0), 1.0 / 2.2);
+            case CM_TRANSFER_FUNCTION_GAMMA28: return std::pow(std::max(c, 0.0), 1.0 / 2.8);
+            case CM_TRANSFER_FUNCTION_HLG: return tfHLG(c);
+            case CM_TRANSFER_FUNCTION_EXT_SRGB: return sign(c) * tfLinPow(std::abs(c), SRGB_POW, SRGB_CUT, SRGB_SCALE, SRGB_ALPHA);
+            case CM_TRANSFER_FUNCTION_BT1886: return tfLinPow(c, BT1886_POW, BT1886_CUT, BT1886_SCALE, BT1886_ALPHA);
+            case CM_TRANSFER_FUNCTION_ST240: return tfLinPow(c, ST240_POW, ST240_CUT, ST240_SCALE, ST240_ALPHA);
+            case CM_TRANSFER_FUNCTION_LOG_100: return c <= 0.01 ? 0.0 : 1.0 + std::log(c) / std::numbers::ln10 / 2.0;
+            case CM_TRANSFER_FUNCTION_LOG_316: return c <= std::sqrt(10.0) / 1000.0 ? 0.0 : 1.0 + std::log(c) / std::numbers::ln10 / 2.5;
+            case CM_TRANSFER_FUNCTION_XVYCC: return sign(c) * tfLinPow(std::abs(c), BT1886_POW, BT1886_CUT, BT1886_SCALE, BT1886_ALPHA);
+            case CM_TRANSFER_FUNCTION_ST428: return std::pow(std::max(c, 0.0) / ST428_SCALE, 1.0 / ST428_POW);
+            case CM_TRANSFER_FUNCTION_SRGB:
+            default: return tfLinPow(c, SRGB_POW, SRGB_CUT, SRGB_SCALE, SRGB_ALPHA);
+        }
+    }
+
+    vec3 tonemap(const vec3& color, const mat3& dstXYZ, const SCMShaderParams& p) {
+        if (p.maxLuminance < p.dstMaxLuminance * 1.01) {
+            return {std::clamp<double>(color[0], 0.0, p.dstMaxLuminance), std::clamp<double>(color[1], 0.0, p.dstMaxLuminance),
+                    std::clamp<double>(color[2], 0.0, p.dstMaxLuminance)};
+        }
+
+        const auto toLMS   = mul(BT2020_TO_LMS, dstXYZ);
+        const auto fromLMS = mul(inverse(dstXYZ), LMS_TO_BT2020);
+
+        auto       lms = mul(toLMS, color);
+        for (auto& c : lms) {
+            c = tfPQ(c / HDR_MAX_LUMINANCE);
+        }
+
+        auto ICtCp = mul(ICTCP_PQ, lms);
+
+        // the shader works out the tone mapped luminance here but doesn't use it (yet), so neither do we
+
+        const double E = std::pow(std::clamp(ICtCp[0], 0.0, 1.0), PQ_M1);
+        ICtCp[0]       = std::pow((PQ_C1 + PQ_C2 * E) / (1.0 + PQ_C3 * E), PQ_M2) / HDR_MAX_LUMINANCE;
+
+        auto result = mul(ICTCP_PQ_INV, ICtCp);
+        for (auto& c : result) {
+            c = tfInvPQ(c);
+        }
+
+        result = mul(fromLMS, result);
+        for (auto& c : result) {
+            c *= HDR_MAX_LUMINANCE;
+        }
+
+        return result;
+    }
+
+    // doColorManagement for an unpremultiplied color
+    vec3 colorManage(vec3 color, const mat3& convert, const mat3& dstXYZ, const SCMShaderParams& p) {
+        for (auto& c : color) {
+            c = toLinear(c, p.sourceTF);
+        }
+
+        color = mul(convert, color);
+        for (auto& c : color) {
+            c = c * (p.srcTFRange[1] - p.srcTFRange[0]) + p.srcTFRange[0];
+        }
+
+        color = tonemap(color, dstXYZ, p);
+
+        for (auto& c : color) {
+            if (p.targetTF == CM_TRANSFER_FUNCTION_EXT_LINEAR)
+                c = c / SDR_MAX_LUMINANCE;
+            else
+                c = fromLinear((c - p.dstTFRange[0]) / (p.dstTFRange[1] - p.dstTFRange[0]), p.targetTF);
+        }
+
+        if ((p.sourceTF == CM_TRANSFER_FUNCTION_SRGB || p.sourceTF == CM_TRANSFER_FUNCTION_GAMMA22) && p.targetTF == CM_TRANSFER_FUNCTION_ST2084_PQ) {
+            if (p.sdrSaturation != 1.0) {
+                // same as the shader, which takes the second column of the matrix
+                const double Y = color[0] * dstXYZ[3] + color[1] * dstXYZ[4] + color[2] * dstXYZ[5];
+                for (auto& c : color) {
+                    c = Y + (c - Y) * p.sdrSaturation;
+                }
+            }
+
+            for (auto& c : color) {
+                c *= p.sdrBrightness;
+            }
+        }
+
+        return color;
+    }
+}
+
+CColorLUTResource::CColorLUTResource(const SCMShaderParams& params, int size) : m_params(params), m_size(size) {
+    ;
+}
+
+bool CColorLUTResource::supports(const SCMShaderParams& params) {
+    return params.sourceTF != CM_TRANSFER_FUNCTION_EXT_LINEAR && params.sourceTF != CM_TRANSFER_FUNCTION_EXT_SRGB && params.sourceTF != CM_TRANSFER_FUNCTION_XVYCC;
+}
+
+void CColorLUTResource::render() {
+    mat3 convert;
+    for (size_t i = 0; i < convert.size(); ++i) {
+        convert[i] = m_params.convertMatrix[i];
+    }
+
+    const auto   DSTXYZ = primaries2xyz(m_params.targetPrimaries);
+    const double STEP   = 1.0 / (m_size - 1);
+
+    m_data.resize(sc<size_t>(m_size) * m_size * m_size * 3);
+
+    size_t i = 0;
+    for (int b = 0; b < m_size; ++b) {
+        for (int g = 0; g < m_size; ++g) {
+            for (int r = 0; r < m_size; ++r) {
+                const auto COLOR = colorManage({r * STEP, g * STEP, b * STEP}, convert, DSTXYZ, m_params);
+                for (const auto c : COLOR) {
+                    m_data[i++] = std::isfinite(c) ? sc<float>(c) : 0.f;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "AsyncResourceGatherer.hpp"
+
+#include <array>
+#include <vector>
+
+// everything passCMUniforms hands to the CM shaders, which is all doColorManagement (CM.glsl) depends on
+struct SCMShaderParams {
+    int                  sourceTF        = 0; // eTransferFunction
+    int                  targetTF        = 0;
+    std::array<float, 8> targetPrimaries = {};
+    std::array<float, 2> srcTFRange      = {};
+    std::array<float, 2> dstTFRange      = {};
+    float                maxLuminance    = 0;
+    float                dstMaxLuminance = 0;
+    float                dstRefLuminance = 0;
+    float                sdrSaturation   = 1;
+    float                sdrBrightness   = 1;
+    std::array<float, 9> convertMatrix   = {}; // column major, as uploaded
+
+    bool                 operator==(const SCMShaderParams&) const = default;
+};
+
+/*
+    Bakes doColorManagement into a size³ grid of unpremultiplied, encoded source colors in [0, 1],
+    red changing fastest, so the shader can do one trilinear lookup instead.
+    Tonemapping runs on the unpremultiplied color here, unlike the shader, which only matters for
+    translucent pixels above the monitor's max luminance.
+*/
+class CColorLUTResource : public Hyprgraphics::IAsyncResource {
+  public:
+    CColorLUTResource(const SCMShaderParams& params, int size);
+    virtual ~CColorLUTResource() = default;
+
+    virtual void render();
+
+    // extended range sources have values outside of [0, 1], which the grid can't hold
+    static bool           supports(const SCMShaderParams& params);
+
+    const SCMShaderParams m_params;
+    const int             m_size = 0;
+    std::vector<float>    m_data; // rgb
+};
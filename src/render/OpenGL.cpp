@@ -19,7 +19,7 @@
 #include "../protocols/core/Compositor.hpp"
 #include "../protocols/ColorManagement.hpp"
 #include "../protocols/types/ColorManagement.hpp"
-#include "../managers/HookSystemManager.hpp"
+#include "../managers/HookEvents.hpp"
 #include "../managers/input/InputManager.hpp"
 #include "../managers/eventLoop/EventLoopManager.hpp"
 #include "../managers/CursorManager.hpp"
@@ -34,6 +34,7 @@
 #include "pass/ClearPassElement.hpp"
 #include "render/Shader.hpp"
 #include "AsyncResourceGatherer.hpp"
+#include "../debug/FrameTrace.hpp"
 #include <ranges>
 #include <algorithm>
 #include <string>
@@ -380,7 +381,7 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() : m_drmFD(g_pCompositor->m_drmRenderNode.fd >
 
     initAssets();
 
-    static auto P = g_pHookSystem->hookDynamic("preRender", [&](void* self, SCallbackInfo& info, std::any data) { preRender(std::any_cast<PHLMONITOR>(data)); });
+    static auto P = g_pHookSystem->hook<HOOK_EVENT_PRE_RENDER>([&](SCallbackInfo& info, const PHLMONITOR& monitor) { preRender(monitor); });
 
     RASSERT(eglMakeCurrent(m_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT), "Couldn't unset current EGL!");
 
@@ -411,18 +412,14 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() : m_drmFD(g_pCompositor->m_drmRenderNode.fd >
 #endif
     };
 
-    static auto P2 = g_pHookSystem->hookDynamic("mouseButton", [](void* self, SCallbackInfo& info, std::any e) {
-        auto E = std::any_cast<IPointer::SButtonEvent>(e);
-
+    static auto P2 = g_pHookSystem->hook<HOOK_EVENT_MOUSE_BUTTON>([](SCallbackInfo& info, const IPointer::SButtonEvent& E) {
         if (E.state != WL_POINTER_BUTTON_STATE_PRESSED)
             return;
 
         addLastPressToHistory(g_pInputManager->getMouseCoordsInternal(), g_pInputManager->getClickMode() == CLICKMODE_KILL, false);
     });
 
-    static auto P3 = g_pHookSystem->hookDynamic("touchDown", [](void* self, SCallbackInfo& info, std::any e) {
-        auto E = std::any_cast<ITouch::SDownEvent>(e);
-
+    static auto P3 = g_pHookSystem->hook<HOOK_EVENT_TOUCH_DOWN>([](SCallbackInfo& info, const ITouch::SDownEvent& E) {
         auto PMONITOR = g_pCompositor->getMonitorFromName(!E.device->m_boundOutput.empty() ? E.device->m_boundOutput : "");
 
         PMONITOR = PMONITOR ? PMONITOR : Desktop::focusState()->monitor();
@@ -434,8 +431,17 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() : m_drmFD(g_pCompositor->m_drmRenderNode.fd >
 }
 
 CHyprOpenGLImpl::~CHyprOpenGLImpl() {
-    if (m_eglDisplay && m_eglContext != EGL_NO_CONTEXT)
+    if (m_eglDisplay && m_eglContext != EGL_NO_CONTEXT) {
+        eglMakeCurrent(m_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, m_eglContext);
+
+        for (const auto& lut : m_cmLuts) {
+            if (lut->texture)
+                glDeleteTextures(1, &lut->texture);
+        }
+        m_cmLuts.clear();
+
         eglDestroyContext(m_eglDisplay, m_eglContext);
+    }
 
     if (m_eglDisplay)
         eglTerminate(m_eglDisplay);
@@ -779,6 +785,7 @@ void CHyprOpenGLImpl::beginSimple(PHLMONITOR pMonitor, const CRegion& damage, SP
 
 void CHyprOpenGLImpl::begin(PHLMONITOR pMonitor, const CRegion& damage_, CFramebuffer* fb, std::optional<CRegion> finalDamage) {
     m_renderData.pMonitor = pMonitor;
+    m_cmLutFrame++;
 
     const GLenum RESETSTATUS = glGetGraphicsResetStatus();
     if (RESETSTATUS != GL_NO_ERROR) {
@@ -797,6 +804,8 @@ void CHyprOpenGLImpl::begin(PHLMONITOR pMonitor, const CRegion& damage_, CFrameb
 
     setViewport(0, 0, pMonitor->m_pixelSize.x, pMonitor->m_pixelSize.y);
 
+    m_frameStats = {};
+
     m_renderData.projection = Mat3x3::outputProjection(pMonitor->m_pixelSize, HYPRUTILS_TRANSFORM_NORMAL);
 
     m_renderData.monitorProjection = pMonitor->m_projMatrix;
@@ -976,6 +985,8 @@ static void getCMShaderUniforms(SShader& shader) {
     shader.uniformLocations[SHADER_SDR_SATURATION]    = glGetUniformLocation(shader.program, "sdrSaturation");
     shader.uniformLocations[SHADER_SDR_BRIGHTNESS]    = glGetUniformLocation(shader.program, "sdrBrightnessMultiplier");
     shader.uniformLocations[SHADER_CONVERT_MATRIX]    = glGetUniformLocation(shader.program, "convertMatrix");
+    shader.uniformLocations[SHADER_CM_LUT]            = glGetUniformLocation(shader.program, "cmLut");
+    shader.uniformLocations[SHADER_CM_LUT_SIZE]       = glGetUniformLocation(shader.program, "cmLutSize");
 }
 
 // shader has #include "rounding.glsl"
@@ -986,6 +997,29 @@ static void getRoundingShaderUniforms(SShader& shader) {
     shader.uniformLocations[SHADER_ROUNDING_POWER] = glGetUniformLocation(shader.program, "roundingPower");
 }
 
+// CM.frag, either m_shCM or one of its specialized variants
+static void getCMTexShaderUniforms(SShader& shader) {
+    const auto prog = shader.program;
+
+    getCMShaderUniforms(shader);
+    getRoundingShaderUniforms(shader);
+    shader.uniformLocations[SHADER_PROJ]                = glGetUniformLocation(prog, "proj");
+    shader.uniformLocations[SHADER_TEX]                 = glGetUniformLocation(prog, "tex");
+    shader.uniformLocations[SHADER_TEX_TYPE]            = glGetUniformLocation(prog, "texType");
+    shader.uniformLocations[SHADER_ALPHA_MATTE]         = glGetUniformLocation(prog, "texMatte");
+    shader.uniformLocations[SHADER_ALPHA]               = glGetUniformLocation(prog, "alpha");
+    shader.uniformLocations[SHADER_TEX_ATTRIB]          = glGetAttribLocation(prog, "texcoord");
+    shader.uniformLocations[SHADER_MATTE_TEX_ATTRIB]    = glGetAttribLocation(prog, "texcoordMatte");
+    shader.uniformLocations[SHADER_POS_ATTRIB]          = glGetAttribLocation(prog, "pos");
+    shader.uniformLocations[SHADER_DISCARD_OPAQUE]      = glGetUniformLocation(prog, "discardOpaque");
+    shader.uniformLocations[SHADER_DISCARD_ALPHA]       = glGetUniformLocation(prog, "discardAlpha");
+    shader.uniformLocations[SHADER_DISCARD_ALPHA_VALUE] = glGetUniformLocation(prog, "discardAlphaValue");
+    shader.uniformLocations[SHADER_APPLY_TINT]          = glGetUniformLocation(prog, "applyTint");
+    shader.uniformLocations[SHADER_TINT]                = glGetUniformLocation(prog, "tint");
+    shader.uniformLocations[SHADER_USE_ALPHA_MATTE]     = glGetUniformLocation(prog, "useAlphaMatte");
+    shader.createVao();
+}
+
 bool CHyprOpenGLImpl::initShaders() {
     auto              shaders   = makeShared<SPreparedShaders>();
     const bool        isDynamic = m_shadersInitialized;
@@ -1013,23 +1047,8 @@ bool CHyprOpenGLImpl::initShaders() {
             m_cmSupported = prog > 0;
             if (m_cmSupported) {
                 shaders->m_shCM.program = prog;
-                getCMShaderUniforms(shaders->m_shCM);
-                getRoundingShaderUniforms(shaders->m_shCM);
-                shaders->m_shCM.uniformLocations[SHADER_PROJ]                = glGetUniformLocation(prog, "proj");
-                shaders->m_shCM.uniformLocations[SHADER_TEX]                 = glGetUniformLocation(prog, "tex");
-                shaders->m_shCM.uniformLocations[SHADER_TEX_TYPE]            = glGetUniformLocation(prog, "texType");
-                shaders->m_shCM.uniformLocations[SHADER_ALPHA_MATTE]         = glGetUniformLocation(prog, "texMatte");
-                shaders->m_shCM.uniformLocations[SHADER_ALPHA]               = glGetUniformLocation(prog, "alpha");
-                shaders->m_shCM.uniformLocations[SHADER_TEX_ATTRIB]          = glGetAttribLocation(prog, "texcoord");
-                shaders->m_shCM.uniformLocations[SHADER_MATTE_TEX_ATTRIB]    = glGetAttribLocation(prog, "texcoordMatte");
-                shaders->m_shCM.uniformLocations[SHADER_POS_ATTRIB]          = glGetAttribLocation(prog, "pos");
-                shaders->m_shCM.uniformLocations[SHADER_DISCARD_OPAQUE]      = glGetUniformLocation(prog, "discardOpaque");
-                shaders->m_shCM.uniformLocations[SHADER_DISCARD_ALPHA]       = glGetUniformLocation(prog, "discardAlpha");
-                shaders->m_shCM.uniformLocations[SHADER_DISCARD_ALPHA_VALUE] = glGetUniformLocation(prog, "discardAlphaValue");
-                shaders->m_shCM.uniformLocations[SHADER_APPLY_TINT]          = glGetUniformLocation(prog, "applyTint");
-                shaders->m_shCM.uniformLocations[SHADER_TINT]                = glGetUniformLocation(prog, "tint");
-                shaders->m_shCM.uniformLocations[SHADER_USE_ALPHA_MATTE]     = glGetUniformLocation(prog, "useAlphaMatte");
-                shaders->m_shCM.createVao();
+                getCMTexShaderUniforms(shaders->m_shCM);
+                shaders->TEXFRAGSRCCM = TEXFRAGSRCCM;
             } else
                 Debug::log(ERR,
                            "WARNING: CM Shader failed compiling, color management will not work. It's likely because your GPU is an old piece of garbage, don't file bug reports "
@@ -1419,6 +1438,99 @@ void CHyprOpenGLImpl::scissor(const int x, const int y, const int w, const int h
     scissor(box, transform);
 }
 
+// Draws the unit quad of the bound program through glMatrix, restricted to damage.
+// As long as the quad stays axis aligned in window space (any monitor transform, no rotation), each damage rect is clipped
+// to the quad on the cpu and turned back into quad space, and all of them go out in one draw. Rotated quads can't be
+// clipped like that, so those fall back to one scissored draw per rect.
+void CHyprOpenGLImpl::drawQuadWithDamage(SShader* shader, const Mat3x3& glMatrix, const CRegion& damage, bool transform, const CBox& uv) {
+    if (damage.empty())
+        return;
+
+    // quad space -> window space, i.e. the projection followed by the viewport transform
+    const auto M   = glMatrix.getMatrix();
+    const auto VW  = m_lastViewport.width / 2.F, VH = m_lastViewport.height / 2.F;
+    const auto A   = M[0] * VW, B = M[1] * VW, C = m_lastViewport.x + (M[2] + 1.F) * VW;
+    const auto D   = M[3] * VH, E = M[4] * VH, F = m_lastViewport.y + (M[5] + 1.F) * VH;
+    const auto DET = A * E - B * D;
+
+    const bool AXISALIGNED = ((std::abs(B) < 0.001F && std::abs(D) < 0.001F) || (std::abs(A) < 0.001F && std::abs(E) < 0.001F)) && std::abs(DET) > 0.001F;
+
+    if (!AXISALIGNED) {
+        glBindVertexArray(shader->uniformLocations[SHADER_SHADER_VAO]);
+
+        if (shader->uniformLocations[SHADER_SHADER_VBO_UV] > 0) {
+            const float U1 = uv.x, V1 = uv.y, U2 = uv.x + uv.w, V2 = uv.y + uv.h;
+            const float uvs[] = {U2, V1, U1, V1, U2, V2, U1, V2};
+
+            glBindBuffer(GL_ARRAY_BUFFER, shader->uniformLocations[SHADER_SHADER_VBO_UV]);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(uvs), uvs);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+
+        damage.forEachRect([this, transform](const auto& RECT) {
+            scissor(&RECT, transform);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            m_frameStats.drawCalls++;
+            m_frameStats.quads++;
+        });
+
+        scissor(nullptr);
+        glBindVertexArray(0);
+        return;
+    }
+
+    // window space bounds of the quad, the damage rects get clipped to these
+    const auto X1 = std::min(C, A + B + C), X2 = std::max(C, A + B + C);
+    const auto Y1 = std::min(F, D + E + F), Y2 = std::max(F, D + E + F);
+
+    const auto TR = wlTransformToHyprutils(invertTransform(m_renderData.pMonitor->m_transform));
+
+    m_batchVerts.clear();
+
+    damage.forEachRect([&](const auto& RECT) {
+        CBox box = {RECT.x1, RECT.y1, RECT.x2 - RECT.x1, RECT.y2 - RECT.y1};
+        if (transform)
+            box.transform(TR, m_renderData.pMonitor->m_transformedSize.x, m_renderData.pMonitor->m_transformedSize.y);
+
+        const float LEFT = std::max<float>(box.x, X1), RIGHT = std::min<float>(box.x + box.w, X2);
+        const float TOP  = std::max<float>(box.y, Y1), BOTTOM = std::min<float>(box.y + box.h, Y2);
+
+        if (LEFT >= RIGHT || TOP >= BOTTOM)
+            return;
+
+        auto push = [&](float wx, float wy) {
+            const float PX = (E * (wx - C) - B * (wy - F)) / DET;
+            const float PY = (A * (wy - F) - D * (wx - C)) / DET;
+
+            m_batchVerts.insert(m_batchVerts.end(), {PX, PY, sc<float>(uv.x + PX * uv.w), sc<float>(uv.y + PY * uv.h)});
+        };
+
+        push(LEFT, TOP);
+        push(RIGHT, TOP);
+        push(LEFT, BOTTOM);
+        push(RIGHT, TOP);
+        push(RIGHT, BOTTOM);
+        push(LEFT, BOTTOM);
+
+        m_frameStats.quads++;
+    });
+
+    if (m_batchVerts.empty())
+        return;
+
+    setCapStatus(GL_SCISSOR_TEST, false);
+
+    glBindVertexArray(shader->uniformLocations[SHADER_SHADER_VAO_BATCH]);
+    glBindBuffer(GL_ARRAY_BUFFER, shader->uniformLocations[SHADER_SHADER_VBO_BATCH]);
+    glBufferData(GL_ARRAY_BUFFER, m_batchVerts.size() * sizeof(float), m_batchVerts.data(), GL_STREAM_DRAW);
+
+    glDrawArrays(GL_TRIANGLES, 0, m_batchVerts.size() / 4);
+    m_frameStats.drawCalls++;
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
 void CHyprOpenGLImpl::renderRect(const CBox& box, const CHyprColor& col, SRectRenderData data) {
     if (!data.damage)
         data.damage = &m_renderData.damage;
@@ -1509,27 +1621,13 @@ void CHyprOpenGLImpl::renderRectWithDamageInternal(const CBox& box, const CHyprC
     m_shaders->m_shQUAD.setUniformFloat(SHADER_RADIUS, data.round);
     m_shaders->m_shQUAD.setUniformFloat(SHADER_ROUNDING_POWER, data.roundingPower);
 
-    glBindVertexArray(m_shaders->m_shQUAD.uniformLocations[SHADER_SHADER_VAO]);
-
     if (m_renderData.clipBox.width != 0 && m_renderData.clipBox.height != 0) {
         CRegion damageClip{m_renderData.clipBox.x, m_renderData.clipBox.y, m_renderData.clipBox.width, m_renderData.clipBox.height};
         damageClip.intersect(*data.damage);
 
-        if (!damageClip.empty()) {
-            damageClip.forEachRect([this](const auto& RECT) {
-                scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            });
-        }
-    } else {
-        data.damage->forEachRect([this](const auto& RECT) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        });
-    }
-
-    glBindVertexArray(0);
-    scissor(nullptr);
+        drawQuadWithDamage(&m_shaders->m_shQUAD, glMatrix, damageClip);
+    } else
+        drawQuadWithDamage(&m_shaders->m_shQUAD, glMatrix, *data.damage);
 }
 
 void CHyprOpenGLImpl::renderTexture(SP<CTexture> tex, const CBox& box, STextureRenderData data) {
@@ -1560,43 +1658,96 @@ static bool isSDR2HDR(const NColorManagement::SImageDescription& imageDescriptio
          targetImageDescription.transferFunction == NColorManagement::CM_TRANSFER_FUNCTION_HLG);
 }
 
-void CHyprOpenGLImpl::passCMUniforms(SShader& shader, const NColorManagement::SImageDescription& imageDescription,
-                                     const NColorManagement::SImageDescription& targetImageDescription, bool modifySDR, float sdrMinLuminance, int sdrMaxLuminance) {
+NColorManagement::eTransferFunction CHyprOpenGLImpl::cmSourceTF(const NColorManagement::SImageDescription& imageDescription) {
     static auto PSDREOTF = CConfigValue<Hyprlang::INT>("render:cm_sdr_eotf");
 
     if (m_renderData.surface.valid() &&
         ((!m_renderData.surface->m_colorManagement.valid() && *PSDREOTF >= 1) ||
          (*PSDREOTF == 2 && m_renderData.surface->m_colorManagement.valid() &&
-          imageDescription.transferFunction == NColorManagement::eTransferFunction::CM_TRANSFER_FUNCTION_SRGB))) {
-        shader.setUniformInt(SHADER_SOURCE_TF, NColorManagement::eTransferFunction::CM_TRANSFER_FUNCTION_GAMMA22);
-    } else
-        shader.setUniformInt(SHADER_SOURCE_TF, imageDescription.transferFunction);
+          imageDescription.transferFunction == NColorManagement::eTransferFunction::CM_TRANSFER_FUNCTION_SRGB)))
+        return NColorManagement::eTransferFunction::CM_TRANSFER_FUNCTION_GAMMA22;
+
+    return imageDescription.transferFunction;
+}
 
-    shader.setUniformInt(SHADER_TARGET_TF, targetImageDescription.transferFunction);
+SShader* CHyprOpenGLImpl::getCMShader(const SCMShaderParams& params, eTextureType texType, bool rounding, bool lut) {
+    static auto PVARIANTS = CConfigValue<Hyprlang::INT>("render:cm_shader_variants");
 
-    const auto                   targetPrimaries = targetImageDescription.primariesNameSet || targetImageDescription.primaries == SPCPRimaries{} ?
-                          getPrimaries(targetImageDescription.primariesNamed) :
-                          targetImageDescription.primaries;
+    if (!*PVARIANTS && !lut)
+        return &m_shaders->m_shCM;
+
+    // same check tonemap() does per pixel. With a LUT, the transfer functions and tonemapping are in the texture
+    const bool tonemap  = !lut && !(params.maxLuminance < params.dstMaxLuminance * 1.01);
+    const auto SOURCETF = lut ? 0 : sc<uint32_t>(params.sourceTF);
+    const auto TARGETTF = lut ? 0 : sc<uint32_t>(params.targetTF);
+    const auto KEY      = SOURCETF | (TARGETTF << 8) | (sc<uint32_t>(texType) << 16) | (sc<uint32_t>(tonemap) << 20) | (sc<uint32_t>(rounding) << 21) | (sc<uint32_t>(lut) << 22);
+
+    auto       it = m_shaders->m_cmVariants.find(KEY);
+    if (it == m_shaders->m_cmVariants.end()) {
+        std::string defines = std::format("#define CM_SPECIALIZED\n#define CM_TEX_TYPE {}\n", sc<int>(texType));
+        if (lut)
+            defines += "#define CM_LUT\n";
+        else
+            defines += std::format("#define CM_SOURCE_TF {}\n#define CM_TARGET_TF {}\n", SOURCETF, TARGETTF);
+        if (!tonemap)
+            defines += "#define CM_NO_TONEMAP\n";
+        if (!rounding)
+            defines += "#define CM_NO_ROUNDING\n";
+
+        // defines have to go after #version
+        auto       source = m_shaders->TEXFRAGSRCCM;
+        const auto EOL    = source.find('\n');
+        source.insert(EOL == std::string::npos ? source.length() : EOL + 1, defines);
+
+        UP<SShader> variant;
+        const auto  PROG = createProgram(m_shaders->TEXVERTSRC, source, true, true);
+        if (PROG) {
+            variant          = makeUnique<SShader>();
+            variant->program = PROG;
+            getCMTexShaderUniforms(*variant);
+            Debug::log(LOG, "Built CM shader variant {:x}, {} cached", KEY, m_shaders->m_cmVariants.size() + 1);
+        } else
+            Debug::log(ERR, "CM shader variant {:x} failed compiling, falling back to the generic one", KEY);
 
-    const std::array<GLfloat, 8> glTargetPrimaries = {
+        it = m_shaders->m_cmVariants.emplace(KEY, std::move(variant)).first;
+    }
+
+    if (it->second)
+        return it->second.get();
+
+    // the generic shader can't sample a LUT, the caller has to go analytic
+    return lut ? nullptr : &m_shaders->m_shCM;
+}
+
+SCMShaderParams CHyprOpenGLImpl::getCMParams(const NColorManagement::SImageDescription& imageDescription, const NColorManagement::SImageDescription& targetImageDescription,
+                                             bool modifySDR, float sdrMinLuminance, int sdrMaxLuminance) {
+    SCMShaderParams params;
+
+    params.sourceTF = cmSourceTF(imageDescription);
+    params.targetTF = targetImageDescription.transferFunction;
+
+    const auto targetPrimaries = targetImageDescription.primariesNameSet || targetImageDescription.primaries == SPCPRimaries{} ?
+        getPrimaries(targetImageDescription.primariesNamed) :
+        targetImageDescription.primaries;
+
+    params.targetPrimaries = {
         targetPrimaries.red.x,  targetPrimaries.red.y,  targetPrimaries.green.x, targetPrimaries.green.y,
         targetPrimaries.blue.x, targetPrimaries.blue.y, targetPrimaries.white.x, targetPrimaries.white.y,
     };
-    shader.setUniformMatrix4x2fv(SHADER_TARGET_PRIMARIES, 1, false, glTargetPrimaries);
 
     const bool needsSDRmod = modifySDR && isSDR2HDR(imageDescription, targetImageDescription);
 
-    shader.setUniformFloat2(SHADER_SRC_TF_RANGE, imageDescription.getTFMinLuminance(needsSDRmod ? sdrMinLuminance : -1),
-                            imageDescription.getTFMaxLuminance(needsSDRmod ? sdrMaxLuminance : -1));
-    shader.setUniformFloat2(SHADER_DST_TF_RANGE, targetImageDescription.getTFMinLuminance(needsSDRmod ? sdrMinLuminance : -1),
-                            targetImageDescription.getTFMaxLuminance(needsSDRmod ? sdrMaxLuminance : -1));
+    params.srcTFRange = {imageDescription.getTFMinLuminance(needsSDRmod ? sdrMinLuminance : -1), imageDescription.getTFMaxLuminance(needsSDRmod ? sdrMaxLuminance : -1)};
+    params.dstTFRange = {targetImageDescription.getTFMinLuminance(needsSDRmod ? sdrMinLuminance : -1),
+                         targetImageDescription.getTFMaxLuminance(needsSDRmod ? sdrMaxLuminance : -1)};
 
     const float maxLuminance = imageDescription.luminances.max > 0 ? imageDescription.luminances.max : imageDescription.luminances.reference;
-    shader.setUniformFloat(SHADER_MAX_LUMINANCE, maxLuminance * targetImageDescription.luminances.reference / imageDescription.luminances.reference);
-    shader.setUniformFloat(SHADER_DST_MAX_LUMINANCE, targetImageDescription.luminances.max > 0 ? targetImageDescription.luminances.max : 10000);
-    shader.setUniformFloat(SHADER_DST_REF_LUMINANCE, targetImageDescription.luminances.reference);
-    shader.setUniformFloat(SHADER_SDR_SATURATION, needsSDRmod && m_renderData.pMonitor->m_sdrSaturation > 0 ? m_renderData.pMonitor->m_sdrSaturation : 1.0f);
-    shader.setUniformFloat(SHADER_SDR_BRIGHTNESS, needsSDRmod && m_renderData.pMonitor->m_sdrBrightness > 0 ? m_renderData.pMonitor->m_sdrBrightness : 1.0f);
+    params.maxLuminance      = maxLuminance * targetImageDescription.luminances.reference / imageDescription.luminances.reference;
+    params.dstMaxLuminance   = targetImageDescription.luminances.max > 0 ? targetImageDescription.luminances.max : 10000;
+    params.dstRefLuminance   = targetImageDescription.luminances.reference;
+    params.sdrSaturation     = needsSDRmod && m_renderData.pMonitor->m_sdrSaturation > 0 ? m_renderData.pMonitor->m_sdrSaturation : 1.0f;
+    params.sdrBrightness     = needsSDRmod && m_renderData.pMonitor->m_sdrBrightness > 0 ? m_renderData.pMonitor->m_sdrBrightness : 1.0f;
+
     const auto cacheKey = std::make_pair(imageDescription.getId(), targetImageDescription.getId());
     if (!primariesConversionCache.contains(cacheKey)) {
         const auto                   mat             = imageDescription.getPrimaries().convertMatrix(targetImageDescription.getPrimaries()).mat();
@@ -1607,7 +1758,103 @@ void CHyprOpenGLImpl::passCMUniforms(SShader& shader, const NColorManagement::SI
         };
         primariesConversionCache.insert(std::make_pair(cacheKey, glConvertMatrix));
     }
-    shader.setUniformMatrix3fv(SHADER_CONVERT_MATRIX, 1, false, primariesConversionCache[cacheKey]);
+    params.convertMatrix = primariesConversionCache[cacheKey];
+
+    return params;
+}
+
+CHyprOpenGLImpl::SCMLut* CHyprOpenGLImpl::getCMLut(const SCMShaderParams& params) {
+    static auto PLUT     = CConfigValue<Hyprlang::INT>("render:cm_lut");
+    static auto PLUTSIZE = CConfigValue<Hyprlang::INT>("render:cm_lut_size");
+
+    if (!*PLUT || !CColorLUTResource::supports(params))
+        return nullptr;
+
+    const int SIZE = std::clamp(sc<int>(*PLUTSIZE), 2, 65);
+
+    auto      it = std::ranges::find_if(m_cmLuts, [&](const auto& lut) { return lut->size == SIZE && lut->params == params; });
+    if (it == m_cmLuts.end()) {
+        constexpr size_t MAX_CM_LUTS = 16;
+
+        if (m_cmLuts.size() >= MAX_CM_LUTS) {
+            // draws queued earlier in this frame may still sample the ones it used, go analytic if that's all of them
+            const auto OLDEST = std::ranges::min_element(m_cmLuts, {}, [this](const auto& lut) { return lut->lastFrame == m_cmLutFrame ? UINT64_MAX : lut->lastUsed; });
+            if ((*OLDEST)->lastFrame == m_cmLutFrame)
+                return nullptr;
+
+            if ((*OLDEST)->texture)
+                glDeleteTextures(1, &(*OLDEST)->texture);
+            m_cmLuts.erase(OLDEST);
+        }
+
+        auto lut       = makeShared<SCMLut>(params, SIZE);
+        lut->pending   = makeAtomicShared<CColorLUTResource>(params, SIZE);
+        lut->lastUsed  = ++m_cmLutUses;
+        lut->lastFrame = m_cmLutFrame;
+
+        // analytic until the worker is done with it
+        SP<CMainLoopExecutor> executor = makeShared<CMainLoopExecutor>([weak = WP<SCMLut>{lut}] {
+            g_pEventLoopManager->doLater([weak] {
+                const auto LUT = weak.lock();
+                if (!LUT)
+                    return;
+
+                LUT->ready = true;
+
+                for (const auto& m : g_pCompositor->m_monitors) {
+                    g_pHyprRenderer->damageMonitor(m);
+                }
+            });
+        });
+
+        lut->pending->m_events.finished.listenStatic([executor] {
+            // this is in the worker thread.
+            executor->signal();
+        });
+
+        g_pAsyncResourceGatherer->enqueue(lut->pending);
+        m_cmLuts.emplace_back(lut);
+        return nullptr;
+    }
+
+    const auto& LUT = *it;
+    LUT->lastUsed   = ++m_cmLutUses;
+    LUT->lastFrame  = m_cmLutFrame;
+
+    if (LUT->ready && !LUT->texture) {
+        glGenTextures(1, &LUT->texture);
+        glBindTexture(GL_TEXTURE_3D, LUT->texture);
+        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        glTexImage3D(GL_TEXTURE_3D, 0, GL_RGB16F, SIZE, SIZE, SIZE, 0, GL_RGB, GL_FLOAT, LUT->pending->m_data.data());
+        glBindTexture(GL_TEXTURE_3D, 0);
+
+        LUT->pending.reset();
+    }
+
+    return LUT->texture ? LUT.get() : nullptr;
+}
+
+void CHyprOpenGLImpl::passCMUniforms(SShader& shader, const SCMShaderParams& params) {
+    shader.setUniformInt(SHADER_SOURCE_TF, params.sourceTF);
+    shader.setUniformInt(SHADER_TARGET_TF, params.targetTF);
+    shader.setUniformMatrix4x2fv(SHADER_TARGET_PRIMARIES, 1, false, params.targetPrimaries);
+    shader.setUniformFloat2(SHADER_SRC_TF_RANGE, params.srcTFRange[0], params.srcTFRange[1]);
+    shader.setUniformFloat2(SHADER_DST_TF_RANGE, params.dstTFRange[0], params.dstTFRange[1]);
+    shader.setUniformFloat(SHADER_MAX_LUMINANCE, params.maxLuminance);
+    shader.setUniformFloat(SHADER_DST_MAX_LUMINANCE, params.dstMaxLuminance);
+    shader.setUniformFloat(SHADER_DST_REF_LUMINANCE, params.dstRefLuminance);
+    shader.setUniformFloat(SHADER_SDR_SATURATION, params.sdrSaturation);
+    shader.setUniformFloat(SHADER_SDR_BRIGHTNESS, params.sdrBrightness);
+    shader.setUniformMatrix3fv(SHADER_CONVERT_MATRIX, 1, false, params.convertMatrix);
+}
+
+void CHyprOpenGLImpl::passCMUniforms(SShader& shader, const NColorManagement::SImageDescription& imageDescription,
+                                     const NColorManagement::SImageDescription& targetImageDescription, bool modifySDR, float sdrMinLuminance, int sdrMaxLuminance) {
+    passCMUniforms(shader, getCMParams(imageDescription, targetImageDescription, modifySDR, sdrMinLuminance, sdrMaxLuminance));
 }
 
 void CHyprOpenGLImpl::passCMUniforms(SShader& shader, const SImageDescription& imageDescription) {
@@ -1702,22 +1949,44 @@ void CHyprOpenGLImpl::renderTextureInternal(SP<CTexture> tex, const CBox& box, c
         || (imageDescription == m_renderData.pMonitor->m_imageDescription && !data.cmBackToSRGB) /* Source and target have the same image description */
         || (((*PPASS && canPassHDRSurface) || (*PPASS == 1 && !isHDRSurface)) && m_renderData.pMonitor->inFullscreenMode()) /* Fullscreen window with pass cm enabled */;
 
-    if (!skipCM && !usingFinalShader && (texType == TEXTURE_RGBA || texType == TEXTURE_RGBX))
-        shader = &m_shaders->m_shCM;
+    const bool      useCM = !skipCM && !usingFinalShader && (texType == TEXTURE_RGBA || texType == TEXTURE_RGBX);
+    SCMShaderParams cmParams;
+    SCMLut*         cmLut = nullptr;
 
-    useProgram(shader->program);
-
-    if (shader == &m_shaders->m_shCM) {
-        shader->setUniformInt(SHADER_TEX_TYPE, texType);
+    if (useCM) {
         if (data.cmBackToSRGB) {
             // revert luma changes to avoid black screenshots.
             // this will likely not be 1:1, and might cause screenshots to be too bright, but it's better than pitch black.
             imageDescription.luminances = {};
             static auto PSDREOTF        = CConfigValue<Hyprlang::INT>("render:cm_sdr_eotf");
             auto        chosenSdrEotf   = *PSDREOTF > 0 ? NColorManagement::CM_TRANSFER_FUNCTION_GAMMA22 : NColorManagement::CM_TRANSFER_FUNCTION_SRGB;
-            passCMUniforms(*shader, imageDescription, NColorManagement::SImageDescription{.transferFunction = chosenSdrEotf}, true, -1, -1);
+            cmParams                    = getCMParams(imageDescription, NColorManagement::SImageDescription{.transferFunction = chosenSdrEotf}, true, -1, -1);
         } else
-            passCMUniforms(*shader, imageDescription);
+            cmParams = getCMParams(imageDescription, m_renderData.pMonitor->m_imageDescription, true, m_renderData.pMonitor->m_sdrMinLuminance,
+                                   m_renderData.pMonitor->m_sdrMaxLuminance);
+
+        cmLut = getCMLut(cmParams);
+
+        SShader* lutShader = cmLut ? getCMShader(cmParams, texType, data.round > 0, true) : nullptr;
+        if (!lutShader)
+            cmLut = nullptr;
+
+        shader = lutShader ? lutShader : getCMShader(cmParams, texType, data.round > 0);
+    }
+
+    useProgram(shader->program);
+
+    if (useCM) {
+        shader->setUniformInt(SHADER_TEX_TYPE, texType);
+        passCMUniforms(*shader, cmParams);
+
+        if (cmLut) {
+            glActiveTexture(GL_TEXTURE1);
+            glBindTexture(GL_TEXTURE_3D, cmLut->texture);
+            glActiveTexture(GL_TEXTURE0);
+            shader->setUniformInt(SHADER_CM_LUT, 1);
+            shader->setUniformFloat(SHADER_CM_LUT_SIZE, cmLut->size);
+        }
     }
 
     shader->setUniformMatrix3fv(SHADER_PROJ, 1, GL_TRUE, glMatrix.getMatrix());
@@ -1826,20 +2095,9 @@ void CHyprOpenGLImpl::renderTextureInternal(SP<CTexture> tex, const CBox& box, c
             shader->setUniformInt(SHADER_APPLY_TINT, 0);
     }
 
-    glBindVertexArray(shader->uniformLocations[SHADER_SHADER_VAO]);
-    if (data.allowCustomUV && m_renderData.primarySurfaceUVTopLeft != Vector2D(-1, -1)) {
-        const float customUVs[] = {
-            m_renderData.primarySurfaceUVBottomRight.x, m_renderData.primarySurfaceUVTopLeft.y,     m_renderData.primarySurfaceUVTopLeft.x,
-            m_renderData.primarySurfaceUVTopLeft.y,     m_renderData.primarySurfaceUVBottomRight.x, m_renderData.primarySurfaceUVBottomRight.y,
-            m_renderData.primarySurfaceUVTopLeft.x,     m_renderData.primarySurfaceUVBottomRight.y,
-        };
-
-        glBindBuffer(GL_ARRAY_BUFFER, shader->uniformLocations[SHADER_SHADER_VBO_UV]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(customUVs), customUVs);
-    } else {
-        glBindBuffer(GL_ARRAY_BUFFER, shader->uniformLocations[SHADER_SHADER_VBO_UV]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(fullVerts), fullVerts);
-    }
+    CBox uv = {0, 0, 1, 1};
+    if (data.allowCustomUV && m_renderData.primarySurfaceUVTopLeft != Vector2D(-1, -1))
+        uv = {m_renderData.primarySurfaceUVTopLeft, m_renderData.primarySurfaceUVBottomRight - m_renderData.primarySurfaceUVTopLeft};
 
     if (!m_renderData.clipBox.empty() || !m_renderData.clipRegion.empty()) {
         CRegion damageClip = m_renderData.clipBox;
@@ -1851,21 +2109,16 @@ void CHyprOpenGLImpl::renderTextureInternal(SP<CTexture> tex, const CBox& box, c
                 damageClip.intersect(m_renderData.clipRegion);
         }
 
-        if (!damageClip.empty()) {
-            damageClip.forEachRect([this](const auto& RECT) {
-                scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            });
-        }
-    } else {
-        data.damage->forEachRect([this](const auto& RECT) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        });
+        drawQuadWithDamage(shader, glMatrix, damageClip, true, uv);
+    } else
+        drawQuadWithDamage(shader, glMatrix, *data.damage, true, uv);
+
+    if (cmLut) {
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_3D, 0);
+        glActiveTexture(GL_TEXTURE0);
     }
 
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
     tex->unbind();
 }
 
@@ -1904,15 +2157,8 @@ void CHyprOpenGLImpl::renderTexturePrimitive(SP<CTexture> tex, const CBox& box)
     useProgram(shader->program);
     shader->setUniformMatrix3fv(SHADER_PROJ, 1, GL_TRUE, glMatrix.getMatrix());
     shader->setUniformInt(SHADER_TEX, 0);
-    glBindVertexArray(shader->uniformLocations[SHADER_SHADER_VAO]);
-
-    m_renderData.damage.forEachRect([this](const auto& RECT) {
-        scissor(&RECT);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    });
+    drawQuadWithDamage(shader, glMatrix, m_renderData.damage);
 
-    scissor(nullptr);
-    glBindVertexArray(0);
     tex->unbind();
 }
 
@@ -1947,15 +2193,8 @@ void CHyprOpenGLImpl::renderTextureMatte(SP<CTexture> tex, const CBox& box, CFra
     auto matteTex = matte.getTexture();
     matteTex->bind();
 
-    glBindVertexArray(shader->uniformLocations[SHADER_SHADER_VAO]);
-
-    m_renderData.damage.forEachRect([this](const auto& RECT) {
-        scissor(&RECT);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    });
+    drawQuadWithDamage(shader, glMatrix, m_renderData.damage);
 
-    scissor(nullptr);
-    glBindVertexArray(0);
     tex->unbind();
 }
 
@@ -1974,6 +2213,7 @@ CFramebuffer* CHyprOpenGLImpl::blurMainFramebufferWithDamage(float a, CRegion* o
 
 CFramebuffer* CHyprOpenGLImpl::blurFramebufferWithDamage(float a, CRegion* originalDamage, CFramebuffer& source) {
     TRACY_GPU_ZONE("RenderBlurFramebufferWithDamage");
+    TRACE_SCOPE("blur");
 
     const auto BLENDBEFORE = m_blend;
     blend(false);
@@ -1991,7 +2231,7 @@ CFramebuffer* CHyprOpenGLImpl::blurFramebufferWithDamage(float a, CRegion* origi
     static auto PBLURVIBRANCY         = CConfigValue<Hyprlang::FLOAT>("decoration:blur:vibrancy");
     static auto PBLURVIBRANCYDARKNESS = CConfigValue<Hyprlang::FLOAT>("decoration:blur:vibrancy_darkness");
 
-    const auto  BLUR_PASSES = std::clamp(*PBLURPASSES, sc<int64_t>(1), sc<int64_t>(8));
+    const auto  BLUR_PASSES = sc<int>(std::clamp(*PBLURPASSES, sc<int64_t>(1), sc<int64_t>(BLUR_MAX_PASSES)));
 
     // prep damage
     CRegion damage{*originalDamage};
@@ -2044,29 +2284,34 @@ CFramebuffer* CHyprOpenGLImpl::blurFramebufferWithDamage(float a, CRegion* origi
         m_shaders->m_shBLURPREPARE.setUniformFloat(SHADER_BRIGHTNESS, *PBLURBRIGHTNESS);
         m_shaders->m_shBLURPREPARE.setUniformInt(SHADER_TEX, 0);
 
-        glBindVertexArray(m_shaders->m_shBLURPREPARE.uniformLocations[SHADER_SHADER_VAO]);
-
-        if (!damage.empty()) {
-            damage.forEachRect([this](const auto& RECT) {
-                scissor(&RECT, false /* this region is already transformed */);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            });
-        }
+        drawQuadWithDamage(&m_shaders->m_shBLURPREPARE, glMatrix, damage, false /* this region is already transformed */);
 
-        glBindVertexArray(0);
         currentRenderToFB = PMIRRORSWAPFB;
     }
 
+    // the down and up passes go through a chain of half sized framebuffers, level 0 being the swap fb
+    const auto PMIPS = &m_renderData.pCurrentMonData->blurMips;
+    for (auto i = 0; i < BLUR_PASSES; ++i) {
+        const Vector2D SIZE = {std::max(1.0, std::ceil(m_renderData.pMonitor->m_pixelSize.x / (1 << (i + 1)))),
+                               std::max(1.0, std::ceil(m_renderData.pMonitor->m_pixelSize.y / (1 << (i + 1))))};
+
+        if (PMIPS->at(i).m_size != SIZE || PMIPS->at(i).m_drmFormat != PMIRRORFB->m_drmFormat)
+            PMIPS->at(i).alloc(SIZE.x, SIZE.y, PMIRRORFB->m_drmFormat);
+    }
+
+    auto mipLevel = [&](int level) -> CFramebuffer* { return level == 0 ? PMIRRORSWAPFB : &PMIPS->at(level - 1); };
+
     // declare the draw func
-    auto drawPass = [&](SShader* pShader, CRegion* pDamage) {
-        if (currentRenderToFB == PMIRRORFB)
-            PMIRRORSWAPFB->bind();
-        else
-            PMIRRORFB->bind();
+    auto drawPass = [&](SShader* pShader, int from, int to) {
+        const auto PTARGET = mipLevel(to);
+        const auto SIZE    = PTARGET->m_size;
+
+        PTARGET->bind();
+        setViewport(0, 0, SIZE.x, SIZE.y);
 
         glActiveTexture(GL_TEXTURE0);
 
-        auto currentTex = currentRenderToFB->getTexture();
+        auto currentTex = mipLevel(from)->getTexture();
 
         currentTex->bind();
 
@@ -2075,53 +2320,36 @@ CFramebuffer* CHyprOpenGLImpl::blurFramebufferWithDamage(float a, CRegion* origi
         useProgram(pShader->program);
 
         // prep two shaders
+        // halfpixel is relative to the target in both directions, which keeps the sampling distance
+        // at radius texels of the source when going down, and half of that when going up.
         pShader->setUniformMatrix3fv(SHADER_PROJ, 1, GL_TRUE, glMatrix.getMatrix());
         pShader->setUniformFloat(SHADER_RADIUS, *PBLURSIZE * a); // this makes the blursize change with a
+        pShader->setUniformFloat2(SHADER_HALFPIXEL, 0.5f / SIZE.x, 0.5f / SIZE.y);
         if (pShader == &m_shaders->m_shBLUR1) {
-            m_shaders->m_shBLUR1.setUniformFloat2(SHADER_HALFPIXEL, 0.5f / (m_renderData.pMonitor->m_pixelSize.x / 2.f), 0.5f / (m_renderData.pMonitor->m_pixelSize.y / 2.f));
             m_shaders->m_shBLUR1.setUniformInt(SHADER_PASSES, BLUR_PASSES);
             m_shaders->m_shBLUR1.setUniformFloat(SHADER_VIBRANCY, *PBLURVIBRANCY);
             m_shaders->m_shBLUR1.setUniformFloat(SHADER_VIBRANCY_DARKNESS, *PBLURVIBRANCYDARKNESS);
-        } else
-            m_shaders->m_shBLUR2.setUniformFloat2(SHADER_HALFPIXEL, 0.5f / (m_renderData.pMonitor->m_pixelSize.x * 2.f), 0.5f / (m_renderData.pMonitor->m_pixelSize.y * 2.f));
-        pShader->setUniformInt(SHADER_TEX, 0);
-
-        glBindVertexArray(pShader->uniformLocations[SHADER_SHADER_VAO]);
-
-        if (!pDamage->empty()) {
-            pDamage->forEachRect([this](const auto& RECT) {
-                scissor(&RECT, false /* this region is already transformed */);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            });
         }
+        pShader->setUniformInt(SHADER_TEX, 0);
 
-        glBindVertexArray(0);
+        // damage scaled down to the level, and grown a bit so rounding doesn't eat edge pixels
+        CRegion levelDamage = damage.copy().scale(SIZE / m_renderData.pMonitor->m_pixelSize).expand(2);
 
-        if (currentRenderToFB != PMIRRORFB)
-            currentRenderToFB = PMIRRORFB;
-        else
-            currentRenderToFB = PMIRRORSWAPFB;
+        drawQuadWithDamage(pShader, glMatrix, levelDamage, false /* this region is already transformed */);
     };
 
     // draw the things.
-    // first draw is swap -> mirr
-    PMIRRORFB->bind();
-    PMIRRORSWAPFB->getTexture()->bind();
-
-    // damage region will be scaled, make a temp
-    CRegion tempDamage{damage};
-
-    // and draw
     for (auto i = 1; i <= BLUR_PASSES; ++i) {
-        tempDamage = damage.copy().scale(1.f / (1 << i));
-        drawPass(&m_shaders->m_shBLUR1, &tempDamage); // down
+        drawPass(&m_shaders->m_shBLUR1, i - 1, i); // down
     }
 
     for (auto i = BLUR_PASSES - 1; i >= 0; --i) {
-        tempDamage = damage.copy().scale(1.f / (1 << i)); // when upsampling we make the region twice as big
-        drawPass(&m_shaders->m_shBLUR2, &tempDamage);     // up
+        drawPass(&m_shaders->m_shBLUR2, i + 1, i); // up
     }
 
+    // the up passes ended in the swap fb
+    currentRenderToFB = PMIRRORSWAPFB;
+
     // finalize the image
     {
         static auto PBLURNOISE      = CConfigValue<Hyprlang::FLOAT>("decoration:blur:noise");
@@ -2147,16 +2375,7 @@ CFramebuffer* CHyprOpenGLImpl::blurFramebufferWithDamage(float a, CRegion* origi
 
         m_shaders->m_shBLURFINISH.setUniformInt(SHADER_TEX, 0);
 
-        glBindVertexArray(m_shaders->m_shBLURFINISH.uniformLocations[SHADER_SHADER_VAO]);
-
-        if (!damage.empty()) {
-            damage.forEachRect([this](const auto& RECT) {
-                scissor(&RECT, false /* this region is already transformed */);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            });
-        }
-
-        glBindVertexArray(0);
+        drawQuadWithDamage(&m_shaders->m_shBLURFINISH, glMatrix, damage, false /* this region is already transformed */);
 
         if (currentRenderToFB != PMIRRORFB)
             currentRenderToFB = PMIRRORFB;
@@ -2262,6 +2481,7 @@ void CHyprOpenGLImpl::preRender(PHLMONITOR pMonitor) {
 void CHyprOpenGLImpl::preBlurForCurrentMonitor() {
 
     TRACY_GPU_ZONE("RenderPreBlurForCurrentMonitor");
+    TRACE_SCOPE("preBlur");
 
     const auto SAVEDRENDERMODIF = m_renderData.renderModif;
     m_renderData.renderModif    = {}; // fix shit
@@ -2531,8 +2751,6 @@ void CHyprOpenGLImpl::renderBorder(const CBox& box, const CGradientValueData& gr
     m_shaders->m_shBORDER1.setUniformFloat(SHADER_ROUNDING_POWER, data.roundingPower);
     m_shaders->m_shBORDER1.setUniformFloat(SHADER_THICK, scaledBorderSize);
 
-    glBindVertexArray(m_shaders->m_shBORDER1.uniformLocations[SHADER_SHADER_VAO]);
-
     // calculate the border's region, which we need to render over. No need to run the shader on
     // things outside there
     CRegion borderRegion = m_renderData.damage.copy().intersect(newBox);
@@ -2541,14 +2759,7 @@ void CHyprOpenGLImpl::renderBorder(const CBox& box, const CGradientValueData& gr
     if (m_renderData.clipBox.width != 0 && m_renderData.clipBox.height != 0)
         borderRegion.intersect(m_renderData.clipBox);
 
-    if (!borderRegion.empty()) {
-        borderRegion.forEachRect([this](const auto& RECT) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        });
-    }
-
-    glBindVertexArray(0);
+    drawQuadWithDamage(&m_shaders->m_shBORDER1, glMatrix, borderRegion);
 
     blend(BLEND);
 }
@@ -2619,8 +2830,6 @@ void CHyprOpenGLImpl::renderBorder(const CBox& box, const CGradientValueData& gr
     m_shaders->m_shBORDER1.setUniformFloat(SHADER_ROUNDING_POWER, data.roundingPower);
     m_shaders->m_shBORDER1.setUniformFloat(SHADER_THICK, scaledBorderSize);
 
-    glBindVertexArray(m_shaders->m_shBORDER1.uniformLocations[SHADER_SHADER_VAO]);
-
     // calculate the border's region, which we need to render over. No need to run the shader on
     // things outside there
     CRegion borderRegion = m_renderData.damage.copy().intersect(newBox);
@@ -2629,14 +2838,7 @@ void CHyprOpenGLImpl::renderBorder(const CBox& box, const CGradientValueData& gr
     if (m_renderData.clipBox.width != 0 && m_renderData.clipBox.height != 0)
         borderRegion.intersect(m_renderData.clipBox);
 
-    if (!borderRegion.empty()) {
-        borderRegion.forEachRect([this](const auto& RECT) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        });
-    }
-
-    glBindVertexArray(0);
+    drawQuadWithDamage(&m_shaders->m_shBORDER1, glMatrix, borderRegion);
     blend(BLEND);
 }
 
@@ -2687,26 +2889,13 @@ void CHyprOpenGLImpl::renderRoundedShadow(const CBox& box, int round, float roun
     m_shaders->m_shSHADOW.setUniformFloat(SHADER_RANGE, range);
     m_shaders->m_shSHADOW.setUniformFloat(SHADER_SHADOW_POWER, SHADOWPOWER);
 
-    glBindVertexArray(m_shaders->m_shSHADOW.uniformLocations[SHADER_SHADER_VAO]);
-
     if (m_renderData.clipBox.width != 0 && m_renderData.clipBox.height != 0) {
         CRegion damageClip{m_renderData.clipBox.x, m_renderData.clipBox.y, m_renderData.clipBox.width, m_renderData.clipBox.height};
         damageClip.intersect(m_renderData.damage);
 
-        if (!damageClip.empty()) {
-            damageClip.forEachRect([this](const auto& RECT) {
-                scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            });
-        }
-    } else {
-        m_renderData.damage.forEachRect([this](const auto& RECT) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        });
-    }
-
-    glBindVertexArray(0);
+        drawQuadWithDamage(&m_shaders->m_shSHADOW, glMatrix, damageClip);
+    } else
+        drawQuadWithDamage(&m_shaders->m_shSHADOW, glMatrix, m_renderData.damage);
 }
 
 void CHyprOpenGLImpl::saveBufferForMirror(const CBox& box) {
@@ -2764,28 +2953,23 @@ void CHyprOpenGLImpl::renderMirrored() {
     g_pHyprRenderer->m_renderPass.add(makeUnique<CTexPassElement>(std::move(data)));
 }
 
-void CHyprOpenGLImpl::renderSplash(cairo_t* const CAIRO, cairo_surface_t* const CAIROSURFACE, double offsetY, const Vector2D& size) {
-    static auto           PSPLASHCOLOR = CConfigValue<Hyprlang::INT>("misc:col.splash");
-    static auto           PSPLASHFONT  = CConfigValue<std::string>("misc:splash_font_family");
-    static auto           FALLBACKFONT = CConfigValue<std::string>("misc:font_family");
-
-    const auto            FONTFAMILY = *PSPLASHFONT != STRVAL_EMPTY ? *PSPLASHFONT : *FALLBACKFONT;
-    const auto            FONTSIZE   = sc<int>(size.y / 76);
-    const auto            COLOR      = CHyprColor(*PSPLASHCOLOR);
+static void renderSplash(cairo_t* const CAIRO, cairo_surface_t* const CAIROSURFACE, double offsetY, const Vector2D& size, const std::string& text,
+                         const std::string& fontFamily, const CHyprColor& color) {
+    const auto            FONTSIZE = sc<int>(size.y / 76);
 
     PangoLayout*          layoutText = pango_cairo_create_layout(CAIRO);
     PangoFontDescription* pangoFD    = pango_font_description_new();
 
-    pango_font_description_set_family_static(pangoFD, FONTFAMILY.c_str());
+    pango_font_description_set_family_static(pangoFD, fontFamily.c_str());
     pango_font_description_set_absolute_size(pangoFD, FONTSIZE * PANGO_SCALE);
     pango_font_description_set_style(pangoFD, PANGO_STYLE_NORMAL);
     pango_font_description_set_weight(pangoFD, PANGO_WEIGHT_NORMAL);
     pango_layout_set_font_description(layoutText, pangoFD);
 
-    cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
+    cairo_set_source_rgba(CAIRO, color.r, color.g, color.b, color.a);
 
     int textW = 0, textH = 0;
-    pango_layout_set_text(layoutText, g_pCompositor->m_currentSplash.c_str(), -1);
+    pango_layout_set_text(layoutText, text.c_str(), -1);
     pango_layout_get_size(layoutText, &textW, &textH);
     textW /= PANGO_SCALE;
     textH /= PANGO_SCALE;
@@ -2799,6 +2983,45 @@ void CHyprOpenGLImpl::renderSplash(cairo_t* const CAIRO, cairo_surface_t* const
     cairo_surface_flush(CAIROSURFACE);
 }
 
+// rasterizes the splash layer of a background on a gatherer thread. Everything is copied in, it doesn't touch the config.
+// m_surface is only read on the main thread once finished fired.
+class CBackgroundSplashResource : public Hyprgraphics::IAsyncResource {
+  public:
+    CBackgroundSplashResource(const Vector2D& size, std::string text, std::string fontFamily, const CHyprColor& color) :
+        m_size(size), m_text(std::move(text)), m_fontFamily(std::move(fontFamily)), m_color(color) {
+        ;
+    }
+
+    virtual ~CBackgroundSplashResource() {
+        if (m_surface)
+            cairo_surface_destroy(m_surface);
+    }
+
+    virtual void render() {
+        m_surface        = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, m_size.x, m_size.y);
+        const auto CAIRO = cairo_create(m_surface);
+
+        cairo_set_antialias(CAIRO, CAIRO_ANTIALIAS_GOOD);
+        cairo_save(CAIRO);
+        cairo_set_source_rgba(CAIRO, 0, 0, 0, 0);
+        cairo_set_operator(CAIRO, CAIRO_OPERATOR_SOURCE);
+        cairo_paint(CAIRO);
+        cairo_restore(CAIRO);
+
+        renderSplash(CAIRO, m_surface, 0.02 * m_size.y, m_size, m_text, m_fontFamily, m_color);
+
+        cairo_destroy(CAIRO);
+    }
+
+    cairo_surface_t* m_surface = nullptr;
+
+  private:
+    Vector2D    m_size;
+    std::string m_text;
+    std::string m_fontFamily;
+    CHyprColor  m_color;
+};
+
 std::string CHyprOpenGLImpl::resolveAssetPath(const std::string& filename) {
     std::string fullPath;
     for (auto& e : ASSET_PATHS) {
@@ -3038,10 +3261,9 @@ void CHyprOpenGLImpl::requestBackgroundResource() {
     if (*PNOWALLPAPER)
         return;
 
-    static bool        once    = true;
-    static std::string texPath = "wall";
+    if (m_backgroundPath.empty()) {
+        std::string texPath = "wall";
 
-    if (once) {
         // get the adequate tex
         if (FORCEWALLPAPER == -1) {
             std::mt19937_64                 engine(time(nullptr));
@@ -3053,17 +3275,15 @@ void CHyprOpenGLImpl::requestBackgroundResource() {
 
         texPath += ".png";
 
-        texPath = resolveAssetPath(texPath);
-
-        once = false;
+        m_backgroundPath = resolveAssetPath(texPath);
     }
 
-    if (texPath.empty()) {
+    if (m_backgroundPath.empty()) {
         m_backgroundResourceFailed = true;
         return;
     }
 
-    m_backgroundResource = makeAtomicShared<Hyprgraphics::CImageResource>(texPath);
+    m_backgroundResource = makeAtomicShared<Hyprgraphics::CImageResource>(m_backgroundPath);
 
     // doesn't have to be ASP as it's passed
     SP<CMainLoopExecutor> executor = makeShared<CMainLoopExecutor>([] {
@@ -3083,66 +3303,78 @@ void CHyprOpenGLImpl::requestBackgroundResource() {
 void CHyprOpenGLImpl::createBGTextureForMonitor(PHLMONITOR pMonitor) {
     RASSERT(m_renderData.pMonitor, "Tried to createBGTex without begin()!");
 
-    Debug::log(LOG, "Creating a texture for BGTex");
-
-    static auto PRENDERTEX = CConfigValue<Hyprlang::INT>("misc:disable_hyprland_logo");
-    static auto PNOSPLASH  = CConfigValue<Hyprlang::INT>("misc:disable_splash_rendering");
+    static auto PRENDERTEX   = CConfigValue<Hyprlang::INT>("misc:disable_hyprland_logo");
+    static auto PNOSPLASH    = CConfigValue<Hyprlang::INT>("misc:disable_splash_rendering");
+    static auto PSPLASHCOLOR = CConfigValue<Hyprlang::INT>("misc:col.splash");
+    static auto PSPLASHFONT  = CConfigValue<std::string>("misc:splash_font_family");
+    static auto FALLBACKFONT = CConfigValue<std::string>("misc:font_family");
 
     if (*PRENDERTEX || m_backgroundResourceFailed)
         return;
 
-    if (!m_backgroundResource) {
-        // queue the asset to be created
-        requestBackgroundResource();
+    const auto DRMFORMAT  = pMonitor->m_output->state->state().drmFormat;
+    const auto FONTFAMILY = *PSPLASHFONT != STRVAL_EMPTY ? *PSPLASHFONT : *FALLBACKFONT;
+    const auto SPLASHKEY  = *PNOSPLASH ?
+         std::string{} :
+         std::format("{}x{}:{}:{}:{:x}", pMonitor->m_pixelSize.x, pMonitor->m_pixelSize.y, g_pCompositor->m_currentSplash, FONTFAMILY, *PSPLASHCOLOR);
+    // the transform is in there because the wallpaper gets fit to the transformed size
+    const auto KEY = std::format("{}x{}:{:x}:{}:{}:{}", pMonitor->m_pixelSize.x, pMonitor->m_pixelSize.y, DRMFORMAT, sc<int>(pMonitor->m_transform), m_backgroundPath, SPLASHKEY);
+
+    // an identical monitor already has it
+    if (const auto IT = m_bgCache.find(KEY); IT != m_bgCache.end() && !IT->second.expired()) {
+        Debug::log(LOG, "Background for monitor {} shared from cache", pMonitor->m_name);
+
+        m_monitorBGFBs[pMonitor] = IT->second.lock();
+        pMonitor->m_backgroundOpacity->setValueAndWarp(0.F);
+        *pMonitor->m_backgroundOpacity = 1.F;
         return;
     }
 
-    if (!m_backgroundResource->m_ready)
-        return;
-
-    // release the last tex if exists
-    const auto PFB = &m_monitorBGFBs[pMonitor];
-    PFB->release();
-
-    PFB->alloc(pMonitor->m_pixelSize.x, pMonitor->m_pixelSize.y, pMonitor->m_output->state->state().drmFormat);
+    // the splash is rasterized off the main thread, the background color stays up in the meantime
+    SPendingSplash* splash = nullptr;
+    if (!SPLASHKEY.empty()) {
+        if (!m_bgSplashPending.contains(SPLASHKEY)) {
+            auto resource = makeAtomicShared<CBackgroundSplashResource>(pMonitor->m_pixelSize, g_pCompositor->m_currentSplash, FONTFAMILY, CHyprColor(*PSPLASHCOLOR));
 
-    // create a new one with cairo
-    SP<CTexture> tex = makeShared<CTexture>();
-
-    tex->allocate();
+            SP<CMainLoopExecutor> executor = makeShared<CMainLoopExecutor>([this, SPLASHKEY] {
+                g_pEventLoopManager->doLater([this, SPLASHKEY] {
+                    const auto IT = m_bgSplashPending.find(SPLASHKEY);
+                    if (IT == m_bgSplashPending.end())
+                        return;
 
-    const auto CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, pMonitor->m_pixelSize.x, pMonitor->m_pixelSize.y);
-    const auto CAIRO        = cairo_create(CAIROSURFACE);
+                    IT->second.ready = true;
 
-    cairo_set_antialias(CAIRO, CAIRO_ANTIALIAS_GOOD);
-    cairo_save(CAIRO);
-    cairo_set_source_rgba(CAIRO, 0, 0, 0, 0);
-    cairo_set_operator(CAIRO, CAIRO_OPERATOR_SOURCE);
-    cairo_paint(CAIRO);
-    cairo_restore(CAIRO);
+                    for (const auto& m : g_pCompositor->m_monitors) {
+                        g_pHyprRenderer->damageMonitor(m);
+                    }
+                });
+            });
 
-    if (!*PNOSPLASH)
-        renderSplash(CAIRO, CAIROSURFACE, 0.02 * pMonitor->m_pixelSize.y, pMonitor->m_pixelSize);
+            resource->m_events.finished.listenStatic([executor] {
+                // this is in the worker thread.
+                executor->signal();
+            });
 
-    cairo_surface_flush(CAIROSURFACE);
+            m_bgSplashPending[SPLASHKEY] = SPendingSplash{.resource = resource};
+            g_pAsyncResourceGatherer->enqueue(resource);
+        }
 
-    tex->m_size = pMonitor->m_pixelSize;
+        splash = &m_bgSplashPending[SPLASHKEY];
+    }
 
-    // copy the data to an OpenGL texture we have
-    const GLint glFormat = GL_RGBA;
-    const GLint glType   = GL_UNSIGNED_BYTE;
+    if (!m_backgroundResource) {
+        // queue the asset to be created
+        requestBackgroundResource();
+        return;
+    }
 
-    const auto  DATA = cairo_image_surface_get_data(CAIROSURFACE);
-    tex->bind();
-    tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    tex->setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    tex->setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
+    if (!m_backgroundResource->m_ready || (splash && !splash->ready))
+        return;
 
-    glTexImage2D(GL_TEXTURE_2D, 0, glFormat, tex->m_size.x, tex->m_size.y, 0, glFormat, glType, DATA);
+    Debug::log(LOG, "Creating a texture for BGTex");
 
-    cairo_surface_destroy(CAIROSURFACE);
-    cairo_destroy(CAIRO);
+    const auto PFB = makeShared<CFramebuffer>();
+    PFB->alloc(pMonitor->m_pixelSize.x, pMonitor->m_pixelSize.y, DRMFORMAT);
 
     // render the texture to our fb
     PFB->bind();
@@ -3172,8 +3404,11 @@ void CHyprOpenGLImpl::createBGTextureForMonitor(PHLMONITOR pMonitor) {
         renderTextureInternal(backgroundTexture, texbox, {.damage = &fakeDamage, .a = 1.0});
     }
 
-    CBox monbox = {{}, pMonitor->m_pixelSize};
-    renderTextureInternal(tex, monbox, {.damage = &fakeDamage, .a = 1.0});
+    // then the splash over it
+    if (splash && splash->resource->m_surface) {
+        CBox monbox = {{}, pMonitor->m_pixelSize};
+        renderTextureInternal(texFromCairo(splash->resource->m_surface), monbox, {.damage = &fakeDamage, .a = 1.0});
+    }
 
     // bind back
     if (m_renderData.currentFB)
@@ -3181,7 +3416,14 @@ void CHyprOpenGLImpl::createBGTextureForMonitor(PHLMONITOR pMonitor) {
 
     Debug::log(LOG, "Background created for monitor {}", pMonitor->m_name);
 
-    // clear the resource after we're done using it
+    std::erase_if(m_bgCache, [](const auto& e) { return e.second.expired(); });
+    m_bgCache[KEY]           = PFB;
+    m_monitorBGFBs[pMonitor] = PFB;
+
+    // the cache has it now, no need to keep the splash or the resource around
+    if (!SPLASHKEY.empty())
+        m_bgSplashPending.erase(SPLASHKEY);
+
     g_pEventLoopManager->doLater([this] { m_backgroundResource.reset(); });
 
     // set the animation to start for fading this background in nicely
@@ -3206,7 +3448,7 @@ void CHyprOpenGLImpl::clearWithTex() {
         data.box          = {0, 0, m_renderData.pMonitor->m_transformedSize.x, m_renderData.pMonitor->m_transformedSize.y};
         data.a            = m_renderData.pMonitor->m_backgroundOpacity->value();
         data.flipEndFrame = true;
-        data.tex          = TEXIT->second.getTexture();
+        data.tex          = TEXIT->second->getTexture();
         g_pHyprRenderer->m_renderPass.add(makeUnique<CTexPassElement>(std::move(data)));
     }
 }
@@ -3225,15 +3467,16 @@ void CHyprOpenGLImpl::destroyMonitorResources(PHLMONITORREF pMonitor) {
         RESIT->second.monitorMirrorFB.release();
         RESIT->second.blurFB.release();
         RESIT->second.offMainFB.release();
+        for (auto& mip : RESIT->second.blurMips) {
+            mip.release();
+        }
         RESIT->second.stencilTex->destroyTexture();
         g_pHyprOpenGL->m_monitorRenderResources.erase(RESIT);
     }
 
     auto TEXIT = g_pHyprOpenGL->m_monitorBGFBs.find(pMonitor);
-    if (TEXIT != g_pHyprOpenGL->m_monitorBGFBs.end()) {
-        TEXIT->second.release();
-        g_pHyprOpenGL->m_monitorBGFBs.erase(TEXIT);
-    }
+    if (TEXIT != g_pHyprOpenGL->m_monitorBGFBs.end())
+        g_pHyprOpenGL->m_monitorBGFBs.erase(TEXIT); // the fb goes once no other monitor shares it
 
     if (pMonitor)
         Debug::log(LOG, "Monitor {} -> destroyed all render data", pMonitor->m_name);
@@ -13,6 +13,8 @@
 #include <string>
 #include <stack>
 #include <map>
+#include <unordered_map>
+#include <array>
 
 #include <cairo/cairo.h>
 
@@ -20,6 +22,7 @@
 #include "Texture.hpp"
 #include "Framebuffer.hpp"
 #include "Renderbuffer.hpp"
+#include "ColorLUT.hpp"
 #include "pass/Pass.hpp"
 
 #include <EGL/egl.h>
@@ -84,6 +87,7 @@ enum eMonitorExtraRenderFBs : uint8_t {
 struct SPreparedShaders {
     std::string TEXVERTSRC;
     std::string TEXVERTSRC320;
+    std::string TEXFRAGSRCCM;
     SShader     m_shQUAD;
     SShader     m_shRGBA;
     SShader     m_shPASSTHRURGBA;
@@ -98,8 +102,13 @@ struct SPreparedShaders {
     SShader     m_shBORDER1;
     SShader     m_shGLITCH;
     SShader     m_shCM;
+
+    // m_shCM specializations by CHyprOpenGLImpl::getCMShader, built on first use. nullptr if one didn't compile
+    std::unordered_map<uint32_t, UP<SShader>> m_cmVariants;
 };
 
+constexpr int BLUR_MAX_PASSES = 8;
+
 struct SMonitorRenderData {
     CFramebuffer offloadFB;
     CFramebuffer mirrorFB;     // these are used for some effects,
@@ -108,6 +117,9 @@ struct SMonitorRenderData {
     CFramebuffer monitorMirrorFB; // used for mirroring outputs, does not contain artifacts like offloadFB
     CFramebuffer blurFB;
 
+    // blur down / up passes, each half the size of the one before. Allocated as deep as the passes need.
+    std::array<CFramebuffer, BLUR_MAX_PASSES> blurMips;
+
     SP<CTexture> stencilTex = makeShared<CTexture>();
 
     bool         blurFBDirty        = true;
@@ -171,6 +183,7 @@ class CEGLSync {
 };
 
 class CGradientValueData;
+class CBackgroundSplashResource;
 
 class CHyprOpenGLImpl {
   public:
@@ -287,6 +300,12 @@ class CHyprOpenGLImpl {
 
     SCurrentRenderData                          m_renderData;
 
+    // reset on begin(), shown in the debug overlay
+    struct {
+        size_t drawCalls = 0;
+        size_t quads     = 0;
+    } m_frameStats;
+
     Hyprutils::OS::CFileDescriptor              m_gbmFD;
     gbm_device*                                 m_gbmDevice      = nullptr;
     EGLContext                                  m_eglContext     = nullptr;
@@ -300,7 +319,7 @@ class CHyprOpenGLImpl {
     std::map<PHLLSREF, CFramebuffer>            m_layerFramebuffers;
     std::map<WP<CPopup>, CFramebuffer>          m_popupFramebuffers;
     std::map<PHLMONITORREF, SMonitorRenderData> m_monitorRenderResources;
-    std::map<PHLMONITORREF, CFramebuffer>       m_monitorBGFBs;
+    std::map<PHLMONITORREF, SP<CFramebuffer>>   m_monitorBGFBs; // monitors with identical backgrounds share one, see createBGTextureForMonitor
 
     struct {
         PFNGLEGLIMAGETARGETRENDERBUFFERSTORAGEOESPROC glEGLImageTargetRenderbufferStorageOES = nullptr;
@@ -378,8 +397,33 @@ class CHyprOpenGLImpl {
     SShader                           m_finalScreenShader;
     CTimer                            m_globalTimer;
     GLuint                            m_currentProgram;
+    std::vector<float>                m_batchVerts;
     ASP<Hyprgraphics::CImageResource> m_backgroundResource;
     bool                              m_backgroundResourceFailed = false;
+    std::string                       m_backgroundPath;
+
+    struct SPendingSplash {
+        ASP<CBackgroundSplashResource> resource;
+        bool                           ready = false;
+    };
+
+    // finished backgrounds by what went into them, and splashes still being rasterized by their size and contents
+    std::unordered_map<std::string, WP<CFramebuffer>> m_bgCache;
+    std::unordered_map<std::string, SPendingSplash>   m_bgSplashPending;
+
+    // render:cm_lut, baked conversions by the parameters they were baked for
+    struct SCMLut {
+        SCMShaderParams        params;
+        int                    size    = 0;
+        GLuint                 texture = 0;
+        ASP<CColorLUTResource> pending;
+        bool                   ready     = false; // pending is baked, but not uploaded yet
+        uint64_t               lastUsed  = 0;
+        uint64_t               lastFrame = 0; // m_cmLutFrame when it was last looked up, entries of the current frame aren't evicted
+    };
+    std::vector<SP<SCMLut>> m_cmLuts;
+    uint64_t                m_cmLutUses  = 0;
+    uint64_t                m_cmLutFrame = 0; // bumped by begin()
 
     void                              logShaderError(const GLuint&, bool program = false, bool silent = false);
     void                              createBGTextureForMonitor(PHLMONITOR);
@@ -406,8 +450,19 @@ class CHyprOpenGLImpl {
     void          passCMUniforms(SShader&, const NColorManagement::SImageDescription& imageDescription, const NColorManagement::SImageDescription& targetImageDescription,
                                  bool modifySDR = false, float sdrMinLuminance = -1.0f, int sdrMaxLuminance = -1);
     void          passCMUniforms(SShader&, const NColorManagement::SImageDescription& imageDescription);
+    void          passCMUniforms(SShader&, const SCMShaderParams& params);
+
+    // the generic m_shCM, or a variant of it with the transfer functions, texType, tonemapping and rounding baked in (render:cm_shader_variants).
+    // With lut, the variant samples a SCMLut instead and nullptr means it couldn't be built
+    SShader*                            getCMShader(const SCMShaderParams& params, eTextureType texType, bool rounding, bool lut = false);
+    SCMShaderParams                     getCMParams(const NColorManagement::SImageDescription& imageDescription, const NColorManagement::SImageDescription& targetImageDescription,
+                                                    bool modifySDR = false, float sdrMinLuminance = -1.0f, int sdrMaxLuminance = -1);
+    NColorManagement::eTransferFunction cmSourceTF(const NColorManagement::SImageDescription& imageDescription);
+    // a baked LUT for these params if render:cm_lut is on and one is ready, queues the bake otherwise
+    SCMLut*                             getCMLut(const SCMShaderParams& params);
+
     void          renderTexturePrimitive(SP<CTexture> tex, const CBox& box);
-    void          renderSplash(cairo_t* const, cairo_surface_t* const, double offset, const Vector2D& size);
+    void          drawQuadWithDamage(SShader* shader, const Mat3x3& glMatrix, const CRegion& damage, bool transform = true, const CBox& uv = {0, 0, 1, 1});
     void          renderRectInternal(const CBox&, const CHyprColor&, const SRectRenderData& data);
     void          renderRectWithBlurInternal(const CBox&, const CHyprColor&, const SRectRenderData& data);
     void          renderRectWithDamageInternal(const CBox&, const CHyprColor&, const SRectRenderData& data);
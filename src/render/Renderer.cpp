@@ -2,6 +2,7 @@
 #include "../Compositor.hpp"
 #include "../helpers/math/Math.hpp"
 #include <algorithm>
+#include <ranges>
 #include <aquamarine/output/Output.hpp>
 #include <filesystem>
 #include "../config/ConfigValue.hpp"
@@ -9,7 +10,7 @@
 #include "../managers/CursorManager.hpp"
 #include "../managers/PointerManager.hpp"
 #include "../managers/input/InputManager.hpp"
-#include "../managers/HookSystemManager.hpp"
+#include "../managers/HookEvents.hpp"
 #include "../managers/animation/AnimationManager.hpp"
 #include "../managers/LayoutManager.hpp"
 #include "../desktop/Window.hpp"
@@ -36,6 +37,7 @@
 #include "pass/RendererHintsPassElement.hpp"
 #include "pass/SurfacePassElement.hpp"
 #include "debug/Log.hpp"
+#include "debug/FrameTrace.hpp"
 #include "../protocols/ColorManagement.hpp"
 #include "../protocols/types/ContentType.hpp"
 #include "../helpers/MiscFunctions.hpp"
@@ -111,7 +113,7 @@ CHyprRenderer::CHyprRenderer() {
 
     // cursor hiding stuff
 
-    static auto P = g_pHookSystem->hookDynamic("keyPress", [&](void* self, SCallbackInfo& info, std::any param) {
+    static auto P = g_pHookSystem->hook<HOOK_EVENT_KEY_PRESS>([&](SCallbackInfo& info, const SKeyPressHookArg& e) {
         if (m_cursorHiddenConditions.hiddenOnKeyboard)
             return;
 
@@ -119,7 +121,7 @@ CHyprRenderer::CHyprRenderer() {
         ensureCursorRenderingMode();
     });
 
-    static auto P2 = g_pHookSystem->hookDynamic("mouseMove", [&](void* self, SCallbackInfo& info, std::any param) {
+    static auto P2 = g_pHookSystem->hook<HOOK_EVENT_MOUSE_MOVE>([&](SCallbackInfo& info, const Vector2D& pos) {
         if (!m_cursorHiddenConditions.hiddenOnKeyboard && m_cursorHiddenConditions.hiddenOnTouch == g_pInputManager->m_lastInputTouch && !m_cursorHiddenConditions.hiddenOnTimeout)
             return;
 
@@ -139,9 +141,7 @@ CHyprRenderer::CHyprRenderer() {
         });
     });
 
-    static auto P4 = g_pHookSystem->hookDynamic("windowUpdateRules", [&](void* self, SCallbackInfo& info, std::any param) {
-        const auto PWINDOW = std::any_cast<PHLWINDOW>(param);
-
+    static auto P4 = g_pHookSystem->hook<HOOK_EVENT_WINDOW_UPDATE_RULES>([&](SCallbackInfo& info, const PHLWINDOW& PWINDOW) {
         if (PWINDOW->m_ruleApplicator->renderUnfocused().valueOrDefault())
             addWindowToRenderUnfocused(PWINDOW);
     });
@@ -283,10 +283,79 @@ bool CHyprRenderer::shouldRenderWindow(PHLWINDOW pWindow) {
     return false;
 }
 
+static bool hasVisiblePopups(PHLWINDOW pWindow) {
+    if (pWindow->m_isX11 || !pWindow->m_popupHead)
+        return false;
+
+    bool visible = false;
+    pWindow->m_popupHead->breadthfirst([&visible](WP<CPopup> popup, void* data) { visible = visible || popup->m_mapped || popup->m_fadingOut; }, nullptr);
+    return visible;
+}
+
+std::vector<PHLWINDOW> CHyprRenderer::cullOccludedWindows(PHLMONITOR pMonitor, const std::vector<PHLWINDOW>& drawOrder, const Time::steady_tp& time) {
+    static auto            PCULL = CConfigValue<Hyprlang::INT>("render:cull_occluded_windows");
+
+    std::vector<PHLWINDOW> culled;
+
+    if (!*PCULL || drawOrder.size() < 2)
+        return culled;
+
+    // everything below is in layout coords, the same ones renderWindow positions windows in
+    CRegion opaque;
+
+    // front to back, so opaque always holds what's drawn over the current window
+    for (auto const& w : drawOrder | std::views::reverse) {
+        const auto PWORKSPACE = w->m_workspace;
+        const auto OFFSET     = (w->m_pinned || !PWORKSPACE ? Vector2D{} : PWORKSPACE->m_renderOffset->value()) + w->m_floatingOffset;
+        const bool DRAWN      = w->m_isMapped && !w->m_fadingOut && w->m_transformers.empty();
+        // windows over fullscreen can be in drawOrder twice, culling one would cull both
+        const bool ONCE = std::ranges::count(drawOrder, w) == 1;
+
+        m_occlusionStats.considered++;
+
+        // popups and dim_around draw outside of the bounding box
+        if (DRAWN && ONCE && !opaque.empty() && !w->m_ruleApplicator->dimAround().valueOrDefault() && !hasVisiblePopups(w) &&
+            CRegion{w->getFullWindowBoundingBox().translate(OFFSET)}.subtract(opaque).empty()) {
+            // what CSurfacePassElement::discard would've done, clients still need their frame callbacks
+            if (!m_bBlockSurfaceFeedback) {
+                w->m_wlSurface->resource()->breadthfirst(
+                    [&time, &pMonitor](SP<CWLSurfaceResource> s, const Vector2D& offset, void* data) {
+                        if (s->m_current.texture)
+                            s->presentFeedback(time, pMonitor, true);
+                    },
+                    nullptr);
+            }
+
+            m_occlusionStats.culled++;
+            culled.emplace_back(w);
+            continue;
+        }
+
+        const auto PSURFACE = w->m_wlSurface;
+        const bool OCCLUDES = DRAWN && w->m_monitorMovedFrom == -1 && w->m_movingFromWorkspaceAlpha->value() == 1.F && !w->m_realSize->isBeingAnimated() &&
+            PSURFACE->m_alphaModifier == 1.F && PSURFACE->m_overallOpacity == 1.F && w->opaque();
+
+        if (OCCLUDES) {
+            // rounded corners show what's behind
+            const float ROUNDING = w->isEffectiveInternalFSMode(FSMODE_FULLSCREEN) ? 0.F : w->rounding();
+            opaque.add(CBox{w->m_realPosition->value() + OFFSET, w->m_realSize->value()}.expand(-ROUNDING));
+        } else if (shouldBlur(w) && !g_pHyprOpenGL->shouldUseNewBlurOptimizations(nullptr, w)) {
+            // blur samples everything behind it (xray only needs the background), keep that around
+            opaque.subtract(w->getFullWindowBoundingBox().translate(OFFSET).expand(m_renderPass.oneBlurRadius()));
+        }
+    }
+
+    return culled;
+}
+
 void CHyprRenderer::renderWorkspaceWindowsFullscreen(PHLMONITOR pMonitor, PHLWORKSPACE pWorkspace, const Time::steady_tp& time) {
     PHLWINDOW pWorkspaceWindow = nullptr;
 
-    EMIT_HOOK_EVENT("render", RENDER_PRE_WINDOWS);
+    EMIT_HOOK(HOOK_EVENT_RENDER, RENDER_PRE_WINDOWS);
+
+    // collect first, culling needs the whole draw order before anything is rendered
+    std::vector<PHLWINDOW> drawOrder, overFullscreen;
+    std::vector<bool>      decorate;
 
     // loop over the tiled windows that are fading out
     for (auto const& w : g_pCompositor->m_windows) {
@@ -302,7 +371,8 @@ void CHyprRenderer::renderWorkspaceWindowsFullscreen(PHLMONITOR pMonitor, PHLWOR
         if (pWorkspace->m_isSpecialWorkspace != w->onSpecialWorkspace())
             continue;
 
-        renderWindow(w, pMonitor, time, true, RENDER_PASS_ALL);
+        drawOrder.emplace_back(w);
+        decorate.emplace_back(true);
     }
 
     // and floating ones too
@@ -322,7 +392,8 @@ void CHyprRenderer::renderWorkspaceWindowsFullscreen(PHLMONITOR pMonitor, PHLWOR
         if (pWorkspace->m_isSpecialWorkspace && w->m_monitor != pWorkspace->m_monitor)
             continue; // special on another are rendered as a part of the base pass
 
-        renderWindow(w, pMonitor, time, true, RENDER_PASS_ALL);
+        drawOrder.emplace_back(w);
+        decorate.emplace_back(true);
     }
 
     // TODO: this pass sucks
@@ -343,8 +414,10 @@ void CHyprRenderer::renderWorkspaceWindowsFullscreen(PHLMONITOR pMonitor, PHLWOR
         if (w->m_monitor == pWorkspace->m_monitor && pWorkspace->m_isSpecialWorkspace != w->onSpecialWorkspace())
             continue;
 
-        if (shouldRenderWindow(w, pMonitor))
-            renderWindow(w, pMonitor, time, pWorkspace->m_fullscreenMode != FSMODE_FULLSCREEN, RENDER_PASS_ALL);
+        if (shouldRenderWindow(w, pMonitor)) {
+            drawOrder.emplace_back(w);
+            decorate.emplace_back(pWorkspace->m_fullscreenMode != FSMODE_FULLSCREEN);
+        }
 
         if (w->m_workspace != pWorkspace)
             continue;
@@ -352,35 +425,52 @@ void CHyprRenderer::renderWorkspaceWindowsFullscreen(PHLMONITOR pMonitor, PHLWOR
         pWorkspaceWindow = w;
     }
 
+    // then windows over fullscreen.
+    if (pWorkspaceWindow) {
+        for (auto const& w : g_pCompositor->m_windows) {
+            if (w->workspaceID() != pWorkspaceWindow->workspaceID() || !w->m_isFloating || (!w->m_createdOverFullscreen && !w->m_pinned) ||
+                (!w->m_isMapped && !w->m_fadingOut) || w->isFullscreen())
+                continue;
+
+            if (w->m_monitor == pWorkspace->m_monitor && pWorkspace->m_isSpecialWorkspace != w->onSpecialWorkspace())
+                continue;
+
+            if (pWorkspace->m_isSpecialWorkspace && w->m_monitor != pWorkspace->m_monitor)
+                continue; // special on another are rendered as a part of the base pass
+
+            overFullscreen.emplace_back(w);
+        }
+    }
+
+    const auto BELOW_COUNT = drawOrder.size();
+    drawOrder.insert(drawOrder.end(), overFullscreen.begin(), overFullscreen.end());
+
+    const auto CULLED = cullOccludedWindows(pMonitor, drawOrder, time);
+
+    for (size_t i = 0; i < BELOW_COUNT; ++i) {
+        if (!std::ranges::contains(CULLED, drawOrder[i]))
+            renderWindow(drawOrder[i], pMonitor, time, decorate[i], RENDER_PASS_ALL);
+    }
+
     if (!pWorkspaceWindow) {
         // ?? happens sometimes...
         pWorkspace->m_hasFullscreenWindow = false;
         return; // this will produce one blank frame. Oh well.
     }
 
-    // then render windows over fullscreen.
-    for (auto const& w : g_pCompositor->m_windows) {
-        if (w->workspaceID() != pWorkspaceWindow->workspaceID() || !w->m_isFloating || (!w->m_createdOverFullscreen && !w->m_pinned) || (!w->m_isMapped && !w->m_fadingOut) ||
-            w->isFullscreen())
-            continue;
-
-        if (w->m_monitor == pWorkspace->m_monitor && pWorkspace->m_isSpecialWorkspace != w->onSpecialWorkspace())
-            continue;
-
-        if (pWorkspace->m_isSpecialWorkspace && w->m_monitor != pWorkspace->m_monitor)
-            continue; // special on another are rendered as a part of the base pass
-
-        renderWindow(w, pMonitor, time, true, RENDER_PASS_ALL);
+    for (auto const& w : overFullscreen) {
+        if (!std::ranges::contains(CULLED, w))
+            renderWindow(w, pMonitor, time, true, RENDER_PASS_ALL);
     }
 }
 
 void CHyprRenderer::renderWorkspaceWindows(PHLMONITOR pMonitor, PHLWORKSPACE pWorkspace, const Time::steady_tp& time) {
     PHLWINDOW lastWindow;
 
-    EMIT_HOOK_EVENT("render", RENDER_PRE_WINDOWS);
+    EMIT_HOOK(HOOK_EVENT_RENDER, RENDER_PRE_WINDOWS);
 
-    std::vector<PHLWINDOWREF> windows, tiledFadingOut;
-    windows.reserve(g_pCompositor->m_windows.size());
+    std::vector<PHLWINDOW> tiled, tiledFadingOut, floating;
+    tiled.reserve(g_pCompositor->m_windows.size());
 
     for (auto const& w : g_pCompositor->m_windows) {
         if (w->isHidden() || (!w->m_isMapped && !w->m_fadingOut))
@@ -389,86 +479,59 @@ void CHyprRenderer::renderWorkspaceWindows(PHLMONITOR pMonitor, PHLWORKSPACE pWo
         if (!shouldRenderWindow(w, pMonitor))
             continue;
 
-        windows.emplace_back(w);
-    }
-
-    // Non-floating main
-    for (auto& w : windows) {
-        if (w->m_isFloating)
-            continue; // floating are in the second pass
-
         // some things may force us to ignore the special/not special disparity
         const bool IGNORE_SPECIAL_CHECK = w->m_monitorMovedFrom != -1 && (w->m_workspace && !w->m_workspace->isVisible());
 
         if (!IGNORE_SPECIAL_CHECK && pWorkspace->m_isSpecialWorkspace != w->onSpecialWorkspace())
             continue;
 
-        // render active window after all others of this pass
-        if (w == Desktop::focusState()->window()) {
-            lastWindow = w.lock();
-            continue;
-        }
+        if (w->m_isFloating) {
+            if (w->m_pinned)
+                continue; // pinned are rendered above all workspaces
 
-        // render tiled fading out after others
-        if (w->m_fadingOut) {
-            tiledFadingOut.emplace_back(w);
-            w.reset();
-            continue;
-        }
+            if (pWorkspace->m_isSpecialWorkspace && w->m_monitor != pWorkspace->m_monitor)
+                continue; // special on another are rendered as a part of the base pass
 
-        // render the bad boy
-        renderWindow(w.lock(), pMonitor, time, true, RENDER_PASS_MAIN);
-        w.reset();
+            floating.emplace_back(w);
+        } else if (w == Desktop::focusState()->window())
+            lastWindow = w; // render active window after all others of this pass
+        else if (w->m_fadingOut)
+            tiledFadingOut.emplace_back(w); // render tiled fading out after others
+        else
+            tiled.emplace_back(w);
     }
 
+    // back to front, the order the loops below render in
     if (lastWindow)
-        renderWindow(lastWindow, pMonitor, time, true, RENDER_PASS_MAIN);
-
-    lastWindow.reset();
-
-    // render tiled windows that are fading out after other tiled to not hide them behind
-    for (auto& w : tiledFadingOut) {
-        renderWindow(w.lock(), pMonitor, time, true, RENDER_PASS_MAIN);
-    }
+        tiled.emplace_back(lastWindow);
 
-    // Non-floating popup
-    for (auto& w : windows) {
-        if (!w)
-            continue;
+    tiled.insert(tiled.end(), tiledFadingOut.begin(), tiledFadingOut.end());
 
-        if (w->m_isFloating)
-            continue; // floating are in the second pass
+    std::vector<PHLWINDOW> drawOrder = tiled;
+    drawOrder.insert(drawOrder.end(), floating.begin(), floating.end());
 
-        // some things may force us to ignore the special/not special disparity
-        const bool IGNORE_SPECIAL_CHECK = w->m_monitorMovedFrom != -1 && (w->m_workspace && !w->m_workspace->isVisible());
+    const auto CULLED = cullOccludedWindows(pMonitor, drawOrder, time);
 
-        if (!IGNORE_SPECIAL_CHECK && pWorkspace->m_isSpecialWorkspace != w->onSpecialWorkspace())
+    // Non-floating main
+    for (auto const& w : tiled) {
+        if (std::ranges::contains(CULLED, w))
             continue;
 
         // render the bad boy
-        renderWindow(w.lock(), pMonitor, time, true, RENDER_PASS_POPUP);
-        w.reset();
+        renderWindow(w, pMonitor, time, true, RENDER_PASS_MAIN);
     }
 
-    // floating on top
-    for (auto& w : windows) {
-        if (!w)
-            continue;
-
-        if (!w->m_isFloating || w->m_pinned)
-            continue;
+    // Non-floating popup, only the active window gets its popups drawn over the other tiled ones
+    if (lastWindow && !std::ranges::contains(CULLED, lastWindow))
+        renderWindow(lastWindow, pMonitor, time, true, RENDER_PASS_POPUP);
 
-        // some things may force us to ignore the special/not special disparity
-        const bool IGNORE_SPECIAL_CHECK = w->m_monitorMovedFrom != -1 && (w->m_workspace && !w->m_workspace->isVisible());
-
-        if (!IGNORE_SPECIAL_CHECK && pWorkspace->m_isSpecialWorkspace != w->onSpecialWorkspace())
+    // floating on top
+    for (auto const& w : floating) {
+        if (std::ranges::contains(CULLED, w))
             continue;
 
-        if (pWorkspace->m_isSpecialWorkspace && w->m_monitor != pWorkspace->m_monitor)
-            continue; // special on another are rendered as a part of the base pass
-
         // render the bad boy
-        renderWindow(w.lock(), pMonitor, time, true, RENDER_PASS_ALL);
+        renderWindow(w, pMonitor, time, true, RENDER_PASS_ALL);
     }
 }
 
@@ -541,7 +604,7 @@ void CHyprRenderer::renderWindow(PHLWINDOW pWindow, PHLMONITOR pMonitor, const T
     // for plugins
     g_pHyprOpenGL->m_renderData.currentWindow = pWindow;
 
-    EMIT_HOOK_EVENT("render", RENDER_PRE_WINDOW);
+    EMIT_HOOK(HOOK_EVENT_RENDER, RENDER_PRE_WINDOW);
 
     const auto fullAlpha = renderdata.alpha * renderdata.fadeAlpha;
 
@@ -724,7 +787,7 @@ void CHyprRenderer::renderWindow(PHLWINDOW pWindow, PHLMONITOR pMonitor, const T
         }
     }
 
-    EMIT_HOOK_EVENT("render", RENDER_POST_WINDOW);
+    EMIT_HOOK(HOOK_EVENT_RENDER, RENDER_POST_WINDOW);
 
     g_pHyprOpenGL->m_renderData.currentWindow.reset();
 }
@@ -936,7 +999,7 @@ void CHyprRenderer::renderAllClientsForWorkspace(PHLMONITOR pMonitor, PHLWORKSPA
             renderLayer(ls.lock(), pMonitor, time);
         }
 
-        EMIT_HOOK_EVENT("render", RENDER_POST_WALLPAPER);
+        EMIT_HOOK(HOOK_EVENT_RENDER, RENDER_POST_WALLPAPER);
 
         for (auto const& ls : pMonitor->m_layerSurfaceLayers[ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM]) {
             renderLayer(ls.lock(), pMonitor, time);
@@ -960,7 +1023,7 @@ void CHyprRenderer::renderAllClientsForWorkspace(PHLMONITOR pMonitor, PHLWORKSPA
             renderLayer(ls.lock(), pMonitor, time);
         }
 
-        EMIT_HOOK_EVENT("render", RENDER_POST_WALLPAPER);
+        EMIT_HOOK(HOOK_EVENT_RENDER, RENDER_POST_WALLPAPER);
 
         for (auto const& ls : pMonitor->m_layerSurfaceLayers[ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM]) {
             renderLayer(ls.lock(), pMonitor, time);
@@ -1025,7 +1088,7 @@ void CHyprRenderer::renderAllClientsForWorkspace(PHLMONITOR pMonitor, PHLWORKSPA
         renderWindow(w, pMonitor, time, true, RENDER_PASS_ALL);
     }
 
-    EMIT_HOOK_EVENT("render", RENDER_POST_WINDOWS);
+    EMIT_HOOK(HOOK_EVENT_RENDER, RENDER_POST_WINDOWS);
 
     // Render surfaces above windows for monitor
     for (auto const& ls : pMonitor->m_layerSurfaceLayers[ZWLR_LAYER_SHELL_V1_LAYER_TOP]) {
@@ -1257,6 +1320,8 @@ void CHyprRenderer::calculateUVForSurface(PHLWINDOW pWindow, SP<CWLSurfaceResour
 }
 
 void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
+    TRACE_SCOPE("renderMonitor");
+
     static std::chrono::high_resolution_clock::time_point renderStart        = std::chrono::high_resolution_clock::now();
     static std::chrono::high_resolution_clock::time_point renderStartOverlay = std::chrono::high_resolution_clock::now();
     static std::chrono::high_resolution_clock::time_point endRenderOverlay   = std::chrono::high_resolution_clock::now();
@@ -1298,10 +1363,7 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
             g_pConfigManager->performMonitorReload();
     }
 
-    if (pMonitor->m_scheduledRecalc) {
-        pMonitor->m_scheduledRecalc = false;
-        g_pLayoutManager->getCurrentLayout()->recalculateMonitor(pMonitor->m_id);
-    }
+    g_pLayoutManager->flushPendingRecalcs();
 
     if (!pMonitor->m_output->needsFrame && pMonitor->m_forceFullFrames == 0)
         return;
@@ -1322,7 +1384,7 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
         pMonitor->m_drmFormat = pMonitor->m_prevDrmFormat;
     }
 
-    EMIT_HOOK_EVENT("preRender", pMonitor);
+    EMIT_HOOK(HOOK_EVENT_PRE_RENDER, pMonitor);
 
     const auto NOW = Time::steadyNow();
 
@@ -1337,7 +1399,7 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
         return;
     }
 
-    EMIT_HOOK_EVENT("render", RENDER_PRE);
+    EMIT_HOOK(HOOK_EVENT_RENDER, RENDER_PRE);
 
     pMonitor->m_renderingActive = true;
 
@@ -1369,6 +1431,8 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
         g_pHyprOpenGL->m_renderData.useNearestNeighbor = false;
     }
 
+    m_occlusionStats = {};
+
     CRegion damage, finalDamage;
     if (!beginRender(pMonitor, damage, RENDER_MODE_NORMAL)) {
         Debug::log(ERR, "renderer: couldn't beginRender()!");
@@ -1390,7 +1454,7 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
             pMonitor->m_forceFullFrames = 0;
     }
 
-    EMIT_HOOK_EVENT("render", RENDER_BEGIN);
+    EMIT_HOOK(HOOK_EVENT_RENDER, RENDER_BEGIN);
 
     bool renderCursor = true;
 
@@ -1400,7 +1464,7 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
                 g_pHyprOpenGL->blend(false);
                 g_pHyprOpenGL->renderMirrored();
                 g_pHyprOpenGL->blend(true);
-                EMIT_HOOK_EVENT("render", RENDER_POST_MIRROR);
+                EMIT_HOOK(HOOK_EVENT_RENDER, RENDER_POST_MIRROR);
                 renderCursor = false;
             } else {
                 CBox renderBox = {0, 0, sc<int>(pMonitor->m_pixelSize.x), sc<int>(pMonitor->m_pixelSize.y)};
@@ -1455,7 +1519,7 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
         m_renderPass.add(makeUnique<CRectPassElement>(data));
     }
 
-    EMIT_HOOK_EVENT("render", RENDER_LAST_MOMENT);
+    EMIT_HOOK(HOOK_EVENT_RENDER, RENDER_LAST_MOMENT);
 
     endRender();
 
@@ -1477,7 +1541,7 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
 
     pMonitor->m_renderingActive = false;
 
-    EMIT_HOOK_EVENT("render", RENDER_POST);
+    EMIT_HOOK(HOOK_EVENT_RENDER, RENDER_POST);
 
     pMonitor->m_output->state->addDamage(frameDamage);
     pMonitor->m_output->state->setPresentationMode(shouldTear ? Aquamarine::eOutputPresentationMode::AQ_OUTPUT_PRESENTATION_IMMEDIATE :
@@ -1497,6 +1561,8 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
     if (*PDEBUGOVERLAY == 1) {
         const float durationUs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - renderStart).count() / 1000.f;
         g_pDebugOverlay->renderData(pMonitor, durationUs);
+        g_pDebugOverlay->drawCallData(pMonitor, g_pHyprOpenGL->m_frameStats.drawCalls, g_pHyprOpenGL->m_frameStats.quads);
+        g_pDebugOverlay->occlusionData(pMonitor, m_occlusionStats.culled, m_occlusionStats.considered);
 
         if (pMonitor == g_pCompositor->m_monitors.front()) {
             const float noOverlayUs = durationUs - std::chrono::duration_cast<std::chrono::nanoseconds>(endRenderOverlay - renderStartOverlay).count() / 1000.f;
@@ -1935,7 +2001,18 @@ void CHyprRenderer::arrangeLayersForMonitor(const MONITORID& monitor) {
     // damage the monitor if can
     damageMonitor(PMONITOR);
 
-    g_pLayoutManager->getCurrentLayout()->recalculateMonitor(monitor);
+    auto& last = PMONITOR->m_lastArrange;
+    if (last.valid && last.position == PMONITOR->m_position && last.size == PMONITOR->m_size && last.reservedTopLeft == PMONITOR->m_reservedTopLeft &&
+        last.reservedBottomRight == PMONITOR->m_reservedBottomRight)
+        return;
+
+    last = {.position            = PMONITOR->m_position,
+            .size                = PMONITOR->m_size,
+            .reservedTopLeft     = PMONITOR->m_reservedTopLeft,
+            .reservedBottomRight = PMONITOR->m_reservedBottomRight,
+            .valid               = true};
+
+    g_pLayoutManager->scheduleRecalc(monitor);
 }
 
 void CHyprRenderer::damageSurface(SP<CWLSurfaceResource> pSurface, double x, double y, double scale) {
@@ -2354,6 +2431,8 @@ bool CHyprRenderer::beginRender(PHLMONITOR pMonitor, CRegion& damage, eRenderMod
 }
 
 void CHyprRenderer::endRender(const std::function<void()>& renderingDoneCallback) {
+    TRACE_SCOPE("endRender");
+
     const auto  PMONITOR           = g_pHyprOpenGL->m_renderData.pMonitor;
     static auto PNVIDIAANTIFLICKER = CConfigValue<Hyprlang::INT>("opengl:nvidia_anti_flicker");
 
@@ -159,11 +159,18 @@ class CHyprRenderer {
         bool hiddenOnKeyboard = false;
     } m_cursorHiddenConditions;
 
+    std::vector<PHLWINDOW>         cullOccludedWindows(PHLMONITOR, const std::vector<PHLWINDOW>& drawOrder, const Time::steady_tp&); // drawOrder is back to front
     SP<CRenderbuffer>              getOrCreateRenderbuffer(SP<Aquamarine::IBuffer> buffer, uint32_t fmt);
     std::vector<SP<CRenderbuffer>> m_renderbuffers;
     std::vector<PHLWINDOWREF>      m_renderUnfocused;
     SP<CEventLoopTimer>            m_renderUnfocusedTimer;
 
+    // reset every renderMonitor, shown in the debug overlay
+    struct {
+        size_t considered = 0;
+        size_t culled     = 0;
+    } m_occlusionStats;
+
     friend class CHyprOpenGLImpl;
     friend class CToplevelExportFrame;
     friend class CInputManager;
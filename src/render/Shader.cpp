@@ -45,16 +45,39 @@ void SShader::createVao() {
         glVertexAttribPointer(uniformLocations[SHADER_TEX_ATTRIB], 2, GL_FLOAT, GL_FALSE, 0, nullptr);
     }
 
+    glBindVertexArray(0);
+
+    // batched quads: interleaved pos / uv, streamed per draw (see CHyprOpenGLImpl::drawQuadWithDamage)
+    GLuint batchVao = 0, batchVbo = 0;
+
+    glGenVertexArrays(1, &batchVao);
+    glBindVertexArray(batchVao);
+    glGenBuffers(1, &batchVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, batchVbo);
+
+    if (uniformLocations[SHADER_POS_ATTRIB] != -1) {
+        glEnableVertexAttribArray(uniformLocations[SHADER_POS_ATTRIB]);
+        glVertexAttribPointer(uniformLocations[SHADER_POS_ATTRIB], 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), nullptr);
+    }
+
+    if (uniformLocations[SHADER_TEX_ATTRIB] != -1) {
+        glEnableVertexAttribArray(uniformLocations[SHADER_TEX_ATTRIB]);
+        glVertexAttribPointer(uniformLocations[SHADER_TEX_ATTRIB], 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), rc<void*>(2 * sizeof(float)));
+    }
+
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    uniformLocations[SHADER_SHADER_VAO]     = shaderVao;
-    uniformLocations[SHADER_SHADER_VBO_POS] = shaderVbo;
-    uniformLocations[SHADER_SHADER_VBO_UV]  = shaderVboUv;
+    uniformLocations[SHADER_SHADER_VAO]       = shaderVao;
+    uniformLocations[SHADER_SHADER_VBO_POS]   = shaderVbo;
+    uniformLocations[SHADER_SHADER_VBO_UV]    = shaderVboUv;
+    uniformLocations[SHADER_SHADER_VAO_BATCH] = batchVao;
+    uniformLocations[SHADER_SHADER_VBO_BATCH] = batchVbo;
 
     RASSERT(uniformLocations[SHADER_SHADER_VAO] >= 0, "SHADER_SHADER_VAO could not be created");
     RASSERT(uniformLocations[SHADER_SHADER_VBO_POS] >= 0, "SHADER_SHADER_VBO_POS could not be created");
     RASSERT(uniformLocations[SHADER_SHADER_VBO_UV] >= 0, "SHADER_SHADER_VBO_UV could not be created");
+    RASSERT(uniformLocations[SHADER_SHADER_VAO_BATCH] >= 0, "SHADER_SHADER_VAO_BATCH could not be created");
 }
 
 void SShader::setUniformInt(eShaderUniform location, GLint v0) {
@@ -220,6 +243,15 @@ void SShader::destroy() {
     if (shaderVboUv)
         glDeleteBuffers(1, &shaderVboUv);
 
+    GLuint batchVao = uniformLocations[SHADER_SHADER_VAO_BATCH] == -1 ? 0 : uniformLocations[SHADER_SHADER_VAO_BATCH];
+    GLuint batchVbo = uniformLocations[SHADER_SHADER_VBO_BATCH] == -1 ? 0 : uniformLocations[SHADER_SHADER_VBO_BATCH];
+
+    if (batchVao)
+        glDeleteVertexArrays(1, &batchVao);
+
+    if (batchVbo)
+        glDeleteBuffers(1, &batchVbo);
+
     glDeleteProgram(program);
     program = 0;
 }
@@ -21,6 +21,8 @@ enum eShaderUniform : uint8_t {
     SHADER_SDR_SATURATION,
     SHADER_SDR_BRIGHTNESS,
     SHADER_CONVERT_MATRIX,
+    SHADER_CM_LUT,
+    SHADER_CM_LUT_SIZE,
     SHADER_TEX,
     SHADER_ALPHA,
     SHADER_POS_ATTRIB,
@@ -32,6 +34,8 @@ enum eShaderUniform : uint8_t {
     SHADER_SHADER_VAO,
     SHADER_SHADER_VBO_POS,
     SHADER_SHADER_VBO_UV,
+    SHADER_SHADER_VAO_BATCH,
+    SHADER_SHADER_VBO_BATCH,
     SHADER_TOP_LEFT,
     SHADER_BOTTOM_RIGHT,
     SHADER_FULL_SIZE,
@@ -61,14 +61,21 @@ Vector2D CDecorationPositioner::getEdgeDefinedPoint(uint32_t edges, PHLWINDOWREF
     return {};
 }
 
-void CDecorationPositioner::uncacheDecoration(IHyprWindowDecoration* deco) {
-    std::erase_if(m_windowPositioningDatas, [&](const auto& data) { return !data->pWindow.lock() || data->pDecoration == deco; });
+CDecorationPositioner::SWindowData* CDecorationPositioner::getWindowData(const PHLWINDOWREF& pWindow) {
+    const auto WIT = m_windowDatas.find(pWindow.get());
+    if (WIT == m_windowDatas.end() || WIT->second.window.expired())
+        return nullptr;
+
+    return &WIT->second;
+}
 
-    const auto WIT = std::ranges::find_if(m_windowDatas, [&](const auto& other) { return other.first.lock() == deco->m_window.lock(); });
-    if (WIT == m_windowDatas.end())
+void CDecorationPositioner::uncacheDecoration(IHyprWindowDecoration* deco) {
+    const auto WINDOWDATA = getWindowData(deco->m_window);
+    if (!WINDOWDATA)
         return;
 
-    WIT->second.needsRecalc = true;
+    std::erase_if(WINDOWDATA->decorations, [deco](const auto& data) { return data.pDecoration == deco; });
+    WINDOWDATA->needsRecalc = true;
 }
 
 void CDecorationPositioner::repositionDeco(IHyprWindowDecoration* deco) {
@@ -76,37 +83,31 @@ void CDecorationPositioner::repositionDeco(IHyprWindowDecoration* deco) {
     onWindowUpdate(deco->m_window.lock());
 }
 
-CDecorationPositioner::SWindowPositioningData* CDecorationPositioner::getDataFor(IHyprWindowDecoration* pDecoration, PHLWINDOW pWindow) {
-    auto it = std::ranges::find_if(m_windowPositioningDatas, [&](const auto& el) { return el->pDecoration == pDecoration; });
+CDecorationPositioner::SDecorationData* CDecorationPositioner::getDataFor(IHyprWindowDecoration* pDecoration, SWindowData& windowData) {
+    auto it = std::ranges::find_if(windowData.decorations, [pDecoration](const auto& el) { return el.pDecoration == pDecoration; });
 
-    if (it != m_windowPositioningDatas.end())
-        return it->get();
+    if (it != windowData.decorations.end())
+        return &*it;
 
-    const auto DATA = m_windowPositioningDatas.emplace_back(makeUnique<CDecorationPositioner::SWindowPositioningData>(pWindow, pDecoration)).get();
-
-    DATA->positioningInfo = pDecoration->getPositioningInfo();
-
-    return DATA;
+    return &windowData.decorations.emplace_back(SDecorationData{.pDecoration = pDecoration, .positioningInfo = pDecoration->getPositioningInfo()});
 }
 
-void CDecorationPositioner::sanitizeDatas() {
-    std::erase_if(m_windowDatas, [](const auto& other) { return !valid(other.first); });
-    std::erase_if(m_windowPositioningDatas, [](const auto& other) {
-        if (!validMapped(other->pWindow))
-            return true;
-        if (std::ranges::find_if(other->pWindow->m_windowDecorations, [&](const auto& el) { return el.get() == other->pDecoration; }) == other->pWindow->m_windowDecorations.end())
-            return true;
-        return false;
+void CDecorationPositioner::syncDecorations(SWindowData& windowData, PHLWINDOW pWindow) {
+    // decorations removed through removeWindowDeco are uncached already, this catches anything that went away another way
+    std::erase_if(windowData.decorations, [&pWindow](const auto& data) {
+        return std::ranges::find_if(pWindow->m_windowDecorations, [&data](const auto& el) { return el.get() == data.pDecoration; }) == pWindow->m_windowDecorations.end();
     });
+
+    for (auto const& wd : pWindow->m_windowDecorations) {
+        getDataFor(wd.get(), windowData);
+    }
 }
 
 void CDecorationPositioner::forceRecalcFor(PHLWINDOW pWindow) {
-    const auto WIT = std::ranges::find_if(m_windowDatas, [&](const auto& other) { return other.first.lock() == pWindow; });
-    if (WIT == m_windowDatas.end())
+    const auto WINDOWDATA = getWindowData(pWindow);
+    if (!WINDOWDATA)
         return;
 
-    const auto WINDOWDATA = &WIT->second;
-
     WINDOWDATA->needsRecalc = true;
 }
 
@@ -114,46 +115,36 @@ void CDecorationPositioner::onWindowUpdate(PHLWINDOW pWindow) {
     if (!validMapped(pWindow))
         return;
 
-    const auto WIT = std::ranges::find_if(m_windowDatas, [&](const auto& other) { return other.first.lock() == pWindow; });
-    if (WIT == m_windowDatas.end())
+    const auto WINDOWDATA = getWindowData(pWindow);
+    if (!WINDOWDATA)
         return;
 
-    const auto WINDOWDATA = &WIT->second;
-
-    sanitizeDatas();
-
-    //
-    std::vector<CDecorationPositioner::SWindowPositioningData*> datas;
-    // reserve to avoid reallocations
-    datas.reserve(pWindow->m_windowDecorations.size());
+    syncDecorations(*WINDOWDATA, pWindow);
 
-    for (auto const& wd : pWindow->m_windowDecorations) {
-        datas.push_back(getDataFor(wd.get(), pWindow));
-    }
+    auto& datas = WINDOWDATA->decorations;
 
     if (WINDOWDATA->lastWindowSize == pWindow->m_realSize->value() /* position not changed */
-        && std::ranges::all_of(m_windowPositioningDatas, [pWindow](const auto& data) { return pWindow != data->pWindow.lock() || !data->needsReposition; })
-        /* all window datas are either not for this window or don't need a reposition */
+        && std::ranges::all_of(datas, [](const auto& data) { return !data.needsReposition; }) /* no decoration needs a reposition */
         && !WINDOWDATA->needsRecalc /* window doesn't need recalc */
     )
         return;
 
-    for (auto const& wd : datas) {
-        wd->positioningInfo = wd->pDecoration->getPositioningInfo();
+    for (auto& wd : datas) {
+        wd.positioningInfo = wd.pDecoration->getPositioningInfo();
     }
 
     WINDOWDATA->lastWindowSize = pWindow->m_realSize->value();
     WINDOWDATA->needsRecalc    = false;
     const bool EPHEMERAL       = pWindow->m_realSize->isBeingAnimated();
 
-    std::ranges::sort(datas, [](const auto& a, const auto& b) { return a->positioningInfo.priority > b->positioningInfo.priority; });
+    std::ranges::sort(datas, [](const auto& a, const auto& b) { return a.positioningInfo.priority > b.positioningInfo.priority; });
 
     CBox wb = pWindow->getWindowMainSurfaceBox();
 
     // calc reserved
     float reservedXL = 0, reservedYT = 0, reservedXR = 0, reservedYB = 0;
-    for (size_t i = 0; i < datas.size(); ++i) {
-        auto* const wd = datas[i];
+    for (auto& data : datas) {
+        auto* const wd = &data;
 
         if (!wd->positioningInfo.reserved)
             continue;
@@ -177,8 +168,8 @@ void CDecorationPositioner::onWindowUpdate(PHLWINDOW pWindow) {
 
     float stickyOffsetXL = 0, stickyOffsetYT = 0, stickyOffsetXR = 0, stickyOffsetYB = 0;
 
-    for (size_t i = 0; i < datas.size(); ++i) {
-        auto* const wd = datas[i];
+    for (auto& data : datas) {
+        auto* const wd = &data;
 
         wd->needsReposition = false;
 
@@ -283,40 +274,37 @@ void CDecorationPositioner::onWindowUpdate(PHLWINDOW pWindow) {
 }
 
 void CDecorationPositioner::onWindowUnmap(PHLWINDOW pWindow) {
-    std::erase_if(m_windowPositioningDatas, [&](const auto& data) { return data->pWindow.lock() == pWindow; });
-    m_windowDatas.erase(pWindow);
+    m_windowDatas.erase(pWindow.get());
 }
 
 void CDecorationPositioner::onWindowMap(PHLWINDOW pWindow) {
-    m_windowDatas[pWindow] = {};
+    m_windowDatas[pWindow.get()] = {.window = pWindow};
 }
 
 SBoxExtents CDecorationPositioner::getWindowDecorationReserved(PHLWINDOWREF pWindow) {
-    try {
-        const auto E = m_windowDatas.at(pWindow);
-        return E.reserved;
-    } catch (std::out_of_range& e) { return {}; }
+    const auto WINDOWDATA = getWindowData(pWindow);
+    return WINDOWDATA ? WINDOWDATA->reserved : SBoxExtents{};
 }
 
 SBoxExtents CDecorationPositioner::getWindowDecorationExtents(PHLWINDOWREF pWindow, bool inputOnly) {
     CBox const mainSurfaceBox = pWindow->getWindowMainSurfaceBox();
     CBox       accum          = mainSurfaceBox;
 
-    for (auto const& data : m_windowPositioningDatas) {
-        if (!data->pDecoration || (inputOnly && !(data->pDecoration->getDecorationFlags() & DECORATION_ALLOWS_MOUSE_INPUT)))
-            continue;
+    const auto WINDOWDATA = getWindowData(pWindow);
+    if (!WINDOWDATA)
+        return {};
 
-        auto const window = data->pWindow;
-        if (!window || window != pWindow)
+    for (auto const& data : WINDOWDATA->decorations) {
+        if (!data.pDecoration || (inputOnly && !(data.pDecoration->getDecorationFlags() & DECORATION_ALLOWS_MOUSE_INPUT)))
             continue;
 
         CBox decoBox;
-        if (data->positioningInfo.policy == DECORATION_POSITION_ABSOLUTE) {
+        if (data.positioningInfo.policy == DECORATION_POSITION_ABSOLUTE) {
             decoBox = mainSurfaceBox;
-            decoBox.addExtents(data->positioningInfo.desiredExtents);
+            decoBox.addExtents(data.positioningInfo.desiredExtents);
         } else {
-            decoBox = data->lastReply.assignedGeometry;
-            decoBox.translate(getEdgeDefinedPoint(data->positioningInfo.edges, pWindow));
+            decoBox = data.lastReply.assignedGeometry;
+            decoBox.translate(getEdgeDefinedPoint(data.positioningInfo.edges, pWindow));
         }
 
         // Check bounds only if decoBox extends beyond accum
@@ -348,23 +336,24 @@ SBoxExtents CDecorationPositioner::getWindowDecorationExtents(PHLWINDOWREF pWind
 }
 
 CBox CDecorationPositioner::getBoxWithIncludedDecos(PHLWINDOW pWindow) {
-    CBox accum = pWindow->getWindowMainSurfaceBox();
+    CBox       accum = pWindow->getWindowMainSurfaceBox();
 
-    for (auto const& data : m_windowPositioningDatas) {
-        if (data->pWindow.lock() != pWindow)
-            continue;
+    const auto WINDOWDATA = getWindowData(pWindow);
+    if (!WINDOWDATA)
+        return accum;
 
-        if (!(data->pDecoration->getDecorationFlags() & DECORATION_PART_OF_MAIN_WINDOW))
+    for (auto const& data : WINDOWDATA->decorations) {
+        if (!(data.pDecoration->getDecorationFlags() & DECORATION_PART_OF_MAIN_WINDOW))
             continue;
 
         CBox decoBox;
 
-        if (data->positioningInfo.policy == DECORATION_POSITION_ABSOLUTE) {
-            decoBox = data->pWindow->getWindowMainSurfaceBox();
-            decoBox.addExtents(data->positioningInfo.desiredExtents);
+        if (data.positioningInfo.policy == DECORATION_POSITION_ABSOLUTE) {
+            decoBox = pWindow->getWindowMainSurfaceBox();
+            decoBox.addExtents(data.positioningInfo.desiredExtents);
         } else {
-            decoBox              = data->lastReply.assignedGeometry;
-            const auto EDGEPOINT = getEdgeDefinedPoint(data->positioningInfo.edges, pWindow);
+            decoBox              = data.lastReply.assignedGeometry;
+            const auto EDGEPOINT = getEdgeDefinedPoint(data.positioningInfo.edges, pWindow);
             decoBox.translate(EDGEPOINT);
         }
 
@@ -386,8 +375,14 @@ CBox CDecorationPositioner::getBoxWithIncludedDecos(PHLWINDOW pWindow) {
 }
 
 CBox CDecorationPositioner::getWindowDecorationBox(IHyprWindowDecoration* deco) {
-    auto const window = deco->m_window.lock();
-    const auto DATA   = getDataFor(deco, window);
+    auto const window     = deco->m_window.lock();
+    const auto WINDOWDATA = getWindowData(window);
+
+    // not positioned (yet), nothing assigned
+    if (!WINDOWDATA)
+        return CBox{}.translate(getEdgeDefinedPoint(deco->getPositioningInfo().edges, window));
+
+    const auto DATA = getDataFor(deco, *WINDOWDATA);
 
     CBox       box = DATA->lastReply.assignedGeometry;
     box.translate(getEdgeDefinedPoint(DATA->positioningInfo.edges, window));
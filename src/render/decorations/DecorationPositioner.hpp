@@ -2,7 +2,7 @@
 
 #include <cstdint>
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include "../../helpers/math/Math.hpp"
 #include "../../desktop/DesktopTypes.hpp"
 
@@ -72,8 +72,7 @@ class CDecorationPositioner {
     void        forceRecalcFor(PHLWINDOW pWindow);
 
   private:
-    struct SWindowPositioningData {
-        PHLWINDOWREF                pWindow;
+    struct SDecorationData {
         IHyprWindowDecoration*      pDecoration = nullptr;
         SDecorationPositioningInfo  positioningInfo;
         SDecorationPositioningReply lastReply;
@@ -81,19 +80,22 @@ class CDecorationPositioner {
     };
 
     struct SWindowData {
-        Vector2D    lastWindowSize = {};
-        SBoxExtents reserved       = {};
-        SBoxExtents extents        = {};
-        bool        needsRecalc    = false;
+        PHLWINDOWREF                 window;
+        Vector2D                     lastWindowSize = {};
+        SBoxExtents                  reserved       = {};
+        SBoxExtents                  extents        = {};
+        bool                         needsRecalc    = false;
+        std::vector<SDecorationData> decorations; // sorted by priority after an update
     };
 
-    std::map<PHLWINDOWREF, SWindowData>     m_windowDatas;
-    std::vector<UP<SWindowPositioningData>> m_windowPositioningDatas;
+    // keyed by the window's address, entries go with closeWindow. window is checked on lookup, so a reused address doesn't pick up stale data.
+    std::unordered_map<const CWindow*, SWindowData> m_windowDatas;
 
-    SWindowPositioningData*                 getDataFor(IHyprWindowDecoration* pDecoration, PHLWINDOW pWindow);
-    void                                    onWindowUnmap(PHLWINDOW pWindow);
-    void                                    onWindowMap(PHLWINDOW pWindow);
-    void                                    sanitizeDatas();
+    SWindowData*                                    getWindowData(const PHLWINDOWREF& pWindow);
+    SDecorationData*                                getDataFor(IHyprWindowDecoration* pDecoration, SWindowData& windowData);
+    void                                            syncDecorations(SWindowData& windowData, PHLWINDOW pWindow);
+    void                                            onWindowUnmap(PHLWINDOW pWindow);
+    void                                            onWindowMap(PHLWINDOW pWindow);
 };
 
 inline UP<CDecorationPositioner> g_pDecorationPositioner;
@@ -10,6 +10,7 @@
 #include "../../render/Renderer.hpp"
 #include "../../desktop/state/FocusState.hpp"
 #include "../../protocols/core/Compositor.hpp"
+#include "../../debug/FrameTrace.hpp"
 
 bool CRenderPass::empty() const {
     return false;
@@ -24,6 +25,8 @@ void CRenderPass::add(UP<IPassElement>&& el) {
 }
 
 void CRenderPass::simplify() {
+    TRACE_SCOPE("CRenderPass::simplify");
+
     static auto PDEBUGPASS = CConfigValue<Hyprlang::INT>("debug:pass");
 
     // TODO: use precompute blur for instances where there is nothing in between
@@ -180,6 +183,8 @@ CRegion CRenderPass::render(const CRegion& damage_) {
             continue;
         }
 
+        TRACE_SCOPE(el->element->passName());
+
         g_pHyprOpenGL->m_renderData.damage = el->elementDamage;
         el->element->draw(el->elementDamage);
     }
@@ -7,10 +7,17 @@ in vec2 v_texcoord;
 uniform sampler2D tex;
 //uniform samplerExternalOES texture0;
 
+// CM_SPECIALIZED variants get these baked in as constants, see CHyprOpenGLImpl::getCMShader
+#ifdef CM_SPECIALIZED
+#define texType CM_TEX_TYPE
+#define sourceTF CM_SOURCE_TF
+#define targetTF CM_TARGET_TF
+#else
 uniform int texType; // eTextureType: 0 - rgba, 1 - rgbx, 2 - ext
 // uniform int skipCM;
 uniform int sourceTF; // eTransferFunction
 uniform int targetTF; // eTransferFunction
+#endif
 uniform mat4x2 targetPrimaries;
 
 uniform float alpha;
@@ -22,6 +29,12 @@ uniform float discardAlphaValue;
 uniform int applyTint;
 uniform vec3 tint;
 
+#ifdef CM_LUT
+// doColorManagement baked for unpremultiplied colors, see CColorLUTResource
+uniform highp sampler3D cmLut;
+uniform float cmLutSize;
+#endif
+
 #include "rounding.glsl"
 #include "CM.glsl"
 
@@ -42,13 +55,20 @@ void main() {
         discard;
 
     // this shader shouldn't be used when skipCM == 1
+#ifdef CM_LUT
+    vec3 lutCoord = clamp(pixColor.rgb / max(pixColor.a, 0.001), 0.0, 1.0) * ((cmLutSize - 1.0) / cmLutSize) + 0.5 / cmLutSize;
+    pixColor = vec4(texture(cmLut, lutCoord).rgb * pixColor.a, pixColor.a);
+#else
     pixColor = doColorManagement(pixColor, sourceTF, targetTF, targetPrimaries);
+#endif
 
     if (applyTint == 1)
         pixColor = vec4(pixColor.rgb * tint.rgb, pixColor[3]);
 
+#ifndef CM_NO_ROUNDING
     if (radius > 0.0)
         pixColor = rounding(pixColor);
+#endif
     
     fragColor = pixColor * alpha;
 }
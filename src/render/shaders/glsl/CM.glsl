@@ -414,7 +414,11 @@ vec4 doColorManagement(vec4 pixColor, int srcTF, int dstTF, mat4x2 dstPrimaries)
     pixColor = toNit(pixColor, srcTFRange);
     pixColor.rgb *= pixColor.a;
     mat3 dstxyz = primaries2xyz(dstPrimaries);
+#ifdef CM_NO_TONEMAP
+    pixColor = vec4(clamp(pixColor.rgb, vec3(0.0), vec3(dstMaxLuminance)), pixColor[3]);
+#else
     pixColor = tonemap(pixColor, dstxyz);
+#endif
     pixColor = fromLinearNit(pixColor, dstTF, dstTFRange);
     if ((srcTF == CM_TRANSFER_FUNCTION_SRGB || srcTF == CM_TRANSFER_FUNCTION_GAMMA22) && dstTF == CM_TRANSFER_FUNCTION_ST2084_PQ) {
         pixColor = saturate(pixColor, dstxyz, sdrSaturation);
@@ -110,7 +110,7 @@ vec3 hsl2rgb(vec3 col) {
 
 layout(location = 0) out vec4 fragColor;
 void main() {
-    vec2 uv = v_texcoord * 2.0;
+    vec2 uv = v_texcoord;
 
     vec4 sum = texture(tex, uv) * 4.0;
     sum += texture(tex, uv - halfpixel.xy * radius);
@@ -9,7 +9,7 @@ in vec2 v_texcoord;
 layout(location = 0) out vec4 fragColor;
 
 void main() {
-    vec2 uv = v_texcoord / 2.0;
+    vec2 uv = v_texcoord;
 
     vec4 sum = texture(tex, uv + vec2(-halfpixel.x * 2.0, 0.0) * radius);
 
@@ -25,6 +25,8 @@
 #include "../defines.hpp"
 #include "../Compositor.hpp"
 #include "../managers/CursorManager.hpp"
+#include "../managers/eventLoop/EventLoopManager.hpp"
+#include "../managers/eventLoop/EventLoopTimer.hpp"
 using namespace Hyprutils::OS;
 
 // Constants
@@ -180,6 +182,10 @@ static int xwaylandReady(int fd, uint32_t mask, void* data) {
     return g_pXWayland->m_server->ready(fd, mask);
 }
 
+static int xwaylandSocketReady(int fd, uint32_t mask, void* data) {
+    return g_pXWayland->m_server->socketReady(fd, mask);
+}
+
 static bool safeRemove(const std::string& path) {
     try {
         return std::filesystem::remove(path);
@@ -263,14 +269,20 @@ void CXWaylandServer::die() {
     if (m_display < 0)
         return;
 
-    if (m_xFDReadEvents[0]) {
-        wl_event_source_remove(m_xFDReadEvents[0]);
-        wl_event_source_remove(m_xFDReadEvents[1]);
-        m_xFDReadEvents = {nullptr, nullptr};
+    for (auto& source : m_xFDReadEvents) {
+        if (source)
+            wl_event_source_remove(source);
+        source = nullptr;
     }
 
     if (m_pipeSource)
         wl_event_source_remove(m_pipeSource);
+    m_pipeSource = nullptr;
+
+    if (m_idleShutdownTimer) {
+        g_pEventLoopManager->removeTimer(m_idleShutdownTimer);
+        m_idleShutdownTimer.reset();
+    }
 
     // possible crash. Better to leak a bit.
     //if (xwaylandClient)
@@ -285,13 +297,114 @@ bool CXWaylandServer::create() {
 
     setenv("DISPLAY", m_displayName.c_str(), true);
 
-    // TODO: lazy mode
+    static auto PLAZY = CConfigValue<Hyprlang::INT>("xwayland:lazy");
+    if (*PLAZY)
+        return listenLazily();
 
     m_idleSource = wl_event_loop_add_idle(g_pCompositor->m_wlEventLoop, ::startServer, nullptr);
 
     return true;
 }
 
+bool CXWaylandServer::listenLazily() {
+    // the sockets are already listening, X clients can connect and will just wait in the backlog
+    // until Xwayland is up and accepts them.
+    for (size_t i = 0; i < m_xFDs.size(); ++i) {
+        m_xFDReadEvents[i] = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, m_xFDs[i].get(), WL_EVENT_READABLE, ::xwaylandSocketReady, nullptr);
+        if (!m_xFDReadEvents[i]) {
+            Debug::log(ERR, "XWayland: failed to watch the X socket for lazy startup");
+            die();
+            return false;
+        }
+    }
+
+    Debug::log(LOG, "XWayland: lazy mode, Xwayland will start once an X client connects to {}", m_displayName);
+    return true;
+}
+
+int CXWaylandServer::socketReady(int fd, uint32_t mask) {
+    for (auto& source : m_xFDReadEvents) {
+        if (source)
+            wl_event_source_remove(source);
+        source = nullptr;
+    }
+
+    if (mask & (WL_EVENT_HANGUP | WL_EVENT_ERROR)) {
+        // the socket is gone for good, make X clients fail right away instead of waiting on a server that never comes
+        Debug::log(ERR, "XWayland: X socket errored out while waiting for a client, XWayland will not work...");
+        die();
+        unsetenv("DISPLAY");
+        return 0;
+    }
+
+    Debug::log(LOG, "XWayland: an X client connected to {}, starting Xwayland", m_displayName);
+
+    if (!start())
+        Debug::log(ERR, "The XWayland server could not start! XWayland will not work...");
+
+    return 0;
+}
+
+void CXWaylandServer::onXWindowsChanged(size_t count) {
+    static auto PLAZY    = CConfigValue<Hyprlang::INT>("xwayland:lazy");
+    static auto PTIMEOUT = CConfigValue<Hyprlang::INT>("xwayland:lazy_idle_timeout");
+
+    // X clients without any windows are checked for once the timer fires, see stopIdle
+    if (count > 0 || !*PLAZY || *PTIMEOUT <= 0) {
+        if (m_idleShutdownTimer)
+            m_idleShutdownTimer->updateTimeout(std::nullopt);
+        return;
+    }
+
+    if (!m_idleShutdownTimer) {
+        m_idleShutdownTimer = makeShared<CEventLoopTimer>(std::nullopt, [this](SP<CEventLoopTimer> self, void* data) { stopIdle(); }, nullptr);
+        g_pEventLoopManager->addTimer(m_idleShutdownTimer);
+    }
+
+    m_idleShutdownTimer->updateTimeout(std::chrono::seconds(*PTIMEOUT));
+}
+
+void CXWaylandServer::stopIdle() {
+    static auto PTIMEOUT = CConfigValue<Hyprlang::INT>("xwayland:lazy_idle_timeout");
+
+    if (m_serverPID < 0 || !g_pXWayland->m_wm)
+        return;
+
+    // no windows doesn't mean no clients, stopping would kill xbindkeys, xcape, grabs and the like
+    const auto CLIENTS = g_pXWayland->m_wm->foreignClientCount();
+    if (!CLIENTS) {
+        Debug::log(LOG, "XWayland: can't query the connected X clients, keeping Xwayland running");
+        return;
+    }
+
+    if (*CLIENTS > 0) {
+        Debug::log(LOG, "XWayland: no X windows left but {} X clients are still connected, keeping Xwayland running", *CLIENTS);
+        if (*PTIMEOUT > 0)
+            m_idleShutdownTimer->updateTimeout(std::chrono::seconds(*PTIMEOUT));
+        return;
+    }
+
+    Debug::log(LOG, "XWayland: no X clients left for a while, stopping Xwayland until the next X client connects");
+
+    // drop the wm first, otherwise it sees the hangup and restarts everything
+    g_pXWayland->m_wm.reset();
+    m_xwmFDs[0].take(); // closed by xcb_disconnect
+    m_xwmFDs[1].reset();
+    m_waylandFDs[1].reset();
+
+    if (m_pipeSource)
+        wl_event_source_remove(m_pipeSource);
+    m_pipeSource = nullptr;
+    m_pipeFd.reset();
+
+    // the wl_client goes away on its own once Xwayland exits
+    kill(m_serverPID, SIGTERM);
+    m_serverPID      = -1;
+    m_xwaylandClient = nullptr;
+
+    listenLazily();
+}
+
 void CXWaylandServer::runXWayland(CFileDescriptor& notifyFD) {
     if (!m_xFDs[0].setFlags(m_xFDs[0].getFlags() & ~FD_CLOEXEC) || !m_xFDs[1].setFlags(m_xFDs[1].getFlags() & ~FD_CLOEXEC) ||
         !m_waylandFDs[1].setFlags(m_waylandFDs[1].getFlags() & ~FD_CLOEXEC) || !m_xwmFDs[1].setFlags(m_xwmFDs[1].getFlags() & ~FD_CLOEXEC)) {
@@ -383,6 +496,8 @@ bool CXWaylandServer::start() {
         _exit(0);
     }
 
+    m_serverPID = serverPID;
+
     return true;
 }
 
@@ -417,6 +532,9 @@ int CXWaylandServer::ready(int fd, uint32_t mask) {
 
     g_pCursorManager->setXWaylandCursor();
 
+    // in lazy mode, the client that woke us up might not map anything
+    onXWindowsChanged(0);
+
     return 0;
 }
 
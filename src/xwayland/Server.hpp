@@ -1,13 +1,15 @@
 #pragma once
 
 #include <array>
+#include <sys/types.h>
 #include <hyprutils/os/FileDescriptor.hpp>
 #include "../helpers/signal/Signal.hpp"
+#include "../helpers/memory/Memory.hpp"
 
 struct wl_event_source;
 struct wl_client;
+class CEventLoopTimer;
 
-// TODO: add lazy mode
 class CXWaylandServer {
   public:
     CXWaylandServer();
@@ -22,6 +24,12 @@ class CXWaylandServer {
     // called on ready
     int        ready(int fd, uint32_t mask);
 
+    // lazy mode: called when an X client connects to one of the sockets before Xwayland runs
+    int        socketReady(int fd, uint32_t mask);
+
+    // called by the xwm whenever an X window comes or goes, arms / disarms the idle shutdown
+    void       onXWindowsChanged(size_t count);
+
     void       die();
 
     wl_client* m_xwaylandClient = nullptr;
@@ -30,6 +38,11 @@ class CXWaylandServer {
     bool                                          tryOpenSockets();
     void                                          runXWayland(Hyprutils::OS::CFileDescriptor& notifyFD);
 
+    // lazy mode: watches the X sockets and starts Xwayland on the first connection
+    bool                                          listenLazily();
+    // lazy mode: stops Xwayland and the xwm after the idle timeout, and goes back to listening
+    void                                          stopIdle();
+
     std::string                                   m_displayName;
     int                                           m_display = -1;
     std::array<Hyprutils::OS::CFileDescriptor, 2> m_xFDs;
@@ -39,6 +52,8 @@ class CXWaylandServer {
     Hyprutils::OS::CFileDescriptor                m_pipeFd;
     std::array<Hyprutils::OS::CFileDescriptor, 2> m_xwmFDs;
     std::array<Hyprutils::OS::CFileDescriptor, 2> m_waylandFDs;
+    pid_t                                         m_serverPID = -1;
+    SP<CEventLoopTimer>                           m_idleShutdownTimer;
 
     friend class CXWM;
 };
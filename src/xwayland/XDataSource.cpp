@@ -10,7 +10,7 @@ using namespace Hyprutils::OS;
 CXDataSource::CXDataSource(SXSelection& sel_) : m_selection(sel_) {
     xcb_get_property_cookie_t cookie = xcb_get_property(g_pXWayland->m_wm->getConnection(),
                                                         1, // delete
-                                                        m_selection.window, HYPRATOMS["_WL_SELECTION"], XCB_GET_PROPERTY_TYPE_ANY, 0, 4096);
+                                                        m_selection.window, HYPRATOMS[HA_WL_SELECTION], XCB_GET_PROPERTY_TYPE_ANY, 0, 4096);
 
     xcb_get_property_reply_t* reply = xcb_get_property_reply(g_pXWayland->m_wm->getConnection(), cookie, nullptr);
     if (!reply)
@@ -23,11 +23,11 @@ CXDataSource::CXDataSource(SXSelection& sel_) : m_selection(sel_) {
 
     auto value = sc<xcb_atom_t*>(xcb_get_property_value(reply));
     for (uint32_t i = 0; i < reply->value_len; i++) {
-        if (value[i] == HYPRATOMS["UTF8_STRING"])
+        if (value[i] == HYPRATOMS[HA_UTF8_STRING])
             m_mimeTypes.emplace_back("text/plain;charset=utf-8");
-        else if (value[i] == HYPRATOMS["TEXT"])
+        else if (value[i] == HYPRATOMS[HA_TEXT])
             m_mimeTypes.emplace_back("text/plain");
-        else if (value[i] != HYPRATOMS["TARGETS"] && value[i] != HYPRATOMS["TIMESTAMP"]) {
+        else if (value[i] != HYPRATOMS[HA_TARGETS] && value[i] != HYPRATOMS[HA_TIMESTAMP]) {
 
             auto type = g_pXWayland->m_wm->mimeFromAtom(value[i]);
 
@@ -52,9 +52,9 @@ void CXDataSource::send(const std::string& mime, CFileDescriptor fd) {
     xcb_atom_t mimeAtom = 0;
 
     if (mime == "text/plain")
-        mimeAtom = HYPRATOMS["TEXT"];
+        mimeAtom = HYPRATOMS[HA_TEXT];
     else if (mime == "text/plain;charset=utf-8")
-        mimeAtom = HYPRATOMS["UTF8_STRING"];
+        mimeAtom = HYPRATOMS[HA_UTF8_STRING];
     else {
         for (size_t i = 0; i < m_mimeTypes.size(); ++i) {
             if (m_mimeTypes[i] == mime) {
@@ -72,18 +72,19 @@ void CXDataSource::send(const std::string& mime, CFileDescriptor fd) {
     Debug::log(LOG, "[XDataSource] send with mime {} to fd {}", mime, fd.get());
 
     auto transfer            = makeUnique<SXTransfer>(m_selection);
+    transfer->out            = false;
     transfer->incomingWindow = xcb_generate_id(g_pXWayland->m_wm->getConnection());
     const uint32_t MASK      = XCB_EVENT_MASK_SUBSTRUCTURE_NOTIFY | XCB_EVENT_MASK_PROPERTY_CHANGE;
     xcb_create_window(g_pXWayland->m_wm->getConnection(), XCB_COPY_FROM_PARENT, transfer->incomingWindow, g_pXWayland->m_wm->m_screen->root, 0, 0, 10, 10, 0,
                       XCB_WINDOW_CLASS_INPUT_OUTPUT, g_pXWayland->m_wm->m_screen->root_visual, XCB_CW_EVENT_MASK, &MASK);
 
-    xcb_atom_t selection_atom = HYPRATOMS["CLIPBOARD"];
+    xcb_atom_t selection_atom = HYPRATOMS[HA_CLIPBOARD];
     if (&m_selection == &g_pXWayland->m_wm->m_primarySelection)
-        selection_atom = HYPRATOMS["PRIMARY"];
+        selection_atom = HYPRATOMS[HA_PRIMARY];
     else if (&m_selection == &g_pXWayland->m_wm->m_dndSelection)
-        selection_atom = HYPRATOMS["XdndSelection"];
+        selection_atom = HYPRATOMS[HA_XdndSelection];
 
-    xcb_convert_selection(g_pXWayland->m_wm->getConnection(), transfer->incomingWindow, selection_atom, mimeAtom, HYPRATOMS["_WL_SELECTION"], XCB_TIME_CURRENT_TIME);
+    xcb_convert_selection(g_pXWayland->m_wm->getConnection(), transfer->incomingWindow, selection_atom, mimeAtom, HYPRATOMS[HA_WL_SELECTION], XCB_TIME_CURRENT_TIME);
 
     xcb_flush(g_pXWayland->m_wm->getConnection());
 
@@ -146,10 +146,10 @@ bool CXWaylandSurface::wantsFocus() {
         return true;
 
     const std::array<uint32_t, 10> search = {
-        HYPRATOMS["_NET_WM_WINDOW_TYPE_COMBO"],   HYPRATOMS["_NET_WM_WINDOW_TYPE_DND"],          HYPRATOMS["_NET_WM_WINDOW_TYPE_DROPDOWN_MENU"],
-        HYPRATOMS["_NET_WM_WINDOW_TYPE_MENU"],    HYPRATOMS["_NET_WM_WINDOW_TYPE_NOTIFICATION"], HYPRATOMS["_NET_WM_WINDOW_TYPE_POPUP_MENU"],
-        HYPRATOMS["_NET_WM_WINDOW_TYPE_SPLASH"],  HYPRATOMS["_NET_WM_WINDOW_TYPE_DESKTOP"],      HYPRATOMS["_NET_WM_WINDOW_TYPE_TOOLTIP"],
-        HYPRATOMS["_NET_WM_WINDOW_TYPE_UTILITY"],
+        HYPRATOMS[HA_NET_WM_WINDOW_TYPE_COMBO],   HYPRATOMS[HA_NET_WM_WINDOW_TYPE_DND],          HYPRATOMS[HA_NET_WM_WINDOW_TYPE_DROPDOWN_MENU],
+        HYPRATOMS[HA_NET_WM_WINDOW_TYPE_MENU],    HYPRATOMS[HA_NET_WM_WINDOW_TYPE_NOTIFICATION], HYPRATOMS[HA_NET_WM_WINDOW_TYPE_POPUP_MENU],
+        HYPRATOMS[HA_NET_WM_WINDOW_TYPE_SPLASH],  HYPRATOMS[HA_NET_WM_WINDOW_TYPE_DESKTOP],      HYPRATOMS[HA_NET_WM_WINDOW_TYPE_TOOLTIP],
+        HYPRATOMS[HA_NET_WM_WINDOW_TYPE_UTILITY],
     };
 
     for (auto const& searched : search) {
@@ -227,7 +227,7 @@ void CXWaylandSurface::restackToTop() {
 
 void CXWaylandSurface::close() {
     xcb_client_message_data_t msg = {};
-    msg.data32[0]                 = HYPRATOMS["WM_DELETE_WINDOW"];
+    msg.data32[0]                 = HYPRATOMS[HA_WM_DELETE_WINDOW];
     msg.data32[1]                 = XCB_CURRENT_TIME;
     g_pXWayland->m_wm->sendWMMessage(m_self.lock(), &msg, XCB_EVENT_MASK_NO_EVENT);
 }
@@ -243,11 +243,11 @@ void CXWaylandSurface::setWithdrawn(bool withdrawn_) {
     else
         props[0] = XCB_ICCCM_WM_STATE_NORMAL;
 
-    xcb_change_property(g_pXWayland->m_wm->getConnection(), XCB_PROP_MODE_REPLACE, m_xID, HYPRATOMS["WM_STATE"], HYPRATOMS["WM_STATE"], 32, props.size(), props.data());
+    xcb_change_property(g_pXWayland->m_wm->getConnection(), XCB_PROP_MODE_REPLACE, m_xID, HYPRATOMS[HA_WM_STATE], HYPRATOMS[HA_WM_STATE], 32, props.size(), props.data());
 }
 
 void CXWaylandSurface::ping() {
-    bool supportsPing = std::ranges::find(m_protocols, HYPRATOMS["_NET_WM_PING"]) != m_protocols.end();
+    bool supportsPing = std::ranges::find(m_protocols, HYPRATOMS[HA_NET_WM_PING]) != m_protocols.end();
 
     if (!supportsPing) {
         Debug::log(TRACE, "CXWaylandSurface: XID {} does not support ping, just sending an instant reply", m_xID);
@@ -256,7 +256,7 @@ void CXWaylandSurface::ping() {
     }
 
     xcb_client_message_data_t msg = {};
-    msg.data32[0]                 = HYPRATOMS["_NET_WM_PING"];
+    msg.data32[0]                 = HYPRATOMS[HA_NET_WM_PING];
     msg.data32[1]                 = Time::millis(Time::steadyNow());
     msg.data32[2]                 = m_xID;
 
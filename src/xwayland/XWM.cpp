@@ -42,12 +42,8 @@ template <typename T>
 using XCBReplyPtr = std::unique_ptr<T, SFreeDeleter>;
 
 SP<CXWaylandSurface> CXWM::windowForXID(xcb_window_t wid) {
-    for (auto const& s : m_surfaces) {
-        if (s->m_xID == wid)
-            return s;
-    }
-
-    return nullptr;
+    const auto IT = m_surfacesByXID.find(wid);
+    return IT == m_surfacesByXID.end() ? nullptr : IT->second.lock();
 }
 
 void CXWM::handleCreate(xcb_create_notify_event_t* e) {
@@ -56,12 +52,15 @@ void CXWM::handleCreate(xcb_create_notify_event_t* e) {
 
     const auto XSURF = m_surfaces.emplace_back(SP<CXWaylandSurface>(new CXWaylandSurface(e->window, CBox{e->x, e->y, e->width, e->height}, e->override_redirect)));
     XSURF->m_self    = XSURF;
+    m_surfacesByXID[e->window] = XSURF;
     Debug::log(LOG, "[xwm] New XSurface at {:x} with xid of {}", rc<uintptr_t>(XSURF.get()), e->window);
 
     const auto WINDOW = CWindow::create(XSURF);
     g_pCompositor->m_windows.emplace_back(WINDOW);
     WINDOW->m_self = WINDOW;
     Debug::log(LOG, "[xwm] New XWayland window at {:x} for surf {:x}", rc<uintptr_t>(WINDOW.get()), rc<uintptr_t>(XSURF.get()));
+
+    g_pXWayland->m_server->onXWindowsChanged(m_surfaces.size());
 }
 
 void CXWM::handleDestroy(xcb_destroy_notify_event_t* e) {
@@ -72,6 +71,11 @@ void CXWM::handleDestroy(xcb_destroy_notify_event_t* e) {
 
     XSURF->m_events.destroy.emit();
     std::erase_if(m_surfaces, [XSURF](const auto& other) { return XSURF == other; });
+    m_surfacesByXID.erase(e->window);
+    if (XSURF->m_surface)
+        m_surfacesByWL.erase(XSURF->m_surface.get());
+
+    g_pXWayland->m_server->onXWindowsChanged(m_surfaces.size());
 }
 
 void CXWM::handleConfigureRequest(xcb_configure_request_event_t* e) {
@@ -186,11 +190,9 @@ static bool lookupParentExists(SP<CXWaylandSurface> XSURF, SP<CXWaylandSurface>
 }
 
 std::string CXWM::getAtomName(uint32_t atom) {
-    for (auto const& ha : HYPRATOMS) {
-        if (ha.second != atom)
-            continue;
-
-        return ha.first;
+    for (size_t i = 0; i < HA_COUNT; ++i) {
+        if (HYPRATOMS[i] == atom)
+            return HYPRATOM_NAMES[i];
     }
 
     // Get the name of the atom
@@ -225,7 +227,7 @@ void CXWM::readProp(SP<CXWaylandSurface> XSURF, uint32_t atom, xcb_get_property_
     };
 
     auto handleWMName = [&]() {
-        if (reply->type != HYPRATOMS["UTF8_STRING"] && reply->type != HYPRATOMS["TEXT"] && reply->type != XCB_ATOM_STRING)
+        if (reply->type != HYPRATOMS[HA_UTF8_STRING] && reply->type != HYPRATOMS[HA_TEXT] && reply->type != XCB_ATOM_STRING)
             return;
         XSURF->m_state.title = std::string{value, valueLen};
         XSURF->m_events.metadataChanged.emit();
@@ -239,7 +241,7 @@ void CXWM::readProp(SP<CXWaylandSurface> XSURF, uint32_t atom, xcb_get_property_
     auto handleWMState = [&]() {
         auto* atoms = rc<const xcb_atom_t*>(value);
         for (uint32_t i = 0; i < reply->value_len; i++) {
-            if (atoms[i] == HYPRATOMS["_NET_WM_STATE_MODAL"])
+            if (atoms[i] == HYPRATOMS[HA_NET_WM_STATE_MODAL])
                 XSURF->m_modal = true;
         }
     };
@@ -278,7 +280,7 @@ void CXWM::readProp(SP<CXWaylandSurface> XSURF, uint32_t atom, xcb_get_property_
     };
 
     auto handleSizeHints = [&]() {
-        if (reply->type != HYPRATOMS["WM_SIZE_HINTS"] || reply->value_len == 0)
+        if (reply->type != HYPRATOMS[HA_WM_SIZE_HINTS] || reply->value_len == 0)
             return;
 
         XSURF->m_sizeHints = makeUnique<xcb_size_hints_t>();
@@ -313,21 +315,21 @@ void CXWM::readProp(SP<CXWaylandSurface> XSURF, uint32_t atom, xcb_get_property_
 
     if (atom == XCB_ATOM_WM_CLASS)
         handleWMClass();
-    else if (atom == XCB_ATOM_WM_NAME || atom == HYPRATOMS["_NET_WM_NAME"])
+    else if (atom == XCB_ATOM_WM_NAME || atom == HYPRATOMS[HA_NET_WM_NAME])
         handleWMName();
-    else if (atom == HYPRATOMS["_NET_WM_WINDOW_TYPE"])
+    else if (atom == HYPRATOMS[HA_NET_WM_WINDOW_TYPE])
         handleWindowType();
-    else if (atom == HYPRATOMS["_NET_WM_STATE"])
+    else if (atom == HYPRATOMS[HA_NET_WM_STATE])
         handleWMState();
-    else if (atom == HYPRATOMS["WM_HINTS"])
+    else if (atom == HYPRATOMS[HA_WM_HINTS])
         handleWMHints();
-    else if (atom == HYPRATOMS["WM_WINDOW_ROLE"])
+    else if (atom == HYPRATOMS[HA_WM_WINDOW_ROLE])
         handleWMRole();
     else if (atom == XCB_ATOM_WM_TRANSIENT_FOR)
         handleTransientFor();
-    else if (atom == HYPRATOMS["WM_NORMAL_HINTS"])
+    else if (atom == HYPRATOMS[HA_WM_NORMAL_HINTS])
         handleSizeHints();
-    else if (atom == HYPRATOMS["WM_PROTOCOLS"])
+    else if (atom == HYPRATOMS[HA_WM_PROTOCOLS])
         handleWMProtocols();
     else {
         Debug::log(TRACE, "[xwm] Unhandled prop {} -> {}", atom, propName);
@@ -343,6 +345,12 @@ void CXWM::handlePropertyNotify(xcb_property_notify_event_t* e) {
     if (!XSURF)
         return;
 
+    // readProp doesn't handle anything else, don't round trip for it
+    if (!std::ranges::contains(m_interestingProps, e->atom)) {
+        Debug::log(TRACE, "[xwm] Ignoring property notify for {}", e->atom);
+        return;
+    }
+
     xcb_get_property_cookie_t             cookie = xcb_get_property(getConnection(), 0, XSURF->m_xID, e->atom, XCB_ATOM_ANY, 0, 2048);
     XCBReplyPtr<xcb_get_property_reply_t> reply(xcb_get_property_reply(getConnection(), cookie, nullptr));
 
@@ -362,12 +370,12 @@ void CXWM::handleClientMessage(xcb_client_message_event_t* e) {
 
     std::string propName = getAtomName(e->type);
 
-    if (e->type == HYPRATOMS["WM_PROTOCOLS"]) {
-        if (e->data.data32[1] == XSURF->m_lastPingSeq && e->data.data32[0] == HYPRATOMS["_NET_WM_PING"]) {
+    if (e->type == HYPRATOMS[HA_WM_PROTOCOLS]) {
+        if (e->data.data32[1] == XSURF->m_lastPingSeq && e->data.data32[0] == HYPRATOMS[HA_NET_WM_PING]) {
             g_pANRManager->onResponse(XSURF);
             return;
         }
-    } else if (e->type == HYPRATOMS["WL_SURFACE_ID"]) {
+    } else if (e->type == HYPRATOMS[HA_WL_SURFACE_ID]) {
         if (XSURF->m_surface) {
             Debug::log(WARN, "[xwm] Re-assignment of WL_SURFACE_ID");
             dissociate(XSURF);
@@ -379,7 +387,7 @@ void CXWM::handleClientMessage(xcb_client_message_event_t* e) {
             auto surf = CWLSurfaceResource::fromResource(resource);
             associate(XSURF, surf);
         }
-    } else if (e->type == HYPRATOMS["WL_SURFACE_SERIAL"]) {
+    } else if (e->type == HYPRATOMS[HA_WL_SURFACE_SERIAL]) {
         if (XSURF->m_wlSerial) {
             Debug::log(WARN, "[xwm] Re-assignment of WL_SURFACE_SERIAL");
             dissociate(XSURF);
@@ -402,7 +410,7 @@ void CXWM::handleClientMessage(xcb_client_message_event_t* e) {
             break;
         }
 
-    } else if (e->type == HYPRATOMS["_NET_WM_STATE"]) {
+    } else if (e->type == HYPRATOMS[HA_NET_WM_STATE]) {
         if (e->format == 32) {
             uint32_t action = e->data.data32[0];
             for (size_t i = 0; i < 2; ++i) {
@@ -424,26 +432,26 @@ void CXWM::handleClientMessage(xcb_client_message_event_t* e) {
                     return false;
                 };
 
-                if (prop == HYPRATOMS["_NET_WM_STATE_FULLSCREEN"])
+                if (prop == HYPRATOMS[HA_NET_WM_STATE_FULLSCREEN])
                     XSURF->m_state.requestsFullscreen = updateState(action, XSURF->m_fullscreen);
-                if (prop == HYPRATOMS["_NET_WM_STATE_HIDDEN"])
+                if (prop == HYPRATOMS[HA_NET_WM_STATE_HIDDEN])
                     XSURF->m_state.requestsMinimize = updateState(action, XSURF->m_minimized);
-                if (prop == HYPRATOMS["_NET_WM_STATE_MAXIMIZED_VERT"] || prop == HYPRATOMS["_NET_WM_STATE_MAXIMIZED_HORZ"])
+                if (prop == HYPRATOMS[HA_NET_WM_STATE_MAXIMIZED_VERT] || prop == HYPRATOMS[HA_NET_WM_STATE_MAXIMIZED_HORZ])
                     XSURF->m_state.requestsMaximize = updateState(action, XSURF->m_maximized);
             }
 
             XSURF->m_events.stateChanged.emit();
         }
-    } else if (e->type == HYPRATOMS["WM_CHANGE_STATE"]) {
+    } else if (e->type == HYPRATOMS[HA_WM_CHANGE_STATE]) {
         int state = e->data.data32[0];
         if (state == XCB_ICCCM_WM_STATE_ICONIC || state == XCB_ICCCM_WM_STATE_WITHDRAWN)
             XSURF->m_state.requestsMinimize = true;
         else if (state == XCB_ICCCM_WM_STATE_NORMAL)
             XSURF->m_state.requestsMinimize = false;
         XSURF->m_events.stateChanged.emit();
-    } else if (e->type == HYPRATOMS["_NET_ACTIVE_WINDOW"]) {
+    } else if (e->type == HYPRATOMS[HA_NET_ACTIVE_WINDOW]) {
         XSURF->m_events.activate.emit();
-    } else if (e->type == HYPRATOMS["XdndStatus"]) {
+    } else if (e->type == HYPRATOMS[HA_XdndStatus]) {
         if (m_dndDataOffers.empty() || !m_dndDataOffers.at(0)->getSource()) {
             Debug::log(TRACE, "[xwm] Rejecting XdndStatus message: nothing to get");
             return;
@@ -456,7 +464,7 @@ void CXWM::handleClientMessage(xcb_client_message_event_t* e) {
             m_dndDataOffers.at(0)->getSource()->accepted("");
 
         Debug::log(LOG, "[xwm] XdndStatus: accepted: {}");
-    } else if (e->type == HYPRATOMS["XdndFinished"]) {
+    } else if (e->type == HYPRATOMS[HA_XdndFinished]) {
         if (m_dndDataOffers.empty() || !m_dndDataOffers.at(0)->getSource()) {
             Debug::log(TRACE, "[xwm] Rejecting XdndFinished message: nothing to get");
             return;
@@ -508,7 +516,7 @@ void CXWM::sendWMMessage(SP<CXWaylandSurface> surf, xcb_client_message_data_t* d
         .format        = 32,
         .sequence      = 0,
         .window        = surf->m_xID,
-        .type          = HYPRATOMS["WM_PROTOCOLS"],
+        .type          = HYPRATOMS[HA_WM_PROTOCOLS],
         .data          = *data,
     };
 
@@ -540,7 +548,7 @@ void CXWM::focusWindow(SP<CXWaylandSurface> surf) {
         return;
 
     xcb_client_message_data_t msg = {{0}};
-    msg.data32[0]                 = HYPRATOMS["WM_TAKE_FOCUS"];
+    msg.data32[0]                 = HYPRATOMS[HA_WM_TAKE_FOCUS];
     msg.data32[1]                 = XCB_TIME_CURRENT_TIME;
 
     if (surf->m_hints && !surf->m_hints->input)
@@ -590,9 +598,9 @@ void CXWM::selectionSendNotify(xcb_selection_request_event_t* e, bool success) {
 
 xcb_atom_t CXWM::mimeToAtom(const std::string& mime) {
     if (mime == "text/plain;charset=utf-8")
-        return HYPRATOMS["UTF8_STRING"];
+        return HYPRATOMS[HA_UTF8_STRING];
     if (mime == "text/plain")
-        return HYPRATOMS["TEXT"];
+        return HYPRATOMS[HA_TEXT];
 
     xcb_intern_atom_cookie_t             cookie = xcb_intern_atom(getConnection(), 0, mime.length(), mime.c_str());
     XCBReplyPtr<xcb_intern_atom_reply_t> reply(xcb_intern_atom_reply(getConnection(), cookie, nullptr));
@@ -604,9 +612,9 @@ xcb_atom_t CXWM::mimeToAtom(const std::string& mime) {
 }
 
 std::string CXWM::mimeFromAtom(xcb_atom_t atom) {
-    if (atom == HYPRATOMS["UTF8_STRING"])
+    if (atom == HYPRATOMS[HA_UTF8_STRING])
         return "text/plain;charset=utf-8";
-    if (atom == HYPRATOMS["TEXT"])
+    if (atom == HYPRATOMS[HA_TEXT])
         return "text/plain";
 
     xcb_get_atom_name_cookie_t             cookie = xcb_get_atom_name(getConnection(), atom);
@@ -624,13 +632,16 @@ void CXWM::handleSelectionNotify(xcb_selection_notify_event_t* e) {
 
     SXSelection* sel = getSelection(e->selection);
 
+    if (!sel)
+        return;
+
     if (e->property == XCB_ATOM_NONE) {
-        auto it = std::ranges::find_if(sel->transfers, [](const auto& t) { return !t->propertyReply; });
+        auto it = std::ranges::find_if(sel->transfers, [e](const auto& t) { return !t->out && t->incomingWindow == e->requestor; });
         if (it != sel->transfers.end()) {
             Debug::log(TRACE, "[xwm] converting selection failed");
             sel->transfers.erase(it);
         }
-    } else if (e->target == HYPRATOMS["TARGETS"]) {
+    } else if (e->target == HYPRATOMS[HA_TARGETS]) {
         if (!m_focusedSurface) {
             Debug::log(TRACE, "[xwm] denying access to write to clipboard because no X client is in focus");
             return;
@@ -638,34 +649,64 @@ void CXWM::handleSelectionNotify(xcb_selection_notify_event_t* e) {
 
         setClipboardToWayland(*sel);
     } else if (!sel->transfers.empty())
-        getTransferData(*sel);
+        getTransferData(*sel, e->requestor);
 }
 
 bool CXWM::handleSelectionPropertyNotify(xcb_property_notify_event_t* e) {
-    if (e->state != XCB_PROPERTY_DELETE)
-        return false;
+    for (auto* sel : {&m_clipboard, &m_primarySelection, &m_dndSelection}) {
+        if (e->state == XCB_PROPERTY_DELETE) {
+            // out: the requestor took the last chunk, it's ready for the next one
+            auto it = std::ranges::find_if(sel->transfers, [e](const auto& t) {
+                return t->out && t->incremental && t->request.requestor == e->window && t->request.property == e->atom;
+            });
+
+            if (it == sel->transfers.end())
+                continue;
 
-    for (auto* sel : {&m_clipboard, &m_primarySelection}) {
-        auto it = std::ranges::find_if(sel->transfers, [e](const auto& t) { return t->incomingWindow == e->window; });
-        if (it != sel->transfers.end()) {
-            if (!(*it)->getIncomingSelectionProp(true)) {
-                sel->transfers.erase(it);
-                return false;
-            }
-            getTransferData(*sel);
+            auto& transfer        = *it;
+            transfer->propertySet = false;
+
+            if (transfer->eof || transfer->data.size() >= INCR_CHUNK_SIZE)
+                sel->sendChunk(*transfer);
+
+            return true;
+        }
+
+        // in: the owner put the next chunk up
+        auto it = std::ranges::find_if(sel->transfers, [e](const auto& t) { return !t->out && t->incomingWindow == e->window; });
+        if (it == sel->transfers.end())
+            continue;
+
+        auto& transfer = *it;
+        if (e->state != XCB_PROPERTY_NEW_VALUE || e->atom != HYPRATOMS[HA_WL_SELECTION] || !transfer->incremental || transfer->propertyReply)
+            return true;
+
+        if (!transfer->getIncomingSelectionProp()) {
+            sel->transfers.erase(it);
+            return true;
+        }
+
+        if (xcb_get_property_value_length(transfer->propertyReply) == 0) {
+            Debug::log(LOG, "[xwm] incremental transfer from X done");
+            xcb_delete_property(getConnection(), transfer->incomingWindow, HYPRATOMS[HA_WL_SELECTION]);
+            xcb_flush(getConnection());
+            sel->transfers.erase(it);
             return true;
         }
+
+        transfer->pollWayland(WL_EVENT_WRITABLE);
+        return true;
     }
 
     return false;
 }
 
 SXSelection* CXWM::getSelection(xcb_atom_t atom) {
-    if (atom == HYPRATOMS["CLIPBOARD"])
+    if (atom == HYPRATOMS[HA_CLIPBOARD])
         return &m_clipboard;
-    else if (atom == HYPRATOMS["PRIMARY"])
+    else if (atom == HYPRATOMS[HA_PRIMARY])
         return &m_primarySelection;
-    else if (atom == HYPRATOMS["XdndSelection"])
+    else if (atom == HYPRATOMS[HA_XdndSelection])
         return &m_dndSelection;
 
     return nullptr;
@@ -683,7 +724,7 @@ void CXWM::handleSelectionRequest(xcb_selection_request_event_t* e) {
         return;
     }
 
-    if (e->selection == HYPRATOMS["CLIPBOARD_MANAGER"]) {
+    if (e->selection == HYPRATOMS[HA_CLIPBOARD_MANAGER]) {
         selectionSendNotify(e, true);
         return;
     }
@@ -700,7 +741,7 @@ void CXWM::handleSelectionRequest(xcb_selection_request_event_t* e) {
         return;
     }
 
-    if (e->target == HYPRATOMS["TARGETS"]) {
+    if (e->target == HYPRATOMS[HA_TARGETS]) {
         // send mime types
         std::vector<std::string> mimes;
         if (sel == &m_clipboard && g_pSeatManager->m_selection.currentSelection)
@@ -714,8 +755,8 @@ void CXWM::handleSelectionRequest(xcb_selection_request_event_t* e) {
         std::vector<xcb_atom_t> atoms;
         // reserve to avoid reallocations
         atoms.reserve(mimes.size() + 2);
-        atoms.push_back(HYPRATOMS["TIMESTAMP"]);
-        atoms.push_back(HYPRATOMS["TARGETS"]);
+        atoms.push_back(HYPRATOMS[HA_TIMESTAMP]);
+        atoms.push_back(HYPRATOMS[HA_TARGETS]);
 
         for (auto const& m : mimes) {
             atoms.push_back(mimeToAtom(m));
@@ -723,10 +764,10 @@ void CXWM::handleSelectionRequest(xcb_selection_request_event_t* e) {
 
         xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, e->requestor, e->property, XCB_ATOM_ATOM, 32, atoms.size(), atoms.data());
         selectionSendNotify(e, true);
-    } else if (e->target == HYPRATOMS["TIMESTAMP"]) {
+    } else if (e->target == HYPRATOMS[HA_TIMESTAMP]) {
         xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, e->requestor, e->property, XCB_ATOM_INTEGER, 32, 1, &sel->timestamp);
         selectionSendNotify(e, true);
-    } else if (e->target == HYPRATOMS["DELETE"]) {
+    } else if (e->target == HYPRATOMS[HA_DELETE]) {
         selectionSendNotify(e, true);
     } else {
         std::string mime = mimeFromAtom(e->target);
@@ -774,9 +815,9 @@ bool CXWM::handleSelectionXFixesNotify(xcb_xfixes_selection_notify_event_t* e) {
     }
 
     if (sel == &m_clipboard)
-        xcb_convert_selection(getConnection(), sel->window, HYPRATOMS["CLIPBOARD"], HYPRATOMS["TARGETS"], HYPRATOMS["_WL_SELECTION"], e->timestamp);
+        xcb_convert_selection(getConnection(), sel->window, HYPRATOMS[HA_CLIPBOARD], HYPRATOMS[HA_TARGETS], HYPRATOMS[HA_WL_SELECTION], e->timestamp);
     else if (sel == &m_primarySelection)
-        xcb_convert_selection(getConnection(), sel->window, HYPRATOMS["PRIMARY"], HYPRATOMS["TARGETS"], HYPRATOMS["_WL_SELECTION"], e->timestamp);
+        xcb_convert_selection(getConnection(), sel->window, HYPRATOMS[HA_PRIMARY], HYPRATOMS[HA_TARGETS], HYPRATOMS[HA_WL_SELECTION], e->timestamp);
     xcb_flush(getConnection());
 
     return true;
@@ -859,18 +900,29 @@ void CXWM::gatherResources() {
     xcb_prefetch_extension_data(getConnection(), &xcb_composite_id);
     xcb_prefetch_extension_data(getConnection(), &xcb_res_id);
 
-    for (auto& ATOM : HYPRATOMS) {
-        xcb_intern_atom_cookie_t             cookie = xcb_intern_atom(getConnection(), 0, ATOM.first.length(), ATOM.first.c_str());
-        XCBReplyPtr<xcb_intern_atom_reply_t> reply(xcb_intern_atom_reply(getConnection(), cookie, nullptr));
+    // send all the requests first, then collect the replies, so this is one round trip instead of one per atom
+    std::array<xcb_intern_atom_cookie_t, HA_COUNT> cookies;
+    for (size_t i = 0; i < HA_COUNT; ++i) {
+        cookies[i] = xcb_intern_atom(getConnection(), 0, strlen(HYPRATOM_NAMES[i]), HYPRATOM_NAMES[i]);
+    }
+
+    for (size_t i = 0; i < HA_COUNT; ++i) {
+        XCBReplyPtr<xcb_intern_atom_reply_t> reply(xcb_intern_atom_reply(getConnection(), cookies[i], nullptr));
 
         if (!reply) {
-            Debug::log(ERR, "[xwm] Atom failed: {}", ATOM.first);
+            Debug::log(ERR, "[xwm] Atom failed: {}", HYPRATOM_NAMES[i]);
             continue;
         }
 
-        ATOM.second = reply->atom;
+        HYPRATOMS[i] = reply->atom;
     }
 
+    m_interestingProps = {
+        XCB_ATOM_WM_CLASS,          XCB_ATOM_WM_NAME,          XCB_ATOM_WM_TRANSIENT_FOR,        HYPRATOMS[HA_WM_HINTS],
+        HYPRATOMS[HA_NET_WM_STATE], HYPRATOMS[HA_NET_WM_NAME], HYPRATOMS[HA_NET_WM_WINDOW_TYPE], HYPRATOMS[HA_WM_NORMAL_HINTS],
+        HYPRATOMS[HA_WM_PROTOCOLS], HYPRATOMS[HA_WM_WINDOW_ROLE],
+    };
+
     m_xfixes = xcb_get_extension_data(getConnection(), &xcb_xfixes_id);
 
     if (!m_xfixes || !m_xfixes->present)
@@ -986,11 +1038,11 @@ CXWM::CXWM() : m_connection(makeUnique<CXCBConnection>(g_pXWayland->m_server->m_
     xcb_composite_redirect_subwindows(getConnection(), m_screen->root, XCB_COMPOSITE_REDIRECT_MANUAL);
 
     xcb_atom_t supported[] = {
-        HYPRATOMS["_NET_WM_STATE"],        HYPRATOMS["_NET_ACTIVE_WINDOW"],       HYPRATOMS["_NET_WM_MOVERESIZE"],           HYPRATOMS["_NET_WM_STATE_FOCUSED"],
-        HYPRATOMS["_NET_WM_STATE_MODAL"],  HYPRATOMS["_NET_WM_STATE_FULLSCREEN"], HYPRATOMS["_NET_WM_STATE_MAXIMIZED_VERT"], HYPRATOMS["_NET_WM_STATE_MAXIMIZED_HORZ"],
-        HYPRATOMS["_NET_WM_STATE_HIDDEN"], HYPRATOMS["_NET_CLIENT_LIST"],         HYPRATOMS["_NET_CLIENT_LIST_STACKING"],    HYPRATOMS["_NET_WORKAREA"],
+        HYPRATOMS[HA_NET_WM_STATE],        HYPRATOMS[HA_NET_ACTIVE_WINDOW],       HYPRATOMS[HA_NET_WM_MOVERESIZE],           HYPRATOMS[HA_NET_WM_STATE_FOCUSED],
+        HYPRATOMS[HA_NET_WM_STATE_MODAL],  HYPRATOMS[HA_NET_WM_STATE_FULLSCREEN], HYPRATOMS[HA_NET_WM_STATE_MAXIMIZED_VERT], HYPRATOMS[HA_NET_WM_STATE_MAXIMIZED_HORZ],
+        HYPRATOMS[HA_NET_WM_STATE_HIDDEN], HYPRATOMS[HA_NET_CLIENT_LIST],         HYPRATOMS[HA_NET_CLIENT_LIST_STACKING],    HYPRATOMS[HA_NET_WORKAREA],
     };
-    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_screen->root, HYPRATOMS["_NET_SUPPORTED"], XCB_ATOM_ATOM, 32, sizeof(supported) / sizeof(*supported), supported);
+    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_screen->root, HYPRATOMS[HA_NET_SUPPORTED], XCB_ATOM_ATOM, 32, sizeof(supported) / sizeof(*supported), supported);
 
     setActiveWindow(XCB_WINDOW_NONE);
     initSelection();
@@ -1014,24 +1066,24 @@ CXWM::~CXWM() {
 }
 
 void CXWM::setActiveWindow(xcb_window_t window) {
-    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_screen->root, HYPRATOMS["_NET_ACTIVE_WINDOW"], HYPRATOMS["WINDOW"], 32, 1, &window);
+    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_screen->root, HYPRATOMS[HA_NET_ACTIVE_WINDOW], HYPRATOMS[HA_WINDOW], 32, 1, &window);
 }
 
 void CXWM::createWMWindow() {
     constexpr const char* wmName = "Hyprland :D";
     m_wmWindow                   = xcb_generate_id(getConnection());
     xcb_create_window(getConnection(), XCB_COPY_FROM_PARENT, m_wmWindow, m_screen->root, 0, 0, 10, 10, 0, XCB_WINDOW_CLASS_INPUT_OUTPUT, m_screen->root_visual, 0, nullptr);
-    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_wmWindow, HYPRATOMS["_NET_WM_NAME"], HYPRATOMS["UTF8_STRING"],
+    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_wmWindow, HYPRATOMS[HA_NET_WM_NAME], HYPRATOMS[HA_UTF8_STRING],
                         8, // format
                         strlen(wmName), wmName);
-    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_screen->root, HYPRATOMS["_NET_SUPPORTING_WM_CHECK"], XCB_ATOM_WINDOW,
+    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_screen->root, HYPRATOMS[HA_NET_SUPPORTING_WM_CHECK], XCB_ATOM_WINDOW,
                         32, // format
                         1, &m_wmWindow);
-    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_wmWindow, HYPRATOMS["_NET_SUPPORTING_WM_CHECK"], XCB_ATOM_WINDOW,
+    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_wmWindow, HYPRATOMS[HA_NET_SUPPORTING_WM_CHECK], XCB_ATOM_WINDOW,
                         32, // format
                         1, &m_wmWindow);
-    xcb_set_selection_owner(getConnection(), m_wmWindow, HYPRATOMS["WM_S0"], XCB_CURRENT_TIME);
-    xcb_set_selection_owner(getConnection(), m_wmWindow, HYPRATOMS["_NET_WM_CM_S0"], XCB_CURRENT_TIME);
+    xcb_set_selection_owner(getConnection(), m_wmWindow, HYPRATOMS[HA_WM_S0], XCB_CURRENT_TIME);
+    xcb_set_selection_owner(getConnection(), m_wmWindow, HYPRATOMS[HA_NET_WM_CM_S0], XCB_CURRENT_TIME);
 }
 
 void CXWM::activateSurface(SP<CXWaylandSurface> surf, bool activate) {
@@ -1056,7 +1108,7 @@ void CXWM::sendState(SP<CXWaylandSurface> surf) {
         surf->setWithdrawn(false); // resend normal state
 
     if (surf->m_withdrawn) {
-        xcb_delete_property(getConnection(), surf->m_xID, HYPRATOMS["_NET_WM_STATE"]);
+        xcb_delete_property(getConnection(), surf->m_xID, HYPRATOMS[HA_NET_WM_STATE]);
         return;
     }
 
@@ -1064,19 +1116,19 @@ void CXWM::sendState(SP<CXWaylandSurface> surf) {
     // reserve to avoid reallocations
     props.reserve(6); // props below
     if (surf->m_modal)
-        props.push_back(HYPRATOMS["_NET_WM_STATE_MODAL"]);
+        props.push_back(HYPRATOMS[HA_NET_WM_STATE_MODAL]);
     if (surf->m_fullscreen)
-        props.push_back(HYPRATOMS["_NET_WM_STATE_FULLSCREEN"]);
+        props.push_back(HYPRATOMS[HA_NET_WM_STATE_FULLSCREEN]);
     if (surf->m_maximized) {
-        props.push_back(HYPRATOMS["NET_WM_STATE_MAXIMIZED_VERT"]);
-        props.push_back(HYPRATOMS["NET_WM_STATE_MAXIMIZED_HORZ"]);
+        props.push_back(HYPRATOMS[HA_NET_WM_STATE_MAXIMIZED_VERT]);
+        props.push_back(HYPRATOMS[HA_NET_WM_STATE_MAXIMIZED_HORZ]);
     }
     if (surf->m_minimized)
-        props.push_back(HYPRATOMS["_NET_WM_STATE_HIDDEN"]);
+        props.push_back(HYPRATOMS[HA_NET_WM_STATE_HIDDEN]);
     if (surf == m_focusedSurface)
-        props.push_back(HYPRATOMS["_NET_WM_STATE_FOCUSED"]);
+        props.push_back(HYPRATOMS[HA_NET_WM_STATE_FOCUSED]);
 
-    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, surf->m_xID, HYPRATOMS["_NET_WM_STATE"], XCB_ATOM_ATOM, 32, props.size(), props.data());
+    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, surf->m_xID, HYPRATOMS[HA_NET_WM_STATE], XCB_ATOM_ATOM, 32, props.size(), props.data());
 }
 
 void CXWM::onNewSurface(SP<CWLSurfaceResource> surf) {
@@ -1114,45 +1166,49 @@ void CXWM::onNewResource(SP<CXWaylandSurfaceResource> resource) {
 }
 
 void CXWM::readWindowData(SP<CXWaylandSurface> surf) {
-    const std::array<xcb_atom_t, 9> interestingProps = {
-        XCB_ATOM_WM_CLASS,          XCB_ATOM_WM_NAME,          XCB_ATOM_WM_TRANSIENT_FOR,        HYPRATOMS["WM_HINTS"],
-        HYPRATOMS["_NET_WM_STATE"], HYPRATOMS["_NET_WM_NAME"], HYPRATOMS["_NET_WM_WINDOW_TYPE"], HYPRATOMS["WM_NORMAL_HINTS"],
-        HYPRATOMS["WM_PROTOCOLS"],
-    };
+    // pipeline the requests, so mapping a window costs one round trip to Xwayland instead of one per property
+    std::array<xcb_get_property_cookie_t, INTERESTING_PROPS_COUNT> cookies;
+    for (size_t i = 0; i < m_interestingProps.size(); i++) {
+        cookies[i] = xcb_get_property(getConnection(), 0, surf->m_xID, m_interestingProps[i], XCB_ATOM_ANY, 0, 2048);
+    }
 
-    for (size_t i = 0; i < interestingProps.size(); i++) {
-        xcb_get_property_cookie_t             cookie = xcb_get_property(getConnection(), 0, surf->m_xID, interestingProps[i], XCB_ATOM_ANY, 0, 2048);
-        XCBReplyPtr<xcb_get_property_reply_t> reply(xcb_get_property_reply(getConnection(), cookie, nullptr));
+    for (size_t i = 0; i < m_interestingProps.size(); i++) {
+        XCBReplyPtr<xcb_get_property_reply_t> reply(xcb_get_property_reply(getConnection(), cookies[i], nullptr));
         if (!reply) {
             Debug::log(ERR, "[xwm] Failed to get window property");
             continue;
         }
-        readProp(surf, interestingProps[i], reply.get());
+        readProp(surf, m_interestingProps[i], reply.get());
     }
 }
 
 SP<CXWaylandSurface> CXWM::windowForWayland(SP<CWLSurfaceResource> surf) {
-    for (auto& s : m_surfaces) {
-        if (s->m_surface == surf)
-            return s;
+    const auto IT = m_surfacesByWL.find(surf.get());
+    if (IT == m_surfacesByWL.end())
+        return nullptr;
+
+    // the xsurface can drop its wl_surface on its own (e.g. when that gets destroyed), don't trust stale entries
+    const auto XSURF = IT->second.lock();
+    if (!XSURF || XSURF->m_surface != surf) {
+        m_surfacesByWL.erase(IT);
+        return nullptr;
     }
 
-    return nullptr;
+    return XSURF;
 }
 
 void CXWM::associate(SP<CXWaylandSurface> surf, SP<CWLSurfaceResource> wlSurf) {
     if (surf->m_surface)
         return;
 
-    auto existing = std::ranges::find_if(m_surfaces, [wlSurf](const auto& e) { return e->m_surface == wlSurf; });
-
-    if (existing != m_surfaces.end()) {
+    if (windowForWayland(wlSurf)) {
         Debug::log(WARN, "[xwm] associate() called but surface is already associated to {:x}, ignoring...", rc<uintptr_t>(surf.get()));
         return;
     }
 
     surf->m_surface = wlSurf;
     surf->ensureListeners();
+    m_surfacesByWL[wlSurf.get()] = surf;
 
     readWindowData(surf);
 
@@ -1166,6 +1222,7 @@ void CXWM::dissociate(SP<CXWaylandSurface> surf) {
     if (surf->m_mapped)
         surf->unmap();
 
+    m_surfacesByWL.erase(surf->m_surface.get());
     surf->m_surface.reset();
     surf->m_events.resourceChange.emit();
 
@@ -1181,7 +1238,7 @@ void CXWM::updateClientList() {
             windows.push_back(surf->m_xID);
     }
 
-    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_screen->root, HYPRATOMS["_NET_CLIENT_LIST"], XCB_ATOM_WINDOW, 32, windows.size(), windows.data());
+    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_screen->root, HYPRATOMS[HA_NET_CLIENT_LIST], XCB_ATOM_WINDOW, 32, windows.size(), windows.data());
 
     windows.clear();
     windows.reserve(m_mappedSurfacesStacking.size());
@@ -1191,7 +1248,7 @@ void CXWM::updateClientList() {
             windows.push_back(surf->m_xID);
     }
 
-    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_screen->root, HYPRATOMS["_NET_CLIENT_LIST_STACKING"], XCB_ATOM_WINDOW, 32, windows.size(), windows.data());
+    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_screen->root, HYPRATOMS[HA_NET_CLIENT_LIST_STACKING], XCB_ATOM_WINDOW, 32, windows.size(), windows.data());
 }
 
 void CXWM::updateWorkArea(int x, int y, int w, int h) {
@@ -1200,16 +1257,36 @@ void CXWM::updateWorkArea(int x, int y, int w, int h) {
     auto connection = g_pXWayland->m_wm->getConnection();
 
     if (w <= 0 || h <= 0) {
-        xcb_delete_property(connection, m_screen->root, HYPRATOMS["_NET_WORKAREA"]);
+        xcb_delete_property(connection, m_screen->root, HYPRATOMS[HA_NET_WORKAREA]);
         xcb_flush(connection);
         return;
     }
 
     uint32_t values[4] = {sc<uint32_t>(x), sc<uint32_t>(y), sc<uint32_t>(w), sc<uint32_t>(h)};
-    xcb_change_property(connection, XCB_PROP_MODE_REPLACE, m_screen->root, HYPRATOMS["_NET_WORKAREA"], XCB_ATOM_CARDINAL, 32, 4, values);
+    xcb_change_property(connection, XCB_PROP_MODE_REPLACE, m_screen->root, HYPRATOMS[HA_NET_WORKAREA], XCB_ATOM_CARDINAL, 32, 4, values);
     xcb_flush(connection);
 }
 
+std::optional<size_t> CXWM::foreignClientCount() {
+    if (!m_xres || !getConnection())
+        return std::nullopt;
+
+    auto                                       cookie = xcb_res_query_clients(getConnection());
+    XCBReplyPtr<xcb_res_query_clients_reply_t> reply(xcb_res_query_clients_reply(getConnection(), cookie, nullptr));
+    if (!reply)
+        return std::nullopt;
+
+    // the server's own client has base 0, windowless clients (xbindkeys, xcape, ...) show up here as well
+    const auto OWNBASE = xcb_get_setup(getConnection())->resource_id_base;
+    size_t     count   = 0;
+    for (auto it = xcb_res_query_clients_clients_iterator(reply.get()); it.rem > 0; xcb_res_client_next(&it)) {
+        if (it.data->resource_base != 0 && it.data->resource_base != OWNBASE)
+            count++;
+    }
+
+    return count;
+}
+
 bool CXWM::isWMWindow(xcb_window_t w) {
     return w == m_wmWindow || w == m_clipboard.window || w == m_dndSelection.window;
 }
@@ -1226,7 +1303,7 @@ void CXWM::initSelection() {
     const uint32_t xfixesMask =
         XCB_XFIXES_SELECTION_EVENT_MASK_SET_SELECTION_OWNER | XCB_XFIXES_SELECTION_EVENT_MASK_SELECTION_WINDOW_DESTROY | XCB_XFIXES_SELECTION_EVENT_MASK_SELECTION_CLIENT_CLOSE;
 
-    auto createSelectionWindow = [&](xcb_window_t& window, const std::string& atomName, bool inputOnly = false) {
+    auto createSelectionWindow = [&](xcb_window_t& window, eHyprAtom atom, bool inputOnly = false) {
         window                = xcb_generate_id(getConnection());
         const uint16_t width  = inputOnly ? 8192 : 10;
         const uint16_t height = inputOnly ? 8192 : 10;
@@ -1235,25 +1312,25 @@ void CXWM::initSelection() {
                           inputOnly ? XCB_WINDOW_CLASS_INPUT_ONLY : XCB_WINDOW_CLASS_INPUT_OUTPUT, m_screen->root_visual, XCB_CW_EVENT_MASK, &windowMask);
 
         if (!inputOnly) {
-            xcb_set_selection_owner(getConnection(), window, HYPRATOMS[atomName], XCB_TIME_CURRENT_TIME);
-            xcb_xfixes_select_selection_input(getConnection(), window, HYPRATOMS[atomName], xfixesMask);
+            xcb_set_selection_owner(getConnection(), window, HYPRATOMS[atom], XCB_TIME_CURRENT_TIME);
+            xcb_xfixes_select_selection_input(getConnection(), window, HYPRATOMS[atom], xfixesMask);
         }
 
         return window;
     };
 
-    createSelectionWindow(m_clipboard.window, "CLIPBOARD_MANAGER");
-    createSelectionWindow(m_clipboard.window, "CLIPBOARD");
+    createSelectionWindow(m_clipboard.window, HA_CLIPBOARD_MANAGER);
+    createSelectionWindow(m_clipboard.window, HA_CLIPBOARD);
     m_clipboard.listeners.setSelection        = g_pSeatManager->m_events.setSelection.listen([this] { m_clipboard.onSelection(); });
     m_clipboard.listeners.keyboardFocusChange = g_pSeatManager->m_events.keyboardFocusChange.listen([this] { m_clipboard.onKeyboardFocus(); });
 
-    createSelectionWindow(m_primarySelection.window, "PRIMARY");
+    createSelectionWindow(m_primarySelection.window, HA_PRIMARY);
     m_primarySelection.listeners.setSelection        = g_pSeatManager->m_events.setPrimarySelection.listen([this] { m_primarySelection.onSelection(); });
     m_primarySelection.listeners.keyboardFocusChange = g_pSeatManager->m_events.keyboardFocusChange.listen([this] { m_primarySelection.onKeyboardFocus(); });
 
-    createSelectionWindow(m_dndSelection.window, "XdndAware", true);
+    createSelectionWindow(m_dndSelection.window, HA_XdndAware, true);
     const uint32_t xdndVersion = XDND_VERSION;
-    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_dndSelection.window, HYPRATOMS["XdndAware"], XCB_ATOM_ATOM, 32, 1, &xdndVersion);
+    xcb_change_property(getConnection(), XCB_PROP_MODE_REPLACE, m_dndSelection.window, HYPRATOMS[HA_XdndAware], XCB_ATOM_ATOM, 32, 1, &xdndVersion);
 }
 
 void CXWM::setClipboardToWayland(SXSelection& sel) {
@@ -1275,62 +1352,36 @@ void CXWM::setClipboardToWayland(SXSelection& sel) {
 
 static int writeDataSource(int fd, uint32_t mask, void* data) {
     auto selection = sc<SXSelection*>(data);
-    return selection->onWrite();
+    return selection->onWrite(fd);
 }
 
-void CXWM::getTransferData(SXSelection& sel) {
+void CXWM::getTransferData(SXSelection& sel, xcb_window_t incomingWindow) {
     Debug::log(LOG, "[xwm] getTransferData");
 
-    auto it = std::ranges::find_if(sel.transfers, [](const auto& t) { return !t->propertyReply; });
+    auto it = std::ranges::find_if(sel.transfers, [incomingWindow](const auto& t) { return !t->out && t->incomingWindow == incomingWindow; });
     if (it == sel.transfers.end()) {
         Debug::log(ERR, "[xwm] No pending transfer found");
         return;
     }
 
     auto& transfer = *it;
-    if (!transfer || !transfer->incomingWindow) {
-        Debug::log(ERR, "[xwm] Invalid transfer state");
-        sel.transfers.erase(it);
-        return;
-    }
-
-    if (!transfer->getIncomingSelectionProp(true)) {
+    if (!transfer->getIncomingSelectionProp()) {
         Debug::log(ERR, "[xwm] Failed to get property data");
         sel.transfers.erase(it);
         return;
     }
 
-    if (!transfer->propertyReply) {
-        Debug::log(ERR, "[xwm] No property reply");
-        sel.transfers.erase(it);
-        return;
-    }
+    transfer->eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, transfer->wlFD.get(), WL_EVENT_WRITABLE, ::writeDataSource, &sel);
 
-    if (transfer->propertyReply->type == HYPRATOMS["INCR"]) {
-        transfer->incremental   = true;
-        transfer->propertyStart = 0;
+    if (transfer->propertyReply->type == HYPRATOMS[HA_INCR]) {
+        // deleting the INCR property tells the owner to start sending chunks, they come in as property notifies
+        transfer->incremental = true;
         free(transfer->propertyReply); // NOLINT(cppcoreguidelines-no-malloc)
         transfer->propertyReply = nullptr;
-        return;
+        transfer->pollWayland(0);
+        xcb_delete_property(getConnection(), transfer->incomingWindow, HYPRATOMS[HA_WL_SELECTION]);
+        xcb_flush(getConnection());
     }
-
-    const size_t transferIndex = std::distance(sel.transfers.begin(), it);
-    int          writeResult   = sel.onWrite();
-
-    if (writeResult != 1)
-        return;
-
-    if (transferIndex >= sel.transfers.size())
-        return;
-
-    Hyprutils::Memory::CUniquePointer<SXTransfer>& updatedTransfer = sel.transfers[transferIndex];
-    if (!updatedTransfer)
-        return;
-
-    if (updatedTransfer->eventSource && updatedTransfer->wlFD.get() == -1)
-        return;
-
-    updatedTransfer->eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, updatedTransfer->wlFD.get(), WL_EVENT_WRITABLE, ::writeDataSource, &sel);
 }
 
 void CXWM::setCursor(unsigned char* pixData, uint32_t stride, const Vector2D& size, const Vector2D& hotspot) {
@@ -1405,11 +1456,11 @@ void SXSelection::onSelection() {
     auto conn = g_pXWayland->m_wm->getConnection();
 
     if (isClipboard && currentSel) {
-        xcb_set_selection_owner(conn, g_pXWayland->m_wm->m_clipboard.window, HYPRATOMS["CLIPBOARD"], XCB_TIME_CURRENT_TIME);
+        xcb_set_selection_owner(conn, g_pXWayland->m_wm->m_clipboard.window, HYPRATOMS[HA_CLIPBOARD], XCB_TIME_CURRENT_TIME);
         xcb_flush(conn);
         g_pXWayland->m_wm->m_clipboard.notifyOnFocus = true;
     } else if (isPrimary && currentPrimSel) {
-        xcb_set_selection_owner(conn, g_pXWayland->m_wm->m_primarySelection.window, HYPRATOMS["PRIMARY"], XCB_TIME_CURRENT_TIME);
+        xcb_set_selection_owner(conn, g_pXWayland->m_wm->m_primarySelection.window, HYPRATOMS[HA_PRIMARY], XCB_TIME_CURRENT_TIME);
         xcb_flush(conn);
         g_pXWayland->m_wm->m_primarySelection.notifyOnFocus = true;
     }
@@ -1429,7 +1480,7 @@ void SXSelection::onKeyboardFocus() {
 }
 
 int SXSelection::onRead(int fd, uint32_t mask) {
-    auto it = std::ranges::find_if(transfers, [fd](const auto& t) { return t->wlFD.get() == fd; });
+    auto it = std::ranges::find_if(transfers, [fd](const auto& t) { return t->out && t->wlFD.get() == fd; });
 
     if (it == transfers.end()) {
         Debug::log(ERR, "[xwm] No transfer found for fd {}", fd);
@@ -1438,41 +1489,98 @@ int SXSelection::onRead(int fd, uint32_t mask) {
 
     auto&        transfer = *it;
     const size_t oldSize  = transfer->data.size();
-    transfer->data.resize(oldSize + INCR_CHUNK_SIZE);
+    transfer->data.resize(INCR_CHUNK_SIZE);
 
-    ssize_t bytesRead = read(fd, transfer->data.data() + oldSize, INCR_CHUNK_SIZE - 1);
+    ssize_t bytesRead = read(fd, transfer->data.data() + oldSize, INCR_CHUNK_SIZE - oldSize);
 
     if (bytesRead < 0) {
+        transfer->data.resize(oldSize);
+        if (errno == EAGAIN || errno == EINTR)
+            return 1;
+
         Debug::log(ERR, "[xwm] readDataSource died");
-        g_pXWayland->m_wm->selectionSendNotify(&transfer->request, false);
+        if (!transfer->incremental)
+            g_pXWayland->m_wm->selectionSendNotify(&transfer->request, false);
         transfers.erase(it);
         return 0;
     }
 
     transfer->data.resize(oldSize + bytesRead);
+    transfer->eof = bytesRead == 0;
 
-    if (bytesRead == 0) {
-        if (transfer->data.empty()) {
-            Debug::log(WARN, "[xwm] Transfer ended with zero bytes — rejecting");
-            g_pXWayland->m_wm->selectionSendNotify(&transfer->request, false);
+    const bool FULL = transfer->data.size() >= INCR_CHUNK_SIZE;
+
+    // nothing to do until there's a full chunk or the source is done
+    if (!FULL && !transfer->eof)
+        return 1;
+
+    // don't read ahead more than one chunk, wait for the requestor to catch up
+    transfer->pollWayland(0);
+
+    auto conn = g_pXWayland->m_wm->getConnection();
+
+    if (!transfer->incremental) {
+        if (transfer->eof) {
+            if (transfer->data.empty()) {
+                Debug::log(WARN, "[xwm] Transfer ended with zero bytes — rejecting");
+                g_pXWayland->m_wm->selectionSendNotify(&transfer->request, false);
+                transfers.erase(it);
+                return 0;
+            }
+
+            // fits in a single property
+            Debug::log(LOG, "[xwm] Transfer complete, total size: {}", transfer->data.size());
+            xcb_change_property(conn, XCB_PROP_MODE_REPLACE, transfer->request.requestor, transfer->request.property, transfer->request.target, 8, transfer->data.size(),
+                                transfer->data.data());
+            xcb_flush(conn);
+            g_pXWayland->m_wm->selectionSendNotify(&transfer->request, true);
             transfers.erase(it);
             return 0;
         }
 
-        Debug::log(LOG, "[xwm] Transfer complete, total size: {}", transfer->data.size());
-        auto conn = g_pXWayland->m_wm->getConnection();
-        xcb_change_property(conn, XCB_PROP_MODE_REPLACE, transfer->request.requestor, transfer->request.property, transfer->request.target, 8, transfer->data.size(),
-                            transfer->data.data());
+        // too big for one go, switch to INCR. The value is a lower bound of the size, which is all we know.
+        Debug::log(LOG, "[xwm] Transfer to X is larger than {} bytes, going incremental", INCR_CHUNK_SIZE);
+
+        const uint32_t PROPERTY_MASK = XCB_EVENT_MASK_PROPERTY_CHANGE;
+        const uint32_t LOWER_BOUND   = INCR_CHUNK_SIZE;
 
+        transfer->incremental = true;
+        transfer->propertySet = true;
+        xcb_change_window_attributes(conn, transfer->request.requestor, XCB_CW_EVENT_MASK, &PROPERTY_MASK);
+        xcb_change_property(conn, XCB_PROP_MODE_REPLACE, transfer->request.requestor, transfer->request.property, HYPRATOMS[HA_INCR], 32, 1, &LOWER_BOUND);
         xcb_flush(conn);
         g_pXWayland->m_wm->selectionSendNotify(&transfer->request, true);
-        transfers.erase(it);
-    } else
-        Debug::log(LOG, "[xwm] Received {} bytes, awaiting more...", bytesRead);
+        return 1;
+    }
+
+    if (!transfer->propertySet)
+        sendChunk(*transfer);
 
     return 1;
 }
 
+void SXSelection::sendChunk(SXTransfer& transfer) {
+    auto       conn = g_pXWayland->m_wm->getConnection();
+    const bool LAST = transfer.data.empty();
+
+    xcb_change_property(conn, XCB_PROP_MODE_REPLACE, transfer.request.requestor, transfer.request.property, transfer.request.target, 8, transfer.data.size(),
+                        transfer.data.data());
+    xcb_flush(conn);
+
+    transfer.propertySet = true;
+    transfer.data.clear();
+
+    if (LAST) {
+        Debug::log(LOG, "[xwm] incremental transfer to X done");
+        std::erase_if(transfers, [&transfer](const auto& t) { return t.get() == &transfer; });
+        return;
+    }
+
+    // refill while the requestor chews on this one
+    if (!transfer.eof)
+        transfer.pollWayland(WL_EVENT_READABLE);
+}
+
 static int readDataSource(int fd, uint32_t mask, void* data) {
     Debug::log(LOG, "[xwm] readDataSource on fd {}", fd);
 
@@ -1579,40 +1687,67 @@ bool SXSelection::sendData(xcb_selection_request_event_t* e, std::string mime) {
     return true;
 }
 
-int SXSelection::onWrite() {
-    auto it = std::ranges::find_if(transfers, [](const auto& t) { return t->propertyReply; });
+int SXSelection::onWrite(int fd) {
+    auto it = std::ranges::find_if(transfers, [fd](const auto& t) { return !t->out && t->wlFD.get() == fd; });
     if (it == transfers.end()) {
-        Debug::log(ERR, "[xwm] No transfer with property data found");
+        Debug::log(ERR, "[xwm] No transfer found for fd {}", fd);
         return 0;
     }
 
-    auto&   transfer  = *it;
+    auto& transfer = *it;
+    if (!transfer->propertyReply) {
+        // waiting on X for the next chunk
+        transfer->pollWayland(0);
+        return 1;
+    }
+
     char*   property  = sc<char*>(xcb_get_property_value(transfer->propertyReply));
     int     remainder = xcb_get_property_value_length(transfer->propertyReply) - transfer->propertyStart;
 
     ssize_t len = write(transfer->wlFD.get(), property + transfer->propertyStart, remainder);
     if (len == -1) {
-        if (errno == EAGAIN)
+        if (errno == EAGAIN || errno == EINTR)
             return 1;
         Debug::log(ERR, "[xwm] write died in transfer get");
         transfers.erase(it);
         return 0;
     }
 
+    transfer->propertyStart += len;
     if (len < remainder) {
-        transfer->propertyStart += len;
-        Debug::log(LOG, "[xwm] wl client read partially: len {}", len);
-    } else {
-        Debug::log(LOG, "[xwm] cb transfer to wl client complete, read {} bytes", len);
-        if (!transfer->incremental) {
+        Debug::log(TRACE, "[xwm] wl client read partially: len {}", len);
+        return 1;
+    }
+
+    const bool MORE = transfer->propertyReply->bytes_after > 0;
+    transfer->propertyOffset += xcb_get_property_value_length(transfer->propertyReply) / 4;
+    free(transfer->propertyReply); // NOLINT(cppcoreguidelines-no-malloc)
+    transfer->propertyReply = nullptr;
+
+    // the rest of this property, one chunk at a time
+    if (MORE) {
+        if (!transfer->getIncomingSelectionProp()) {
             transfers.erase(it);
-        } else {
-            free(transfer->propertyReply); // NOLINT(cppcoreguidelines-no-malloc)
-            transfer->propertyReply = nullptr;
-            transfer->propertyStart = 0;
+            return 0;
         }
+        return 1;
+    }
+
+    transfer->propertyOffset = 0;
+
+    if (!transfer->incremental) {
+        Debug::log(LOG, "[xwm] cb transfer to wl client complete");
+        xcb_delete_property(g_pXWayland->m_wm->getConnection(), transfer->incomingWindow, HYPRATOMS[HA_WL_SELECTION]);
+        xcb_flush(g_pXWayland->m_wm->getConnection());
+        transfers.erase(it);
+        return 0;
     }
 
+    // ask the owner for the next chunk
+    transfer->pollWayland(0);
+    xcb_delete_property(g_pXWayland->m_wm->getConnection(), transfer->incomingWindow, HYPRATOMS[HA_WL_SELECTION]);
+    xcb_flush(g_pXWayland->m_wm->getConnection());
+
     return 1;
 }
 
@@ -1625,9 +1760,13 @@ SXTransfer::~SXTransfer() {
         free(propertyReply); // NOLINT(cppcoreguidelines-no-malloc)
 }
 
-bool SXTransfer::getIncomingSelectionProp(bool erase) {
-    xcb_get_property_cookie_t cookie =
-        xcb_get_property(*g_pXWayland->m_wm->m_connection, erase, incomingWindow, HYPRATOMS["_WL_SELECTION"], XCB_GET_PROPERTY_TYPE_ANY, 0, 0x1fffffff);
+bool SXTransfer::getIncomingSelectionProp() {
+    if (propertyReply)
+        free(propertyReply); // NOLINT(cppcoreguidelines-no-malloc)
+    propertyReply = nullptr;
+
+    xcb_get_property_cookie_t cookie = xcb_get_property(*g_pXWayland->m_wm->m_connection, 0, incomingWindow, HYPRATOMS[HA_WL_SELECTION], XCB_GET_PROPERTY_TYPE_ANY,
+                                                        propertyOffset, INCR_CHUNK_SIZE / 4);
 
     propertyStart = 0;
     propertyReply = xcb_get_property_reply(*g_pXWayland->m_wm->m_connection, cookie, nullptr);
@@ -1640,4 +1779,9 @@ bool SXTransfer::getIncomingSelectionProp(bool erase) {
     return true;
 }
 
+void SXTransfer::pollWayland(uint32_t mask) {
+    if (eventSource)
+        wl_event_source_fd_update(eventSource, mask);
+}
+
 #endif
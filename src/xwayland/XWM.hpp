@@ -13,33 +13,43 @@
 #include <hyprutils/os/FileDescriptor.hpp>
 #include <cinttypes> // for PRIxPTR
 #include <cstdint>
+#include <array>
+#include <unordered_map>
+#include <optional>
 
 struct wl_event_source;
 class CXWaylandSurfaceResource;
 struct SXSelection;
 
+// One direction of a selection transfer between X and wayland. Data is streamed through in chunks of
+// at most INCR_CHUNK_SIZE, and each side only gets the next chunk once the other one took the previous,
+// so memory use doesn't depend on the size of the selection.
 struct SXTransfer {
     ~SXTransfer();
 
     SXSelection&                   selection;
     bool                           out = true;
 
-    bool                           incremental   = false;
-    bool                           flushOnDelete = false;
-    bool                           propertySet   = false;
+    bool                           incremental = false;
+    bool                           eof         = false; // out: the wayland source is done, one more (empty) chunk to go
+    bool                           propertySet = false; // out: the requestor hasn't deleted the last chunk yet
 
     Hyprutils::OS::CFileDescriptor wlFD;
     wl_event_source*               eventSource = nullptr;
 
-    std::vector<uint8_t>           data;
+    std::vector<uint8_t>           data; // out: read from wayland, not yet handed to X
 
     xcb_selection_request_event_t  request;
 
-    int                            propertyStart;
-    xcb_get_property_reply_t*      propertyReply;
-    xcb_window_t                   incomingWindow;
+    int                            propertyStart  = 0;       // in: bytes of propertyReply already written
+    uint32_t                       propertyOffset = 0;       // in: where propertyReply starts in the property, in 32-bit units
+    xcb_get_property_reply_t*      propertyReply  = nullptr; // in: the current chunk
+    xcb_window_t                   incomingWindow = 0;
 
-    bool                           getIncomingSelectionProp(bool erase);
+    // in: fetches the next chunk of the property into propertyReply
+    bool                           getIncomingSelectionProp();
+    // pauses (0) or resumes (WL_EVENT_*) polling the wayland fd
+    void                           pollWayland(uint32_t mask);
 };
 
 struct SXSelection {
@@ -53,7 +63,9 @@ struct SXSelection {
     void             onKeyboardFocus();
     bool             sendData(xcb_selection_request_event_t* e, std::string mime);
     int              onRead(int fd, uint32_t mask);
-    int              onWrite();
+    int              onWrite(int fd);
+    // out: hands the buffered data to the requestor, an empty chunk ends an incremental transfer
+    void             sendChunk(SXTransfer& transfer);
 
     struct {
         CHyprSignalListener setSelection;
@@ -120,6 +132,9 @@ class CXWM {
     SP<IDataOffer>     createX11DataOffer(SP<CWLSurfaceResource> surf, SP<IDataSource> source);
     void               updateWorkArea(int x, int y, int w, int h);
 
+    // X clients connected besides the wm itself, empty if XRes can't tell
+    std::optional<size_t> foreignClientCount();
+
   private:
     void                 setCursor(unsigned char* pixData, uint32_t stride, const Vector2D& size, const Vector2D& hotspot);
 
@@ -174,7 +189,7 @@ class CXWM {
     xcb_atom_t   mimeToAtom(const std::string& mime);
     std::string  mimeFromAtom(xcb_atom_t atom);
     void         setClipboardToWayland(SXSelection& sel);
-    void         getTransferData(SXSelection& sel);
+    void         getTransferData(SXSelection& sel, xcb_window_t incomingWindow);
     std::string  getAtomName(uint32_t atom);
     void         readProp(SP<CXWaylandSurface> XSURF, uint32_t atom, xcb_get_property_reply_t* reply);
 
@@ -221,6 +236,14 @@ class CXWM {
         CHyprSignalListener newXShellSurface;
     } m_listeners;
 
+    // lookups for the hot paths, m_surfaces stays the owner
+    std::unordered_map<xcb_window_t, WP<CXWaylandSurface>>        m_surfacesByXID;
+    std::unordered_map<CWLSurfaceResource*, WP<CXWaylandSurface>> m_surfacesByWL;
+
+    // exactly the properties readProp handles, resolved with the atoms. Keep the two in sync
+    static constexpr size_t                                       INTERESTING_PROPS_COUNT = 10;
+    std::array<xcb_atom_t, INTERESTING_PROPS_COUNT>               m_interestingProps      = {};
+
     friend class CXWaylandSurface;
     friend class CXWayland;
     friend class CXDataSource;
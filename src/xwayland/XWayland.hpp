@@ -4,6 +4,9 @@
 #include "../helpers/memory/Memory.hpp"
 #include "../macros.hpp"
 
+#include <array>
+#include <cstdint>
+
 #include "XSurface.hpp"
 
 #ifndef NO_XWAYLAND
@@ -30,102 +33,116 @@ class CXWayland {
     bool m_enabled = false;
 };
 
-inline UP<CXWayland>                             g_pXWayland;
+inline UP<CXWayland> g_pXWayland;
 
-inline std::unordered_map<std::string, uint32_t> HYPRATOMS = {
-#ifndef NO_XWAYLAND
-    HYPRATOM("_NET_SUPPORTED"),
-    HYPRATOM("_NET_SUPPORTING_WM_CHECK"),
-    HYPRATOM("_NET_WM_NAME"),
-    HYPRATOM("_NET_WM_VISIBLE_NAME"),
-    HYPRATOM("_NET_WM_MOVERESIZE"),
-    HYPRATOM("_NET_WM_STATE_STICKY"),
-    HYPRATOM("_NET_WM_STATE_FULLSCREEN"),
-    HYPRATOM("_NET_WM_STATE_DEMANDS_ATTENTION"),
-    HYPRATOM("_NET_WM_STATE_MODAL"),
-    HYPRATOM("_NET_WM_STATE_HIDDEN"),
-    HYPRATOM("_NET_WM_STATE_FOCUSED"),
-    HYPRATOM("_NET_WM_STATE"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_NORMAL"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_DOCK"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_DIALOG"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_UTILITY"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_TOOLBAR"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_SPLASH"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_MENU"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_DROPDOWN_MENU"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_POPUP_MENU"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_TOOLTIP"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_NOTIFICATION"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_COMBO"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_DND"),
-    HYPRATOM("_NET_WM_WINDOW_TYPE_DESKTOP"),
-    HYPRATOM("_NET_WM_STATE_MAXIMIZED_HORZ"),
-    HYPRATOM("_NET_WM_STATE_MAXIMIZED_VERT"),
-    HYPRATOM("_NET_WM_DESKTOP"),
-    HYPRATOM("_NET_WM_STRUT_PARTIAL"),
-    HYPRATOM("_NET_CLIENT_LIST"),
-    HYPRATOM("_NET_CLIENT_LIST_STACKING"),
-    HYPRATOM("_NET_CURRENT_DESKTOP"),
-    HYPRATOM("_NET_NUMBER_OF_DESKTOPS"),
-    HYPRATOM("_NET_DESKTOP_NAMES"),
-    HYPRATOM("_NET_DESKTOP_VIEWPORT"),
-    HYPRATOM("_NET_ACTIVE_WINDOW"),
-    HYPRATOM("_NET_CLOSE_WINDOW"),
-    HYPRATOM("_NET_MOVERESIZE_WINDOW"),
-    HYPRATOM("_NET_WM_USER_TIME"),
-    HYPRATOM("_NET_STARTUP_ID"),
-    HYPRATOM("_NET_WORKAREA"),
-    HYPRATOM("_NET_WM_ICON"),
-    HYPRATOM("_NET_WM_CM_S0"),
-    HYPRATOM("_NET_WM_PING"),
-    HYPRATOM("WM_PROTOCOLS"),
-    HYPRATOM("WM_HINTS"),
-    HYPRATOM("WM_DELETE_WINDOW"),
-    HYPRATOM("UTF8_STRING"),
-    HYPRATOM("WM_STATE"),
-    HYPRATOM("WM_CLIENT_LEADER"),
-    HYPRATOM("WM_TAKE_FOCUS"),
-    HYPRATOM("WM_NORMAL_HINTS"),
-    HYPRATOM("WM_SIZE_HINTS"),
-    HYPRATOM("WM_WINDOW_ROLE"),
-    HYPRATOM("_NET_REQUEST_FRAME_EXTENTS"),
-    HYPRATOM("_NET_FRAME_EXTENTS"),
-    HYPRATOM("_MOTIF_WM_HINTS"),
-    HYPRATOM("WM_CHANGE_STATE"),
-    HYPRATOM("_NET_SYSTEM_TRAY_OPCODE"),
-    HYPRATOM("_NET_SYSTEM_TRAY_COLORS"),
-    HYPRATOM("_NET_SYSTEM_TRAY_VISUAL"),
-    HYPRATOM("_NET_SYSTEM_TRAY_ORIENTATION"),
-    HYPRATOM("_XEMBED_INFO"),
-    HYPRATOM("MANAGER"),
-    HYPRATOM("XdndSelection"),
-    HYPRATOM("XdndAware"),
-    HYPRATOM("XdndStatus"),
-    HYPRATOM("XdndPosition"),
-    HYPRATOM("XdndEnter"),
-    HYPRATOM("XdndLeave"),
-    HYPRATOM("XdndDrop"),
-    HYPRATOM("XdndFinished"),
-    HYPRATOM("XdndProxy"),
-    HYPRATOM("XdndTypeList"),
-    HYPRATOM("XdndActionMove"),
-    HYPRATOM("XdndActionCopy"),
-    HYPRATOM("XdndActionAsk"),
-    HYPRATOM("XdndActionPrivate"),
-    HYPRATOM("CLIPBOARD"),
-    HYPRATOM("PRIMARY"),
-    HYPRATOM("_WL_SELECTION"),
-    HYPRATOM("CLIPBOARD_MANAGER"),
-    HYPRATOM("WINDOW"),
-    HYPRATOM("WM_S0"),
-    HYPRATOM("WL_SURFACE_ID"),
-    HYPRATOM("WL_SURFACE_SERIAL"),
-    HYPRATOM("TARGETS"),
-    HYPRATOM("TIMESTAMP"),
-    HYPRATOM("DELETE"),
-    HYPRATOM("TEXT"),
-    HYPRATOM("INCR"),
-#endif
+// every atom the xwm uses. Resolved once in CXWM::gatherResources, looked up by index after that.
+#define HYPRATOMS_FOREACH(X)                                                                                                                                                       \
+    X(NET_SUPPORTED, "_NET_SUPPORTED")                                                                                                                                             \
+    X(NET_SUPPORTING_WM_CHECK, "_NET_SUPPORTING_WM_CHECK")                                                                                                                         \
+    X(NET_WM_NAME, "_NET_WM_NAME")                                                                                                                                                 \
+    X(NET_WM_VISIBLE_NAME, "_NET_WM_VISIBLE_NAME")                                                                                                                                 \
+    X(NET_WM_MOVERESIZE, "_NET_WM_MOVERESIZE")                                                                                                                                     \
+    X(NET_WM_STATE_STICKY, "_NET_WM_STATE_STICKY")                                                                                                                                 \
+    X(NET_WM_STATE_FULLSCREEN, "_NET_WM_STATE_FULLSCREEN")                                                                                                                         \
+    X(NET_WM_STATE_DEMANDS_ATTENTION, "_NET_WM_STATE_DEMANDS_ATTENTION")                                                                                                           \
+    X(NET_WM_STATE_MODAL, "_NET_WM_STATE_MODAL")                                                                                                                                   \
+    X(NET_WM_STATE_HIDDEN, "_NET_WM_STATE_HIDDEN")                                                                                                                                 \
+    X(NET_WM_STATE_FOCUSED, "_NET_WM_STATE_FOCUSED")                                                                                                                               \
+    X(NET_WM_STATE, "_NET_WM_STATE")                                                                                                                                               \
+    X(NET_WM_WINDOW_TYPE, "_NET_WM_WINDOW_TYPE")                                                                                                                                   \
+    X(NET_WM_WINDOW_TYPE_NORMAL, "_NET_WM_WINDOW_TYPE_NORMAL")                                                                                                                     \
+    X(NET_WM_WINDOW_TYPE_DOCK, "_NET_WM_WINDOW_TYPE_DOCK")                                                                                                                         \
+    X(NET_WM_WINDOW_TYPE_DIALOG, "_NET_WM_WINDOW_TYPE_DIALOG")                                                                                                                     \
+    X(NET_WM_WINDOW_TYPE_UTILITY, "_NET_WM_WINDOW_TYPE_UTILITY")                                                                                                                   \
+    X(NET_WM_WINDOW_TYPE_TOOLBAR, "_NET_WM_WINDOW_TYPE_TOOLBAR")                                                                                                                   \
+    X(NET_WM_WINDOW_TYPE_SPLASH, "_NET_WM_WINDOW_TYPE_SPLASH")                                                                                                                     \
+    X(NET_WM_WINDOW_TYPE_MENU, "_NET_WM_WINDOW_TYPE_MENU")                                                                                                                         \
+    X(NET_WM_WINDOW_TYPE_DROPDOWN_MENU, "_NET_WM_WINDOW_TYPE_DROPDOWN_MENU")                                                                                                       \
+    X(NET_WM_WINDOW_TYPE_POPUP_MENU, "_NET_WM_WINDOW_TYPE_POPUP_MENU")                                                                                                             \
+    X(NET_WM_WINDOW_TYPE_TOOLTIP, "_NET_WM_WINDOW_TYPE_TOOLTIP")                                                                                                                   \
+    X(NET_WM_WINDOW_TYPE_NOTIFICATION, "_NET_WM_WINDOW_TYPE_NOTIFICATION")                                                                                                         \
+    X(NET_WM_WINDOW_TYPE_COMBO, "_NET_WM_WINDOW_TYPE_COMBO")                                                                                                                       \
+    X(NET_WM_WINDOW_TYPE_DND, "_NET_WM_WINDOW_TYPE_DND")                                                                                                                           \
+    X(NET_WM_WINDOW_TYPE_DESKTOP, "_NET_WM_WINDOW_TYPE_DESKTOP")                                                                                                                   \
+    X(KDE_NET_WM_WINDOW_TYPE_OVERRIDE, "_KDE_NET_WM_WINDOW_TYPE_OVERRIDE")                                                                                                         \
+    X(NET_WM_STATE_MAXIMIZED_HORZ, "_NET_WM_STATE_MAXIMIZED_HORZ")                                                                                                                 \
+    X(NET_WM_STATE_MAXIMIZED_VERT, "_NET_WM_STATE_MAXIMIZED_VERT")                                                                                                                 \
+    X(NET_WM_DESKTOP, "_NET_WM_DESKTOP")                                                                                                                                           \
+    X(NET_WM_STRUT_PARTIAL, "_NET_WM_STRUT_PARTIAL")                                                                                                                               \
+    X(NET_CLIENT_LIST, "_NET_CLIENT_LIST")                                                                                                                                         \
+    X(NET_CLIENT_LIST_STACKING, "_NET_CLIENT_LIST_STACKING")                                                                                                                       \
+    X(NET_CURRENT_DESKTOP, "_NET_CURRENT_DESKTOP")                                                                                                                                 \
+    X(NET_NUMBER_OF_DESKTOPS, "_NET_NUMBER_OF_DESKTOPS")                                                                                                                           \
+    X(NET_DESKTOP_NAMES, "_NET_DESKTOP_NAMES")                                                                                                                                     \
+    X(NET_DESKTOP_VIEWPORT, "_NET_DESKTOP_VIEWPORT")                                                                                                                               \
+    X(NET_ACTIVE_WINDOW, "_NET_ACTIVE_WINDOW")                                                                                                                                     \
+    X(NET_CLOSE_WINDOW, "_NET_CLOSE_WINDOW")                                                                                                                                       \
+    X(NET_MOVERESIZE_WINDOW, "_NET_MOVERESIZE_WINDOW")                                                                                                                             \
+    X(NET_WM_USER_TIME, "_NET_WM_USER_TIME")                                                                                                                                       \
+    X(NET_STARTUP_ID, "_NET_STARTUP_ID")                                                                                                                                           \
+    X(NET_WORKAREA, "_NET_WORKAREA")                                                                                                                                               \
+    X(NET_WM_ICON, "_NET_WM_ICON")                                                                                                                                                 \
+    X(NET_WM_CM_S0, "_NET_WM_CM_S0")                                                                                                                                               \
+    X(NET_WM_PING, "_NET_WM_PING")                                                                                                                                                 \
+    X(WM_PROTOCOLS, "WM_PROTOCOLS")                                                                                                                                                \
+    X(WM_HINTS, "WM_HINTS")                                                                                                                                                        \
+    X(WM_DELETE_WINDOW, "WM_DELETE_WINDOW")                                                                                                                                        \
+    X(UTF8_STRING, "UTF8_STRING")                                                                                                                                                  \
+    X(WM_STATE, "WM_STATE")                                                                                                                                                        \
+    X(WM_CLIENT_LEADER, "WM_CLIENT_LEADER")                                                                                                                                        \
+    X(WM_TAKE_FOCUS, "WM_TAKE_FOCUS")                                                                                                                                              \
+    X(WM_NORMAL_HINTS, "WM_NORMAL_HINTS")                                                                                                                                          \
+    X(WM_SIZE_HINTS, "WM_SIZE_HINTS")                                                                                                                                              \
+    X(WM_WINDOW_ROLE, "WM_WINDOW_ROLE")                                                                                                                                            \
+    X(NET_REQUEST_FRAME_EXTENTS, "_NET_REQUEST_FRAME_EXTENTS")                                                                                                                     \
+    X(NET_FRAME_EXTENTS, "_NET_FRAME_EXTENTS")                                                                                                                                     \
+    X(MOTIF_WM_HINTS, "_MOTIF_WM_HINTS")                                                                                                                                           \
+    X(WM_CHANGE_STATE, "WM_CHANGE_STATE")                                                                                                                                          \
+    X(NET_SYSTEM_TRAY_OPCODE, "_NET_SYSTEM_TRAY_OPCODE")                                                                                                                           \
+    X(NET_SYSTEM_TRAY_COLORS, "_NET_SYSTEM_TRAY_COLORS")                                                                                                                           \
+    X(NET_SYSTEM_TRAY_VISUAL, "_NET_SYSTEM_TRAY_VISUAL")                                                                                                                           \
+    X(NET_SYSTEM_TRAY_ORIENTATION, "_NET_SYSTEM_TRAY_ORIENTATION")                                                                                                                 \
+    X(XEMBED_INFO, "_XEMBED_INFO")                                                                                                                                                 \
+    X(MANAGER, "MANAGER")                                                                                                                                                          \
+    X(XdndSelection, "XdndSelection")                                                                                                                                              \
+    X(XdndAware, "XdndAware")                                                                                                                                                      \
+    X(XdndStatus, "XdndStatus")                                                                                                                                                    \
+    X(XdndPosition, "XdndPosition")                                                                                                                                                \
+    X(XdndEnter, "XdndEnter")                                                                                                                                                      \
+    X(XdndLeave, "XdndLeave")                                                                                                                                                      \
+    X(XdndDrop, "XdndDrop")                                                                                                                                                        \
+    X(XdndFinished, "XdndFinished")                                                                                                                                                \
+    X(XdndProxy, "XdndProxy")                                                                                                                                                      \
+    X(XdndTypeList, "XdndTypeList")                                                                                                                                                \
+    X(XdndActionMove, "XdndActionMove")                                                                                                                                            \
+    X(XdndActionCopy, "XdndActionCopy")                                                                                                                                            \
+    X(XdndActionAsk, "XdndActionAsk")                                                                                                                                              \
+    X(XdndActionPrivate, "XdndActionPrivate")                                                                                                                                      \
+    X(CLIPBOARD, "CLIPBOARD")                                                                                                                                                      \
+    X(PRIMARY, "PRIMARY")                                                                                                                                                          \
+    X(WL_SELECTION, "_WL_SELECTION")                                                                                                                                               \
+    X(CLIPBOARD_MANAGER, "CLIPBOARD_MANAGER")                                                                                                                                      \
+    X(WINDOW, "WINDOW")                                                                                                                                                            \
+    X(WM_S0, "WM_S0")                                                                                                                                                              \
+    X(WL_SURFACE_ID, "WL_SURFACE_ID")                                                                                                                                              \
+    X(WL_SURFACE_SERIAL, "WL_SURFACE_SERIAL")                                                                                                                                      \
+    X(TARGETS, "TARGETS")                                                                                                                                                          \
+    X(TIMESTAMP, "TIMESTAMP")                                                                                                                                                      \
+    X(DELETE, "DELETE")                                                                                                                                                            \
+    X(TEXT, "TEXT")                                                                                                                                                                \
+    X(INCR, "INCR")
+
+enum eHyprAtom : uint8_t {
+#define HYPRATOM_ENUM(id, name) HA_##id,
+    HYPRATOMS_FOREACH(HYPRATOM_ENUM)
+#undef HYPRATOM_ENUM
+    HA_COUNT,
 };
+
+inline constexpr std::array<const char*, HA_COUNT> HYPRATOM_NAMES = {
+#define HYPRATOM_NAME(id, name) name,
+    HYPRATOMS_FOREACH(HYPRATOM_NAME)
+#undef HYPRATOM_NAME
+};
+
+inline std::array<uint32_t, HA_COUNT> HYPRATOMS = {};